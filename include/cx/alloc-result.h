@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cx/common.h>
+#include <cx/idioms.h>
+#include <cx/error.h>
+#include <cx/exit.h>
+#include <cx/result.h>
+
+//Allocation errors and results shared by all allocators. Separate from
+//<cx/allocator.h> so that allocators included before it, to be selected with
+//`CX_ALLOC_USER_IMPL`, can report errors
+namespace CX {
+ //Allocation error kinds
+ enum struct AllocErrorType : unsigned char {
+  //The allocator could not obtain memory
+  OUT_OF_MEMORY,
+  //The requested alignment is not a power of two
+  INVALID_ALIGNMENT,
+  //The size of the requested allocation overflows `SizeType`
+  SIZE_OVERFLOW,
+  //The allocator cannot serve requests of this kind
+  UNSUPPORTED,
+  //No allocator backend is available
+  UNAVAILABLE
+ };
+
+ //Error for failed allocations
+ struct AllocError final {
+  AllocErrorType type;
+
+  constexpr char const * describe() const noexcept {
+   switch (type) {
+    case AllocErrorType::OUT_OF_MEMORY: {
+     return "Allocation failed: out of memory";
+    }
+    case AllocErrorType::INVALID_ALIGNMENT: {
+     return "Allocation failed: alignment must be a power of two";
+    }
+    case AllocErrorType::SIZE_OVERFLOW: {
+     return "Allocation failed: allocation size overflow";
+    }
+    case AllocErrorType::UNSUPPORTED: {
+     return "Allocation failed: request not supported by the allocator";
+    }
+    case AllocErrorType::UNAVAILABLE: {
+     return
+      "NoneAllocator cannot allocate memory. Either enable STL/LIBC support "
+      "to inherit one of their allocator backends, or define your own using "
+      "CX_ALLOC_USER_IMPL.";
+    }
+   }
+   return "Allocation failed";
+  }
+ };
+ static_assert(IsError<AllocError>);
+
+ //Allocation result; refers to the first allocated object
+ template<typename T>
+ using AllocResult = Result<T&, AllocError>;
+
+ //Supporting meta-functions for allocators
+ namespace AllocatorMetaFunctions {
+  //Returns whether `alignment` is a non-zero power of two
+  constexpr bool isAlignment(SizeType const alignment) noexcept {
+   return alignment && !(alignment & (alignment - 1));
+  }
+
+  //Stores the size of `n` objects of type `T`, in bytes, to `bytes`; returns
+  //`false` if the size overflows `SizeType`
+  template<typename T>
+  constexpr bool byteSize(SizeType const n, SizeType& bytes) noexcept {
+   return !__builtin_mul_overflow(n, sizeof(T), &bytes);
+  }
+
+  //Copies `n` objects from `src` to `dst`
+  template<typename T>
+  constexpr void copy(T * const dst, T const * const src, SizeType const n)
+   noexcept
+  {
+   if (isConstexpr()) {
+    for (SizeType i = 0; i < n; i++) {
+     dst[i] = src[i];
+    }
+   } else {
+    __builtin_memcpy((void *)dst, (void const *)src, n * sizeof(T));
+   }
+  }
+ }
+
+ //Returns the object referred to by `result`, or exits with its error
+ template<typename T>
+ constexpr T& unwrapAllocation(AllocResult<T> const& result) noexcept {
+  if (!result.hasValue()) {
+   exit(result.error());
+  }
+  return result.value();
+ }
+}
@@ -1,7 +1,14 @@
+#pragma once
+
 //Dependencies for supporting the libc allocator implementation
 //Note: Included before any CX headers since STL headers depend on exceptions.
 #ifdef CX_LIBC_SUPPORT
  #include <cstdlib>
+ #include <cstddef>
+ //`malloc_usable_size`, for in-place expansion of allocations
+ #ifdef __GLIBC__
+  #include <malloc.h>
+ #endif
 #endif
 
 #include <cx/common.h>
@@ -25,22 +32,24 @@
    constexpr allocator() noexcept = default;
    constexpr ~allocator() noexcept = default;
 
-   constexpr T* allocate(SizeType const n) noexcept {
-    constexpr std::nothrow_t no_throw;
-    return static_cast<T *>(::operator new(n * sizeof(T), no_throw));
+   //Note: Uses the implicitly declared global allocation functions, since
+   //`std::nothrow_t` is unavailable without <new>
+   constexpr T* allocate(CX::SizeType const n) noexcept {
+    return static_cast<T *>(::operator new(n * sizeof(T)));
    }
 
-   constexpr void deallocate(T * p, SizeType) noexcept {
-    constexpr std::nothrow_t no_throw;
-    ::operator delete(p, no_throw);
+   constexpr void deallocate(T * p, CX::SizeType) noexcept {
+    ::operator delete(p);
    }
   };
  }
 #endif
 
 #include <cx/idioms.h>
+#include <cx/templates.h>
 #include <cx/error.h>
 #include <cx/exit.h>
+#include <cx/alloc-result.h>
 
 //Flags to configure default allocator behaviour
 #if defined(CX_ALLOC_USER_IMPL)
@@ -64,7 +73,7 @@ namespace CX {
   //MaybeAllocator<Dummy<>>::Stateless &&
   requires (
    MaybeAllocator<Dummy<>>& a,
-   Dummy<>& (* allocate)(SizeType) noexcept,
+   AllocResult<Dummy<>> (* allocate)(SizeType) noexcept,
    void (* deallocate)(Dummy<> const&, SizeType) noexcept
   ) {
    a;
@@ -78,8 +87,10 @@ namespace CX {
   //!MaybeAllocator<Dummy<>>::Stateless &&
   requires (
    MaybeAllocator<Dummy<>>& a,
-   Dummy<>& (MaybeAllocator<Dummy<>>::* allocate)(SizeType) noexcept,
-   void (MaybeAllocator<Dummy<>>::* deallocate)(Dummy<> const&, SizeType) noexcept
+   AllocResult<Dummy<>> (MaybeAllocator<Dummy<>>::* allocate)(SizeType)
+    noexcept,
+   void (MaybeAllocator<Dummy<>>::* deallocate)(Dummy<> const&, SizeType)
+    noexcept
   ) {
    a;
    allocate = &MaybeAllocator<Dummy<>>::allocate;
@@ -91,6 +102,94 @@ namespace CX {
  concept IsAllocator = IsStatefulAllocator<MaybeAllocator>
   || IsStatelessAllocator<MaybeAllocator>;
 
+ //Over-aligned allocation identity concept; `allocate(n, alignment)`
+ //allocates `n` objects aligned to at least `alignment`, a power of two, and
+ //`deallocate(t, n, alignment)` releases them
+ template<template<typename...> typename MaybeAllocator>
+ concept IsAligningAllocator = IsAllocator<MaybeAllocator>
+  && requires (MaybeAllocator<Dummy<>>& a, Dummy<> const& t, SizeType n) {
+   {a.allocate(n, n)} -> SameType<AllocResult<Dummy<>>>;
+   a.deallocate(t, n, n);
+  };
+
+ //In-place resizing identity concept; `expand(t, oldN, newN)` resizes the
+ //allocation of `oldN` objects at `t` to `newN` objects without moving it,
+ //and returns whether it succeeded
+ template<template<typename...> typename MaybeAllocator>
+ concept IsExpandingAllocator = IsAllocator<MaybeAllocator>
+  && requires (MaybeAllocator<Dummy<>>& a, Dummy<>& t, SizeType n) {
+   {a.expand(t, n, n)} -> SameType<bool>;
+  };
+
+ //Reallocation identity concept; `reallocate(t, oldN, newN)` resizes the
+ //allocation of `oldN` trivially copyable objects at `t` to `newN` objects,
+ //moving it if necessary. On error, `t` remains allocated
+ template<template<typename...> typename MaybeAllocator>
+ concept IsReallocatingAllocator = IsAllocator<MaybeAllocator>
+  && requires (MaybeAllocator<Dummy<>>& a, Dummy<>& t, SizeType n) {
+   {a.reallocate(t, n, n)} -> SameType<AllocResult<Dummy<>>>;
+  };
+
+ //Allocator instance storage type; zero-sized for stateless allocators
+ template<template<typename...> typename A, typename T>
+ requires IsAllocator<A>
+ using AllocatorStorage = SelectType<IsStatefulAllocator<A>, A<T>, Never>;
+
+ //Resizes the allocation of `oldN` objects at `t`, made with `allocator`, to
+ //`newN` objects, preserving the first `min(oldN, newN)` objects. The
+ //allocation is resized in place if `A` can expand it, then with
+ //`A::reallocate`; otherwise it is moved to a new allocation. On error, `t`
+ //remains allocated and unchanged
+ template<template<typename...> typename A, TriviallyCopyable T>
+ requires IsAllocator<A>
+ constexpr AllocResult<T> reallocate(
+  AllocatorStorage<A, T>& allocator,
+  T& t,
+  SizeType const oldN,
+  SizeType const newN
+ ) noexcept {
+  constexpr bool const Stateful = IsStatefulAllocator<A>;
+  if constexpr (IsExpandingAllocator<A>) {
+   bool expanded;
+   if constexpr (Stateful) {
+    expanded = allocator.expand(t, oldN, newN);
+   } else {
+    expanded = A<T>::expand(t, oldN, newN);
+   }
+   if (expanded) {
+    return t;
+   }
+  }
+  if constexpr (IsReallocatingAllocator<A>) {
+   if constexpr (Stateful) {
+    return allocator.reallocate(t, oldN, newN);
+   } else {
+    return A<T>::reallocate(t, oldN, newN);
+   }
+  } else {
+   AllocResult<T> result = [&] {
+    if constexpr (Stateful) {
+     return allocator.allocate(newN);
+    } else {
+     return A<T>::allocate(newN);
+    }
+   }();
+   if (result) {
+    AllocatorMetaFunctions::copy(
+     &result.value(),
+     &t,
+     oldN < newN ? oldN : newN
+    );
+    if constexpr (Stateful) {
+     allocator.deallocate(t, oldN);
+    } else {
+     A<T>::deallocate(t, oldN);
+    }
+   }
+   return result;
+  }
+ }
+
  //Error for `ConstexprAllocator`
  struct NotInConstantEvaluatedContextError final {
   constexpr auto& describe() const noexcept {
@@ -120,27 +219,48 @@ namespace CX {
    assertInConstantEvaluatedContext();
   }
 
-  //TODO Convert to `CX::Result`
   [[nodiscard]]
-  static constexpr T& allocate(SizeType const n = 1) noexcept {
+  static constexpr AllocResult<T> allocate(SizeType const n = 1) noexcept {
    assertInConstantEvaluatedContext();
+   SizeType bytes;
+   if (!AllocatorMetaFunctions::byteSize<T>(n, bytes)) {
+    return AllocError{AllocErrorType::SIZE_OVERFLOW};
+   }
    auto val = std::allocator<T>{}
     .allocate(n);
    if (!val) {
-    //TODO return error
-    exit();
+    return AllocError{AllocErrorType::OUT_OF_MEMORY};
    }
    return *val;
   }
 
-  //TODO Convert to `CX::Result`
+  //Note: Objects have no addresses during constant evaluation; `alignment`
+  //is only validated
+  [[nodiscard]]
+  static constexpr AllocResult<T> allocate(
+   SizeType const n,
+   SizeType const alignment
+  ) noexcept {
+   if (!AllocatorMetaFunctions::isAlignment(alignment)) {
+    return AllocError{AllocErrorType::INVALID_ALIGNMENT};
+   }
+   return allocate(n);
+  }
+
   static constexpr void deallocate(T const& t, SizeType const n = 1) noexcept {
    assertInConstantEvaluatedContext();
    std::allocator<T>{}
     .deallocate(&const_cast<T&>(t), n);
   }
+
+  static constexpr void deallocate(T const& t, SizeType const n, SizeType)
+   noexcept
+  {
+   deallocate(t, n);
+  }
  };
  static_assert(IsStatelessAllocator<ConstexprAllocator>);
+ static_assert(IsAligningAllocator<ConstexprAllocator>);
 
  //STL-backed allocator implementation
  #ifdef CX_STL_SUPPORT
@@ -149,82 +269,221 @@ namespace CX {
    constexpr StlAllocator() noexcept = default;
    constexpr ~StlAllocator() noexcept = default;
 
-   //TODO Convert to `CX::Result`
    [[nodiscard]]
-   static constexpr T& allocate(SizeType const n = 1) noexcept {
+   static constexpr AllocResult<T> allocate(SizeType const n = 1) noexcept {
+    SizeType bytes;
+    if (!AllocatorMetaFunctions::byteSize<T>(n, bytes)) {
+     return AllocError{AllocErrorType::SIZE_OVERFLOW};
+    }
     auto val = std
-     ::allocator<T>
-     ::allocate(n);
+     ::allocator<T>{}
+     .allocate(n);
     if (!val) {
-     //TODO return error
-     exit();
+     return AllocError{AllocErrorType::OUT_OF_MEMORY};
     }
     return *val;
    }
 
+   //Requests aligned beyond `alignof(T)` use the aligned, non-throwing
+   //`operator new`
+   [[nodiscard]]
+   static constexpr AllocResult<T> allocate(
+    SizeType const n,
+    SizeType const alignment
+   ) noexcept {
+    if (!AllocatorMetaFunctions::isAlignment(alignment)) {
+     return AllocError{AllocErrorType::INVALID_ALIGNMENT};
+    }
+    if (isConstexpr() || alignment <= alignof(T)) {
+     return allocate(n);
+    }
+    SizeType bytes;
+    if (!AllocatorMetaFunctions::byteSize<T>(n, bytes)) {
+     return AllocError{AllocErrorType::SIZE_OVERFLOW};
+    }
+    auto const ptr = ::operator new(
+     bytes,
+     std::align_val_t{alignment},
+     std::nothrow
+    );
+    if (!ptr) {
+     return AllocError{AllocErrorType::OUT_OF_MEMORY};
+    }
+    return *static_cast<T *>(ptr);
+   }
+
    //TODO Convert to return `Option<Error>` or `Result<void, Error>` and add
    //[[nodiscard]]
    static constexpr void deallocate(T const& t, SizeType const n = 1)
     noexcept
    {
     std
-     ::allocator<T>
-     ::deallocate(t, n);
+     ::allocator<T>{}
+     .deallocate(&const_cast<T&>(t), n);
+   }
+
+   //Releases an allocation made with `allocate(n, alignment)`, using the
+   //sized `operator delete`
+   static constexpr void deallocate(
+    T const& t,
+    SizeType const n,
+    SizeType const alignment
+   ) noexcept {
+    if (isConstexpr() || alignment <= alignof(T)) {
+     deallocate(t, n);
+    } else {
+     ::operator delete(
+      (void *)&t,
+      n * sizeof(T),
+      std::align_val_t{alignment}
+     );
+    }
    }
   };
   static_assert(IsStatelessAllocator<StlAllocator>);
+  static_assert(IsAligningAllocator<StlAllocator>);
  #endif
 
  //LIBC-backed allocator implementation
  #ifdef CX_LIBC_SUPPORT
   //TODO Windows UCRT _aligned_malloc / _aligned_free support
+  //Note: libc has no sized `free`; sizes are only used for constant-evaluated
+  //allocations and to bound in-place expansion
   template<typename T>
   struct LibcAllocator final : Never {
+  private:
+   //Whether `malloc` and `realloc` guarantee `alignment`
+   static constexpr bool mallocAligned(SizeType const alignment) noexcept {
+    return alignment <= alignof(max_align_t);
+   }
+
+  public:
    constexpr LibcAllocator() noexcept = default;
    constexpr ~LibcAllocator() noexcept = default;
 
-   //TODO Convert to CX::Result
    [[nodiscard]]
-   static constexpr T& allocate(SizeType const n = 1) noexcept {
+   static constexpr AllocResult<T> allocate(SizeType const n = 1) noexcept {
+    return allocate(n, alignof(T));
+   }
+
+   //Allocates `n` objects aligned to at least `alignment`. Fundamental
+   //alignments are served by `malloc`; larger alignments by `aligned_alloc`
+   //when the size is a multiple of the alignment, as C11 requires, and by
+   //`posix_memalign` otherwise
+   [[nodiscard]]
+   static constexpr AllocResult<T> allocate(
+    SizeType const n,
+    SizeType const alignment
+   ) noexcept {
+    if (!AllocatorMetaFunctions::isAlignment(alignment)) {
+     return AllocError{AllocErrorType::INVALID_ALIGNMENT};
+    }
+    SizeType bytes;
+    if (!AllocatorMetaFunctions::byteSize<T>(n, bytes)) {
+     return AllocError{AllocErrorType::SIZE_OVERFLOW};
+    }
     if (isConstexpr()) {
      //Use ConstexprAllocator for constant-evaluated allocations
      return ConstexprAllocator<T>::allocate(n);
-    } else {
-     //Use libc memory management logic at runtime
-     T * ptr;
-     auto const err = posix_memalign(&ptr, alignof(T), n * sizeof(T));
-     if (err) {
-      //TODO Appropriate errors for EINVAL and ENOMEM
-      exit();
-     }
-     return *ptr;
     }
+    //Use libc memory management logic at runtime
+    //Note: Zero-sized requests are rounded up so that every successful
+    //allocation is unique and non-null
+    auto const size = bytes ? bytes : 1;
+    auto const align = alignment < alignof(T) ? alignof(T) : alignment;
+    void * ptr;
+    if (mallocAligned(align)) {
+     ptr = malloc(size);
+    } else if (size % align == 0) {
+     ptr = aligned_alloc(align, size);
+    } else if (posix_memalign(&ptr, align, size)) {
+     ptr = nullptr;
+    }
+    if (!ptr) {
+     return AllocError{AllocErrorType::OUT_OF_MEMORY};
+    }
+    return *static_cast<T *>(ptr);
    }
 
-   //TODO Convert to CX::Result
    static constexpr void deallocate(T const& t, SizeType const n) noexcept {
     if (isConstexpr()) {
      //Use ConstexprAllocator for constant-evaluated deallocations
      ConstexprAllocator<T>::deallocate(t, n);
     } else {
      //Use libc memory management logic at runtime
-     free(&t);
+     free((void *)&t);
+    }
+   }
+
+   static constexpr void deallocate(T const& t, SizeType const n, SizeType)
+    noexcept
+   {
+    deallocate(t, n);
+   }
+
+   //Resizes the allocation in place. Shrinking always succeeds; growing
+   //succeeds when the usable size of the allocation, as reported by glibc,
+   //already covers `newN` objects
+   static constexpr bool expand(
+    T& t,
+    SizeType const oldN,
+    SizeType const newN
+   ) noexcept {
+    if (isConstexpr()) {
+     return newN == oldN;
+    }
+    if (newN <= oldN) {
+     return true;
     }
+    #ifdef __GLIBC__
+     SizeType bytes;
+     return AllocatorMetaFunctions::byteSize<T>(newN, bytes)
+      && bytes <= malloc_usable_size((void *)&t);
+    #else
+     return false;
+    #endif
+   }
+
+   //Resizes the allocation with `realloc`, which extends it in place when
+   //possible. Allocations of over-aligned types are moved to a new
+   //allocation instead, since `realloc` only guarantees fundamental
+   //alignment
+   //Note: Only valid for allocations made with `allocate(n)`
+   [[nodiscard]]
+   static constexpr AllocResult<T> reallocate(
+    T& t,
+    SizeType const oldN,
+    SizeType const newN
+   ) noexcept requires TriviallyCopyable<T> {
+    if (isConstexpr() || !mallocAligned(alignof(T))) {
+     auto result = allocate(newN);
+     if (result) {
+      AllocatorMetaFunctions::copy(
+       &result.value(),
+       &t,
+       oldN < newN ? oldN : newN
+      );
+      deallocate(t, oldN);
+     }
+     return result;
+    }
+    SizeType bytes;
+    if (!AllocatorMetaFunctions::byteSize<T>(newN, bytes)) {
+     return AllocError{AllocErrorType::SIZE_OVERFLOW};
+    }
+    auto const ptr = realloc((void *)&t, bytes ? bytes : 1);
+    if (!ptr) {
+     return AllocError{AllocErrorType::OUT_OF_MEMORY};
+    }
+    return *static_cast<T *>(ptr);
    }
   };
   static_assert(IsStatelessAllocator<LibcAllocator>);
+  static_assert(IsAligningAllocator<LibcAllocator>);
+  static_assert(IsExpandingAllocator<LibcAllocator>);
+  static_assert(IsReallocatingAllocator<LibcAllocator>);
  #endif
 
- //Error for `NoneAllocator`
- struct NoneAllocatorError final {
-  constexpr auto& describe() const noexcept {
-   return
-    "NoneAllocator cannot allocate memory. Either enable STL/LIBC support to "
-    "inherit one of their allocator backends, or define your own using "
-    "CX_ALLOC_USER_IMPL.";
-  }
- };
-
  //Default allocator when no supporting libraries (stl / libc) are available to
  //provide an allocator backend
  template<typename T>
@@ -232,12 +491,21 @@ namespace CX {
   constexpr NoneAllocator() noexcept = default;
   constexpr ~NoneAllocator() noexcept = default;
 
-  //TODO Convert to CX::Result
   [[nodiscard]]
-  static constexpr T& allocate(SizeType) noexcept {
-   //TODO Return error instead
-   exit(NoneAllocatorError{});
+  static constexpr AllocResult<T> allocate(SizeType) noexcept {
+   return AllocError{AllocErrorType::UNAVAILABLE};
+  }
+
+  [[nodiscard]]
+  static constexpr AllocResult<T> allocate(SizeType, SizeType) noexcept {
+   return AllocError{AllocErrorType::UNAVAILABLE};
   }
+
+  //Nop; nothing can be allocated
+  static constexpr void deallocate(T const&, SizeType) noexcept {}
+
+  //Nop; nothing can be allocated
+  static constexpr void deallocate(T const&, SizeType, SizeType) noexcept {}
  };
 
  //Alias template for CX default allocator
@@ -255,7 +523,7 @@ namespace CX {
   using Allocator = LibcAllocator<T>;
  #elif CX_ALLOC_IMPL == 3
   //No default allocator implementation, use `NoneAllocator`
-  template<typename>
+  template<typename T>
   using Allocator = NoneAllocator<T>;
  #endif
  static_assert(IsAllocator<Allocator>);
@@ -280,16 +548,14 @@ namespace CX {
   constexpr SinglePlacementAllocator() noexcept {}
   constexpr ~SinglePlacementAllocator() noexcept {}
 
-  //TODO Convert to CX::Result
-  constexpr T& allocate(SizeType const n = 0) noexcept {
+  [[nodiscard]]
+  constexpr AllocResult<T> allocate(SizeType const n = 1) noexcept {
    if (n != 1) {
-    //TODO Appropriate error
-    exit();
+    return AllocError{AllocErrorType::UNSUPPORTED};
    }
    return t;
   }
 
-  //TODO Convert to CX::Result
   //Nop
   constexpr void deallocate(T const&, SizeType) noexcept {}
  };
@@ -0,0 +1,364 @@
+#pragma once
+
+#include <cx/allocator.h>
+#include <cx/common.h>
+#include <cx/idioms.h>
+#include <cx/error.h>
+#include <cx/exit.h>
+
+namespace CX {
+ //Error for `Arena`
+ struct ArenaError final {
+  char const * message;
+
+  constexpr char const * describe() const noexcept {
+   return message;
+  }
+ };
+ static_assert(IsError<ArenaError>);
+
+ //Supporting meta-functions for `CX::Arena`
+ namespace ArenaMetaFunctions {
+  //Alignment of chunks allocated from the upstream allocator; requests
+  //with larger alignments are satisfied by padding within a chunk
+  constexpr SizeType const ChunkAlignment = 16;
+
+  //Default size of the first chunk, in bytes
+  constexpr SizeType const DefaultChunkSize = 4096;
+
+  //Largest size chunks grow to, in bytes; larger requests receive a
+  //dedicated chunk
+  constexpr SizeType const MaxChunkSize = 1 << 20;
+
+  //Unit of upstream allocation; guarantees the alignment of chunks
+  struct alignas(ChunkAlignment) Block final {
+   unsigned char bytes[ChunkAlignment];
+  };
+
+  //Chunk header; stored at the start of every chunk
+  struct alignas(ChunkAlignment) Chunk final {
+   //Previously allocated chunk
+   Chunk * previous;
+   //Number of `Block`s in the chunk, including the header
+   SizeType blocks;
+
+   unsigned char * begin() noexcept {
+    return (unsigned char *)(this + 1);
+   }
+
+   unsigned char * end() noexcept {
+    return (unsigned char *)this + blocks * sizeof(Block);
+   }
+  };
+
+  //Type-erased stateless upstream allocator for chunks
+  struct Upstream final {
+   AllocResult<Block> (* allocate)(SizeType) noexcept;
+   void (* deallocate)(Block const&, SizeType) noexcept;
+
+   //Returns the upstream for the stateless allocator `A`
+   template<template<typename...> typename A>
+   requires IsStatelessAllocator<A>
+   static constexpr Upstream of() noexcept {
+    return {&A<Block>::allocate, &A<Block>::deallocate};
+   }
+  };
+
+  //Returns `address` rounded up to `alignment`, which must be a power of two
+  constexpr SizeType alignUp(SizeType const address, SizeType const alignment)
+   noexcept
+  {
+   return (address + alignment - 1) & ~(alignment - 1);
+  }
+ }
+
+ //Region-based memory resource. Allocates from a list of chunks by bumping a
+ //cursor; individual allocations are never freed. Instead, all allocations
+ //are released together with `reset()`, or all allocations made after a
+ //`mark()` are released with `rewind()`. Chunks are acquired from a
+ //stateless upstream allocator, `CX::Allocator` by default, and grow
+ //geometrically
+ //Note: Not thread-safe; use one arena per thread
+ struct Arena final {
+  using Block = ArenaMetaFunctions::Block;
+  using Chunk = ArenaMetaFunctions::Chunk;
+  using Upstream = ArenaMetaFunctions::Upstream;
+
+  //Position in an arena; see `Arena::mark()`
+  struct Mark final {
+   Chunk * chunk;
+   unsigned char * cursor;
+  };
+
+  //Rewinds the arena to its position at construction, on destruction
+  struct Scope final {
+  private:
+   Arena& arena;
+   Mark const mark;
+
+  public:
+   explicit Scope(Arena& arena) noexcept :
+    arena(arena),
+    mark(arena.mark())
+   {}
+
+   Scope(Scope const&) = delete;
+   Scope(Scope&&) = delete;
+
+   ~Scope() noexcept {
+    arena.rewind(mark);
+   }
+  };
+
+ private:
+  //Most recently allocated chunk
+  Chunk * current = nullptr;
+  //Bump cursor and end of the unused region of `current`
+  unsigned char * cursor = nullptr;
+  unsigned char * limit = nullptr;
+  //Size of the next chunk, in bytes
+  SizeType nextChunkSize;
+  Upstream const upstream;
+
+  //Returns `chunk` to the upstream allocator
+  void release(Chunk * const chunk) const noexcept {
+   upstream.deallocate(*(Block *)chunk, chunk->blocks);
+  }
+
+  //Allocates a chunk with room for `bytes` bytes at `alignment`; returns
+  //whether the upstream allocation succeeded
+  [[gnu::noinline]]
+  bool grow(SizeType const bytes, SizeType const alignment) noexcept {
+   using namespace ArenaMetaFunctions;
+   //Reserve space for the header and for aligning the request
+   auto const padding = alignment > ChunkAlignment
+    ? alignment - ChunkAlignment
+    : 0;
+   auto const required = sizeof(Chunk) + bytes + padding;
+   if (required < bytes) {
+    return false;
+   }
+   auto const size = required > nextChunkSize ? required : nextChunkSize;
+   auto const blocks = (size + sizeof(Block) - 1) / sizeof(Block);
+   auto const result = upstream.allocate(blocks);
+   if (!result.hasValue()) {
+    return false;
+   }
+   auto const chunk = (Chunk *)&result.value();
+   chunk->previous = current;
+   chunk->blocks = blocks;
+   current = chunk;
+   cursor = chunk->begin();
+   limit = chunk->end();
+   if (nextChunkSize < MaxChunkSize) {
+    nextChunkSize *= 2;
+   }
+   return true;
+  }
+
+  //Releases all chunks allocated after `chunk`
+  void releaseAfter(Chunk * const chunk) noexcept {
+   while (current != chunk) {
+    auto const previous = current->previous;
+    release(current);
+    current = previous;
+   }
+  }
+
+ public:
+  //Constructs an empty arena; no memory is allocated until the first
+  //allocation. `chunkSize` is the size of the first chunk, in bytes
+  explicit Arena(
+   SizeType const chunkSize = ArenaMetaFunctions::DefaultChunkSize,
+   Upstream const upstream = Upstream::of<Allocator>()
+  ) noexcept :
+   nextChunkSize(chunkSize ? chunkSize : 1),
+   upstream(upstream)
+  {}
+
+  //Allocators refer to their arena by address; arenas cannot be copied or
+  //moved
+  Arena(Arena const&) = delete;
+  Arena(Arena&&) = delete;
+
+  //Destructor; releases all chunks
+  ~Arena() noexcept {
+   releaseAfter(nullptr);
+  }
+
+  //Allocates `bytes` bytes aligned to `alignment`, which must be a power of
+  //two. Returns `nullptr` if a chunk cannot be allocated
+  [[nodiscard]]
+  void * allocate(SizeType const bytes, SizeType const alignment) noexcept {
+   if (alignment == 0 || (alignment & (alignment - 1))) {
+    exit(ArenaError{"Arena allocation alignment must be a power of two"});
+   }
+   auto address = ArenaMetaFunctions::alignUp((SizeType)cursor, alignment);
+   if (!cursor
+    || address > (SizeType)limit
+    || bytes > (SizeType)limit - address
+   ) {
+    if (!grow(bytes, alignment)) {
+     return nullptr;
+    }
+    address = ArenaMetaFunctions::alignUp((SizeType)cursor, alignment);
+   }
+   cursor = (unsigned char *)(address + bytes);
+   return (void *)address;
+  }
+
+  //Resizes the allocation of `bytes` bytes at `address` to `newBytes` bytes
+  //without moving it; returns whether it succeeded. Only the most recent
+  //allocation can grow, within the space left in its chunk; shrinking always
+  //succeeds, and returns the released space to the arena if the allocation
+  //is the most recent
+  bool expand(
+   void * const address,
+   SizeType const bytes,
+   SizeType const newBytes
+  ) noexcept {
+   auto const begin = (unsigned char *)address;
+   auto const last = begin + bytes == cursor;
+   if (newBytes <= bytes) {
+    if (last) {
+     cursor = begin + newBytes;
+    }
+    return true;
+   }
+   if (!last || newBytes > (SizeType)(limit - begin)) {
+    return false;
+   }
+   cursor = begin + newBytes;
+   return true;
+  }
+
+  //Returns the current position of the arena
+  Mark mark() const noexcept {
+   return {current, cursor};
+  }
+
+  //Releases all allocations made after `mark` was taken; chunks acquired
+  //since then are returned to the upstream allocator. Marks taken after
+  //`mark` are invalidated
+  void rewind(Mark const mark) noexcept {
+   if (!mark.chunk) {
+    reset();
+    return;
+   }
+   releaseAfter(mark.chunk);
+   cursor = mark.cursor;
+   limit = current->end();
+  }
+
+  //Releases all allocations. The most recent chunk, which is also the
+  //largest, is retained for reuse; all other chunks are returned to the
+  //upstream allocator. Invalidates all marks
+  void reset() noexcept {
+   if (!current) {
+    return;
+   }
+   auto const retained = current;
+   current = current->previous;
+   releaseAfter(nullptr);
+   retained->previous = nullptr;
+   current = retained;
+   cursor = retained->begin();
+   limit = retained->end();
+  }
+
+  //Returns the number of chunks held by the arena
+  SizeType chunkCount() const noexcept {
+   SizeType count = 0;
+   for (auto chunk = current; chunk; chunk = chunk->previous) {
+    count++;
+   }
+   return count;
+  }
+
+  //Returns the number of bytes held by the arena, including chunk headers
+  SizeType capacity() const noexcept {
+   SizeType total = 0;
+   for (auto chunk = current; chunk; chunk = chunk->previous) {
+    total += chunk->blocks * sizeof(Block);
+   }
+   return total;
+  }
+ };
+
+ //Stateful allocator handle for `CX::Arena`. Allocations are served by the
+ //referenced arena and `deallocate` is a no-op; memory is reclaimed by
+ //resetting or rewinding the arena. Handles for different element types
+ //may share an arena
+ template<typename T>
+ struct ArenaAllocator final {
+  template<typename>
+  friend struct ArenaAllocator;
+
+ private:
+  Arena * arena;
+
+ public:
+  constexpr ArenaAllocator(Arena& arena) noexcept :
+   arena(&arena)
+  {}
+
+  //Rebinds an allocator for another element type to the same arena
+  template<typename U>
+  constexpr ArenaAllocator(ArenaAllocator<U> const& other) noexcept :
+   arena(other.arena)
+  {}
+
+  //Returns the referenced arena
+  constexpr Arena& resource() const noexcept {
+   return *arena;
+  }
+
+  [[nodiscard]]
+  AllocResult<T> allocate(SizeType const n = 1) noexcept {
+   return allocate(n, alignof(T));
+  }
+
+  [[nodiscard]]
+  AllocResult<T> allocate(SizeType const n, SizeType const alignment)
+   noexcept
+  {
+   if (!AllocatorMetaFunctions::isAlignment(alignment)) {
+    return AllocError{AllocErrorType::INVALID_ALIGNMENT};
+   }
+   SizeType bytes;
+   if (!AllocatorMetaFunctions::byteSize<T>(n, bytes)) {
+    return AllocError{AllocErrorType::SIZE_OVERFLOW};
+   }
+   auto const address = arena->allocate(
+    bytes,
+    alignment < alignof(T) ? alignof(T) : alignment
+   );
+   if (!address) {
+    return AllocError{AllocErrorType::OUT_OF_MEMORY};
+   }
+   return *(T *)address;
+  }
+
+  //Nop
+  constexpr void deallocate(T const&, SizeType = 1) noexcept {}
+
+  //Nop
+  constexpr void deallocate(T const&, SizeType, SizeType) noexcept {}
+
+  //Resizes the allocation in place; see `Arena::expand`
+  bool expand(T& t, SizeType const oldN, SizeType const newN) noexcept {
+   SizeType bytes;
+   return AllocatorMetaFunctions::byteSize<T>(newN, bytes)
+    && arena->expand(&t, oldN * sizeof(T), bytes);
+  }
+
+  //Allocators are equal when they share an arena
+  template<typename U>
+  constexpr bool operator==(ArenaAllocator<U> const& other) const noexcept {
+   return arena == other.arena;
+  }
+ };
+ static_assert(IsStatefulAllocator<ArenaAllocator>);
+ static_assert(IsAligningAllocator<ArenaAllocator>);
+ static_assert(IsExpandingAllocator<ArenaAllocator>);
+}
@@ -1,452 +1,2646 @@
 #pragma once
 
+#include <cx/allocator.h>
+#include <cx/common.h>
 #include <cx/idioms.h>
+#include <cx/templates.h>
+#include <cx/thread.h>
+
+//Select the SIMD instruction sets available to the bulk bitset kernels.
+//Define `CX_BITSET_NO_SIMD` to restrict all bitsets to the scalar kernels
+#if !defined(CX_BITSET_NO_SIMD) \
+ && (defined(CX_COMPILER_GCC) || defined(CX_COMPILER_CLANG_LIKE))
+ #if defined(__x86_64__)
+  #define CX_BITSET_SIMD_X86
+ #elif defined(__aarch64__)
+  #define CX_BITSET_SIMD_NEON
+ #endif
+#endif
+
+//Temporarily disable exception keyword shadowing to avoid breaking
+//intrinsics headers
+#ifndef CX_NO_BELLIGERENT_ERRORS
+ #undef throw
+ #undef try
+ #undef catch
+ #undef finally
+#endif
+
+#ifdef CX_BITSET_SIMD_X86
+ #include <immintrin.h>
+#endif
+
+#ifdef CX_BITSET_SIMD_NEON
+ #include <arm_neon.h>
+#endif
+
+//Re-enable exception keyword shadowing
+#ifndef CX_NO_BELLIGERENT_ERRORS
+ //Disable clang warnings about macros shadowing keywords
+ #ifdef CX_COMPILER_CLANG_LIKE
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wkeyword-macro"
+ #endif
+
+ //Re-define macros to shadow keywords related to exception handling
+ #define throw CX_ERROR_EXCEPTIONS_ARE_BAD
+ #define try CX_ERROR_EXCEPTIONS_ARE_BAD
+ #define catch CX_ERROR_EXCEPTIONS_ARE_BAD
+ #define finally CX_ERROR_EXCEPTIONS_ARE_BAD
+
+ //Pop diagnostic context
+ #ifdef CX_COMPILER_CLANG_LIKE
+  #pragma GCC diagnostic pop
+ #endif
+#endif
 
 namespace CX {
  //Supporting meta-functions for bitset
  namespace BitsetMetaFunctions {
+  //Storage unit for all bitset backends
+  using Word = unsigned long long;
+
+  //Number of bits in a `Word`
+  constexpr SizeType const WordBits = sizeof(Word) * 8;
+
+  //Assumed size of a cache line, in bytes
+  //Note: `std::hardware_destructive_interference_size` is unavailable without
+  //STL support
+  constexpr SizeType const CacheLineSize = 64;
+
+  //Returns the number of words required to store `bits` bits
+  constexpr SizeType wordsForBits(SizeType const bits) noexcept {
+   return (bits + WordBits - 1) / WordBits;
+  }
+
+  //Returns the mask of valid bits in the last word of a `bits`-bit buffer
+  constexpr Word tailMask(SizeType const bits) noexcept {
+   auto const remainder = bits % WordBits;
+   return remainder == 0 ? ~(Word)0 : ~(~(Word)0 << remainder);
+  }
+
+  //Word-span kernels shared by all bitset backends. All kernels operate on
+  //whole words; callers are responsible for masking unused tail bits
+  namespace Kernels {
+   //`dst[i] &= src[i]`
+   constexpr void bitwiseAnd(
+    Word * const dst,
+    Word const * const src,
+    SizeType const count
+   ) noexcept {
+    for (SizeType i = 0; i < count; i++) {
+     dst[i] &= src[i];
+    }
+   }
+
+   //`dst[i] |= src[i]`
+   constexpr void bitwiseOr(
+    Word * const dst,
+    Word const * const src,
+    SizeType const count
+   ) noexcept {
+    for (SizeType i = 0; i < count; i++) {
+     dst[i] |= src[i];
+    }
+   }
+
+   //`dst[i] ^= src[i]`
+   constexpr void bitwiseXor(
+    Word * const dst,
+    Word const * const src,
+    SizeType const count
+   ) noexcept {
+    for (SizeType i = 0; i < count; i++) {
+     dst[i] ^= src[i];
+    }
+   }
+
+   //`dst[i] &= ~src[i]`
+   constexpr void bitwiseAndNot(
+    Word * const dst,
+    Word const * const src,
+    SizeType const count
+   ) noexcept {
+    for (SizeType i = 0; i < count; i++) {
+     dst[i] &= ~src[i];
+    }
+   }
+
+   //`dst[i] = ~dst[i]`
+   constexpr void bitwiseNot(Word * const dst, SizeType const count) noexcept {
+    for (SizeType i = 0; i < count; i++) {
+     dst[i] = ~dst[i];
+    }
+   }
+
+   //`dst[i] = value`
+   constexpr void fill(
+    Word * const dst,
+    Word const value,
+    SizeType const count
+   ) noexcept {
+    for (SizeType i = 0; i < count; i++) {
+     dst[i] = value;
+    }
+   }
+
+   //`dst[i] = src[i]`
+   constexpr void copy(
+    Word * const dst,
+    Word const * const src,
+    SizeType const count
+   ) noexcept {
+    for (SizeType i = 0; i < count; i++) {
+     dst[i] = src[i];
+    }
+   }
+
+   //Returns the number of set bits
+   constexpr SizeType popcount(
+    Word const * const words,
+    SizeType const count
+   ) noexcept {
+    SizeType total = 0;
+    for (SizeType i = 0; i < count; i++) {
+     total += (SizeType)__builtin_popcountll(words[i]);
+    }
+    return total;
+   }
+
+   //Returns the number of bits set in both spans
+   constexpr SizeType intersectCount(
+    Word const * const w1,
+    Word const * const w2,
+    SizeType const count
+   ) noexcept {
+    SizeType total = 0;
+    for (SizeType i = 0; i < count; i++) {
+     total += (SizeType)__builtin_popcountll(w1[i] & w2[i]);
+    }
+    return total;
+   }
+
+   //Returns whether any bit is set
+   constexpr bool any(Word const * const words, SizeType const count) noexcept {
+    for (SizeType i = 0; i < count; i++) {
+     if (words[i]) {
+      return true;
+     }
+    }
+    return false;
+   }
+
+   //Returns whether both word spans are identical
+   constexpr bool equal(
+    Word const * const w1,
+    Word const * const w2,
+    SizeType const count
+   ) noexcept {
+    for (SizeType i = 0; i < count; i++) {
+     if (w1[i] != w2[i]) {
+      return false;
+     }
+    }
+    return true;
+   }
+
+   //Returns the index of the first set bit at or after `from`, or
+   //`count * WordBits` if there is none
+   constexpr SizeType findNext(
+    Word const * const words,
+    SizeType const count,
+    SizeType const from
+   ) noexcept {
+    auto index = from / WordBits;
+    if (index >= count) {
+     return count * WordBits;
+    }
+    //Discard bits below `from` in the first word
+    auto word = words[index] & (~(Word)0 << (from % WordBits));
+    while (true) {
+     if (word) {
+      return index * WordBits + (SizeType)__builtin_ctzll(word);
+     }
+     if (++index == count) {
+      return count * WordBits;
+     }
+     word = words[index];
+    }
+   }
+
+   //Returns the index of the first clear bit at or after `from`, or
+   //`count * WordBits` if there is none
+   constexpr SizeType findNextClear(
+    Word const * const words,
+    SizeType const count,
+    SizeType const from
+   ) noexcept {
+    auto index = from / WordBits;
+    if (index >= count) {
+     return count * WordBits;
+    }
+    //Discard bits below `from` in the first word
+    auto word = ~words[index] & (~(Word)0 << (from % WordBits));
+    while (true) {
+     if (word) {
+      return index * WordBits + (SizeType)__builtin_ctzll(word);
+     }
+     if (++index == count) {
+      return count * WordBits;
+     }
+     word = ~words[index];
+    }
+   }
+
+   //Sets bits `[begin, end)` to `value`, filling whole words at a time
+   constexpr void fillRange(
+    Word * const words,
+    SizeType const begin,
+    SizeType const end,
+    bool const value
+   ) noexcept {
+    if (begin >= end) {
+     return;
+    }
+    auto const first = begin / WordBits;
+    auto const last = (end - 1) / WordBits;
+    auto const firstMask = ~(Word)0 << (begin % WordBits);
+    auto const lastMask = ~(Word)0 >> (WordBits - 1 - (end - 1) % WordBits);
+    if (first == last) {
+     auto const mask = firstMask & lastMask;
+     words[first] = value ? words[first] | mask : words[first] & ~mask;
+     return;
+    }
+    words[first] = value ? words[first] | firstMask : words[first] & ~firstMask;
+    fill(words + first + 1, value ? ~(Word)0 : 0, last - first - 1);
+    words[last] = value ? words[last] | lastMask : words[last] & ~lastMask;
+   }
+
+   //Returns the number of runs of consecutive set bits; a run starts at
+   //every set bit whose lower neighbour is clear
+   constexpr SizeType countRuns(Word const * const words, SizeType const count)
+    noexcept
+   {
+    SizeType total = 0;
+    Word carry = 0;
+    for (SizeType i = 0; i < count; i++) {
+     auto const word = words[i];
+     total += (SizeType)__builtin_popcountll(word & ~((word << 1) | carry));
+     carry = word >> (WordBits - 1);
+    }
+    return total;
+   }
+
+   //Returns the index of the `k`th (zero-based) set bit of `word`; `word`
+   //must have more than `k` bits set
+   constexpr SizeType selectInWord(Word word, SizeType k) noexcept {
+    #if defined(CX_BITSET_SIMD_X86) && defined(__BMI2__)
+     if (!isConstexpr()) {
+      //Deposit the `k`th bit of the mask onto the `k`th set bit of `word`
+      return (SizeType)__builtin_ctzll(_pdep_u64((Word)1 << k, word));
+     }
+    #endif
+    //Clear the lowest `k` set bits
+    for (; k > 0; k--) {
+     word &= word - 1;
+    }
+    return (SizeType)__builtin_ctzll(word);
+   }
+
+   //Returns the index of the `k`th (zero-based) set bit, or
+   //`count * WordBits` if fewer than `k + 1` bits are set
+   constexpr SizeType select(
+    Word const * const words,
+    SizeType const count,
+    SizeType k
+   ) noexcept {
+    for (SizeType i = 0; i < count; i++) {
+     auto const bits = (SizeType)__builtin_popcountll(words[i]);
+     if (k < bits) {
+      return i * WordBits + selectInWord(words[i], k);
+     }
+     k -= bits;
+    }
+    return count * WordBits;
+   }
+
+   //Shifts the span towards higher bit indices by `shift` bits
+   constexpr void shiftLeft(
+    Word * const words,
+    SizeType const count,
+    SizeType const shift
+   ) noexcept {
+    auto const wordShift = shift / WordBits;
+    auto const bitShift = shift % WordBits;
+    if (wordShift >= count) {
+     fill(words, 0, count);
+     return;
+    }
+    for (SizeType i = count; i-- > wordShift;) {
+     auto word = words[i - wordShift] << bitShift;
+     if (bitShift != 0 && i > wordShift) {
+      word |= words[i - wordShift - 1] >> (WordBits - bitShift);
+     }
+     words[i] = word;
+    }
+    fill(words, 0, wordShift);
+   }
+
+   //Shifts the span towards lower bit indices by `shift` bits
+   constexpr void shiftRight(
+    Word * const words,
+    SizeType const count,
+    SizeType const shift
+   ) noexcept {
+    auto const wordShift = shift / WordBits;
+    auto const bitShift = shift % WordBits;
+    if (wordShift >= count) {
+     fill(words, 0, count);
+     return;
+    }
+    auto const last = count - wordShift;
+    for (SizeType i = 0; i < last; i++) {
+     auto word = words[i + wordShift] >> bitShift;
+     if (bitShift != 0 && i + 1 < last) {
+      word |= words[i + wordShift + 1] << (WordBits - bitShift);
+     }
+     words[i] = word;
+    }
+    fill(words + last, 0, wordShift);
+   }
+  }
+
+  //Instruction sets implementing the bulk bitset kernels
+  enum struct KernelSet : unsigned char {
+   SCALAR,
+   SSE,
+   AVX2,
+   AVX512,
+   NEON
+  };
+
+  //Table of bulk word-span kernels for a single instruction set
+  struct KernelTable final {
+   KernelSet set;
+   void (* bitwiseAnd)(Word *, Word const *, SizeType) noexcept;
+   void (* bitwiseOr)(Word *, Word const *, SizeType) noexcept;
+   void (* bitwiseXor)(Word *, Word const *, SizeType) noexcept;
+   void (* bitwiseAndNot)(Word *, Word const *, SizeType) noexcept;
+   SizeType (* popcount)(Word const *, SizeType) noexcept;
+   bool (* any)(Word const *, SizeType) noexcept;
+   SizeType (* intersectCount)(Word const *, Word const *, SizeType) noexcept;
+  };
+
   namespace Internal {
-   //Utility type meta-function that yields a buffer type with at least `N`
-   //bits
-   //Note: Naive implementation for platforms/compilers that do not support
-   //N-bit integral types
-   template<auto N>
-   requires (N > 0)
-   struct BufferForNBits final {
-   private:
-    using IndexType = ConstDecayed<decltype(N)>;
-
-    //The number of bytes required to store `N` bits
-    static constexpr auto const bytes = []() constexpr noexcept {
-     auto bytes = N / 8;
-     if (bytes * 8 != N) {
-      bytes++;
-     }
-     return bytes;
-    }();
-
-    //TODO Utility type to support subscript-like access to the underlying bits
-    struct BitReference final {
-
-     constexpr BitReference(BitReference const&) noexcept = delete;
-     constexpr BitReference(BitReference&&) noexcept = delete;
-
-
-     constexpr BitReference& operator=(BitReference const&) noexcept = delete;
-     constexpr BitReference& operator=(BitReference&&) noexcept = delete;
+   //Binary operations implemented by the SIMD kernels
+   enum struct BinaryOp : unsigned char {
+    AND,
+    OR,
+    XOR,
+    AND_NOT
+   };
+
+   //Scalar implementation of `Op`, used for the tails of SIMD kernels
+   template<BinaryOp Op>
+   constexpr void binaryScalar(
+    Word * const dst,
+    Word const * const src,
+    SizeType const count
+   ) noexcept {
+    if constexpr (Op == BinaryOp::AND) {
+     Kernels::bitwiseAnd(dst, src, count);
+    } else if constexpr (Op == BinaryOp::OR) {
+     Kernels::bitwiseOr(dst, src, count);
+    } else if constexpr (Op == BinaryOp::XOR) {
+     Kernels::bitwiseXor(dst, src, count);
+    } else {
+     Kernels::bitwiseAndNot(dst, src, count);
+    }
+   }
+
+   #ifdef CX_BITSET_SIMD_X86
+    //SSE4.2 kernels; 128-bit logic and hardware `popcnt`
+    namespace Sse {
+     template<BinaryOp Op>
+     [[gnu::target("sse4.2,popcnt")]]
+     inline void binary(
+      Word * const dst,
+      Word const * const src,
+      SizeType const count
+     ) noexcept {
+      SizeType i = 0;
+      for (; i + 2 <= count; i += 2) {
+       auto const a = _mm_loadu_si128((__m128i const *)(dst + i));
+       auto const b = _mm_loadu_si128((__m128i const *)(src + i));
+       __m128i r;
+       if constexpr (Op == BinaryOp::AND) {
+        r = _mm_and_si128(a, b);
+       } else if constexpr (Op == BinaryOp::OR) {
+        r = _mm_or_si128(a, b);
+       } else if constexpr (Op == BinaryOp::XOR) {
+        r = _mm_xor_si128(a, b);
+       } else {
+        r = _mm_andnot_si128(b, a);
+       }
+       _mm_storeu_si128((__m128i *)(dst + i), r);
+      }
+      binaryScalar<Op>(dst + i, src + i, count - i);
+     }
+
+     [[gnu::target("sse4.2,popcnt")]]
+     inline SizeType popcount(Word const * const words, SizeType const count)
+      noexcept
+     {
+      SizeType total = 0;
+      for (SizeType i = 0; i < count; i++) {
+       total += (SizeType)_mm_popcnt_u64(words[i]);
+      }
+      return total;
+     }
+
+     [[gnu::target("sse4.2,popcnt")]]
+     inline bool any(Word const * const words, SizeType const count) noexcept {
+      SizeType i = 0;
+      for (; i + 2 <= count; i += 2) {
+       auto const v = _mm_loadu_si128((__m128i const *)(words + i));
+       if (!_mm_testz_si128(v, v)) {
+        return true;
+       }
+      }
+      return Kernels::any(words + i, count - i);
+     }
+
+     [[gnu::target("sse4.2,popcnt")]]
+     inline SizeType intersectCount(
+      Word const * const w1,
+      Word const * const w2,
+      SizeType const count
+     ) noexcept {
+      SizeType total = 0;
+      for (SizeType i = 0; i < count; i++) {
+       total += (SizeType)_mm_popcnt_u64(w1[i] & w2[i]);
+      }
+      return total;
+     }
+    }
+
+    //AVX2 kernels; 256-bit logic and nibble-lookup popcount
+    namespace Avx2 {
+     template<BinaryOp Op>
+     [[gnu::target("avx2")]]
+     inline void binary(
+      Word * const dst,
+      Word const * const src,
+      SizeType const count
+     ) noexcept {
+      SizeType i = 0;
+      for (; i + 4 <= count; i += 4) {
+       auto const a = _mm256_loadu_si256((__m256i const *)(dst + i));
+       auto const b = _mm256_loadu_si256((__m256i const *)(src + i));
+       __m256i r;
+       if constexpr (Op == BinaryOp::AND) {
+        r = _mm256_and_si256(a, b);
+       } else if constexpr (Op == BinaryOp::OR) {
+        r = _mm256_or_si256(a, b);
+       } else if constexpr (Op == BinaryOp::XOR) {
+        r = _mm256_xor_si256(a, b);
+       } else {
+        r = _mm256_andnot_si256(b, a);
+       }
+       _mm256_storeu_si256((__m256i *)(dst + i), r);
+      }
+      binaryScalar<Op>(dst + i, src + i, count - i);
+     }
+
+     //Yields the popcount of each 64-bit lane of `v`
+     [[gnu::target("avx2")]]
+     inline __m256i popcountLanes(__m256i const v) noexcept {
+      auto const lookup = _mm256_setr_epi8(
+       0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+       0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+      );
+      auto const nibble = _mm256_set1_epi8(0x0F);
+      auto const low = _mm256_and_si256(v, nibble);
+      auto const high = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+      auto const bytes = _mm256_add_epi8(
+       _mm256_shuffle_epi8(lookup, low),
+       _mm256_shuffle_epi8(lookup, high)
+      );
+      return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+     }
+
+     //Yields the sum of all 64-bit lanes of `v`
+     [[gnu::target("avx2")]]
+     inline SizeType sumLanes(__m256i const v) noexcept {
+      return (SizeType)_mm256_extract_epi64(v, 0)
+       + (SizeType)_mm256_extract_epi64(v, 1)
+       + (SizeType)_mm256_extract_epi64(v, 2)
+       + (SizeType)_mm256_extract_epi64(v, 3);
+     }
+
+     [[gnu::target("avx2")]]
+     inline SizeType popcount(Word const * const words, SizeType const count)
+      noexcept
+     {
+      auto total = _mm256_setzero_si256();
+      SizeType i = 0;
+      for (; i + 4 <= count; i += 4) {
+       total = _mm256_add_epi64(
+        total,
+        popcountLanes(_mm256_loadu_si256((__m256i const *)(words + i)))
+       );
+      }
+      return sumLanes(total) + Kernels::popcount(words + i, count - i);
+     }
+
+     [[gnu::target("avx2")]]
+     inline bool any(Word const * const words, SizeType const count) noexcept {
+      SizeType i = 0;
+      for (; i + 8 <= count; i += 8) {
+       auto const v = _mm256_or_si256(
+        _mm256_loadu_si256((__m256i const *)(words + i)),
+        _mm256_loadu_si256((__m256i const *)(words + i + 4))
+       );
+       if (!_mm256_testz_si256(v, v)) {
+        return true;
+       }
+      }
+      return Kernels::any(words + i, count - i);
+     }
+
+     [[gnu::target("avx2")]]
+     inline SizeType intersectCount(
+      Word const * const w1,
+      Word const * const w2,
+      SizeType const count
+     ) noexcept {
+      auto total = _mm256_setzero_si256();
+      SizeType i = 0;
+      for (; i + 4 <= count; i += 4) {
+       total = _mm256_add_epi64(total, popcountLanes(_mm256_and_si256(
+        _mm256_loadu_si256((__m256i const *)(w1 + i)),
+        _mm256_loadu_si256((__m256i const *)(w2 + i))
+       )));
+      }
+      return sumLanes(total)
+       + Kernels::intersectCount(w1 + i, w2 + i, count - i);
+     }
+    }
+
+    //AVX-512 kernels; 512-bit logic and `vpopcntq`
+    namespace Avx512 {
+     template<BinaryOp Op>
+     [[gnu::target("avx512f")]]
+     inline void binary(
+      Word * const dst,
+      Word const * const src,
+      SizeType const count
+     ) noexcept {
+      SizeType i = 0;
+      for (; i + 8 <= count; i += 8) {
+       auto const a = _mm512_loadu_si512((void const *)(dst + i));
+       auto const b = _mm512_loadu_si512((void const *)(src + i));
+       __m512i r;
+       if constexpr (Op == BinaryOp::AND) {
+        r = _mm512_and_si512(a, b);
+       } else if constexpr (Op == BinaryOp::OR) {
+        r = _mm512_or_si512(a, b);
+       } else if constexpr (Op == BinaryOp::XOR) {
+        r = _mm512_xor_si512(a, b);
+       } else {
+        //Note: Expressed without `_mm512_andnot_si512`, whose gcc
+        //implementation triggers spurious `-Wuninitialized` diagnostics
+        r = _mm512_and_si512(a, _mm512_xor_si512(b, _mm512_set1_epi64(-1)));
+       }
+       _mm512_storeu_si512((void *)(dst + i), r);
+      }
+      binaryScalar<Op>(dst + i, src + i, count - i);
+     }
+
+     //Yields the sum of all 64-bit lanes of `v`
+     //Note: `_mm512_reduce_add_epi64` is avoided for the same reason as
+     //`_mm512_andnot_si512`
+     [[gnu::target("avx512f")]]
+     inline SizeType sumLanes(__m512i const v) noexcept {
+      Word lanes[8];
+      _mm512_storeu_si512((void *)lanes, v);
+      SizeType total = 0;
+      for (auto const lane : lanes) {
+       total += (SizeType)lane;
+      }
+      return total;
+     }
+
+     [[gnu::target("avx512f,avx512vpopcntdq")]]
+     inline SizeType popcount(Word const * const words, SizeType const count)
+      noexcept
+     {
+      auto total = _mm512_setzero_si512();
+      SizeType i = 0;
+      for (; i + 8 <= count; i += 8) {
+       total = _mm512_add_epi64(
+        total,
+        _mm512_popcnt_epi64(_mm512_loadu_si512((void const *)(words + i)))
+       );
+      }
+      return sumLanes(total) + Kernels::popcount(words + i, count - i);
+     }
+
+     [[gnu::target("avx512f")]]
+     inline bool any(Word const * const words, SizeType const count) noexcept {
+      SizeType i = 0;
+      for (; i + 8 <= count; i += 8) {
+       auto const v = _mm512_loadu_si512((void const *)(words + i));
+       if (_mm512_test_epi64_mask(v, v)) {
+        return true;
+       }
+      }
+      return Kernels::any(words + i, count - i);
+     }
+
+     [[gnu::target("avx512f,avx512vpopcntdq")]]
+     inline SizeType intersectCount(
+      Word const * const w1,
+      Word const * const w2,
+      SizeType const count
+     ) noexcept {
+      auto total = _mm512_setzero_si512();
+      SizeType i = 0;
+      for (; i + 8 <= count; i += 8) {
+       total = _mm512_add_epi64(total, _mm512_popcnt_epi64(_mm512_and_si512(
+        _mm512_loadu_si512((void const *)(w1 + i)),
+        _mm512_loadu_si512((void const *)(w2 + i))
+       )));
+      }
+      return sumLanes(total)
+       + Kernels::intersectCount(w1 + i, w2 + i, count - i);
+     }
+    }
+   #endif
+
+   #ifdef CX_BITSET_SIMD_NEON
+    //NEON kernels; 128-bit logic and per-byte `cnt`
+    namespace Neon {
+     template<BinaryOp Op>
+     inline void binary(
+      Word * const dst,
+      Word const * const src,
+      SizeType const count
+     ) noexcept {
+      SizeType i = 0;
+      for (; i + 2 <= count; i += 2) {
+       auto const a = vld1q_u64((uint64_t const *)(dst + i));
+       auto const b = vld1q_u64((uint64_t const *)(src + i));
+       uint64x2_t r;
+       if constexpr (Op == BinaryOp::AND) {
+        r = vandq_u64(a, b);
+       } else if constexpr (Op == BinaryOp::OR) {
+        r = vorrq_u64(a, b);
+       } else if constexpr (Op == BinaryOp::XOR) {
+        r = veorq_u64(a, b);
+       } else {
+        r = vbicq_u64(a, b);
+       }
+       vst1q_u64((uint64_t *)(dst + i), r);
+      }
+      binaryScalar<Op>(dst + i, src + i, count - i);
+     }
+
+     inline SizeType popcount(Word const * const words, SizeType const count)
+      noexcept
+     {
+      SizeType total = 0;
+      SizeType i = 0;
+      for (; i + 2 <= count; i += 2) {
+       auto const v = vld1q_u8((uint8_t const *)(words + i));
+       total += vaddvq_u8(vcntq_u8(v));
+      }
+      return total + Kernels::popcount(words + i, count - i);
+     }
+
+     inline bool any(Word const * const words, SizeType const count) noexcept {
+      SizeType i = 0;
+      for (; i + 2 <= count; i += 2) {
+       auto const v = vld1q_u32((uint32_t const *)(words + i));
+       if (vmaxvq_u32(v)) {
+        return true;
+       }
+      }
+      return Kernels::any(words + i, count - i);
+     }
+
+     inline SizeType intersectCount(
+      Word const * const w1,
+      Word const * const w2,
+      SizeType const count
+     ) noexcept {
+      SizeType total = 0;
+      SizeType i = 0;
+      for (; i + 2 <= count; i += 2) {
+       auto const v = vandq_u8(
+        vld1q_u8((uint8_t const *)(w1 + i)),
+        vld1q_u8((uint8_t const *)(w2 + i))
+       );
+       total += vaddvq_u8(vcntq_u8(v));
+      }
+      return total + Kernels::intersectCount(w1 + i, w2 + i, count - i);
+     }
+    }
+   #endif
+
+   //Kernel tables for each compiled instruction set
+   inline constexpr KernelTable const ScalarKernels {
+    KernelSet::SCALAR,
+    Kernels::bitwiseAnd,
+    Kernels::bitwiseOr,
+    Kernels::bitwiseXor,
+    Kernels::bitwiseAndNot,
+    Kernels::popcount,
+    Kernels::any,
+    Kernels::intersectCount
+   };
+
+   #ifdef CX_BITSET_SIMD_X86
+    inline constexpr KernelTable const SseKernels {
+     KernelSet::SSE,
+     Sse::binary<BinaryOp::AND>,
+     Sse::binary<BinaryOp::OR>,
+     Sse::binary<BinaryOp::XOR>,
+     Sse::binary<BinaryOp::AND_NOT>,
+     Sse::popcount,
+     Sse::any,
+     Sse::intersectCount
+    };
+
+    inline constexpr KernelTable const Avx2Kernels {
+     KernelSet::AVX2,
+     Avx2::binary<BinaryOp::AND>,
+     Avx2::binary<BinaryOp::OR>,
+     Avx2::binary<BinaryOp::XOR>,
+     Avx2::binary<BinaryOp::AND_NOT>,
+     Avx2::popcount,
+     Avx2::any,
+     Avx2::intersectCount
+    };
+
+    inline constexpr KernelTable const Avx512Kernels {
+     KernelSet::AVX512,
+     Avx512::binary<BinaryOp::AND>,
+     Avx512::binary<BinaryOp::OR>,
+     Avx512::binary<BinaryOp::XOR>,
+     Avx512::binary<BinaryOp::AND_NOT>,
+     Avx512::popcount,
+     Avx512::any,
+     Avx512::intersectCount
+    };
+   #endif
+
+   #ifdef CX_BITSET_SIMD_NEON
+    inline constexpr KernelTable const NeonKernels {
+     KernelSet::NEON,
+     Neon::binary<BinaryOp::AND>,
+     Neon::binary<BinaryOp::OR>,
+     Neon::binary<BinaryOp::XOR>,
+     Neon::binary<BinaryOp::AND_NOT>,
+     Neon::popcount,
+     Neon::any,
+     Neon::intersectCount
+    };
+   #endif
+  }
+
+  //Returns the kernel table for `set`, or `nullptr` if `set` is not
+  //supported by either the compiler or the executing CPU
+  inline KernelTable const * kernelsFor(KernelSet const set) noexcept {
+   switch (set) {
+    case KernelSet::SCALAR: {
+     return &Internal::ScalarKernels;
+    }
+    #ifdef CX_BITSET_SIMD_X86
+     case KernelSet::SSE: {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) {
+       return &Internal::SseKernels;
+      }
+      return nullptr;
+     }
+     case KernelSet::AVX2: {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2")) {
+       return &Internal::Avx2Kernels;
+      }
+      return nullptr;
+     }
+     case KernelSet::AVX512: {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx512f")
+       && __builtin_cpu_supports("avx512vpopcntdq")
+      ) {
+       return &Internal::Avx512Kernels;
+      }
+      return nullptr;
+     }
+    #endif
+    #ifdef CX_BITSET_SIMD_NEON
+     case KernelSet::NEON: {
+      return &Internal::NeonKernels;
+     }
+    #endif
+    default: {
+     return nullptr;
+    }
+   }
+  }
+
+  //Returns the widest kernel table supported by the executing CPU. The
+  //selection is made on first use and cached
+  inline KernelTable const& kernels() noexcept {
+   static KernelTable const * selected = nullptr;
+   auto table = __atomic_load_n(&selected, __ATOMIC_ACQUIRE);
+   if (!table) [[unlikely]] {
+    //Kernel sets in order of preference
+    constexpr KernelSet const preference[] {
+     KernelSet::AVX512,
+     KernelSet::AVX2,
+     KernelSet::NEON,
+     KernelSet::SSE,
+     KernelSet::SCALAR
     };
+    for (auto const set : preference) {
+     if ((table = kernelsFor(set))) {
+      break;
+     }
+    }
+    __atomic_store_n(&selected, table, __ATOMIC_RELEASE);
+   }
+   return *table;
+  }
+
+  //Minimum span length, in words, for which the bulk operations dispatch to
+  //`kernels()`; shorter spans are cheaper to process inline
+  constexpr SizeType const BulkThreshold = 16;
+
+  //Bulk operations used by all bitset backends; dispatch to the runtime
+  //selected kernels for long spans, and to the scalar kernels for short
+  //spans and during constant evaluation
+  namespace Bulk {
+   constexpr void bitwiseAnd(
+    Word * const dst,
+    Word const * const src,
+    SizeType const count
+   ) noexcept {
+    if (!isConstexpr() && count >= BulkThreshold) {
+     kernels().bitwiseAnd(dst, src, count);
+    } else {
+     Kernels::bitwiseAnd(dst, src, count);
+    }
+   }
+
+   constexpr void bitwiseOr(
+    Word * const dst,
+    Word const * const src,
+    SizeType const count
+   ) noexcept {
+    if (!isConstexpr() && count >= BulkThreshold) {
+     kernels().bitwiseOr(dst, src, count);
+    } else {
+     Kernels::bitwiseOr(dst, src, count);
+    }
+   }
+
+   constexpr void bitwiseXor(
+    Word * const dst,
+    Word const * const src,
+    SizeType const count
+   ) noexcept {
+    if (!isConstexpr() && count >= BulkThreshold) {
+     kernels().bitwiseXor(dst, src, count);
+    } else {
+     Kernels::bitwiseXor(dst, src, count);
+    }
+   }
+
+   constexpr void bitwiseAndNot(
+    Word * const dst,
+    Word const * const src,
+    SizeType const count
+   ) noexcept {
+    if (!isConstexpr() && count >= BulkThreshold) {
+     kernels().bitwiseAndNot(dst, src, count);
+    } else {
+     Kernels::bitwiseAndNot(dst, src, count);
+    }
+   }
+
+   constexpr SizeType popcount(Word const * const words, SizeType const count)
+    noexcept
+   {
+    if (!isConstexpr() && count >= BulkThreshold) {
+     return kernels().popcount(words, count);
+    }
+    return Kernels::popcount(words, count);
+   }
+
+   constexpr bool any(Word const * const words, SizeType const count) noexcept {
+    if (!isConstexpr() && count >= BulkThreshold) {
+     return kernels().any(words, count);
+    }
+    return Kernels::any(words, count);
+   }
+
+   constexpr SizeType intersectCount(
+    Word const * const w1,
+    Word const * const w2,
+    SizeType const count
+   ) noexcept {
+    if (!isConstexpr() && count >= BulkThreshold) {
+     return kernels().intersectCount(w1, w2, count);
+    }
+    return Kernels::intersectCount(w1, w2, count);
+   }
+
+   //Returns the number of set bits below bit `index`
+   constexpr SizeType rank(Word const * const words, SizeType const index)
+    noexcept
+   {
+    auto const word = index / WordBits;
+    auto total = popcount(words, word);
+    if (auto const offset = index % WordBits) {
+     total += (SizeType)__builtin_popcountll(
+      words[word] & ~(~(Word)0 << offset)
+     );
+    }
+    return total;
+   }
+  }
+
+  //Bulk operations between word spans of different lengths, shared by all
+  //bitset backends. `src` is treated as if it were zero-extended (or
+  //truncated) to the length of `dst`; callers are responsible for masking
+  //unused tail bits
+  namespace CrossSize {
+   //Returns the smaller of two word counts
+   constexpr SizeType common(SizeType const c1, SizeType const c2) noexcept {
+    return c1 < c2 ? c1 : c2;
+   }
+
+   //`dst = src`
+   constexpr void assign(
+    Word * const dst,
+    SizeType const dstCount,
+    Word const * const src,
+    SizeType const srcCount
+   ) noexcept {
+    auto const shared = common(dstCount, srcCount);
+    Kernels::copy(dst, src, shared);
+    Kernels::fill(dst + shared, 0, dstCount - shared);
+   }
+
+   //`dst &= src`
+   constexpr void bitwiseAnd(
+    Word * const dst,
+    SizeType const dstCount,
+    Word const * const src,
+    SizeType const srcCount
+   ) noexcept {
+    auto const shared = common(dstCount, srcCount);
+    Bulk::bitwiseAnd(dst, src, shared);
+    Kernels::fill(dst + shared, 0, dstCount - shared);
+   }
+
+   //`dst |= src`
+   constexpr void bitwiseOr(
+    Word * const dst,
+    SizeType const dstCount,
+    Word const * const src,
+    SizeType const srcCount
+   ) noexcept {
+    Bulk::bitwiseOr(dst, src, common(dstCount, srcCount));
+   }
+
+   //`dst ^= src`
+   constexpr void bitwiseXor(
+    Word * const dst,
+    SizeType const dstCount,
+    Word const * const src,
+    SizeType const srcCount
+   ) noexcept {
+    Bulk::bitwiseXor(dst, src, common(dstCount, srcCount));
+   }
+
+   //`dst &= ~src`
+   constexpr void bitwiseAndNot(
+    Word * const dst,
+    SizeType const dstCount,
+    Word const * const src,
+    SizeType const srcCount
+   ) noexcept {
+    Bulk::bitwiseAndNot(dst, src, common(dstCount, srcCount));
+   }
+
+   //Returns the number of bits set in both spans
+   constexpr SizeType intersectCount(
+    Word const * const w1,
+    SizeType const c1,
+    Word const * const w2,
+    SizeType const c2
+   ) noexcept {
+    return Bulk::intersectCount(w1, w2, common(c1, c2));
+   }
+
+   //Returns whether both spans have the same bits set
+   constexpr bool equal(
+    Word const * const w1,
+    SizeType const c1,
+    Word const * const w2,
+    SizeType const c2
+   ) noexcept {
+    auto const shared = common(c1, c2);
+    return Kernels::equal(w1, w2, shared)
+     && !Bulk::any(w1 + shared, c1 - shared)
+     && !Bulk::any(w2 + shared, c2 - shared);
+   }
+  }
+
+  //Mutable proxy for a single bit within a bitset
+  struct BitReference final {
+  private:
+   Word& word;
+   Word const mask;
+
+  public:
+   constexpr BitReference(Word& word, SizeType const bit) noexcept :
+    word(word),
+    mask((Word)1 << (bit % WordBits))
+   {}
+
+   constexpr BitReference(BitReference const&) noexcept = default;
+
+   constexpr ~BitReference() noexcept = default;
+
+   //Sets the referenced bit to `value`
+   constexpr BitReference& operator=(bool const value) noexcept {
+    if (value) {
+     word |= mask;
+    } else {
+     word &= ~mask;
+    }
+    return *this;
+   }
+
+   //Sets the referenced bit to the value of the bit referenced by `other`
+   constexpr BitReference& operator=(BitReference const& other) noexcept {
+    return operator=((bool)other);
+   }
+
+   //Inverts the referenced bit
+   constexpr BitReference& flip() noexcept {
+    word ^= mask;
+    return *this;
+   }
+
+   //Yields the inverse of the referenced bit
+   constexpr bool operator~() const noexcept {
+    return !(word & mask);
+   }
+
+   //Yields the value of the referenced bit
+   constexpr operator bool() const noexcept {
+    return word & mask;
+   }
+  };
+
+  //Forward iterator over the indices of the set bits of a word span; each
+  //step clears the lowest set bit of the current word and skips empty words
+  //using count-trailing-zeros, so iteration is O(popcount + words)
+  struct SetBitIterator final {
+  private:
+   Word const * words;
+   SizeType count;
+   SizeType index;
+   Word current;
+
+   //Advances to the next word with set bits, if the current word is empty
+   constexpr void skipEmptyWords() noexcept {
+    if (current) {
+     return;
+    }
+    while (++index < count) {
+     if ((current = words[index])) {
+      return;
+     }
+    }
+    index = count;
+   }
+
+  public:
+   constexpr SetBitIterator(
+    Word const * const words,
+    SizeType const count,
+    SizeType const index
+   ) noexcept :
+    words(words),
+    count(count),
+    index(index < count ? index : count),
+    current(index < count ? words[index] : 0)
+   {
+    if (index < count) {
+     skipEmptyWords();
+    }
+   }
+
+   //Yields the index of the current set bit
+   constexpr SizeType operator*() const noexcept {
+    return index * WordBits + (SizeType)__builtin_ctzll(current);
+   }
+
+   //Advances to the next set bit
+   constexpr SetBitIterator& operator++() noexcept {
+    current &= current - 1;
+    skipEmptyWords();
+    return *this;
+   }
+
+   //Advances to the next set bit, yielding the previous position
+   constexpr SetBitIterator operator++(int) noexcept {
+    auto const previous = *this;
+    operator++();
+    return previous;
+   }
+
+   constexpr bool operator==(SetBitIterator const& other) const noexcept {
+    return index == other.index && current == other.current;
+   }
+  };
+
+  //Range over the indices of the set bits of a word span
+  struct SetBitRange final {
+   Word const * words;
+   SizeType count;
+
+   constexpr SetBitIterator begin() const noexcept {
+    return {words, count, 0};
+   }
+
+   constexpr SetBitIterator end() const noexcept {
+    return {words, count, count};
+   }
+  };
+
+  //Bitset identity meta-function
+  template<typename>
+  struct IsBitset : FalseType {};
+
+  //Dynamic bitset identity meta-function
+  template<typename>
+  struct IsDynamicBitset : FalseType {};
+ }
+
+ //Forward declare `CX::Bitset<N>`
+ template<auto>
+ struct Bitset;
+
+ //Forward declare `CX::DynamicBitset<A>`
+ template<template<typename...> typename A = Allocator>
+ requires IsAllocator<A>
+ struct DynamicBitset;
+
+ namespace BitsetMetaFunctions {
+  template<auto N>
+  struct IsBitset<Bitset<N>> : TrueType {};
+
+  template<template<typename...> typename A>
+  requires IsAllocator<A>
+  struct IsDynamicBitset<DynamicBitset<A>> : TrueType {};
+ }
+
+ //`CX::Bitset` identity concept
+ template<typename T>
+ concept IsBitset = BitsetMetaFunctions
+  ::IsBitset<ConstDecayed<ReferenceDecayed<T>>>
+  ::Value;
+
+ //`CX::DynamicBitset` identity concept
+ template<typename T>
+ concept IsDynamicBitset = BitsetMetaFunctions
+  ::IsDynamicBitset<ConstDecayed<ReferenceDecayed<T>>>
+  ::Value;
+
+ //Identity concept for all bitset backends
+ template<typename T>
+ concept IsAnyBitset = IsBitset<T> || IsDynamicBitset<T>;
+
+ //Precomputed rank directory for a bitset. Stores the number of set bits
+ //preceding each block of `BlockWords` words, reducing `rank` to a lookup
+ //plus at most `BlockWords` word popcounts, and `select` to a binary search
+ //plus a scan of a single block. The index must be rebuilt after the bitset
+ //is modified
+ template<template<typename...> typename A = Allocator>
+ requires IsAllocator<A>
+ struct BitsetRankIndex final {
+  //Number of words in each block; one cache line
+  static constexpr SizeType const BlockWords = 8;
+
+  //Number of bits in each block
+  static constexpr SizeType const BlockBits = BlockWords
+   * BitsetMetaFunctions::WordBits;
+
+  //Rank allocator type alias
+  using AllocatorType = A<SizeType>;
+
+ private:
+  //Whether the allocator instance must be stored
+  static constexpr bool const Stateful = IsStatefulAllocator<A>;
+
+  //Allocator storage type; zero-sized for stateless allocators
+  using StoredAllocator = SelectType<Stateful, AllocatorType, Never>;
+
+  //Allocator instance
+  [[no_unique_address]]
+  StoredAllocator allocator;
+
+  //Number of blocks in the indexed bitset
+  SizeType blocks = 0;
+
+  //Number of set bits preceding each block
+  SizeType * ranks = nullptr;
+
+  //Releases the rank buffer
+  void release() noexcept {
+   if (ranks) {
+    if constexpr (Stateful) {
+     allocator.deallocate(*ranks, blocks);
+    } else {
+     AllocatorType::deallocate(*ranks, blocks);
+    }
+   }
+   blocks = 0;
+   ranks = nullptr;
+  }
+
+ public:
+  //Default constructor; constructs an empty index
+  BitsetRankIndex() noexcept = default;
+
+  //Constructs the index for `bitset`
+  explicit BitsetRankIndex(IsAnyBitset auto const& bitset) noexcept {
+   build(bitset);
+  }
+
+  //Constructs the index for `bitset`, using a copy of `allocator`
+  BitsetRankIndex(
+   IsAnyBitset auto const& bitset,
+   AllocatorType const& allocator
+  ) noexcept requires Stateful :
+   allocator(allocator)
+  {
+   build(bitset);
+  }
+
+  //Indices are tied to a single bitset and are not copyable
+  BitsetRankIndex(BitsetRankIndex const&) = delete;
+
+  //Move-constructor; leaves `other` empty
+  BitsetRankIndex(BitsetRankIndex&& other) noexcept :
+   allocator((StoredAllocator&&)other.allocator),
+   blocks(other.blocks),
+   ranks(other.ranks)
+  {
+   other.blocks = 0;
+   other.ranks = nullptr;
+  }
+
+  //Destructor; deallocates the rank buffer
+  ~BitsetRankIndex() noexcept {
+   release();
+  }
+
+  BitsetRankIndex& operator=(BitsetRankIndex const&) = delete;
+
+  //Move-assignment operator; leaves `other` empty
+  BitsetRankIndex& operator=(BitsetRankIndex&& other) noexcept {
+   if (this != &other) {
+    release();
+    allocator = (StoredAllocator&&)other.allocator;
+    blocks = other.blocks;
+    ranks = other.ranks;
+    other.blocks = 0;
+    other.ranks = nullptr;
+   }
+   return *this;
+  }
+
+  //(Re)builds the index for the current contents of `bitset`
+  void build(IsAnyBitset auto const& bitset) noexcept {
+   auto const words = bitset.data();
+   auto const count = bitset.wordCount();
+   auto const required = (count + BlockWords - 1) / BlockWords;
+   if (required != blocks) {
+    release();
+    if (required) {
+     if constexpr (Stateful) {
+      ranks = &unwrapAllocation(allocator.allocate(required));
+     } else {
+      ranks = &unwrapAllocation(AllocatorType::allocate(required));
+     }
+    }
+    blocks = required;
+   }
+   SizeType total = 0;
+   for (SizeType block = 0; block < blocks; block++) {
+    ranks[block] = total;
+    auto const first = block * BlockWords;
+    auto const remaining = count - first;
+    total += BitsetMetaFunctions::Kernels::popcount(
+     words + first,
+     remaining < BlockWords ? remaining : BlockWords
+    );
+   }
+  }
+
+  //Returns the number of blocks in the index
+  SizeType blockCount() const noexcept {
+   return blocks;
+  }
+
+  //Returns the number of set bits below bit `index` of `bitset`; `index`
+  //must not exceed `bitset.size()`
+  SizeType rank(IsAnyBitset auto const& bitset, SizeType const index)
+   const noexcept
+  {
+   auto const block = index / BlockBits;
+   if (block == blocks) {
+    //`index` is the size of a block-aligned bitset
+    return block ? ranks[block - 1] + BitsetMetaFunctions::Kernels::popcount(
+     bitset.data() + (block - 1) * BlockWords,
+     BlockWords
+    ) : 0;
+   }
+   return ranks[block] + BitsetMetaFunctions::Bulk::rank(
+    bitset.data() + block * BlockWords,
+    index % BlockBits
+   );
+  }
+
+  //Returns the index of the `k`th (zero-based) set bit of `bitset`, or
+  //`bitset.size()` if fewer than `k + 1` bits are set
+  SizeType select(IsAnyBitset auto const& bitset, SizeType const k)
+   const noexcept
+  {
+   if (!blocks) {
+    return bitset.size();
+   }
+   //Find the last block preceded by at most `k` set bits
+   SizeType low = 0;
+   SizeType high = blocks;
+   while (high - low > 1) {
+    auto const middle = low + (high - low) / 2;
+    if (ranks[middle] <= k) {
+     low = middle;
+    } else {
+     high = middle;
+    }
+   }
+   auto const first = low * BlockWords;
+   auto const remaining = bitset.wordCount() - first;
+   auto const index = first * BitsetMetaFunctions::WordBits
+    + BitsetMetaFunctions::Kernels::select(
+     bitset.data() + first,
+     remaining < BlockWords ? remaining : BlockWords,
+     k - ranks[low]
+    );
+   return index < bitset.size() ? index : bitset.size();
+  }
+ };
+
+ //Fixed-size bitset, stored as an array of 64-bit words. Bits beyond `N`
+ //in the last word are always zero
+ //TODO Support user-defined backends
+ template<auto N>
+ struct Bitset final {
+  static_assert(N > 0, "Bitset must contain at least one bit");
+
+  //Bit index type alias
+  using IndexType = ConstDecayed<decltype(N)>;
+
+  //Storage word type alias
+  using Word = BitsetMetaFunctions::Word;
+
+  //Number of bits in the bitset
+  static constexpr SizeType const Size = N;
+
+  //Number of words in the bitset
+  static constexpr SizeType const WordCount = BitsetMetaFunctions
+   ::wordsForBits(N);
+
+ private:
+  //Bit buffer
+  Word words[WordCount]{};
+
+  //Clears the unused bits of the last word
+  constexpr Bitset& clearTail() noexcept {
+   words[WordCount - 1] &= BitsetMetaFunctions::tailMask(N);
+   return *this;
+  }
+
+ public:
+  //Default constructor, all bits are `false`
+  constexpr Bitset() noexcept = default;
+
+  //Default copy-constructor
+  constexpr Bitset(Bitset const&) noexcept = default;
+
+  //Default move-constructor
+  constexpr Bitset(Bitset&&) noexcept = default;
+
+  //Constructor to initialize bitset from an integral value
+  constexpr Bitset(Integral auto value) noexcept {
+   operator=(value);
+  }
+
+  //Differently-sized or dynamic bitset copy-constructor; excess bits of
+  //`other` are discarded
+  constexpr Bitset(IsAnyBitset auto const& other) noexcept {
+   operator=(other);
+  }
+
+  //Constexpr default destructor
+  constexpr ~Bitset() noexcept = default;
+
+  //Returns the number of bits in the bitset
+  static constexpr SizeType size() noexcept {
+   return N;
+  }
+
+  //Returns the number of words in the bitset
+  static constexpr SizeType wordCount() noexcept {
+   return WordCount;
+  }
+
+  //Returns a pointer to the underlying words
+  constexpr Word * data() noexcept {
+   return words;
+  }
+
+  //Returns a pointer to the underlying words
+  constexpr Word const * data() const noexcept {
+   return words;
+  }
+
+  //Returns value of bit at `index`
+  constexpr bool get(IndexType const index) const noexcept {
+   return (words[index / BitsetMetaFunctions::WordBits]
+    >> (index % BitsetMetaFunctions::WordBits)) & 1;
+  }
+
+  //Sets the bit at `index` to `value` and returns its previous value
+  constexpr bool set(IndexType const index, bool const value = true) noexcept {
+   auto bit = operator[](index);
+   bool const previous = bit;
+   bit = value;
+   return previous;
+  }
+
+  //Inverts the bit at `index` and returns its previous value
+  constexpr bool flip(IndexType const index) noexcept {
+   auto bit = operator[](index);
+   bool const previous = bit;
+   bit.flip();
+   return previous;
+  }
+
+  //Reset all bits to `value`
+  constexpr void reset(bool const value = false) noexcept {
+   BitsetMetaFunctions::Kernels::fill(words, value ? ~(Word)0 : 0, WordCount);
+   clearTail();
+  }
+
+  //Returns the number of set bits
+  constexpr SizeType count() const noexcept {
+   return BitsetMetaFunctions::Bulk::popcount(words, WordCount);
+  }
+
+  //Returns whether any bit is set
+  constexpr bool any() const noexcept {
+   return BitsetMetaFunctions::Bulk::any(words, WordCount);
+  }
+
+  //Returns whether no bits are set
+  constexpr bool none() const noexcept {
+   return !any();
+  }
+
+  //Returns whether all bits are set
+  constexpr bool all() const noexcept {
+   return count() == N;
+  }
+
+  //Returns the index of the first set bit, or `N` if no bits are set
+  constexpr IndexType findFirst() const noexcept {
+   return findNext(0);
+  }
+
+  //Returns the index of the first set bit at or after `from`, or `N` if
+  //there is none
+  constexpr IndexType findNext(IndexType const from) const noexcept {
+   if ((SizeType)from >= N) {
+    return N;
+   }
+   auto const index = BitsetMetaFunctions::Kernels::findNext(
+    words,
+    WordCount,
+    from
+   );
+   return (IndexType)(index < N ? index : N);
+  }
+
+  //Returns the index of the first clear bit at or after `from`, or `N` if
+  //there is none
+  constexpr IndexType findNextClear(IndexType const from) const noexcept {
+   if ((SizeType)from >= N) {
+    return N;
+   }
+   auto const index = BitsetMetaFunctions::Kernels::findNextClear(
+    words,
+    WordCount,
+    from
+   );
+   return (IndexType)(index < N ? index : N);
+  }
+
+  //Sets bits `[begin, end)` to `value`
+  constexpr Bitset& setRange(
+   IndexType const begin,
+   IndexType const end,
+   bool const value = true
+  ) noexcept {
+   BitsetMetaFunctions::Kernels::fillRange(
+    words,
+    begin,
+    (SizeType)end < N ? end : N,
+    value
+   );
+   return *this;
+  }
+
+  //Returns the number of runs of consecutive set bits
+  constexpr SizeType runCount() const noexcept {
+   return BitsetMetaFunctions::Kernels::countRuns(words, WordCount);
+  }
+
+  //Returns a range over the indices of the set bits, in ascending order
+  constexpr BitsetMetaFunctions::SetBitRange setBits() const noexcept {
+   return {words, WordCount};
+  }
+
+  //Returns the number of set bits below `index`
+  constexpr SizeType rank(IndexType const index) const noexcept {
+   if ((SizeType)index >= N) {
+    return count();
+   }
+   return BitsetMetaFunctions::Bulk::rank(words, index);
+  }
+
+  //Returns the number of set bits below `index`, using a rank index built
+  //from `*this`
+  template<template<typename...> typename A>
+  SizeType rank(IndexType const index, BitsetRankIndex<A> const& rankIndex)
+   const noexcept
+  {
+   return rankIndex.rank(*this, (SizeType)index < N ? index : N);
+  }
+
+  //Returns the index of the `k`th (zero-based) set bit, or `N` if fewer than
+  //`k + 1` bits are set
+  constexpr IndexType select(SizeType const k) const noexcept {
+   auto const index = BitsetMetaFunctions::Kernels::select(words, WordCount, k);
+   return (IndexType)(index < N ? index : N);
+  }
+
+  //Returns the index of the `k`th (zero-based) set bit, or `N` if fewer than
+  //`k + 1` bits are set, using a rank index built from `*this`
+  template<template<typename...> typename A>
+  IndexType select(SizeType const k, BitsetRankIndex<A> const& rankIndex)
+   const noexcept
+  {
+   return (IndexType)rankIndex.select(*this, k);
+  }
+
+  //Equality; differently-sized bitsets are equal when the same bits are set
+  constexpr bool operator==(IsAnyBitset auto const& other) const noexcept {
+   return BitsetMetaFunctions::CrossSize::equal(
+    words,
+    WordCount,
+    other.data(),
+    other.wordCount()
+   );
+  }
+
+  //Bitwise AND; bits beyond the size of `other` are cleared
+  constexpr Bitset operator&(IsAnyBitset auto const& other) const noexcept {
+   return Bitset{*this} &= other;
+  }
+
+  //Integral bitwise AND
+  constexpr Bitset operator&(Integral auto other) const noexcept {
+   return Bitset{*this} &= Bitset{other};
+  }
+
+  //Bitwise OR
+  constexpr Bitset operator|(IsAnyBitset auto const& other) const noexcept {
+   return Bitset{*this} |= other;
+  }
+
+  //Integral bitwise OR
+  constexpr Bitset operator|(Integral auto other) const noexcept {
+   return Bitset{*this} |= Bitset{other};
+  }
+
+  //Bitwise XOR
+  constexpr Bitset operator^(IsAnyBitset auto const& other) const noexcept {
+   return Bitset{*this} ^= other;
+  }
+
+  //Integral bitwise XOR
+  constexpr Bitset operator^(Integral auto other) const noexcept {
+   return Bitset{*this} ^= Bitset{other};
+  }
+
+  //Bitwise NOT
+  constexpr Bitset operator~() const noexcept {
+   Bitset result{*this};
+   BitsetMetaFunctions::Kernels::bitwiseNot(result.words, WordCount);
+   return result.clearTail();
+  }
+
+  //Bitwise left-shift
+  constexpr Bitset operator<<(IndexType const shift) const noexcept {
+   return Bitset{*this} <<= shift;
+  }
+
+  //Bitwise right-shift
+  constexpr Bitset operator>>(IndexType const shift) const noexcept {
+   return Bitset{*this} >>= shift;
+  }
+
+  //Bitwise AND assignment operator
+  constexpr Bitset& operator&=(IsAnyBitset auto const& other) noexcept {
+   BitsetMetaFunctions::CrossSize::bitwiseAnd(
+    words,
+    WordCount,
+    other.data(),
+    other.wordCount()
+   );
+   return *this;
+  }
+
+  //Bitwise OR assignment operator
+  constexpr Bitset& operator|=(IsAnyBitset auto const& other) noexcept {
+   BitsetMetaFunctions::CrossSize::bitwiseOr(
+    words,
+    WordCount,
+    other.data(),
+    other.wordCount()
+   );
+   return clearTail();
+  }
+
+  //Bitwise XOR assignment operator
+  constexpr Bitset& operator^=(IsAnyBitset auto const& other) noexcept {
+   BitsetMetaFunctions::CrossSize::bitwiseXor(
+    words,
+    WordCount,
+    other.data(),
+    other.wordCount()
+   );
+   return clearTail();
+  }
+
+  //Clears every bit that is set in `other`, ie. `*this &= ~other`
+  constexpr Bitset& andNot(IsAnyBitset auto const& other) noexcept {
+   BitsetMetaFunctions::CrossSize::bitwiseAndNot(
+    words,
+    WordCount,
+    other.data(),
+    other.wordCount()
+   );
+   return *this;
+  }
+
+  //Returns the number of bits set in both `*this` and `other`, without
+  //materializing the intersection
+  constexpr SizeType intersectCount(IsAnyBitset auto const& other)
+   const noexcept
+  {
+   return BitsetMetaFunctions::CrossSize::intersectCount(
+    words,
+    WordCount,
+    other.data(),
+    other.wordCount()
+   );
+  }
+
+  //Bitwise left-shift assignment operator
+  constexpr Bitset& operator<<=(IndexType const shift) noexcept {
+   BitsetMetaFunctions::Kernels::shiftLeft(words, WordCount, shift);
+   return clearTail();
+  }
 
-    //Returns the min of 2 values
-    static constexpr auto min(auto v1, auto v2) noexcept {
-     return v1 < v2 ? v1 : v2;
-    }
+  //Bitwise right-shift assignment operator
+  constexpr Bitset& operator>>=(IndexType const shift) noexcept {
+   BitsetMetaFunctions::Kernels::shiftRight(words, WordCount, shift);
+   return *this;
+  }
 
-    //Utility fop binary bitwise operations
-    template<auto OtherN>
-    constexpr void binOp(BufferForNBits<N> const& other, auto op) noexcept {
-     for (IndexType i = 0; i < min(N, OtherN); i++) {
-      op(buffer[i], other.buffer[i]);
-     }
-    }
+  //Default copy-assignment operator
+  constexpr Bitset& operator=(Bitset const&) noexcept = default;
 
-    //Utility for unary bitwise operations
-    constexpr void unOp(auto op) noexcept {
-     for (IndexType i = 0; i < N; i++) {
-      op(buffer[i]);
-     }
-    }
+  //Default move-assignment operator
+  constexpr Bitset& operator=(Bitset&&) noexcept = default;
 
-   public:
-    unsigned char buffer[bytes];
+  //Integral assignment operator; the bits of `value` are assigned to the
+  //lowest bits of the bitset, all other bits are cleared
+  constexpr Bitset& operator=(Integral auto value) noexcept {
+   using IntegralType = ConstDecayed<ReferenceDecayed<decltype(value)>>;
+   static_assert(
+    sizeof(IntegralType) <= sizeof(Word),
+    "Integral types wider than a bitset word are not supported"
+   );
+   constexpr auto const valueMask = sizeof(IntegralType) < sizeof(Word)
+    ? ~(~(Word)0 << (sizeof(IntegralType) * 8))
+    : ~(Word)0;
+   BitsetMetaFunctions::Kernels::fill(words, 0, WordCount);
+   words[0] = (Word)value & valueMask;
+   return clearTail();
+  }
 
-    //Default constructor
-    constexpr BufferForNBits() noexcept = default;
+  //Differently-sized or dynamic bitset copy-assignment operator; excess bits
+  //of `other` are discarded and missing bits are cleared
+  constexpr Bitset& operator=(IsAnyBitset auto const& other) noexcept {
+   BitsetMetaFunctions::CrossSize::assign(
+    words,
+    WordCount,
+    other.data(),
+    other.wordCount()
+   );
+   return clearTail();
+  }
 
-    //Default copy-constructor
-    constexpr BufferForNBits(BufferForNBits const&) noexcept = default;
+  //Bit index operator
+  constexpr BitsetMetaFunctions::BitReference operator[](IndexType const index)
+   noexcept
+  {
+   return {words[index / BitsetMetaFunctions::WordBits], (SizeType)index};
+  }
 
-    //Default move-constructor
-    constexpr BufferForNBits(BufferForNBits&&) noexcept = default;
+  //Bit index operator
+  constexpr bool operator[](IndexType const index) const noexcept {
+   return get(index);
+  }
 
-    //Constructor to initialize buffer from an integral value
-    constexpr BufferForNBits(Integral auto value) noexcept {
-     const_cast<BufferForNBits&>(*this).operator=(value);
-    }
+  //Zero-check implicit bool conversion
+  constexpr operator bool() const noexcept {
+   return any();
+  }
+ };
 
-    //Differently-sized `BufferForNBits` copy-constructor
-    template<auto OtherN>
-    constexpr BufferForNBits(BufferForNBits<OtherN> const& other) noexcept {
-     operator=(move(other));
-    }
+ //Deduction guide for `Bitset<N>` from integral values
+ template<Integral I>
+ Bitset(I) -> Bitset<sizeof(I) * 8>;
+
+ //Runtime-sized bitset, stored as a span of 64-bit words. Bitsets of up to
+ //`InlineBits` bits are stored inline; larger bitsets allocate their words
+ //using `A`. Bits beyond `size()` in the last word are always zero
+ template<template<typename...> typename A>
+ requires IsAllocator<A>
+ struct DynamicBitset final {
+  //Bit index type alias
+  using IndexType = SizeType;
 
-    //Differently-sized `BufferForNBits` move-constructor
-    template<auto OtherN>
-    constexpr BufferForNBits(BufferForNBits<OtherN>&& other) noexcept {
-     operator=(move(other));
-    }
+  //Storage word type alias
+  using Word = BitsetMetaFunctions::Word;
 
-    //Default copy-assignment operator
-    constexpr BufferForNBits& operator=(BufferForNBits const&) noexcept
-     = default;
+  //Word allocator type alias
+  using AllocatorType = A<Word>;
 
-    //Default move-assignment operator
-    constexpr BufferForNBits& operator=(BufferForNBits&&) noexcept = default;
+  //Number of words stored inline, without allocating
+  static constexpr SizeType const InlineWords = 2;
 
-    //Integral assignment operator
-    constexpr BufferForNBits& operator=(Integral auto value) noexcept {
-     using IntegralType = ConstDecayed<ReferenceDecayed<decltype(value)>>;
-     constexpr unsigned char mask = ~0;
-     for (SizeType i = 0; i < sizeof(IntegralType); i++) {
-      buffer[i / 8] = mask & (value << i);
-     }
-     return *this;
-    }
+  //Largest number of bits stored inline, without allocating
+  static constexpr SizeType const InlineBits = InlineWords
+   * BitsetMetaFunctions::WordBits;
 
-    //Differently-sized copy-assignment operator
-    template<auto OtherN>
-    constexpr BufferForNBits& operator=(BufferForNBits<OtherN> const& other)
-     noexcept
-    {
-     binOp(
-      other,
-      [](auto& b1, auto& b2) {
-       b1 = b2;
-      }
-     );
-     return *this;
-    }
+ private:
+  //Whether the allocator instance must be stored
+  static constexpr bool const Stateful = IsStatefulAllocator<A>;
+
+  //Allocator storage type; zero-sized for stateless allocators
+  using StoredAllocator = SelectType<Stateful, AllocatorType, Never>;
+
+  //Inline word buffer
+  struct InlineStorage final {
+   Word words[InlineWords];
+  };
+
+  //Allocator instance
+  [[no_unique_address]]
+  StoredAllocator allocator;
+
+  //Number of bits in the bitset
+  SizeType bits = 0;
+
+  //Bit buffer; `local` is active when `bits <= InlineBits`. Unused words of
+  //`local` are always zero
+  union {
+   InlineStorage local{};
+   Word * heap;
+  };
+
+  //Returns whether `count` words are stored inline
+  static constexpr bool storedInline(SizeType const count) noexcept {
+   return count <= InlineWords;
+  }
 
-    //Differently-sized move-assginment operator
-    template<auto OtherN>
-    constexpr BufferForNBits operator=(BufferForNBits<OtherN>&& other) noexcept
-    {
-     binOp(
-      other,
-      [](auto& b1, auto& b2) {
-       b1 = b2;
-      }
-     );
-     return *this;
-    }
+  //Allocates `count` words
+  constexpr Word * allocateWords(SizeType const count) noexcept {
+   if constexpr (Stateful) {
+    return &unwrapAllocation(allocator.allocate(count));
+   } else {
+    return &unwrapAllocation(AllocatorType::allocate(count));
+   }
+  }
 
-    //Equality operator
-    constexpr bool operator==(BufferForNBits const& other) const noexcept {
-     for (IndexType i = 0; i < N; i++) {
-      if (buffer[i] != other.buffer[i]) {
-       return false;
-      }
-     }
-     return true;
-    }
+  //Resizes the allocation of `previous` words at `words` to `count` words,
+  //in place when the allocator supports it
+  constexpr Word * reallocateWords(
+   Word * const words,
+   SizeType const previous,
+   SizeType const count
+  ) noexcept {
+   return &unwrapAllocation(reallocate<A>(allocator, *words, previous, count));
+  }
 
-    //Differently-sized equality operator
-    template<auto OtherN>
-    constexpr bool operator==(BufferForNBits<OtherN> const&) const noexcept {
-     return false;
-    }
+  //Deallocates `count` words
+  constexpr void deallocateWords(Word * const words, SizeType const count)
+   noexcept
+  {
+   if constexpr (Stateful) {
+    allocator.deallocate(*words, count);
+   } else {
+    AllocatorType::deallocate(*words, count);
+   }
+  }
 
-    //Bitwise AND operator
-    template<auto OtherN>
-    constexpr void operator&(BufferForNBits<OtherN> const& other)
-     noexcept
-    {
-     binOp(
-      other,
-      [](auto& b1, auto& b2) {
-       b1 &= b2;
-      }
-     );
-    }
+  //Releases any allocated words and leaves the bitset empty
+  constexpr void release() noexcept {
+   if (!storedInline(wordCount())) {
+    deallocateWords(heap, wordCount());
+   }
+   bits = 0;
+   local = InlineStorage{};
+  }
 
-    //Bitwise OR
-    template<auto OtherN>
-    constexpr void operator|(BufferForNBits<OtherN> const& other) noexcept {
-     binOp(
-      other,
-      [](auto& b1, auto& b2) {
-       b1 |= b2;
-      }
-     );
-    }
+  //Clears the unused bits of the last word
+  constexpr DynamicBitset& clearTail() noexcept {
+   if (auto const count = wordCount()) {
+    data()[count - 1] &= BitsetMetaFunctions::tailMask(bits);
+   }
+   return *this;
+  }
 
-    //Bitwise XOR
-    template<auto OtherN>
-    constexpr void operator^(BufferForNBits<OtherN> const& other) noexcept {
-     binOp(
-      other,
-      [](auto& b1, auto& b2) {
-       b1 ^= b2;
-      }
-     );
-    }
+  //Copies `count` words from `src` into the storage of a bitset with
+  //`bits` bits
+  constexpr void copyStorage(Word const * const src, SizeType const count)
+   noexcept
+  {
+   if (storedInline(count)) {
+    BitsetMetaFunctions::Kernels::copy(local.words, src, count);
+   } else {
+    heap = allocateWords(count);
+    BitsetMetaFunctions::Kernels::copy(heap, src, count);
+   }
+  }
 
-    //Bitwise compl
-    constexpr void operator~() noexcept {
-     unOp([](auto& b1) {
-      b1 = ~b1;
-     });
-    }
+ public:
+  //Default constructor; constructs an empty bitset
+  constexpr DynamicBitset() noexcept = default;
+
+  //Constructs a bitset of `size` bits, all set to `value`
+  constexpr explicit DynamicBitset(
+   SizeType const size,
+   bool const value = false
+  ) noexcept
+  {
+   resize(size, value);
+  }
 
-    //Bitwise left-shift
-    constexpr void operator<<(IndexType const shift) noexcept {
-     //TODO test this code
-     for (IndexType i = 0; i < N; i++) {
-      buffer[i] <<= shift;
-      if (i != N - 1) {
-       buffer[i] |= (~(~(unsigned char)0 << shift) & buffer[i + 1]);
-      }
-     }
-    }
+  //Constructs a bitset of `size` bits, all `false`, using a copy of
+  //`allocator`
+  constexpr DynamicBitset(
+   SizeType const size,
+   AllocatorType const& allocator
+  ) noexcept requires Stateful :
+   allocator(allocator)
+  {
+   resize(size);
+  }
 
-    //Bitwise right-shift
-    constexpr void operator>>(IndexType const shift) noexcept {
-     //TODO test this code
-     for (IndexType i = N; i >= 0; i--) {
-      buffer[i] >>= shift;
-      if (i > 0) {
-       buffer[i] |= (~(~(unsigned char)0 >> shift) & buffer[i - 1]);
-      }
-     }
-    }
-   };
+  //Copy-constructor
+  constexpr DynamicBitset(DynamicBitset const& other) noexcept :
+   allocator(other.allocator),
+   bits(other.bits)
+  {
+   copyStorage(other.data(), wordCount());
   }
 
-  //Returns an instance of bit-buffer backend
-  template<auto N>
-  requires (N > 0)
-  constexpr auto bufferForNBits() noexcept {
-   //Used to prevent conflicting return type deductions
-   constexpr auto const useExtInt = [] {
-    #ifdef CX_COMPILER_CLANG_LIKE
-     return N < ((1 << 24) - 1);
-    #else
-     return false;
-    #endif
-   }();
-   #ifdef CX_COMPILER_CLANG_LIKE
-    //If using a clang-like compiler with `_ExtInt` support, use that instead
-    //of the naive byte-buffer backend
-    if constexpr (useExtInt) {
-     using Type = unsigned _ExtInt(N);
-     return Type{};
+  //Move-constructor; leaves `other` empty
+  constexpr DynamicBitset(DynamicBitset&& other) noexcept :
+   allocator((StoredAllocator&&)other.allocator),
+   bits(other.bits)
+  {
+   if (storedInline(wordCount())) {
+    local = other.local;
+   } else {
+    heap = other.heap;
+   }
+   other.bits = 0;
+   other.local = InlineStorage{};
+  }
+
+  //Fixed-size or differently-allocated bitset copy-constructor; the
+  //constructed bitset has the same size as `other`
+  template<typename B>
+  requires (IsAnyBitset<B> && !SameType<B, DynamicBitset>)
+  constexpr DynamicBitset(B const& other) noexcept :
+   bits(other.size())
+  {
+   copyStorage(other.data(), wordCount());
+  }
+
+  //Destructor; deallocates any allocated words
+  constexpr ~DynamicBitset() noexcept {
+   release();
+  }
+
+  //Returns the number of bits in the bitset
+  constexpr SizeType size() const noexcept {
+   return bits;
+  }
+
+  //Returns the number of words in the bitset
+  constexpr SizeType wordCount() const noexcept {
+   return BitsetMetaFunctions::wordsForBits(bits);
+  }
+
+  //Returns a pointer to the underlying words
+  constexpr Word * data() noexcept {
+   return storedInline(wordCount()) ? local.words : heap;
+  }
+
+  //Returns a pointer to the underlying words
+  constexpr Word const * data() const noexcept {
+   return storedInline(wordCount()) ? local.words : heap;
+  }
+
+  //Resizes the bitset to `size` bits. Existing bits are preserved and any
+  //added bits are set to `value`
+  constexpr void resize(SizeType const size, bool const value = false)
+   noexcept
+  {
+   using namespace BitsetMetaFunctions;
+   auto const previousBits = bits;
+   auto const previousCount = wordCount();
+   auto const count = wordsForBits(size);
+   if (storedInline(previousCount) && storedInline(count)) {
+    //Clear inline words that are no longer used
+    if (count < previousCount) {
+     Kernels::fill(local.words + count, 0, previousCount - count);
+    }
+   } else if (count != previousCount) {
+    auto const previous = data();
+    auto const common = CrossSize::common(count, previousCount);
+    if (storedInline(count)) {
+     //Move from allocated to inline storage
+     InlineStorage next{};
+     Kernels::copy(next.words, previous, common);
+     deallocateWords(previous, previousCount);
+     local = next;
+    } else if (storedInline(previousCount)) {
+     //Move from inline to allocated storage
+     auto const next = allocateWords(count);
+     Kernels::copy(next, previous, common);
+     Kernels::fill(next + common, 0, count - common);
+     heap = next;
+    } else {
+     //Resize allocated storage; grows without copying when the allocator
+     //can extend the allocation in place
+     heap = reallocateWords(previous, previousCount, count);
+     Kernels::fill(heap + common, 0, count - common);
+    }
+   }
+   bits = size;
+   //Set added bits
+   if (value && size > previousBits) {
+    auto const words = data();
+    auto const first = previousBits / WordBits;
+    if (auto const offset = previousBits % WordBits) {
+     words[first] |= ~(Word)0 << offset;
+     Kernels::fill(words + first + 1, ~(Word)0, count - first - 1);
+    } else {
+     Kernels::fill(words + first, ~(Word)0, count - first);
     }
-   #endif
-   //Return naive byte-buffer backend
-   if constexpr (!useExtInt) {
-    return Internal::BufferForNBits<N>{};
    }
+   clearTail();
   }
- }
 
- //Optimized buffer type supporting basic bitwise operations
- template<auto N>
- using BufferTypeForNBits = decltype(BitsetMetaFunctions::bufferForNBits<N>());
+  //Returns value of bit at `index`
+  constexpr bool get(IndexType const index) const noexcept {
+   return (data()[index / BitsetMetaFunctions::WordBits]
+    >> (index % BitsetMetaFunctions::WordBits)) & 1;
+  }
 
- //Forward declare `CX::Bitset<N>`
- /*
- template<typename T = SizeType, auto = T{}>
- struct Bitset;
- */
- template<auto>
- struct Bitset;
+  //Sets the bit at `index` to `value` and returns its previous value
+  constexpr bool set(IndexType const index, bool const value = true) noexcept {
+   auto bit = operator[](index);
+   bool const previous = bit;
+   bit = value;
+   return previous;
+  }
 
- //TODO `CX::Bitset` identity concept
- template<typename T>
- concept IsBitset = false;
+  //Inverts the bit at `index` and returns its previous value
+  constexpr bool flip(IndexType const index) noexcept {
+   auto bit = operator[](index);
+   bool const previous = bit;
+   bit.flip();
+   return previous;
+  }
 
- /*
- //TODO Bitset speciailzation for custom backends
- template<typename T, auto>
- struct Bitset final {
+  //Reset all bits to `value`
+  constexpr void reset(bool const value = false) noexcept {
+   BitsetMetaFunctions::Kernels::fill(
+    data(),
+    value ? ~(Word)0 : 0,
+    wordCount()
+   );
+   clearTail();
+  }
 
- };
- */
+  //Returns the number of set bits
+  constexpr SizeType count() const noexcept {
+   return BitsetMetaFunctions::Bulk::popcount(data(), wordCount());
+  }
 
- //TODO
- // - Iterator for each bit
- // - Support user-defined backends
- // - Create a runtime backend for bitsets of non-constexpr sizes
- template<auto N>
- //struct Bitset<decltype(N), N> final : Never {
- struct Bitset final : Never {
-  //Bit index type alias
-  using IndexType = ConstDecayed<decltype(N)>;
+  //Returns whether any bit is set
+  constexpr bool any() const noexcept {
+   return BitsetMetaFunctions::Bulk::any(data(), wordCount());
+  }
 
- private:
-  //Bit buffer type
-  using BufferType = BufferTypeForNBits<N>;
+  //Returns whether no bits are set
+  constexpr bool none() const noexcept {
+   return !any();
+  }
 
-  //Bit buffer
-  BufferType buffer;
+  //Returns whether all bits are set
+  constexpr bool all() const noexcept {
+   return count() == bits;
+  }
 
-  //Returns mutable reference `*this`
-  constexpr auto& mut() const noexcept {
-   return const_cast<Bitset&>(*this);
+  //Returns the index of the first set bit, or `size()` if no bits are set
+  constexpr IndexType findFirst() const noexcept {
+   return findNext(0);
   }
 
- public:
-  //Lazy default constructor, no initialization performed
-  constexpr Bitset() noexcept = default;
+  //Returns the index of the first set bit at or after `from`, or `size()`
+  //if there is none
+  constexpr IndexType findNext(IndexType const from) const noexcept {
+   if (from >= bits) {
+    return bits;
+   }
+   auto const index = BitsetMetaFunctions::Kernels::findNext(
+    data(),
+    wordCount(),
+    from
+   );
+   return index < bits ? index : bits;
+  }
 
-  //Default copy-constructor
-  constexpr Bitset(Bitset const&) noexcept = default;
+  //Returns a range over the indices of the set bits, in ascending order
+  constexpr BitsetMetaFunctions::SetBitRange setBits() const noexcept {
+   return {data(), wordCount()};
+  }
 
-  //Default move-constructor
-  constexpr Bitset(Bitset&&) noexcept = default;
+  //Returns the number of set bits below `index`
+  constexpr SizeType rank(IndexType const index) const noexcept {
+   if (index >= bits) {
+    return count();
+   }
+   return BitsetMetaFunctions::Bulk::rank(data(), index);
+  }
 
-  //Constructor to initialize bitset from an integral value
-  constexpr Bitset(Integral auto value) noexcept {
-   operator=(value);
+  //Returns the number of set bits below `index`, using a rank index built
+  //from `*this`
+  template<template<typename...> typename OtherA>
+  SizeType rank(
+   IndexType const index,
+   BitsetRankIndex<OtherA> const& rankIndex
+  ) const noexcept {
+   return rankIndex.rank(*this, index < bits ? index : bits);
   }
 
-  //Differnetly-sized Bitset copy-constructor
-  template<auto OtherN>
-  constexpr Bitset(Bitset<OtherN> const& other) noexcept {
-   //TODO
-   (void)other;
+  //Returns the index of the `k`th (zero-based) set bit, or `size()` if fewer
+  //than `k + 1` bits are set
+  constexpr IndexType select(SizeType const k) const noexcept {
+   auto const index = BitsetMetaFunctions::Kernels::select(
+    data(),
+    wordCount(),
+    k
+   );
+   return index < bits ? index : bits;
   }
 
-  //Differently-sized Bitset move-constructor
-  template<auto OtherN>
-  constexpr Bitset(Bitset<OtherN>&& other) noexcept {
-   //TODO
-   (void)other;
+  //Returns the index of the `k`th (zero-based) set bit, or `size()` if fewer
+  //than `k + 1` bits are set, using a rank index built from `*this`
+  template<template<typename...> typename OtherA>
+  IndexType select(
+   SizeType const k,
+   BitsetRankIndex<OtherA> const& rankIndex
+  ) const noexcept {
+   return rankIndex.select(*this, k);
   }
 
-  //Constexpr default destructor
-  constexpr ~Bitset() noexcept = default;
+  //Equality; differently-sized bitsets are equal when the same bits are set
+  constexpr bool operator==(IsAnyBitset auto const& other) const noexcept {
+   return BitsetMetaFunctions::CrossSize::equal(
+    data(),
+    wordCount(),
+    other.data(),
+    other.wordCount()
+   );
+  }
 
-  //TODO returns value of bit at `index`
-  constexpr bool get(IndexType const index) const noexcept {
-   (void)index;
-   return false;
+  //Bitwise AND; bits beyond the size of `other` are cleared
+  constexpr DynamicBitset operator&(IsAnyBitset auto const& other)
+   const noexcept
+  {
+   return DynamicBitset{*this} &= other;
   }
 
-  //TODO sets a bit to `value` at `index`
-  constexpr bool set(IndexType const index, bool value) noexcept {
-   (void)index;
-   (void)value;
-   return false;
+  //Bitwise OR
+  constexpr DynamicBitset operator|(IsAnyBitset auto const& other)
+   const noexcept
+  {
+   return DynamicBitset{*this} |= other;
   }
 
-  //TODO reset all bits to `false`
-  constexpr void reset(bool const value = false) noexcept {
-   (void)value;
+  //Bitwise XOR
+  constexpr DynamicBitset operator^(IsAnyBitset auto const& other)
+   const noexcept
+  {
+   return DynamicBitset{*this} ^= other;
   }
 
-  //TODO equality
-  template<auto OtherN>
-  constexpr bool operator==(Bitset<OtherN> const& other) noexcept {
-   (void)other;
-   return false;
+  //Bitwise NOT
+  constexpr DynamicBitset operator~() const noexcept {
+   DynamicBitset result{*this};
+   BitsetMetaFunctions::Kernels::bitwiseNot(result.data(), wordCount());
+   return (DynamicBitset&&)result.clearTail();
   }
 
-  //TODO Bitwise AND
-  template<auto OtherN>
-  constexpr Bitset operator&(Bitset<OtherN> const& other) const noexcept {
-   (void)other;
-   return {};
+  //Bitwise left-shift
+  constexpr DynamicBitset operator<<(IndexType const shift) const noexcept {
+   return DynamicBitset{*this} <<= shift;
   }
 
-  //TODO R-value bitwise AND
-  template<auto OtherN>
-  constexpr Bitset operator&(Bitset<OtherN>&& other) const noexcept {
-   (void)other;
-   return {};
+  //Bitwise right-shift
+  constexpr DynamicBitset operator>>(IndexType const shift) const noexcept {
+   return DynamicBitset{*this} >>= shift;
   }
 
-  //TODO Integral bitwise AND
-  constexpr Bitset operator&(Integral auto other) const noexcept {
-   (void)other;
-   return {};
+  //Bitwise AND assignment operator
+  constexpr DynamicBitset& operator&=(IsAnyBitset auto const& other) noexcept {
+   BitsetMetaFunctions::CrossSize::bitwiseAnd(
+    data(),
+    wordCount(),
+    other.data(),
+    other.wordCount()
+   );
+   return *this;
   }
 
-  //TODO Bitwise OR
-  template<auto OtherN>
-  constexpr Bitset operator|(Bitset<OtherN> const& other) const noexcept {
-   (void)other;
-   return {};
+  //Bitwise OR assignment operator
+  constexpr DynamicBitset& operator|=(IsAnyBitset auto const& other) noexcept {
+   BitsetMetaFunctions::CrossSize::bitwiseOr(
+    data(),
+    wordCount(),
+    other.data(),
+    other.wordCount()
+   );
+   return clearTail();
   }
 
-  //TODO Bitwise XOR
-  template<auto OtherN>
-  constexpr Bitset operator^(Bitset<OtherN> const& other) const noexcept {
-   (void)other;
-   return {};
+  //Bitwise XOR assignment operator
+  constexpr DynamicBitset& operator^=(IsAnyBitset auto const& other) noexcept {
+   BitsetMetaFunctions::CrossSize::bitwiseXor(
+    data(),
+    wordCount(),
+    other.data(),
+    other.wordCount()
+   );
+   return clearTail();
   }
 
-  //TODO Bitwise NOT
-  constexpr Bitset operator~() const noexcept {
-   return {};
+  //Clears every bit that is set in `other`, ie. `*this &= ~other`
+  constexpr DynamicBitset& andNot(IsAnyBitset auto const& other) noexcept {
+   BitsetMetaFunctions::CrossSize::bitwiseAndNot(
+    data(),
+    wordCount(),
+    other.data(),
+    other.wordCount()
+   );
+   return *this;
   }
 
-  //TODO Bitwise left-shift
-  constexpr Bitset operator<<(IndexType const shift) const noexcept {
-   (void)shift;
-   return {};
+  //Returns the number of bits set in both `*this` and `other`, without
+  //materializing the intersection
+  constexpr SizeType intersectCount(IsAnyBitset auto const& other)
+   const noexcept
+  {
+   return BitsetMetaFunctions::CrossSize::intersectCount(
+    data(),
+    wordCount(),
+    other.data(),
+    other.wordCount()
+   );
   }
 
-  //TODO Bitwise right-shift
-  constexpr Bitset operator>>(IndexType const shift) const noexcept {
-   (void)shift;
-   return {};
+  //Bitwise left-shift assignment operator
+  constexpr DynamicBitset& operator<<=(IndexType const shift) noexcept {
+   BitsetMetaFunctions::Kernels::shiftLeft(data(), wordCount(), shift);
+   return clearTail();
   }
 
-  //Default copy-assignment operator
-  constexpr Bitset& operator=(Bitset const&) noexcept = default;
+  //Bitwise right-shift assignment operator
+  constexpr DynamicBitset& operator>>=(IndexType const shift) noexcept {
+   BitsetMetaFunctions::Kernels::shiftRight(data(), wordCount(), shift);
+   return *this;
+  }
 
-  //Default move-assignment operator
-  constexpr Bitset& operator=(Bitset&&) noexcept = default;
+  //Copy-assignment operator; `*this` takes the size of `other`
+  constexpr DynamicBitset& operator=(DynamicBitset const& other) noexcept {
+   return operator=<DynamicBitset>(other);
+  }
 
-  //Interal assignment operator
-  constexpr Bitset& operator=(Integral auto value) noexcept {
-   buffer = value;
+  //Move-assignment operator; leaves `other` empty
+  constexpr DynamicBitset& operator=(DynamicBitset&& other) noexcept {
+   if (this != &other) {
+    release();
+    allocator = (StoredAllocator&&)other.allocator;
+    bits = other.bits;
+    if (storedInline(wordCount())) {
+     local = other.local;
+    } else {
+     heap = other.heap;
+    }
+    other.bits = 0;
+    other.local = InlineStorage{};
+   }
    return *this;
   }
 
-  //Differently-sized Bitset copy-assignment operator
-  template<auto OtherN>
-  constexpr Bitset& operator=(Bitset<OtherN> const& other) noexcept {
-   buffer = other.buffer;
+  //Fixed-size or dynamic bitset copy-assignment operator; `*this` takes the
+  //size of `other`
+  template<IsAnyBitset B>
+  constexpr DynamicBitset& operator=(B const& other) noexcept {
+   if ((void const *)this != (void const *)&other) {
+    resize(other.size());
+    BitsetMetaFunctions::Kernels::copy(data(), other.data(), wordCount());
+   }
    return *this;
   }
 
-  //Differently-sized Bitset move-assignment operator
-  template<auto OtherN>
-  constexpr Bitset& operator=(Bitset<OtherN>&& other) noexcept {
-   return operator=(copy(other));
+  //Bit index operator
+  constexpr BitsetMetaFunctions::BitReference operator[](IndexType const index)
+   noexcept
+  {
+   return {data()[index / BitsetMetaFunctions::WordBits], index};
   }
 
-  /*
   //Bit index operator
-  constexpr BitReference operator[](IndexType bitIndex) noexcept {
-   (void)bitIndex;
+  constexpr bool operator[](IndexType const index) const noexcept {
+   return get(index);
+  }
+
+  //Zero-check bool conversion
+  //Note: Explicit, since `IndexType` is wider than `int` and an implicit
+  //conversion would make shifts by integer literals ambiguous
+  constexpr explicit operator bool() const noexcept {
+   return any();
+  }
+ };
+
+ //Fixed-size bitset supporting concurrent access. Every operation on a
+ //single bit is a word-level atomic read-modify-write; whole-bitset
+ //operations (`count`, `reset`, `load`, ...) are atomic per word, but not
+ //across words. Words are stored in groups of `GroupWords` words, each
+ //aligned to its own cache line; smaller groups trade memory for less
+ //false sharing between threads operating on neighbouring words
+ template<
+  auto N,
+  SizeType GroupWords = BitsetMetaFunctions::CacheLineSize
+   / sizeof(BitsetMetaFunctions::Word)
+ >
+ struct AtomicBitset final {
+  static_assert(N > 0, "Bitset must contain at least one bit");
+  static_assert(
+   GroupWords > 0
+    && GroupWords * sizeof(BitsetMetaFunctions::Word)
+     <= BitsetMetaFunctions::CacheLineSize,
+   "Word groups must fit within a single cache line"
+  );
+
+  //Bit index type alias
+  using IndexType = ConstDecayed<decltype(N)>;
+
+  //Storage word type alias
+  using Word = BitsetMetaFunctions::Word;
+
+  //Number of bits in the bitset
+  static constexpr SizeType const Size = N;
+
+  //Number of words in the bitset
+  static constexpr SizeType const WordCount = BitsetMetaFunctions
+   ::wordsForBits(N);
+
+  //Number of cache-line-aligned word groups in the bitset
+  static constexpr SizeType const GroupCount = (WordCount + GroupWords - 1)
+   / GroupWords;
+
+ private:
+  //Cache-line-aligned group of words
+  struct alignas(BitsetMetaFunctions::CacheLineSize) WordGroup final {
+   Word words[GroupWords];
+  };
+
+  //Bit buffer
+  WordGroup groups[GroupCount]{};
+
+  //Returns the word at `index`
+  Word& word(SizeType const index) noexcept {
+   return groups[index / GroupWords].words[index % GroupWords];
+  }
+
+  //Returns the word at `index`
+  Word const& word(SizeType const index) const noexcept {
+   return groups[index / GroupWords].words[index % GroupWords];
+  }
+
+  //Returns the mask of valid bits in the word at `index`
+  static constexpr Word validBits(SizeType const index) noexcept {
+   return index == WordCount - 1
+    ? BitsetMetaFunctions::tailMask(N)
+    : ~(Word)0;
+  }
+
+  //Atomically loads the word at `index`
+  Word loadWord(SizeType const index) const noexcept {
+   return __atomic_load_n(&word(index), __ATOMIC_ACQUIRE);
+  }
+
+  //Atomically stores `value` to the word at `index`
+  void storeWord(SizeType const index, Word const value) noexcept {
+   __atomic_store_n(&word(index), value, __ATOMIC_RELEASE);
+  }
+
+ public:
+  //Default constructor, all bits are `false`
+  constexpr AtomicBitset() noexcept = default;
+
+  //Constructs the bitset from the bits of `bitset`
+  AtomicBitset(Bitset<N> const& bitset) noexcept {
+   store(bitset);
+  }
+
+  //Atomic bitsets are shared between threads and cannot be copied or moved
+  AtomicBitset(AtomicBitset const&) = delete;
+  AtomicBitset(AtomicBitset&&) = delete;
+
+  //Constexpr default destructor
+  constexpr ~AtomicBitset() noexcept = default;
 
+  AtomicBitset& operator=(AtomicBitset const&) = delete;
+  AtomicBitset& operator=(AtomicBitset&&) = delete;
+
+  //Returns the number of bits in the bitset
+  static constexpr SizeType size() noexcept {
+   return N;
+  }
+
+  //Returns the number of words in the bitset
+  static constexpr SizeType wordCount() noexcept {
+   return WordCount;
+  }
+
+  //Returns value of bit at `index`
+  bool get(IndexType const index) const noexcept {
+   return (loadWord(index / BitsetMetaFunctions::WordBits)
+    >> (index % BitsetMetaFunctions::WordBits)) & 1;
+  }
+
+  //Atomically sets the bit at `index` to `value` and returns its previous
+  //value
+  bool set(IndexType const index, bool const value = true) noexcept {
+   auto const mask = (Word)1 << (index % BitsetMetaFunctions::WordBits);
+   auto& target = word(index / BitsetMetaFunctions::WordBits);
+   auto const previous = value
+    ? __atomic_fetch_or(&target, mask, __ATOMIC_ACQ_REL)
+    : __atomic_fetch_and(&target, ~mask, __ATOMIC_ACQ_REL);
+   return previous & mask;
+  }
+
+  //Atomically sets the bit at `index` and returns its previous value
+  bool testAndSet(IndexType const index) noexcept {
+   return set(index, true);
+  }
+
+  //Atomically clears the bit at `index` and returns its previous value
+  bool testAndClear(IndexType const index) noexcept {
+   return set(index, false);
+  }
+
+  //Atomically inverts the bit at `index` and returns its previous value
+  bool flip(IndexType const index) noexcept {
+   auto const mask = (Word)1 << (index % BitsetMetaFunctions::WordBits);
+   return __atomic_fetch_xor(
+    &word(index / BitsetMetaFunctions::WordBits),
+    mask,
+    __ATOMIC_ACQ_REL
+   ) & mask;
+  }
+
+  //Atomically sets the first clear bit, searching from the word containing
+  //`hint` and wrapping around, and returns its index, or `N` if all bits are
+  //set. Threads passing distinct hints contend on distinct words until the
+  //bitset fills
+  IndexType findFirstClearAndSet(IndexType const hint = 0) noexcept {
+   auto const start = ((SizeType)hint < N ? (SizeType)hint : 0)
+    / BitsetMetaFunctions::WordBits;
+   for (SizeType i = 0; i < WordCount; i++) {
+    auto index = start + i;
+    if (index >= WordCount) {
+     index -= WordCount;
+    }
+    auto& target = word(index);
+    auto const valid = validBits(index);
+    auto current = __atomic_load_n(&target, __ATOMIC_RELAXED);
+    //Claim the lowest clear bit; on losing a race for a bit, retry with
+    //the word yielded by `fetch_or`
+    while (auto const clear = ~current & valid) {
+     auto const mask = clear & (~clear + 1);
+     current = __atomic_fetch_or(&target, mask, __ATOMIC_ACQ_REL);
+     if (!(current & mask)) {
+      return (IndexType)(
+       index * BitsetMetaFunctions::WordBits
+        + (SizeType)__builtin_ctzll(mask)
+      );
+     }
+    }
+   }
+   return N;
+  }
+
+  //Reset all bits to `value`
+  void reset(bool const value = false) noexcept {
+   for (SizeType i = 0; i < WordCount; i++) {
+    storeWord(i, value ? validBits(i) : 0);
+   }
+  }
+
+  //Returns the number of set bits
+  SizeType count() const noexcept {
+   SizeType total = 0;
+   for (SizeType i = 0; i < WordCount; i++) {
+    total += (SizeType)__builtin_popcountll(loadWord(i));
+   }
+   return total;
+  }
+
+  //Returns whether any bit is set
+  bool any() const noexcept {
+   for (SizeType i = 0; i < WordCount; i++) {
+    if (loadWord(i)) {
+     return true;
+    }
+   }
+   return false;
+  }
+
+  //Returns whether no bits are set
+  bool none() const noexcept {
+   return !any();
+  }
+
+  //Returns whether all bits are set
+  bool all() const noexcept {
+   return count() == N;
+  }
+
+  //Returns the index of the first set bit, or `N` if no bits are set
+  IndexType findFirst() const noexcept {
+   return findNext(0);
+  }
+
+  //Returns the index of the first set bit at or after `from`, or `N` if
+  //there is none
+  IndexType findNext(IndexType const from) const noexcept {
+   if ((SizeType)from >= N) {
+    return N;
+   }
+   auto index = (SizeType)from / BitsetMetaFunctions::WordBits;
+   auto current = loadWord(index)
+    & (~(Word)0 << ((SizeType)from % BitsetMetaFunctions::WordBits));
+   while (!current) {
+    if (++index == WordCount) {
+     return N;
+    }
+    current = loadWord(index);
+   }
+   return (IndexType)(
+    index * BitsetMetaFunctions::WordBits + (SizeType)__builtin_ctzll(current)
+   );
+  }
+
+  //Returns a snapshot of the bitset; each word is loaded atomically
+  Bitset<N> load() const noexcept {
+   Bitset<N> result;
+   for (SizeType i = 0; i < WordCount; i++) {
+    result.data()[i] = loadWord(i);
+   }
+   return result;
+  }
+
+  //Stores the bits of `bitset`; each word is stored atomically
+  void store(Bitset<N> const& bitset) noexcept {
+   for (SizeType i = 0; i < WordCount; i++) {
+    storeWord(i, bitset.data()[i]);
+   }
   }
 
   //Bit index operator
-  constexpr BitReference const operator[](IndexType bitIndex) const noexcept {
-   return mut()[bitIndex];
+  bool operator[](IndexType const index) const noexcept {
+   return get(index);
   }
-  */
 
   //Zero-check implicit bool conversion
-  constexpr operator bool() const noexcept {
-   return (bool)buffer;
+  operator bool() const noexcept {
+   return any();
   }
-
-  //TODO all bitwise assignment operators
  };
 
- /*
- //TODO Empty Bitset specialization
- template<>
- struct Bitset<SizeType, 0> final : Never {
-  //TODO all member functions
- };
+ //Slot indices in `[0, Slots)` for per-thread state of shared structures,
+ //such as thread caches; each `Owner` has its own set of slots. A thread
+ //claims a slot on first use and releases it on exit, after which the slot
+ //is reused by the next thread to claim one
+ //Note: Without thread-exit hooks (see `onThreadExit`), slots are never
+ //released
+ template<typename Owner, SizeType Slots>
+ struct ThreadSlot final {
+ private:
+  static constexpr SizeType const Unclaimed = ~(SizeType)0;
 
- //Deduction guides for `Bitset<N>`
- template<Integral I>
- Bitset(I) -> Bitset<I, sizeof(I) * 8>;
- */
-};
+  //Slots in use
+  static inline AtomicBitset<Slots> slots;
+
+  //Slot of the calling thread; constant-initialized, so reading it does not
+  //involve an initialization guard
+  static inline thread_local SizeType claimed = Unclaimed;
+
+  //Releases the slot encoded in `argument`; later uses on the exiting
+  //thread get no slot
+  static void release(void * const argument) noexcept {
+   claimed = Slots;
+   slots.set((SizeType)argument - 1, false);
+  }
+
+  [[gnu::noinline]]
+  static SizeType claim() noexcept {
+   auto const index = (SizeType)slots.findFirstClearAndSet(0);
+   if (index < Slots) {
+    onThreadExit<&release>((void *)(index + 1));
+   }
+   claimed = index;
+   return index;
+  }
+
+ public:
+  //Returns the slot of the calling thread, or `Slots` if all slots are in
+  //use
+  [[gnu::always_inline]]
+  static SizeType get() noexcept {
+   auto const index = claimed;
+   if (index != Unclaimed) [[likely]] {
+    return index;
+   }
+   return claim();
+  }
+ };
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+//Dependencies for the errno error category
+//Note: Included before any CX headers since STL headers depend on exceptions.
+#ifdef CX_LIBC_SUPPORT
+ #include <cerrno>
+#endif
+
+#include <cx/common.h>
+#include <cx/idioms.h>
+#include <cx/error.h>
+
+//Integral error codes. An `ErrorCode<Category>` is only as large as its code;
+//its description is looked up in `Category` when requested, and is referenced,
+//never copied, by `CX::Error`
+namespace CX {
+ //Error category concept. Categories describe codes of `CodeType` with static
+ //descriptions:
+ // struct ParseCategory final {
+ //  using CodeType = unsigned char;
+ //  static constexpr char const Name[] = "parse";
+ //  static constexpr char const * describe(CodeType code) noexcept;
+ // };
+ template<typename MaybeCategory>
+ concept IsErrorCategory = Integral<typename MaybeCategory::CodeType>
+  && requires (typename MaybeCategory::CodeType const code) {
+   {MaybeCategory::Name} -> ConvertibleTo<char const *>;
+   {MaybeCategory::describe(code)} -> SameType<char const *>;
+  };
+
+ //Error consisting of an integral code in `Category`
+ template<typename Category>
+ requires IsErrorCategory<Category>
+ struct ErrorCode final {
+  //Code type alias
+  using CodeType = typename Category::CodeType;
+
+  //Category type alias
+  using CategoryType = Category;
+
+  //Descriptions have static storage duration; see `CX::Error`
+  static constexpr bool const StaticDescription = true;
+
+  CodeType value;
+
+  constexpr ErrorCode(CodeType const value) noexcept :
+   value(value)
+  {}
+
+  //Returns the code
+  constexpr CodeType code() const noexcept {
+   return value;
+  }
+
+  //Returns the name of the category
+  static constexpr char const * category() noexcept {
+   return Category::Name;
+  }
+
+  //Returns the description of the code
+  constexpr char const * describe() const noexcept {
+   return Category::describe(value);
+  }
+
+  constexpr bool operator==(ErrorCode const& other) const noexcept {
+   return value == other.value;
+  }
+ };
+
+ #ifdef CX_LIBC_SUPPORT
+  //Error category for `errno` values
+  struct ErrnoCategory final {
+   using CodeType = int;
+
+   static constexpr char const Name[] = "errno";
+
+   //Returns the description of `code`; descriptions are static, unlike those
+   //returned by `strerror`
+   static constexpr char const * describe(CodeType const code) noexcept {
+    switch (code) {
+     case 0: return "Success";
+     case EPERM: return "Operation not permitted";
+     case ENOENT: return "No such file or directory";
+     case ESRCH: return "No such process";
+     case EINTR: return "Interrupted system call";
+     case EIO: return "Input/output error";
+     case ENXIO: return "No such device or address";
+     case E2BIG: return "Argument list too long";
+     case ENOEXEC: return "Exec format error";
+     case EBADF: return "Bad file descriptor";
+     case ECHILD: return "No child processes";
+     case EAGAIN: return "Resource temporarily unavailable";
+     case ENOMEM: return "Cannot allocate memory";
+     case EACCES: return "Permission denied";
+     case EFAULT: return "Bad address";
+     case EBUSY: return "Device or resource busy";
+     case EEXIST: return "File exists";
+     case EXDEV: return "Invalid cross-device link";
+     case ENODEV: return "No such device";
+     case ENOTDIR: return "Not a directory";
+     case EISDIR: return "Is a directory";
+     case EINVAL: return "Invalid argument";
+     case ENFILE: return "Too many open files in system";
+     case EMFILE: return "Too many open files";
+     case ENOTTY: return "Inappropriate ioctl for device";
+     case EFBIG: return "File too large";
+     case ENOSPC: return "No space left on device";
+     case ESPIPE: return "Illegal seek";
+     case EROFS: return "Read-only file system";
+     case EMLINK: return "Too many links";
+     case EPIPE: return "Broken pipe";
+     case EDOM: return "Numerical argument out of domain";
+     case ERANGE: return "Numerical result out of range";
+     case EDEADLK: return "Resource deadlock avoided";
+     case ENAMETOOLONG: return "File name too long";
+     case ENOSYS: return "Function not implemented";
+     case ENOTEMPTY: return "Directory not empty";
+     case ELOOP: return "Too many levels of symbolic links";
+     #if EWOULDBLOCK != EAGAIN
+      case EWOULDBLOCK: return "Operation would block";
+     #endif
+     case EOVERFLOW: return "Value too large for defined data type";
+     case ENOTSOCK: return "Socket operation on non-socket";
+     #if EOPNOTSUPP != ENOTSUP
+      case EOPNOTSUPP: return "Operation not supported on socket";
+     #endif
+     case ENOTSUP: return "Operation not supported";
+     case EADDRINUSE: return "Address already in use";
+     case EADDRNOTAVAIL: return "Cannot assign requested address";
+     case ENETDOWN: return "Network is down";
+     case ENETUNREACH: return "Network is unreachable";
+     case ECONNABORTED: return "Software caused connection abort";
+     case ECONNRESET: return "Connection reset by peer";
+     case ENOBUFS: return "No buffer space available";
+     case EISCONN: return "Transport endpoint is already connected";
+     case ENOTCONN: return "Transport endpoint is not connected";
+     case ETIMEDOUT: return "Connection timed out";
+     case ECONNREFUSED: return "Connection refused";
+     case EHOSTUNREACH: return "No route to host";
+     case EALREADY: return "Operation already in progress";
+     case EINPROGRESS: return "Operation now in progress";
+     case ECANCELED: return "Operation canceled";
+     default: return "Unknown errno value";
+    }
+   }
+  };
+  static_assert(IsErrorCategory<ErrnoCategory>);
+
+  //`errno` error code type alias
+  using ErrnoError = ErrorCode<ErrnoCategory>;
+  static_assert(IsError<ErrnoError>);
+
+  //Returns the current value of `errno` as an error code
+  inline ErrnoError lastErrno() noexcept {
+   return ErrnoError{errno};
+  }
+ #endif //CX_LIBC_SUPPORT
+}
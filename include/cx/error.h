@@ -3,12 +3,13 @@
 #include <cx/common.h>
 #include <cx/idioms.h>
 
-//TODO Add a `cleanup` chain to the error hierarchy
-
 //Flags to configure error message bahaviour
 #ifdef CX_ERROR_MSG
- //Configure default error message behaviour based on STL support
- #if !defined(CX_ERROR_MSG_ALLOC) && !defined(CX_ERROR_MSG_BUF)
+ //Configure default error message behaviour based on STL support. String
+ //literal descriptions are always referenced; `CX_ERROR_MSG_STATIC` never
+ //copies descriptions and makes `CX::Error` trivially copyable
+ #if !defined(CX_ERROR_MSG_ALLOC) && !defined(CX_ERROR_MSG_BUF) \
+  && !defined(CX_ERROR_MSG_STATIC)
   #ifdef CX_STL_SUPPORT
    //Enable message allocation if building with STL support
    #define CX_ERROR_MSG_ALLOC
@@ -16,14 +17,15 @@
    //Enable message buffers if building without STL support
    #define CX_ERROR_MSG_BUF 1024
   #endif //CX_STL_SUPPORT
- #endif //!defined(CX_ERROR_MSG_ALLOC) && !defined(CX_ERROR_MSG_BUF)
+ #endif
 
  //Sanitize error message behaviour flags
- #if defined(CX_ERROR_MSG_ALLOC) && defined(CX_ERROR_MSG_BUF)
+ #if (defined(CX_ERROR_MSG_ALLOC) + defined(CX_ERROR_MSG_BUF) \
+  + defined(CX_ERROR_MSG_STATIC)) > 1
   #error \
-   Only one of `CX_ERROR_MSG_ALLOC` or `CX_ERROR_MSG_BUF` may be enabled\
-   at one time.
- #endif //defined(CX_ERROR_MSG_ALLOC) && defined(CX_ERROR_MSG_BUF)
+   Only one of `CX_ERROR_MSG_ALLOC`, `CX_ERROR_MSG_BUF` or\
+   `CX_ERROR_MSG_STATIC` may be enabled at one time.
+ #endif
 
  //Sanitize `CX_ERROR_MSG_BUF` flag
  #ifdef CX_ERROR_MSG_BUF
@@ -44,22 +46,70 @@
  #endif //CX_ERROR_MSG_BUF
 #endif //CX_ERROR_MSG
 
-//Flags to configure error tracing behaviour
+//Flags to configure error tracing behaviour. Error causes are recorded in
+//a fixed-size, thread-local ring of trace frames; errors refer to their
+//cause by ring id and sequence number
 #ifdef CX_ERROR_TRACE
- //Sanitize `CX_ERROR_TRACE` flag
- #ifndef CX_STL_SUPPORT
-  #error `CX_ERROR_TRACE` requires STL support.
- #endif //CX_STL_SUPPORT
+ //Configure default number of trace frames retained per thread
+ #ifndef CX_ERROR_TRACE_FRAMES
+  #define CX_ERROR_TRACE_FRAMES 64
+ #endif //CX_ERROR_TRACE_FRAMES
+
+ //Sanitize `CX_ERROR_TRACE_FRAMES` flag
+ #if CX_ERROR_TRACE_FRAMES < 1
+  #error `CX_ERROR_TRACE_FRAMES` must be >= 1
+ #endif //CX_ERROR_TRACE_FRAMES < 1
 #endif //CX_ERROR_TRACE
 
+//Flag for trivially copyable `CX::Error`s; set when error messages are not
+//copied
+#if !defined(CX_ERROR_MSG) || defined(CX_ERROR_MSG_STATIC)
+ #define CX_ERROR_TRIVIAL
+#endif
+
 namespace CX {
  //Forward `CX::Error` for use with error meta-functions
  struct Error;
 
+ //Forward `CX::ErrorTraceFrame` for use with error tracing
+ struct ErrorTraceFrame;
+
+ //Source location, captured by default arguments at the call site
+ struct ErrorLocation final {
+  char const * file = nullptr;
+  char const * function = nullptr;
+  unsigned line = 0;
+
+  //Returns the location of the caller
+  static constexpr ErrorLocation current(
+   char const * const file = __builtin_FILE(),
+   char const * const function = __builtin_FUNCTION(),
+   unsigned const line = __builtin_LINE()
+  ) noexcept {
+   return {file, function, line};
+  }
+ };
+
  //Supporting meta-functions
  namespace ErrorMetaFunctions {
   template<SizeType N>
   void expect(char const(&)[N]) noexcept;
+
+  //Whether `E::describe()` returns a character array, assumed to be a string
+  //literal; such descriptions are referenced rather than copied
+  template<typename E>
+  concept LiteralDescription = requires (E const& e) {
+   ErrorMetaFunctions::expect(e.describe());
+  };
+
+  //Whether `E::describe()` returns descriptions with static storage
+  //duration, either as string literals or as declared by
+  //`E::StaticDescription`; such descriptions are referenced rather than
+  //copied
+  template<typename E>
+  concept StaticDescription = LiteralDescription<E> || requires {
+   requires E::StaticDescription;
+  };
  }
 
  //Error identity concept
@@ -73,6 +123,22 @@ namespace CX {
   };
 
  namespace Internal {
+  #ifdef CX_ERROR_TRACE
+   //Records `cause`, wrapped at `location`, in the current thread's trace
+   //ring; returns the handle of the recorded frame
+   unsigned long long recordErrorTrace(
+    Error const& cause,
+    ErrorLocation const& location,
+    long long code,
+    bool hasCode
+   ) noexcept;
+
+   //Returns the frame with handle `trace` in the current thread's trace
+   //ring, or `nullptr` if it has been overwritten or was recorded in
+   //another thread's ring
+   ErrorTraceFrame const * findErrorTrace(unsigned long long trace) noexcept;
+  #endif //CX_ERROR_TRACE
+
   //Constexpr-compatible error message container
   //TODO Optimize string copying to make it trivial for the optimizer
   struct ErrorMessage final {
@@ -100,26 +166,61 @@ namespace CX {
    }
 
   public:
-   SizeType size;
-   #ifdef CX_ERROR_MSG_ALLOC
-    //Constexpr-compatible allocating message impl
-    char * message;
+   #ifdef CX_ERROR_MSG_STATIC
+    //Constexpr-compatible referencing message impl; descriptions must have
+    //static storage duration
+    char const * message = nullptr;
+
+    //Default constructor
+    constexpr ErrorMessage() noexcept = default;
 
+    //Constexpr cstring literal constructor
+    template<SizeType N>
+    constexpr ErrorMessage(char const(&message)[N]) noexcept :
+     message{message}
+    {}
+
+    //Resets stored message
+    constexpr void reset() noexcept {
+     message = nullptr;
+    }
+
+    //References cstring with static storage duration
+    constexpr ErrorMessage& reference(char const * str) noexcept {
+     message = str;
+     return *this;
+    }
+   #elif defined(CX_ERROR_MSG_ALLOC)
+    //Constexpr-compatible allocating message impl. String literals are
+    //referenced rather than copied
+    //Size of the owned message buffer; `0` if `message` is a referenced
+    //string literal
+    SizeType size;
+    char const * message;
+
+   private:
+    //Releases the owned message buffer, if any
+    constexpr void release() noexcept {
+     if (size) {
+      delete[] const_cast<char *>(message);
+      size = 0;
+     }
+     message = nullptr;
+    }
+
+   public:
     //Default constructor
     constexpr ErrorMessage() noexcept :
      size{0},
      message{nullptr}
     {}
 
-    //Constexpr cstring copy constructor
+    //Constexpr cstring literal constructor
     template<SizeType N>
     constexpr ErrorMessage(char const(&message)[N]) noexcept :
-     size{N},
-     message{new char[N + 1]{0}}
-    {
-     //Copy message contents
-     cstrcpy(this->message, &message[0], N);
-    }
+     size{0},
+     message{message}
+    {}
 
     //Constexpr copy constructor
     constexpr ErrorMessage(ErrorMessage const& other) noexcept :
@@ -139,25 +240,30 @@ namespace CX {
 
     //Constexpr destructor
     constexpr ~ErrorMessage() noexcept {
-     delete[] message;
+     release();
     }
 
     //Constexpr copy-assignment operator
     constexpr ErrorMessage& operator=(ErrorMessage const& other) noexcept {
-     //Reallocate buffer if it is not large enough
-     if (other.size > size || !message) {
-      delete[] message;
-      size = other.size;
-      //Note: `+1` for null terminator
-      message = new char[size + 1];
+     if (&other == this) {
+      return *this;
+     }
+     if (!other.size) {
+      //Reference string literal
+      release();
+      message = other.message;
+      return *this;
      }
      //Copy message contents
-     cstrcpy(message, other.message, size);
-     return *this;
+     return from(other.message);
     }
 
     //Constexpr move-assignment operator
     constexpr ErrorMessage& operator=(ErrorMessage&& other) noexcept {
+     if (&other == this) {
+      return *this;
+     }
+     release();
      size = other.size;
      message = other.message;
      other.size = 0;
@@ -167,49 +273,56 @@ namespace CX {
 
     //Resets stored message
     constexpr void reset() noexcept {
-     //Note: All messages will allocate at least enough for a null terminator
-     //so this will always be in-bounds
-     if (message) {
-      message[0] = '\00';
-     }
+     release();
     }
 
     //Copies cstring
     constexpr ErrorMessage& from(char const * str) noexcept {
-     auto len = cstrlen(str);
+     auto const len = cstrlen(str);
      //Reallocate buffer if it is not large enough
-     if (len > size || !message) {
-      delete[] message;
+     //Note: `+1` for null terminator
+     if (len + 1 > size) {
+      release();
       message = new char[len + 1];
-      size = len;
+      size = len + 1;
      }
      //Copy message contents
-     cstrcpy(message, str, len);
+     cstrcpy(const_cast<char *>(message), str, len);
+     return *this;
+    }
+
+    //References cstring with static storage duration
+    constexpr ErrorMessage& reference(char const * str) noexcept {
+     release();
+     message = str;
      return *this;
     }
    #elif defined(CX_ERROR_MSG_BUF)
-    //Constexpr-compatible non-allocating message impl
+    //Constexpr-compatible non-allocating message impl. String literals are
+    //referenced rather than copied
+    SizeType size;
+    char const * literal;
     char message[CX_ERROR_MSG_BUF];
 
     //Default constructor
     constexpr ErrorMessage() noexcept :
      size{0},
+     literal{nullptr},
      message{0}
     {}
 
-    //Constexpr cstring copy constructor
+    //Constexpr cstring literal constructor
     template<SizeType N>
     constexpr ErrorMessage(char const(&message)[N]) noexcept :
      size{N},
+     literal{message},
      message{0}
-    {
-     //Copy message contents
-     cstrcpy(this->message, message, CX_ERROR_MSG_BUF);
-    }
+    {}
 
     //Constexpr copy constructor
     constexpr ErrorMessage(ErrorMessage const& other) noexcept :
      size{0},
+     literal{nullptr},
      message{0}
     {
      mut().operator=((ErrorMessage const&)other);
@@ -218,6 +331,7 @@ namespace CX {
     //Constexpr move constructor
     constexpr ErrorMessage(ErrorMessage&& other) noexcept :
      size{0},
+     literal{nullptr},
      message{0}
     {
      mut().operator=((ErrorMessage&&)other);
@@ -229,7 +343,11 @@ namespace CX {
     //Constexpr copy-assignment operator
     constexpr ErrorMessage& operator=(ErrorMessage const& other) noexcept {
      size = other.size;
-     cstrcpy(message, other.message, CX_ERROR_MSG_BUF - 1);
+     literal = other.literal;
+     //Only copy buffer contents for non-literal messages
+     if (!literal && CX_ERROR_MSG_BUF > 0) {
+      cstrcpy(message, other.message, CX_ERROR_MSG_BUF - 1);
+     }
      return *this;
     }
 
@@ -242,6 +360,7 @@ namespace CX {
 
     //Resets stored message
     constexpr void reset() noexcept {
+     literal = nullptr;
      if constexpr (CX_ERROR_MSG_BUF > 0) {
       message[0] = '\00';
      }
@@ -249,11 +368,20 @@ namespace CX {
 
     //Copies cstring
     constexpr ErrorMessage& from(char const * str) noexcept {
-     auto len = cstrlen(str);
-     if (len > CX_ERROR_MSG_BUF - 1) {
-      len = CX_ERROR_MSG_BUF - 1;
+     literal = nullptr;
+     if constexpr (CX_ERROR_MSG_BUF > 0) {
+      auto len = cstrlen(str);
+      if (len > CX_ERROR_MSG_BUF - 1) {
+       len = CX_ERROR_MSG_BUF - 1;
+      }
+      cstrcpy(message, str, len);
      }
-     cstrcpy(message, str, len);
+     return *this;
+    }
+
+    //References cstring with static storage duration
+    constexpr ErrorMessage& reference(char const * str) noexcept {
+     literal = str;
      return *this;
     }
    #else
@@ -267,15 +395,23 @@ namespace CX {
     constexpr ErrorMessage& from(char const *) noexcept {
      return *this;
     }
+
+    //nop stub
+    constexpr ErrorMessage& reference(char const *) noexcept {
+     return *this;
+    }
    #endif //CX_ERROR_MSG_ALLOC
 
    //Returns cstring message
    constexpr char const * get() const noexcept {
     #if defined(CX_ERROR_MSG_BUF)
+     if (literal) {
+      return literal;
+     }
      if (CX_ERROR_MSG_BUF > 0 && message[0]) {
       return message;
      }
-    #elif defined(CX_ERROR_MSG_ALLOC)
+    #elif defined(CX_ERROR_MSG_ALLOC) || defined(CX_ERROR_MSG_STATIC)
      return message;
     #endif //defined(CX_ERROR_MSG_BUF)
     return nullptr;
@@ -297,7 +433,10 @@ namespace CX {
    Message message{};
   #endif //CX_ERROR_MSG
   #ifdef CX_ERROR_TRACE
-   Error * prev = nullptr;
+   //Handle of the cause's trace frame; the id of the recording thread's
+   //ring in the upper 32 bits and the frame's sequence number in the lower
+   //32 bits. `0` if there is no cause
+   unsigned long long trace = 0;
   #endif //CX_ERROR_TRACE
 
   //Causes `sizeof(Error) == 0` when compiling without error messages or
@@ -312,10 +451,29 @@ namespace CX {
   constexpr Error(Message&& message) noexcept {
    (void)message;
    #ifdef CX_ERROR_MSG
-    mut().message = message;
+    mut().message = (Message&&)message;
    #endif
   }
 
+  //Returns the message of an error-like object; static descriptions are
+  //referenced and other descriptions are copied. `CX_ERROR_MSG_STATIC`
+  //cannot copy descriptions, so other descriptions are replaced with a
+  //placeholder rather than referenced
+  template<IsError E>
+  static constexpr Message messageOf(E const& error) noexcept {
+   Message message;
+   if constexpr (ErrorMetaFunctions::StaticDescription<E>) {
+    message.reference(error.describe());
+   } else {
+    #ifdef CX_ERROR_MSG_STATIC
+     message.reference("(non-static error description)");
+    #else
+     message.from(error.describe());
+    #endif //CX_ERROR_MSG_STATIC
+   }
+   return message;
+  }
+
  public:
   //Default constructor
   constexpr Error() noexcept = default;
@@ -329,30 +487,45 @@ namespace CX {
    #endif
   }
 
-  //User supplied message and cause constructor
+  //User supplied message and cause constructor. With `CX_ERROR_TRACE`,
+  //`error` is recorded in the current thread's trace ring along with
+  //`location` and, if `error` has a `code()` member, its code
   template<SizeType N>
-  constexpr Error(char const(&message)[N], IsError auto const& error) noexcept
-  {
+  constexpr Error(
+   char const(&message)[N],
+   IsError auto const& error,
+   ErrorLocation const location = ErrorLocation::current()
+  ) noexcept {
    auto& ref = mut();
    //Silence `unused` errors when compiling without messages or tracing
    (void)message;
    (void)error;
+   (void)location;
    (void)ref;
    #ifdef CX_ERROR_MSG
     ref.message = message;
    #endif //CX_ERROR_MSG
    #ifdef CX_ERROR_TRACE
-    using EType = Unqualified<decltype(error)>;
-    if constexpr (SameType<Error, EType>) {
-     //Copy construct error
-     ref.prev = new Error{(EType const&)error};
-    } else {
-     //Create error from error-like object
-     //TODO check for `error.describe()` prototype and prefer
-     //`ErrorMessage::ErrorMessage(char const(&)[N])` constructor over
-     //`ErrorMessage::from(char const *)` to optimize error message
-     //initialization
-     ref.prev = new Error{Message{}.from(error.describe())};
+    //Trace frames are not recorded in constant-evaluated contexts
+    if (!isConstexpr()) {
+     long long code = 0;
+     bool hasCode = false;
+     if constexpr (requires { (long long)error.code(); }) {
+      code = (long long)error.code();
+      hasCode = true;
+     }
+     using EType = Unqualified<decltype(error)>;
+     if constexpr (SameType<Error, EType>) {
+      ref.trace = Internal::recordErrorTrace(error, location, code, hasCode);
+     } else {
+      //Create error from error-like object
+      ref.trace = Internal::recordErrorTrace(
+       Error{messageOf(error)},
+       location,
+       code,
+       hasCode
+      );
+     }
     }
    #endif //CX_ERROR_TRACE
   }
@@ -362,25 +535,29 @@ namespace CX {
    mut().operator=((decltype(error) const&)error);
   }
 
-  //Error copy constructor
-  //Note: Does not support user defined errors
-  constexpr Error(Error const& error) noexcept {
-   mut().operator=((Error const&)error);
-  }
+  #ifdef CX_ERROR_TRIVIAL
+   //Trivial copy and move operations; errors do not own their messages
+   constexpr Error(Error const&) noexcept = default;
+   constexpr Error(Error&&) noexcept = default;
+   constexpr ~Error() noexcept = default;
+  #else
+   //Error copy constructor
+   //Note: Does not support user defined errors
+   constexpr Error(Error const& error) noexcept {
+    mut().operator=((Error const&)error);
+   }
 
-  //Error move constructor
-  //Note: Does not support user defined errors
-  constexpr Error(Error&& error) noexcept {
-   mut().operator=((Error&&)error);
-  }
+   //Error move constructor
+   //Note: Does not support user defined errors
+   constexpr Error(Error&& error) noexcept {
+    mut().operator=((Error&&)error);
+   }
 
-  constexpr ~Error() noexcept {
-   //Suppress "private member is unused" errors
-   (void)unused;
-   #ifdef CX_ERROR_TRACE
-    delete prev;
-   #endif //CX_ERROR_TRACE
-  }
+   constexpr ~Error() noexcept {
+    //Suppress "private member is unused" errors
+    (void)unused;
+   }
+  #endif //CX_ERROR_TRIVIAL
 
   //Error copy-assignment operator
   //Note: Supports user defined errors
@@ -390,50 +567,48 @@ namespace CX {
     operator=((Error const&)error);
    } else {
     //Copy user error message
-    //TODO check for `error.describe()` prototype and prefer
-    //`ErrorMessage::ErrorMessage(char const(&)[N])` constructor over
-    //`ErrorMessage::from(char const *)` to optimize error message
-    //initialization
     #ifdef CX_ERROR_MSG
-     message.from(error.describe());
+     message = messageOf(error);
     #endif //CX_ERROR_MSG
    }
    return *this;
   }
 
-  //Error copy-assignment operator
-  constexpr Error& operator=(Error const& error) noexcept {
-   //Silence `unused` errors when compiling without messages or tracing
-   (void)error;
-   //Copy error message
-   #ifdef CX_ERROR_MSG
-    message = (Message const&)error.message;
-   #endif //CX_ERROR_MSG
-   //Copy error cause, if present
-   #ifdef CX_ERROR_TRACE
-    if (error.prev) {
-     prev = new Error{*error.prev};
-    }
-   #endif //CX_ERROR_TRACE
-   return *this;
-  }
+  #ifdef CX_ERROR_TRIVIAL
+   constexpr Error& operator=(Error const&) noexcept = default;
+   constexpr Error& operator=(Error&&) noexcept = default;
+  #else
+   //Error copy-assignment operator
+   constexpr Error& operator=(Error const& error) noexcept {
+    //Silence `unused` errors when compiling without messages or tracing
+    (void)error;
+    //Copy error message
+    #ifdef CX_ERROR_MSG
+     message = (Message const&)error.message;
+    #endif //CX_ERROR_MSG
+    //Copy error cause
+    #ifdef CX_ERROR_TRACE
+     trace = error.trace;
+    #endif //CX_ERROR_TRACE
+    return *this;
+   }
 
-  //Error move-assignment operator
-  //Note: Does not support user defined errors
-  constexpr Error& operator=(Error&& error) noexcept {
-   //Silence `unused` errors when compiling without messages or tracing
-   (void)error;
-   //Move error message
-   #ifdef CX_ERROR_MSG
-    message = (Message&&)error.message;
-   #endif
-   //Move error cause
-   #ifdef CX_ERROR_TRACE
-    prev = error.prev;
-    error.prev = nullptr;
-   #endif
-   return *this;
-  }
+   //Error move-assignment operator
+   //Note: Does not support user defined errors
+   constexpr Error& operator=(Error&& error) noexcept {
+    //Silence `unused` errors when compiling without messages or tracing
+    (void)error;
+    //Move error message
+    #ifdef CX_ERROR_MSG
+     message = (Message&&)error.message;
+    #endif
+    //Copy error cause; trace frames are not owned by errors
+    #ifdef CX_ERROR_TRACE
+     trace = error.trace;
+    #endif
+    return *this;
+   }
+  #endif //CX_ERROR_TRIVIAL
 
   //Returns the error message
   //Note: When building without `CX_ERROR_MSG`, returns nullptr
@@ -445,12 +620,100 @@ namespace CX {
    #endif //CX_ERROR_MSG
   }
 
-  constexpr Error * cause() const noexcept {
+  //Returns the trace frame recording the error's cause
+  //Note: When building without `CX_ERROR_TRACE`, when the frame has been
+  //overwritten, or when the error was created on another thread, returns
+  //nullptr
+  constexpr ErrorTraceFrame const * causeFrame() const noexcept {
    #ifdef CX_ERROR_TRACE
-    return prev;
-   #else
-    return nullptr;
+    if (!isConstexpr()) {
+     return Internal::findErrorTrace(trace);
+    }
    #endif //CX_ERROR_TRACE
+   return nullptr;
   }
+
+  //Returns the error's cause
+  //Note: See `causeFrame()` for when this returns nullptr
+  constexpr Error const * cause() const noexcept;
  };
+
+ //Cause recorded in a thread's error trace ring
+ struct ErrorTraceFrame final {
+  //The cause
+  Error error;
+  //Location at which the cause was wrapped
+  ErrorLocation location;
+  //Code of the cause; only valid if `hasCode`
+  long long code = 0;
+  bool hasCode = false;
+  //Sequence number of the frame; `0` if the frame is unused
+  unsigned sequence = 0;
+ };
+
+ constexpr Error const * Error::cause() const noexcept {
+  auto const frame = causeFrame();
+  return frame ? &frame->error : nullptr;
+ }
+
+ #ifdef CX_ERROR_TRACE
+  namespace Internal {
+   //Thread-local ring of error trace frames; the oldest frames are
+   //overwritten once the ring is full
+   struct ErrorTraceRing final {
+    ErrorTraceFrame frames[CX_ERROR_TRACE_FRAMES];
+    //Sequence number of the next frame; sequence numbers skip `0`
+    unsigned next = 1;
+    //Process-unique id of the ring, assigned when its first frame is
+    //recorded; `0` until then
+    unsigned id = 0;
+   };
+
+   //Number of trace rings that have been assigned an id
+   inline unsigned errorTraceRings = 0;
+
+   //Returns the current thread's trace ring
+   inline ErrorTraceRing& errorTraceRing() noexcept {
+    static thread_local ErrorTraceRing ring;
+    return ring;
+   }
+
+   inline unsigned long long recordErrorTrace(
+    Error const& cause,
+    ErrorLocation const& location,
+    long long const code,
+    bool const hasCode
+   ) noexcept {
+    auto& ring = errorTraceRing();
+    //Ring ids skip `0`, so that no handle is `0`
+    while (!ring.id) {
+     ring.id = __atomic_add_fetch(&errorTraceRings, 1, __ATOMIC_RELAXED);
+    }
+    auto const sequence = ring.next++;
+    if (!ring.next) {
+     ring.next = 1;
+    }
+    auto& frame = ring.frames[sequence % CX_ERROR_TRACE_FRAMES];
+    frame.error = cause;
+    frame.location = location;
+    frame.code = code;
+    frame.hasCode = hasCode;
+    frame.sequence = sequence;
+    return (unsigned long long)ring.id << 32 | sequence;
+   }
+
+   inline ErrorTraceFrame const * findErrorTrace(
+    unsigned long long const trace
+   ) noexcept {
+    auto const& ring = errorTraceRing();
+    //Frames recorded by other threads are not resolved
+    if (!trace || (unsigned)(trace >> 32) != ring.id) {
+     return nullptr;
+    }
+    auto const sequence = (unsigned)trace;
+    auto const& frame = ring.frames[sequence % CX_ERROR_TRACE_FRAMES];
+    return frame.sequence == sequence ? &frame : nullptr;
+   }
+  }
+ #endif //CX_ERROR_TRACE
 }
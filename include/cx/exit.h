@@ -15,12 +15,40 @@
 #endif //CX_EXIT_HANDLER
 
 //Sanitize `CX_EXIT_HANDLER` flag
-#if CX_EXIT_HANDLER < 0 || CX_EXIT_HANDLER > 2
+#if CX_EXIT_HANDLER < 0 || CX_EXIT_HANDLER > 3
  #error `CX_EXIT_HANDLER` is set to an invalid value. The possible values are:\
   0 - Use STL exit handler;\
   1 - Use LIBC exit handler;\
-  2 - Use user-defined exit handler
+  2 - Use user-defined exit handler;\
+  3 - Use async-signal-safe POSIX exit handler
 #endif
+#if CX_EXIT_HANDLER == 0 && !defined(CX_STL_SUPPORT)
+ #error `CX_EXIT_HANDLER` 0 requires STL support.
+#endif
+#if (CX_EXIT_HANDLER == 1 || CX_EXIT_HANDLER == 3) \
+ && !defined(CX_LIBC_SUPPORT)
+ #error `CX_EXIT_HANDLER` 1 and 3 require libc support.
+#endif
+
+//Flags to configure error reports. Reports are formatted into a stack
+//buffer of `CX_EXIT_REPORT_BUFFER` bytes and truncated if they do not fit.
+//With the POSIX exit handler, `CX_EXIT_REPORT_TIMESTAMP` prefixes reports
+//with a monotonic timestamp and `CX_EXIT_REPORT_BACKTRACE` appends up to
+//`CX_EXIT_REPORT_BACKTRACE_DEPTH` return addresses
+#ifndef CX_EXIT_REPORT_BUFFER
+ #define CX_EXIT_REPORT_BUFFER 4096
+#endif //CX_EXIT_REPORT_BUFFER
+
+//Sanitize `CX_EXIT_REPORT_BUFFER` flag
+#if CX_EXIT_REPORT_BUFFER < 2
+ #error `CX_EXIT_REPORT_BUFFER` must be >= 2
+#endif //CX_EXIT_REPORT_BUFFER < 2
+
+#ifdef CX_EXIT_REPORT_BACKTRACE
+ #ifndef CX_EXIT_REPORT_BACKTRACE_DEPTH
+  #define CX_EXIT_REPORT_BACKTRACE_DEPTH 32
+ #endif //CX_EXIT_REPORT_BACKTRACE_DEPTH
+#endif //CX_EXIT_REPORT_BACKTRACE
 
 //Debug msg for the exit handler being used
 #if CX_EXIT_HANDLER == 0
@@ -33,6 +61,8 @@
   defined an implementation of `void CX::userDefinedExit(Error const&)`, \
   you will encounter linker errors.
  ))
+#elif CX_EXIT_HANDLER == 3
+ CX_DEBUG_MSG((`CX::exit(...)` using POSIX exit handler))
 #endif
 
 //Temporarily disable exception keyword shadowing to avoid breaking STL/libc
@@ -55,6 +85,19 @@
  #include <cstdio>
 #endif
 
+//Conditional POSIX dependencies for the POSIX exit handler
+#if CX_EXIT_HANDLER == 3
+ #include <cerrno>
+ #include <cstdlib>
+ #include <unistd.h>
+ #ifdef CX_EXIT_REPORT_TIMESTAMP
+  #include <time.h>
+ #endif //CX_EXIT_REPORT_TIMESTAMP
+ #ifdef CX_EXIT_REPORT_BACKTRACE
+  #include <execinfo.h>
+ #endif //CX_EXIT_REPORT_BACKTRACE
+#endif //CX_EXIT_HANDLER == 3
+
 //Re-enable exception keyword shadowing
 #ifndef CX_NO_BELLIGERENT_ERRORS
  //Disable clang warnings about macros shadowing keywords
@@ -87,43 +130,195 @@
 namespace CX {
  //Utilities for universal exit function (see below)
  namespace Internal {
-  //TODO refactor
+  //Fixed-capacity error report buffer; appends are truncated once the
+  //buffer is full. Does not allocate and is async-signal-safe
+  struct ErrorReport final {
+   char * data;
+   SizeType capacity;
+   SizeType length = 0;
+   bool truncated = false;
+
+   //Appends `str`
+   ErrorReport& append(char const * str) noexcept {
+    while (*str) {
+     if (length == capacity) {
+      truncated = true;
+      break;
+     }
+     data[length++] = *str++;
+    }
+    return *this;
+   }
+
+   //Appends `value` in base `base`, zero-padded to `minDigits` digits.
+   //Appends nothing if `base` is not in `[2, 16]`; `minDigits` is clamped to
+   //64 digits
+   ErrorReport& append(
+    unsigned long long value,
+    unsigned const base = 10,
+    SizeType minDigits = 1
+   ) noexcept {
+    if (base < 2 || base > 16) {
+     return *this;
+    }
+    //Note: Enough digits for a 64-bit value in base 2
+    char digits[64];
+    if (minDigits > sizeof(digits)) {
+     minDigits = sizeof(digits);
+    }
+    SizeType count = 0;
+    do {
+     digits[count++] = "0123456789abcdef"[value % base];
+     value /= base;
+    } while (value || count < minDigits);
+    char reversed[65];
+    for (SizeType i = 0; i < count; i++) {
+     reversed[i] = digits[count - 1 - i];
+    }
+    reversed[count] = '\00';
+    return append((char const *)reversed);
+   }
+
+   //Appends signed `value` in base 10
+   ErrorReport& append(long long const value) noexcept {
+    if (value < 0) {
+     append("-");
+     return append(0ull - (unsigned long long)value);
+    }
+    return append((unsigned long long)value);
+   }
+
+   //Terminates the report with a newline, replacing the last character if
+   //the report was truncated
+   SizeType finish() noexcept {
+    if (truncated) {
+     data[capacity - 1] = '\n';
+    }
+    return length;
+   }
+  };
+
+  //Formats `err`, invoked from `CX::<funcName>(...)`, and its causes
+  inline void formatError(
+   ErrorReport& report,
+   char const * const funcName,
+   Error const& err
+  ) noexcept {
+   Error const * cause = &err;
+   while (cause) {
+    auto const msg = cause->describe();
+    if (cause == &err) {
+     //Handle formatting of first error
+     report.append("`CX::").append(funcName);
+     if (!msg) {
+      report.append("(...)` invoked without an error\n");
+     } else {
+      report
+       .append("(...)` invoked with error:\n")
+       .append(msg)
+       .append("\n");
+     }
+    } else {
+     //Handle formatting of all causes
+     report
+      .append("Caused by: ")
+      .append(msg ? msg : "(no message)")
+      .append("\n");
+    }
+    #ifdef CX_ERROR_TRACE
+     //Format where the next cause was wrapped, and its code
+     auto const frame = cause->causeFrame();
+     if (frame) {
+      auto const& location = frame->location;
+      report
+       .append("Wrapped at ")
+       .append(location.file ? location.file : "(unknown)")
+       .append(":")
+       .append((unsigned long long)location.line)
+       .append(" (")
+       .append(location.function ? location.function : "(unknown)")
+       .append(")\n");
+      if (frame->hasCode) {
+       report.append("Cause code: ").append(frame->code).append("\n");
+      }
+     }
+     cause = frame ? &frame->error : nullptr;
+    #else
+     cause = cause->cause();
+    #endif //CX_ERROR_TRACE
+   }
+  }
+
+  //Prints `err`, invoked from `CX::<funcName>(...)`, and its causes to
+  //`stderr` with a single write
   inline void printError(char const * funcName, Error const &err) {
    (void)funcName;
    (void)err;
    #if defined(CX_STL_SUPPORT) || defined(CX_LIBC_SUPPORT)
-    Error const * cause = &err;
-    while (cause) {
-     char const
-      * msg = cause->describe(),
-      * fmt;
-     #ifdef CX_COMPILER_MSVC
-      #pragma warning(push)
-      #pragma warning(disable : 4774)
-     #endif
-     if (cause == &err) {
-      //Handle formatting of first error
-      if (!msg) {
-       fmt = "\"CX::%s(...)\" invoked without an error\n";
-      } else {
-       fmt = "\"CX::%s(...)\" invoked with error:\n%s\n";
-      }
-     } else {
-      //Handle formatting of all causes
-      if (!msg) {
-       fmt = "Caused by: (no message)\n";
-      } else {
-       fmt = "Caused by: %s\n";
+    char buffer[CX_EXIT_REPORT_BUFFER];
+    ErrorReport report{buffer, sizeof(buffer)};
+    formatError(report, funcName, err);
+    fwrite(buffer, 1, report.finish(), stderr);
+    fflush(stderr);
+   #endif
+  }
+
+  #if CX_EXIT_HANDLER == 3
+   //Writes a report of `err`, invoked from `CX::<funcName>(...)`, to
+   //`STDERR_FILENO` with a single `write(2)`. Does not allocate and is
+   //async-signal-safe, with the exception of the first backtrace with
+   //`CX_EXIT_REPORT_BACKTRACE`, which may load the unwinder
+   inline void reportError(char const * funcName, Error const& err) noexcept {
+    char buffer[CX_EXIT_REPORT_BUFFER];
+    ErrorReport report{buffer, sizeof(buffer)};
+    #ifdef CX_EXIT_REPORT_TIMESTAMP
+     //Prefix report with monotonic timestamp
+     timespec now;
+     if (clock_gettime(CLOCK_MONOTONIC, &now) == 0) {
+      report
+       .append("[")
+       .append((unsigned long long)now.tv_sec)
+       .append(".")
+       .append((unsigned long long)now.tv_nsec, 10, 9)
+       .append("] ");
+     }
+    #endif //CX_EXIT_REPORT_TIMESTAMP
+    formatError(report, funcName, err);
+    #ifdef CX_EXIT_REPORT_BACKTRACE
+     //Append return addresses; symbolize with `addr2line`
+     void * frames[CX_EXIT_REPORT_BACKTRACE_DEPTH];
+     auto const depth = backtrace(frames, CX_EXIT_REPORT_BACKTRACE_DEPTH);
+     report.append("Backtrace:\n");
+     for (int i = 0; i < depth; i++) {
+      report
+       .append(" #")
+       .append((unsigned long long)i)
+       .append(" 0x")
+       .append((unsigned long long)frames[i], 16)
+       .append("\n");
+     }
+    #endif //CX_EXIT_REPORT_BACKTRACE
+    //Write report, resuming after interruptions and partial writes
+    auto const length = report.finish();
+    SizeType written = 0;
+    auto const savedErrno = errno;
+    while (written < length) {
+     auto const result = ::write(
+      STDERR_FILENO,
+      buffer + written,
+      length - written
+     );
+     if (result < 0) {
+      if (errno == EINTR) {
+       continue;
       }
+      break;
      }
-     fprintf(stderr, fmt, funcName, msg);
-     #ifdef CX_COMPILER_MSVC
-      #pragma warning(pop)
-     #endif
-     cause = cause->cause();
+     written += (SizeType)result;
     }
-   #endif
-  }
+    errno = savedErrno;
+   }
+  #endif //CX_EXIT_HANDLER == 3
  }
 
  struct NoneExitError final {
@@ -140,14 +335,14 @@ namespace CX {
 
  //Returns the default exit handler
  inline constexpr auto defaultExitHandler() noexcept {
-  #ifdef CX_STL_SUPPORT
+  #if CX_EXIT_HANDLER == 0
    //STL exit handler
    return +[](Error const &err) {
     (void)err;
     Internal::printError("exit", err);
     std::terminate();
    };
-  #elif defined(CX_LIBC_SUPPORT)
+  #elif CX_EXIT_HANDLER == 1
    //libc exit handler
    CX_DEBUG_MSG("CX_LIBC_SUPPORT" enabled; using libc exit handler)
    return +[](Error const &err) {
@@ -155,6 +350,12 @@ namespace CX {
     Internal::printError("exit", err);
     abort();
    };
+  #elif CX_EXIT_HANDLER == 3
+   //POSIX exit handler; safe to invoke from signal handlers
+   return +[](Error const &err) {
+    Internal::reportError("exit", err);
+    abort();
+   };
   #else
    //User-defined exit handler
    return userDefinedExit;
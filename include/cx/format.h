@@ -0,0 +1,516 @@
+#pragma once
+
+//Floating point conversions are delegated to libc
+//Note: Included before any CX headers since STL headers depend on exceptions.
+#ifdef CX_LIBC_SUPPORT
+ #include <cstdio>
+#endif
+
+#include <cx/common.h>
+#include <cx/idioms.h>
+#include <cx/tuple.h>
+#include <cx/vararg.h>
+#include <cx/lambda.h>
+
+//Compile-time checked printf-style formatting. Format strings are parsed
+//during compilation, checked against the types of their arguments and
+//compiled into a formatting routine specific to the format string
+namespace CX {
+ //Supporting meta-functions for `CX::format`
+ namespace FormatMetaFunctions {
+  using Internal::FormatArgumentType;
+  using Internal::FormatConversion;
+  using Internal::FormatNone;
+  using Internal::FormatStar;
+
+  //Whether an argument of type `Argument`, passed through a c-variadic
+  //call, may be read as `Expected`. Integers may differ in signedness but
+  //not in size; `%s` accepts any character pointer and `%p` any pointer
+  template<typename Expected, typename Argument>
+  constexpr bool compatible() noexcept {
+   using Promoted = Internal::VarargPromoted<Argument>;
+   using ExpectedPromoted = Internal::VarargPromoted<Expected>;
+   if constexpr (SameType<Promoted, ExpectedPromoted>) {
+    return true;
+   } else if constexpr (Integral<Promoted> && Integral<ExpectedPromoted>) {
+    return sizeof(Promoted) == sizeof(ExpectedPromoted)
+     && !SameType<Promoted, bool>;
+   } else if constexpr (SameType<Expected, char const *>) {
+    return SameType<Argument, char *> || SameType<Argument, NullptrType>;
+   } else if constexpr (SameType<Expected, void const *>) {
+    return Pointer<Argument> || SameType<Argument, NullptrType>;
+   } else {
+    return false;
+   }
+  }
+
+  template<auto Signature, typename Indices, typename... Args>
+  struct FormatMatcher;
+
+  template<auto Signature, SizeType... Indices, typename... Args>
+  struct FormatMatcher<Signature, IndexSequence<Indices...>, Args...> final {
+   static constexpr bool const Value = (compatible<
+    FormatArgumentType<Signature.arguments[Indices]>,
+    Args
+   >() && ...);
+  };
+
+  //Whether `Args` match the arguments of `Format`, in number and type
+  template<FormatString Format, typename... Args>
+  constexpr bool matches() noexcept {
+   constexpr auto const& Signature = Internal::FormatSignatureOf<Format>;
+   if constexpr (!Signature.valid || Signature.count != sizeof...(Args)) {
+    return false;
+   } else {
+    return FormatMatcher<
+     Internal::FormatSignatureOf<Format>,
+     MakeIndexSequence<sizeof...(Args)>,
+     Args...
+    >::Value;
+   }
+  }
+
+  //Whether the arguments of `Args` from `Offset` onwards match `Format`
+  template<FormatString Format, SizeType Offset, typename... Args>
+  constexpr bool matchesFrom() noexcept {
+   if constexpr (sizeof...(Args) < Offset) {
+    return false;
+   } else {
+    return []<SizeType... Indices>(IndexSequence<Indices...>) constexpr {
+     return matches<Format, TypeAtIndex<Offset + Indices, Args...>...>();
+    }(MakeIndexSequence<sizeof...(Args) - Offset>{});
+   }
+  }
+
+  //Number of fixed parameters of a lambda prototype
+  template<typename... Args>
+  struct ParameterCount final {
+   static constexpr SizeType const Value = sizeof...(Args);
+  };
+
+  //Whether the last fixed parameter of a lambda prototype is a format string
+  template<typename... Args>
+  struct FormatParameter final {
+   static constexpr bool const Value = [] {
+    if constexpr (sizeof...(Args) == 0) {
+     return false;
+    } else {
+     return SameType<TypeAtIndex<sizeof...(Args) - 1, Args...>, char const *>;
+    }
+   }();
+  };
+
+  //Bounded output buffer; tracks the untruncated length
+  struct FormatOutput final {
+   char * const buffer;
+   SizeType const size;
+   SizeType length;
+
+   [[gnu::always_inline]]
+   void write(char const c) noexcept {
+    if (length + 1 < size) {
+     buffer[length] = c;
+    }
+    length++;
+   }
+
+   [[gnu::always_inline]]
+   void write(char const * const text, SizeType const count) noexcept {
+    if (length + 1 < size) {
+     auto const available = size - 1 - length;
+     __builtin_memcpy(
+      buffer + length,
+      text,
+      count < available ? count : available
+     );
+    }
+    length += count;
+   }
+
+   void fill(char const c, SizeType count) noexcept {
+    while (count--) {
+     write(c);
+    }
+   }
+
+   //Terminates the buffer and returns the untruncated length
+   SizeType finish() noexcept {
+    if (size) {
+     buffer[length < size ? length : size - 1] = '\0';
+    }
+    return length;
+   }
+  };
+
+  //Writes `content` padded to `width`
+  template<typename Content>
+  [[gnu::always_inline]]
+  inline void pad(
+   FormatOutput& out,
+   SizeType const length,
+   int const width,
+   bool const left,
+   Content content
+  ) noexcept {
+   auto const padding = width > 0 && (SizeType)width > length
+    ? (SizeType)width - length
+    : 0;
+   if (!left) {
+    out.fill(' ', padding);
+   }
+   content();
+   if (left) {
+    out.fill(' ', padding);
+   }
+  }
+
+  //Formats an integral of magnitude `magnitude`
+  template<FormatConversion Conversion>
+  inline void formatIntegral(
+   FormatOutput& out,
+   unsigned long long magnitude,
+   bool const negative,
+   int const width,
+   bool const left,
+   int const precision
+  ) noexcept {
+   constexpr auto const Base = Conversion.conversion == 'o'
+    ? 8u
+    : (Conversion.conversion == 'x'
+     || Conversion.conversion == 'X'
+     || Conversion.conversion == 'p'
+    ) ? 16u : 10u;
+   constexpr char const * const Digits = Conversion.conversion == 'X'
+    ? "0123456789ABCDEF"
+    : "0123456789abcdef";
+   constexpr bool const Signed = Conversion.conversion == 'd'
+    || Conversion.conversion == 'i';
+
+   char digits[24];
+   SizeType count = 0;
+   auto const zero = magnitude == 0;
+   while (magnitude) {
+    digits[count++] = Digits[magnitude % Base];
+    magnitude /= Base;
+   }
+
+   //Precision is the minimum number of digits
+   auto const minimum = precision < 0 ? (SizeType)1 : (SizeType)precision;
+   auto zeros = count < minimum ? minimum - count : 0;
+   char prefix[2];
+   SizeType prefixLength = 0;
+   if constexpr (Signed) {
+    if (negative) {
+     prefix[prefixLength++] = '-';
+    } else if (Conversion.plus) {
+     prefix[prefixLength++] = '+';
+    } else if (Conversion.space) {
+     prefix[prefixLength++] = ' ';
+    }
+   } else if constexpr (Conversion.alternate && Base == 16) {
+    if (!zero || Conversion.conversion == 'p') {
+     prefix[prefixLength++] = '0';
+     prefix[prefixLength++] = Conversion.conversion == 'X' ? 'X' : 'x';
+    }
+   } else if constexpr (Conversion.alternate && Base == 8) {
+    if (!zeros) {
+     zeros = 1;
+    }
+   }
+
+   auto const length = prefixLength + zeros + count;
+   if (!left && Conversion.zero && precision < 0) {
+    out.write(prefix, prefixLength);
+    out.fill(
+     '0',
+     width > 0 && (SizeType)width > length ? (SizeType)width - length : 0
+    );
+    out.fill('0', zeros);
+    while (count) {
+     out.write(digits[--count]);
+    }
+    return;
+   }
+   pad(out, length, width, left, [&] {
+    out.write(prefix, prefixLength);
+    out.fill('0', zeros);
+    while (count) {
+     out.write(digits[--count]);
+    }
+   });
+  }
+
+  //Copy of the specification of conversion `Index` of `Format`
+  template<FormatString Format, SizeType Index>
+  struct Specification final {
+   static constexpr auto const& Conversion = Internal
+    ::FormatSignatureOf<Format>
+    .conversions[Index];
+
+   static constexpr auto const Value = [] {
+    struct {
+     char data[Conversion.specificationLength + 1];
+    } specification{};
+    for (SizeType i = 0; i < Conversion.specificationLength; i++) {
+     specification.data[i] = Format.data[Conversion.specification + i];
+    }
+    return specification;
+   }();
+  };
+
+  //Formats conversion `Index` of `Format`, preceded by its literal text
+  template<FormatString Format, SizeType Index, typename Arguments>
+  [[gnu::always_inline]]
+  inline void formatConversion(
+   FormatOutput& out,
+   Arguments const& arguments
+  ) noexcept {
+   constexpr auto const Conversion = Internal
+    ::FormatSignatureOf<Format>
+    .conversions[Index];
+   constexpr auto const Value = Conversion.index
+    + (Conversion.width == FormatStar)
+    + (Conversion.precision == FormatStar);
+
+   if constexpr (Conversion.literalLength > 0) {
+    out.write(Format.data + Conversion.literal, Conversion.literalLength);
+   }
+   if constexpr (Conversion.conversion == '%') {
+    out.write('%');
+    return;
+   } else {
+    //Resolve the width and precision; negative widths read from arguments
+    //left-justify and negative precisions read from arguments are ignored
+    int width = Conversion.width;
+    bool left = Conversion.left;
+    if constexpr (Conversion.width == FormatStar) {
+     width = arguments.template get<Conversion.index>();
+     if (width < 0) {
+      left = true;
+      width = width < -(int)(~0u >> 1) ? (int)(~0u >> 1) : -width;
+     }
+    }
+    int precision = Conversion.precision;
+    if constexpr (Conversion.precision == FormatStar) {
+     precision = arguments.template get<Value - 1>();
+     if (precision < 0) {
+      precision = FormatNone;
+     }
+    }
+
+    auto const value = arguments.template get<Value>();
+    using ValueType = decltype(value);
+    if constexpr (Conversion.conversion == 'c') {
+     pad(out, 1, width, left, [&] {
+      out.write((char)value);
+     });
+    } else if constexpr (Conversion.conversion == 's') {
+     auto const text = value ? value : "(null)";
+     SizeType length = 0;
+     while ((precision < 0 || length < (SizeType)precision) && text[length]) {
+      length++;
+     }
+     pad(out, length, width, left, [&] {
+      out.write(text, length);
+     });
+    } else if constexpr (Conversion.conversion == 'p') {
+     if (!value) {
+      pad(out, 5, width, left, [&] {
+       out.write("(nil)", 5);
+      });
+     } else {
+      constexpr auto const Pointer = [] {
+       auto pointer = Internal::FormatSignatureOf<Format>.conversions[Index];
+       pointer.alternate = true;
+       pointer.zero = false;
+       pointer.plus = false;
+       pointer.space = false;
+       return pointer;
+      }();
+      formatIntegral<Pointer>(
+       out,
+       (unsigned long long)(SizeType)value,
+       false,
+       width,
+       left,
+       precision
+      );
+     }
+    } else if constexpr (Integral<ValueType>) {
+     if constexpr (Signed<ValueType>) {
+      auto const negative = value < 0;
+      auto const magnitude = negative
+       ? 0ull - (unsigned long long)value
+       : (unsigned long long)value;
+      formatIntegral<Conversion>(
+       out,
+       magnitude,
+       negative,
+       width,
+       left,
+       precision
+      );
+     } else {
+      formatIntegral<Conversion>(
+       out,
+       (unsigned long long)value,
+       false,
+       width,
+       left,
+       precision
+      );
+     }
+    } else {
+     //Floating point conversions
+     #ifdef CX_LIBC_SUPPORT
+      constexpr auto const& Text = Specification<Format, Index>::Value.data;
+      auto const available = out.length + 1 < out.size
+       ? out.size - out.length
+       : 0;
+      auto const target = available ? out.buffer + out.length : nullptr;
+      int written;
+      if constexpr (
+       Conversion.width == FormatStar
+       && Conversion.precision == FormatStar
+      ) {
+       written = snprintf(
+        target,
+        available,
+        Text,
+        arguments.template get<Conversion.index>(),
+        arguments.template get<Value - 1>(),
+        value
+       );
+      } else if constexpr (
+       Conversion.width == FormatStar
+       || Conversion.precision == FormatStar
+      ) {
+       written = snprintf(
+        target,
+        available,
+        Text,
+        arguments.template get<Value - 1>(),
+        value
+       );
+      } else {
+       written = snprintf(target, available, Text, value);
+      }
+      if (written > 0) {
+       out.length += (SizeType)written;
+      }
+     #else
+      static_assert(
+       !Floating<ValueType>,
+       "Floating point conversions require libc support"
+      );
+     #endif
+    }
+   }
+  }
+
+  template<FormatString Format, typename Arguments, SizeType... Indices>
+  [[gnu::always_inline]]
+  inline SizeType formatAll(
+   FormatOutput& out,
+   Arguments const& arguments,
+   IndexSequence<Indices...>
+  ) noexcept {
+   (formatConversion<Format, Indices>(out, arguments), ...);
+   constexpr auto const& Signature = Internal::FormatSignatureOf<Format>;
+   constexpr auto const Trailing = Format.size() - Signature.trailing;
+   if constexpr (Trailing > 0) {
+    out.write(Format.data + Signature.trailing, Trailing);
+   }
+   return out.finish();
+  }
+ }
+
+ //Format argument concept; satisfied if `Args`, as passed through a
+ //c-variadic call, match the conversions of `Format` in number and type
+ template<FormatString Format, typename... Args>
+ concept FormatMatches = ValidFormat<Format>
+  && FormatMetaFunctions::matches<Format, Args...>();
+
+ //Formats `args` as described by `Format` into `buffer`, of `size` bytes.
+ //Like `snprintf`, output is truncated to `size - 1` characters, terminated
+ //if `size` is non-zero, and the untruncated length is returned. The format
+ //string is not parsed at runtime; floating point conversions are delegated
+ //to `snprintf` with their individual specifications
+ template<FormatString Format, typename... Args>
+ requires FormatMatches<Format, Args...>
+ SizeType format(char * const buffer, SizeType const size, Args... args)
+  noexcept
+ {
+  using namespace FormatMetaFunctions;
+  FormatOutput out{buffer, size, 0};
+  return [&]<SizeType... Indices>(IndexSequence<Indices...>) {
+   return formatAll<Format>(
+    out,
+    FormatArguments<Format>{
+     (FormatArgumentType<
+      Internal::FormatSignatureOf<Format>.arguments[Indices]
+     >)args...
+    },
+    MakeIndexSequence<Internal::FormatSignatureOf<Format>.conversionCount>{}
+   );
+  }(MakeIndexSequence<sizeof...(Args)>{});
+ }
+
+ //Formats the arguments of `Format` read from `list`
+ template<FormatString Format>
+ requires ValidFormat<Format>
+ SizeType format(char * const buffer, SizeType const size, VaList& list)
+  noexcept
+ {
+  FormatMetaFunctions::FormatOutput out{buffer, size, 0};
+  return FormatMetaFunctions::formatAll<Format>(
+   out,
+   decode<Format>(list),
+   MakeIndexSequence<Internal::FormatSignatureOf<Format>.conversionCount>{}
+  );
+ }
+
+ //C-variadic formatting function for `Format`; may be stored in a
+ //`Lambda<SizeType (char *, SizeType, ...)>`
+ template<FormatString Format>
+ requires ValidFormat<Format>
+ SizeType formatVarargs(char * const buffer, SizeType const size, ...)
+  noexcept
+ {
+  VaList list;
+  CX_VA_START(list, size);
+  return format<Format>(buffer, size, list);
+ }
+
+ //Invokes the c-variadic `lambda`, whose last fixed parameter is a format
+ //string, with `Format` as the format string. `args` are the remaining fixed
+ //arguments followed by the c-variadic arguments, which must match `Format`:
+ // Lambda<int (FILE *, char const *, ...)> print = &fprintf;
+ // invokeFormatted<"%s: %d">(print, stderr, name, count);
+ template<FormatString Format, typename L, typename... Args>
+ requires (IsLambda<L>
+  && VariadicFunction<typename L::FunctionType>
+  && L::template ArgumentTypes<FormatMetaFunctions::FormatParameter>::Value
+  && FormatMetaFunctions::matchesFrom<
+   Format,
+   L::template ArgumentTypes<FormatMetaFunctions::ParameterCount>::Value - 1,
+   Args...
+  >()
+ )
+ decltype(auto) invokeFormatted(L& lambda, Args... args) {
+  constexpr SizeType const Fixed = L
+   ::template ArgumentTypes<FormatMetaFunctions::ParameterCount>
+   ::Value - 1;
+  Tuple<Args...> const arguments{args...};
+  return [&]<SizeType... Leading, SizeType... Trailing>(
+   IndexSequence<Leading...>,
+   IndexSequence<Trailing...>
+  ) -> decltype(auto) {
+   return lambda(
+    arguments.template get<Leading>()...,
+    (char const *)Format.data,
+    arguments.template get<Fixed + Trailing>()...
+   );
+  }(MakeIndexSequence<Fixed>{}, MakeIndexSequence<sizeof...(Args) - Fixed>{});
+ }
+}
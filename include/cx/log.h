@@ -0,0 +1,422 @@
+#pragma once
+
+//Dependencies for the background consumer
+//Note: Included before any CX headers since STL headers depend on exceptions.
+#ifdef CX_STL_SUPPORT
+ #include <thread>
+#endif
+
+#include <cx/common.h>
+#include <cx/idioms.h>
+#include <cx/allocator.h>
+#include <cx/bitset.h>
+#include <cx/tuple.h>
+#include <cx/vararg.h>
+#include <cx/format.h>
+
+//Maximum number of threads with a ring buffer in each deferred log; records
+//of threads beyond the limit are dropped
+#ifndef CX_LOG_THREAD_RINGS
+ #define CX_LOG_THREAD_RINGS 64
+#endif
+
+//Size of the ring buffer of each thread, in bytes; must be a power of two
+#ifndef CX_LOG_RING_SIZE
+ #define CX_LOG_RING_SIZE 65536
+#endif
+
+//Maximum length of a formatted record, including the terminator
+#ifndef CX_LOG_LINE_SIZE
+ #define CX_LOG_LINE_SIZE 1024
+#endif
+
+//Deferred logging requires libc for floating point formatting
+#ifdef CX_LIBC_SUPPORT
+namespace CX {
+ //Supporting meta-functions for `CX::DeferredLog`
+ namespace LogMetaFunctions {
+  //Number of thread ring slots
+  constexpr SizeType const ThreadRings = CX_LOG_THREAD_RINGS;
+
+  //Size of each ring buffer, in bytes
+  constexpr SizeType const RingSize = CX_LOG_RING_SIZE;
+  static_assert(
+   RingSize >= 64 && !(RingSize & (RingSize - 1)),
+   "'CX_LOG_RING_SIZE' must be a power of two of at least 64"
+  );
+
+  //Size of the formatting buffer, in bytes
+  constexpr SizeType const LineSize = CX_LOG_LINE_SIZE;
+
+  //Alignment of records within a ring buffer
+  constexpr SizeType const RecordAlignment = sizeof(SizeType);
+
+  //Formats the arguments of a record into `line`; returns the formatted
+  //length, excluding the terminator
+  using Formatter = SizeType (*)(
+   unsigned char const * arguments,
+   char * line
+  ) noexcept;
+
+  //Record header; followed by the captured arguments and copies of their
+  //strings
+  struct RecordHeader final {
+   //Size of the record, including the header; padding at the end of a ring
+   //buffer is marked by the low bit and consists of this field only
+   SizeType size;
+   Formatter formatter;
+   //Static format string; identifies the kind of record
+   char const * format;
+  };
+
+  //Single-producer single-consumer ring buffer of records
+  struct alignas(BitsetMetaFunctions::CacheLineSize) Ring final {
+   //Allocated by the producing thread on its first record
+   unsigned char * data;
+   //Write position; only written by the producing thread
+   SizeType head;
+   //Read position last observed by the producing thread
+   SizeType cachedTail;
+   //Records dropped since the ring buffer was full
+   SizeType dropped;
+   //Read position; only written by the consumer
+   alignas(BitsetMetaFunctions::CacheLineSize) SizeType tail;
+  };
+
+  //Thread ring slot of the calling thread
+  using ThreadSlot = CX::ThreadSlot<Ring, ThreadRings>;
+
+  template<typename>
+  struct PackedArguments;
+
+  template<typename... Types>
+  struct PackedArguments<Tuple<Types...>> final {
+   using Type = PackedTuple<Types...>;
+  };
+
+  //Capture and formatting of records for `Format`. Arguments are stored
+  //in a `PackedTuple`; strings are copied after it, in argument order, up
+  //to their precision and terminated
+  template<FormatString Format>
+  requires ValidFormat<Format>
+  struct Record final {
+   using Arguments = typename PackedArguments<FormatArguments<Format>>::Type;
+
+   //Invokes `op` with the string and length of conversion `Index`, if it
+   //is a non-null `%s` string; the length is bounded by the precision, so
+   //the string is not read past it
+   template<SizeType Index, typename Op>
+   [[gnu::always_inline]]
+   static void visitString(Arguments const& arguments, Op& op) noexcept {
+    constexpr auto const Conversion = Internal
+     ::FormatSignatureOf<Format>
+     .conversions[Index];
+    if constexpr (Conversion.argument == Internal::FormatArgument::STRING) {
+     constexpr auto const Value = Conversion.index
+      + (Conversion.width == Internal::FormatStar)
+      + (Conversion.precision == Internal::FormatStar);
+     char const * const string = arguments.template get<Value>();
+     if (!string) {
+      return;
+     }
+     //Negative precisions read from arguments are ignored
+     int precision = Conversion.precision;
+     if constexpr (Conversion.precision == Internal::FormatStar) {
+      precision = arguments.template get<Value - 1>();
+     }
+     SizeType length = 0;
+     while (
+      (precision < 0 || length < (SizeType)precision) && string[length]
+     ) {
+      length++;
+     }
+     op(string, length);
+    }
+   }
+
+   //Invokes `op` with the string and length of each non-null `%s` string
+   //of `arguments`, in argument order
+   template<typename Op>
+   [[gnu::always_inline]]
+   static void forEachString(Arguments const& arguments, Op op) noexcept {
+    [&]<SizeType... Indices>(IndexSequence<Indices...>) {
+     (visitString<Indices>(arguments, op), ...);
+    }(MakeIndexSequence<Internal::FormatSignatureOf<Format>.conversionCount>{});
+   }
+
+   //Reads the arguments of `Format` from `list`
+   [[gnu::always_inline]]
+   static Arguments capture(VaList& list) noexcept {
+    return apply(
+     [](auto... values) noexcept {
+      return Arguments{values...};
+     },
+     decode<Format>(list)
+    );
+   }
+
+   //Returns the size of the record for `arguments`
+   [[gnu::always_inline]]
+   static SizeType size(Arguments const& arguments) noexcept {
+    SizeType size = sizeof(RecordHeader) + sizeof(Arguments);
+    forEachString(
+     arguments,
+     [&](char const *, SizeType const length) noexcept {
+      size += length + 1;
+     }
+    );
+    return (size + RecordAlignment - 1) & ~(RecordAlignment - 1);
+   }
+
+   //Writes a record of `size` bytes for `arguments` to `record`
+   [[gnu::always_inline]]
+   static void store(
+    unsigned char * const record,
+    SizeType const size,
+    Arguments const& arguments
+   ) noexcept {
+    RecordHeader const header{size, &formatRecord, Format.data};
+    __builtin_memcpy(record, &header, sizeof(header));
+    auto cursor = record + sizeof(RecordHeader);
+    __builtin_memcpy(cursor, &arguments, sizeof(Arguments));
+    cursor += sizeof(Arguments);
+    forEachString(
+     arguments,
+     [&](char const * const string, SizeType const length) noexcept {
+      __builtin_memcpy(cursor, string, length);
+      cursor[length] = '\0';
+      cursor += length + 1;
+     }
+    );
+   }
+
+   //Formats the arguments of a record with the formatting routine compiled
+   //for `Format`; strings refer to their copies
+   static SizeType formatRecord(
+    unsigned char const * const record,
+    char * const line
+   ) noexcept {
+    Arguments arguments;
+    __builtin_memcpy(&arguments, record, sizeof(Arguments));
+    auto strings = (char const *)record + sizeof(Arguments);
+    forEach(arguments, [&](auto& argument) noexcept {
+     if constexpr (SameType<decltype(argument), char const *&>) {
+      if (argument) {
+       argument = strings;
+       strings += __builtin_strlen(strings) + 1;
+      }
+     }
+    });
+    auto const length = apply(
+     [&](auto... values) noexcept {
+      return CX::format<Format>(line, LineSize, values...);
+     },
+     arguments
+    );
+    return length < LineSize ? length : LineSize - 1;
+   }
+  };
+ }
+
+ //Deferred binary log. Recording a c-variadic call copies its promoted
+ //arguments, and any strings they refer to, into a binary record in a ring
+ //buffer of the calling thread; the record refers to the static format
+ //string and is formatted later, with the formatting routine compiled for
+ //the format string, by `consume()`, typically on a background
+ //thread (see `DeferredLogConsumer`). Records of each thread are consumed in
+ //order; records of different threads are not ordered. Recording never
+ //blocks: records that do not fit in the ring buffer are dropped and
+ //counted
+ struct DeferredLog final {
+ private:
+  using Ring = LogMetaFunctions::Ring;
+
+  //Ring buffers, indexed by thread slot
+  Ring rings[LogMetaFunctions::ThreadRings]{};
+
+  //Returns the ring buffer of the calling thread, or `nullptr` if thread
+  //slots are exhausted or the buffer cannot be allocated
+  Ring * threadRing() noexcept {
+   using namespace LogMetaFunctions;
+   auto const slot = LogMetaFunctions::ThreadSlot::get();
+   if (slot >= ThreadRings) {
+    return nullptr;
+   }
+   auto& ring = rings[slot];
+   if (!ring.data) {
+    auto const result = Allocator<unsigned char>::allocate(RingSize);
+    if (!result.hasValue()) {
+     return nullptr;
+    }
+    ring.data = &result.value();
+   }
+   return &ring;
+  }
+
+  //Reserves `size` contiguous bytes in `ring`, padding to the end of the
+  //buffer if necessary; returns the new write position, or `0` if the
+  //buffer is full
+  static SizeType reserve(Ring& ring, SizeType const size) noexcept {
+   using namespace LogMetaFunctions;
+   auto const head = ring.head;
+   auto const offset = head & (RingSize - 1);
+   auto const padding = RingSize - offset < size ? RingSize - offset : 0;
+   auto const next = head + padding + size;
+   if (next - ring.cachedTail > RingSize) {
+    ring.cachedTail = __atomic_load_n(&ring.tail, __ATOMIC_ACQUIRE);
+    if (next - ring.cachedTail > RingSize) {
+     __atomic_store_n(&ring.dropped, ring.dropped + 1, __ATOMIC_RELAXED);
+     return 0;
+    }
+   }
+   if (padding) {
+    auto const marker = padding | 1;
+    __builtin_memcpy(ring.data + offset, &marker, sizeof(marker));
+   }
+   return next;
+  }
+
+ public:
+  DeferredLog() noexcept = default;
+
+  //Threads refer to their ring buffers by slot; logs cannot be copied or
+  //moved
+  DeferredLog(DeferredLog const&) = delete;
+  DeferredLog(DeferredLog&&) = delete;
+
+  //Destructor; pending records are discarded
+  ~DeferredLog() noexcept {
+   for (auto& ring : rings) {
+    if (ring.data) {
+     Allocator<unsigned char>::deallocate(
+      *ring.data,
+      LogMetaFunctions::RingSize
+     );
+    }
+   }
+  }
+
+  //Records the arguments of `Format` read from `list`; returns whether the
+  //record was stored
+  template<FormatString Format>
+  requires ValidFormat<Format>
+  bool write(VaList& list) noexcept {
+   using Record = LogMetaFunctions::Record<Format>;
+   auto const ring = threadRing();
+   if (!ring) {
+    return false;
+   }
+   auto const arguments = Record::capture(list);
+   auto const size = Record::size(arguments);
+   auto const next = reserve(*ring, size);
+   if (!next) {
+    return false;
+   }
+   Record::store(
+    ring->data + ((next - size) & (LogMetaFunctions::RingSize - 1)),
+    size,
+    arguments
+   );
+   __atomic_store_n(&ring->head, next, __ATOMIC_RELEASE);
+   return true;
+  }
+
+  //Formats every pending record and passes it to `sink` as
+  //`sink(char const * line, SizeType length)`; returns the number of
+  //records consumed
+  //Note: Must not be invoked concurrently
+  template<typename Sink>
+  SizeType consume(Sink&& sink) noexcept {
+   using namespace LogMetaFunctions;
+   char line[LineSize];
+   SizeType consumed = 0;
+   for (auto& ring : rings) {
+    auto const head = __atomic_load_n(&ring.head, __ATOMIC_ACQUIRE);
+    auto tail = ring.tail;
+    while (tail != head) {
+     auto const record = ring.data + (tail & (RingSize - 1));
+     SizeType size;
+     __builtin_memcpy(&size, record, sizeof(size));
+     if (!(size & 1)) {
+      RecordHeader header;
+      __builtin_memcpy(&header, record, sizeof(header));
+      auto const length = header.formatter(
+       record + sizeof(RecordHeader),
+       line
+      );
+      sink((char const *)line, length);
+      consumed++;
+     }
+     tail += size & ~(SizeType)1;
+     __atomic_store_n(&ring.tail, tail, __ATOMIC_RELEASE);
+    }
+   }
+   return consumed;
+  }
+
+  //Returns the number of records dropped since ring buffers were full
+  SizeType dropped() const noexcept {
+   SizeType dropped = 0;
+   for (auto const& ring : rings) {
+    dropped += __atomic_load_n(&ring.dropped, __ATOMIC_RELAXED);
+   }
+   return dropped;
+  }
+ };
+
+ //Records a c-variadic call in `log`; arguments are read as described by
+ //`Format`. Returns whether the record was stored:
+ // deferLog<"%s: %zu">(&log, name, count);
+ template<FormatString Format>
+ requires ValidFormat<Format>
+ bool deferLog(DeferredLog * const log, ...) noexcept {
+  VaList list;
+  CX_VA_START(list, log);
+  return log->write<Format>(list);
+ }
+
+ #ifdef CX_STL_SUPPORT
+  //Consumes the records of a `DeferredLog` on a background thread, sleeping
+  //for `idle` whenever no records are pending. Remaining records are
+  //consumed on destruction
+  template<typename Sink>
+  struct DeferredLogConsumer final {
+  private:
+   DeferredLog& log;
+   Sink sink;
+   std::chrono::microseconds const idle;
+   bool running = true;
+   std::thread thread;
+
+   void run() noexcept {
+    while (__atomic_load_n(&running, __ATOMIC_ACQUIRE)) {
+     if (!log.consume(sink)) {
+      std::this_thread::sleep_for(idle);
+     }
+    }
+   }
+
+  public:
+   DeferredLogConsumer(
+    DeferredLog& log,
+    Sink sink,
+    std::chrono::microseconds const idle = std::chrono::microseconds{100}
+   ) :
+    log(log),
+    sink((Sink&&)sink),
+    idle(idle),
+    thread([this] { run(); })
+   {}
+
+   DeferredLogConsumer(DeferredLogConsumer const&) = delete;
+   DeferredLogConsumer(DeferredLogConsumer&&) = delete;
+
+   ~DeferredLogConsumer() {
+    __atomic_store_n(&running, false, __ATOMIC_RELEASE);
+    thread.join();
+    log.consume(sink);
+   }
+  };
+ #endif
+}
+#endif //CX_LIBC_SUPPORT
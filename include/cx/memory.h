@@ -1,12 +1,10 @@
 #pragma once
 
+#include <cx/allocator.h>
 #include <cx/lambda.h>
+#include <cx/tuple.h>
 #include <cx/error.h>
 
-#ifdef CX_STL_SUPPORT
- #include <vector>
-#endif
-
 namespace CX {
  struct DeferError final {
   char const * message;
@@ -55,47 +53,263 @@ namespace CX {
    return *this;
   }
 
+  //Invokes deferred functions in reverse order of registration
   inline void drain() {
-   //TODO Invoke in reverse order
-   for (int i = 0; i < count; i++) {
-    auto &deferred = deferrals[i];
+   while (count > 0) {
+    auto &deferred = deferrals[--count];
     deferred();
     deferred.reset();
    }
-   count = 0;
   }
  };
 
- //General purpose deferral mechanism
- #ifdef CX_STL_SUPPORT
-  struct AllocDefer final {
-  private:
-   std::vector<CX::Lambda<void ()>> deferrals;
+ //Nullary function object that can be stored in a `DeferFrame`
+ template<typename F>
+ concept Deferrable = MoveConstructible<F> && requires (F& f) {
+  f();
+ };
+
+ //Non-allocating, non-erasing deferral mechanism. Deferred functions are
+ //stored by type in a `CX::Tuple`, so the frame is only as large as their
+ //captures and draining it invokes each function directly. Functions are
+ //registered at construction, or with `then`, which moves the frame into a
+ //larger one; they are invoked in reverse order of registration when the
+ //frame is drained or destroyed:
+ // auto frame = DeferFrame{[&] { close(fd); }}
+ //  .then([&] { free(buffer); });
+ template<Deferrable... Fs>
+ struct DeferFrame final {
+  template<Deferrable... Gs>
+  friend struct DeferFrame;
+
+ private:
+  Tuple<Fs...> deferrals;
+  bool armed = true;
+
+  //Invokes deferred functions in reverse order
+  template<SizeType... Indices>
+  constexpr void run(IndexSequence<Indices...>) noexcept {
+   (deferrals.template get<sizeof...(Fs) - 1 - Indices>()(), ...);
+  }
+
+  //Constructs a frame from the functions of `frame`, followed by `f`
+  template<typename... Gs, typename F, SizeType... Indices>
+  constexpr DeferFrame(DeferFrame<Gs...>& frame, F& f, IndexSequence<Indices...>)
+   noexcept
+  :
+   deferrals{frame.deferrals.template rget<Indices>()..., (F&&)f}
+  {}
+
+ public:
+  constexpr DeferFrame(Fs... fs) noexcept :
+   deferrals{(Fs&&)fs...}
+  {}
+
+  DeferFrame(DeferFrame const&) = delete;
+
+  //Move constructor; `other` will no longer invoke its functions
+  constexpr DeferFrame(DeferFrame&& other) noexcept :
+   deferrals{(Tuple<Fs...>&&)other.deferrals},
+   armed(other.armed)
+  {
+   other.armed = false;
+  }
+
+  constexpr ~DeferFrame() noexcept {
+   drain();
+  }
+
+  //Returns a frame that additionally defers `f`; `f` runs before all
+  //functions of this frame. This frame will no longer invoke its functions
+  template<Deferrable F>
+  [[nodiscard]]
+  constexpr DeferFrame<Fs..., F> then(F f) && noexcept {
+   DeferFrame<Fs..., F> next{*this, f, MakeIndexSequence<sizeof...(Fs)>{}};
+   next.armed = armed;
+   armed = false;
+   return next;
+  }
+
+  //Invokes deferred functions in reverse order of registration; each is
+  //invoked at most once
+  constexpr void drain() noexcept {
+   if (armed) {
+    armed = false;
+    run(MakeIndexSequence<sizeof...(Fs)>{});
+   }
+  }
+
+  //Discards deferred functions without invoking them
+  constexpr void cancel() noexcept {
+   armed = false;
+  }
+ };
+
+ //General purpose deferral mechanism. Deferred functions are stored in a
+ //growable buffer allocated with `A`, which is kept, along with its entries,
+ //across drains; later registrations re-use existing entries. Registrations
+ //can be grouped with checkpoints, and the functions registered since a
+ //checkpoint invoked or discarded independently of earlier registrations:
+ // auto const checkpoint = deferred.checkpoint();
+ // deferred += [&] { undo(); };
+ // deferred.rollback(checkpoint);
+ template<template<typename...> typename A = Allocator>
+ requires IsAllocator<A>
+ struct AllocDefer final {
+  //Deferred function type alias
+  using Entry = CX::Lambda<void ()>;
+
+  //Entry allocator type alias
+  using AllocatorType = A<Entry>;
+
+  //Registration position; see `checkpoint()`
+  using Checkpoint = SizeType;
+
+  //Capacity of the first allocated buffer
+  static constexpr SizeType const InitialCapacity = 8;
+
+ private:
+  //Whether the allocator instance must be stored
+  static constexpr bool const Stateful = IsStatefulAllocator<A>;
+
+  //Allocator storage type; zero-sized for stateless allocators
+  using StoredAllocator = SelectType<Stateful, AllocatorType, Never>;
+
+  //Allocator instance
+  [[no_unique_address]]
+  StoredAllocator allocator;
+
+  //Entry buffer; all `capacity` entries are constructed, the first `count`
+  //hold deferred functions and the remainder are empty
+  Entry * entries = nullptr;
+  SizeType count = 0;
+  SizeType capacity = 0;
+
+  //Allocates `n` entries
+  Entry * allocateEntries(SizeType const n) noexcept {
+   if constexpr (Stateful) {
+    return &unwrapAllocation(allocator.allocate(n));
+   } else {
+    return &unwrapAllocation(AllocatorType::allocate(n));
+   }
+  }
 
-  public:
-   AllocDefer() = default;
+  //Destructs and deallocates the entry buffer
+  void release() noexcept {
+   if (!entries) {
+    return;
+   }
+   for (SizeType i = 0; i < capacity; i++) {
+    entries[i].~Entry();
+   }
+   if constexpr (Stateful) {
+    allocator.deallocate(*entries, capacity);
+   } else {
+    AllocatorType::deallocate(*entries, capacity);
+   }
+   entries = nullptr;
+   capacity = 0;
+  }
 
-   inline ~AllocDefer() {
-    drain();
+  //Doubles the capacity of the entry buffer, moving registered functions
+  //Note: Entries are not trivially copyable, so the buffer is always moved
+  //rather than reallocated in place
+  void grow() noexcept {
+   auto const next = capacity ? capacity * 2 : InitialCapacity;
+   auto const buffer = allocateEntries(next);
+   for (SizeType i = 0; i < count; i++) {
+    std::construct_at(buffer + i, (Entry&&)entries[i]);
+   }
+   for (SizeType i = count; i < next; i++) {
+    std::construct_at(buffer + i);
    }
+   auto const registered = count;
+   release();
+   entries = buffer;
+   count = registered;
+   capacity = next;
+  }
+
+ public:
+  AllocDefer() noexcept = default;
 
-   template<typename F>
-   requires requires (F f) {
-    CX::Lambda{f};
+  //Constructs an empty deferral mechanism using a copy of `allocator`
+  AllocDefer(AllocatorType const& allocator) noexcept requires Stateful :
+   allocator(allocator)
+  {}
+
+  AllocDefer(AllocDefer const&) = delete;
+
+  //Move constructor; `other` is left empty, without a buffer
+  AllocDefer(AllocDefer&& other) noexcept :
+   allocator((StoredAllocator&&)other.allocator),
+   entries(other.entries),
+   count(other.count),
+   capacity(other.capacity)
+  {
+   other.entries = nullptr;
+   other.count = 0;
+   other.capacity = 0;
+  }
+
+  inline ~AllocDefer() {
+   drain();
+   release();
+  }
+
+  template<typename F>
+  requires requires (F f) {
+   CX::Lambda{f};
+  }
+  AllocDefer& operator+=(F f) noexcept {
+   if (count == capacity) {
+    grow();
    }
-   AllocDefer& operator+=(F f) noexcept {
-    deferrals.push_back(CX::Lambda{f});
-    return *this;
+   entries[count++] = f;
+   return *this;
+  }
+
+  //Returns a checkpoint for the current registration position
+  Checkpoint checkpoint() const noexcept {
+   return count;
+  }
+
+  //Invokes, in reverse order of registration, deferred functions
+  //registered since `checkpoint`. Deferred functions may register further
+  //deferred functions, which are invoked by the same rollback
+  inline void rollback(Checkpoint const checkpoint) {
+   while (count > checkpoint) {
+    //Move the function out of its entry, which may be re-used, or moved by
+    //`grow()`, by registrations made while it runs
+    Entry deferred{(Entry&&)entries[--count]};
+    entries[count].reset();
+    deferred();
    }
+  }
 
-   inline void drain() {
-    for (auto &deferred : deferrals) {
-     deferred();
-    }
-    //TODO consider re-using existing lambda entries by copy-assigning
-    //new deferred functions when they're pushed
-    deferrals.clear();
+  //Discards, without invoking, deferred functions registered since
+  //`checkpoint`
+  inline void discard(Checkpoint const checkpoint) noexcept {
+   while (count > checkpoint) {
+    entries[--count].reset();
    }
-  };
- #endif
+  }
+
+  //Invokes deferred functions in reverse order of registration; the buffer
+  //is kept for subsequent registrations
+  inline void drain() {
+   rollback(0);
+  }
+
+  //Returns the number of registered deferred functions
+  SizeType size() const noexcept {
+   return count;
+  }
+
+  //Returns the number of deferred functions that can be registered without
+  //allocating
+  SizeType reserved() const noexcept {
+   return capacity;
+  }
+ };
 }
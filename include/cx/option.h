@@ -2,9 +2,17 @@
 
 #include <cx/common.h>
 #include <cx/idioms.h>
+#include <cx/templates.h>
 #include <cx/exit.h>
 
 namespace CX {
+ struct OptionValueNotPresentError final {
+  constexpr auto& describe() const noexcept {
+   return "Option value not present!";
+  }
+ };
+ static_assert(IsError<OptionValueNotPresentError>);
+
  template<typename T>
  concept OptionParameter = !(SameType<T, void> || UnsizedArray<T>);
 
@@ -36,7 +44,145 @@ namespace CX {
   ::IsOption<MaybeOption>
   ::Value;
 
+ //Niche trait for `CX::Option`; specializations declare a sentinel value,
+ //`Value`, that is never a valid value of `T`. `Option<T>` will then use the
+ //sentinel to represent absence instead of storing a separate flag.
+ //ie.
+ // template<>
+ // struct CX::OptionNiche<FileDescriptor> {
+ //  static constexpr FileDescriptor const Value{-1};
+ // };
+ template<typename T>
+ struct OptionNiche {};
+
+ //Null pointer niche
+ template<typename T>
+ struct OptionNiche<T *> {
+  static constexpr T * const Value = nullptr;
+ };
+
+ //Niche identity concept
+ template<typename T>
+ concept HasOptionNiche = !Reference<T>
+  && CopyConstructible<T>
+  && CopyAssignable<T>
+  && requires (T const& t) {
+   { (T)OptionNiche<T>::Value } -> SameType<T>;
+   { t == OptionNiche<T>::Value } -> ConvertibleTo<bool>;
+  };
+
+ //Storage backends for `CX::Option`
+ namespace OptionMetaFunctions {
+  //Uninitialized storage for a single optional value
+  //Note: Destruction of the value is managed by the owner, since only it
+  //knows whether or not the value is present
+  template<typename T>
+  union OptionSlot {
+   Never _;
+   T value;
+
+   constexpr OptionSlot() noexcept :
+    _{}
+   {}
+
+   constexpr OptionSlot(OptionSlot const&) noexcept = default;
+   constexpr OptionSlot(OptionSlot&&) noexcept = default;
+
+   constexpr ~OptionSlot() noexcept
+    requires (TriviallyDestructible<T>)
+   = default;
+
+   constexpr ~OptionSlot() noexcept {}
+
+   constexpr OptionSlot& operator=(OptionSlot const&) noexcept = default;
+   constexpr OptionSlot& operator=(OptionSlot&&) noexcept = default;
+  };
+
+  //General purpose storage; value with a separate presence flag
+  template<typename T>
+  struct OptionStorage final {
+   OptionSlot<T> slot;
+   bool populated = false;
+
+   constexpr bool has() const noexcept {
+    return populated;
+   }
+
+   constexpr T& get() const noexcept {
+    return const_cast<T&>(slot.value);
+   }
+
+   //Note: Expects the value to be absent
+   template<typename V>
+   constexpr void emplace(V&& v) noexcept {
+    std::construct_at(&slot.value, (V&&)v);
+    populated = true;
+   }
+
+   constexpr void clear() noexcept {
+    if constexpr (!TriviallyDestructible<T>) {
+     if (populated) {
+      slot.value.~T();
+     }
+    }
+    populated = false;
+   }
+  };
+
+  //Niche storage; absence is represented by `OptionNiche<T>::Value`
+  template<HasOptionNiche T>
+  struct OptionStorage<T> final {
+   T value = (T)OptionNiche<T>::Value;
+
+   constexpr bool has() const noexcept {
+    return !(bool)(value == OptionNiche<T>::Value);
+   }
+
+   constexpr T& get() const noexcept {
+    return const_cast<T&>(value);
+   }
+
+   template<typename V>
+   constexpr void emplace(V&& v) noexcept {
+    value = (V&&)v;
+   }
+
+   constexpr void clear() noexcept {
+    value = (T)OptionNiche<T>::Value;
+   }
+  };
+
+  //Reference storage; references are stored as pointers, where `nullptr`
+  //represents absence
+  template<typename T>
+  requires (LValueReference<T>)
+  struct OptionStorage<T> final {
+   LValueReferenceDecayed<T> * pointer = nullptr;
+
+   constexpr bool has() const noexcept {
+    return pointer;
+   }
+
+   constexpr T get() const noexcept {
+    return *pointer;
+   }
+
+   constexpr void emplace(T t) noexcept {
+    pointer = &t;
+   }
+
+   constexpr void clear() noexcept {
+    pointer = nullptr;
+   }
+  };
+ }
+
  //`CX::Option` impl
+ //Notes:
+ // - `Option<T *>`, `Option<T&>` and options of types with an `OptionNiche`
+ //   specialization have the same size as `T`
+ // - `Option<T *>` treats `nullptr` as absence
+ // - `Option<T&>` rebinds on assignment
  template<OptionParameter T>
  struct Option final {
   //Prevent users from embedding options inside options
@@ -46,231 +192,565 @@ namespace CX {
    "values."
   );
 
+  static_assert(
+   !RValueReference<T>,
+   "Option does not support r-value reference types"
+  );
+
   template<OptionParameter>
   friend struct Option;
 
  private:
-  bool populated;
-  union Storage {
-   unsigned char _[0];
-   T value;
+  using Storage = OptionMetaFunctions::OptionStorage<T>;
 
-   constexpr Storage() noexcept :
-    _{}
-   {}
+  //Type yielded by value decapsulation
+  using ValueReference = SelectType<Reference<T>, T, T const&>;
 
-   //Value copy constructor
-   constexpr Storage(T const& t)
-    noexcept(noexcept(T{(T const&)t}))
-    requires (CopyConstructible<T>)
-   :
-    value{(T const&)t}
-   {}
+  Storage storage;
 
-   //Value move constructor
-   constexpr Storage(T&& t)
-    noexcept(noexcept(T{(T&&)t}))
-    requires (MoveConstructible<T>)
-   :
-    value{(T&&)t}
-   {}
+  static constexpr bool const TrivialStorage = TriviallyCopyable<Storage>;
 
-   //Default copy constructor
-   constexpr Storage(Storage const&) noexcept = default;
-
-   //Default move constructor
-   constexpr Storage(Storage&&) noexcept = default;
-
-   constexpr ~Storage() noexcept(noexcept(value.~T())) = default;
-  } storage;
-
-  template<typename F>
-  static constexpr bool const SupportedGeneratorPrototype = false;
+  constexpr Option& mut() const noexcept {
+   return const_cast<Option&>(*this);
+  }
 
  public:
-  constexpr Option() noexcept :
-   populated{false},
-   storage{}
-  {}
+  constexpr Option() noexcept = default;
 
   //Value copy constructor
-  constexpr Option(T const& t) noexcept(noexcept(Storage{(T const&)t})) :
-   populated{true},
-   storage{(T const&)t}
-  {}
+  constexpr Option(T const& t) noexcept
+   requires (!Reference<T> && CopyConstructible<T>)
+  {
+   storage.emplace((T const&)t);
+  }
 
   //Value move constructor
-  constexpr Option(T&& t) noexcept(noexcept(Storage{(T&&)t})) :
-   populated{true},
-   storage{(T&&)t}
-  {}
+  constexpr Option(T&& t) noexcept
+   requires (!Reference<T> && MoveConstructible<T>)
+  {
+   storage.emplace((T&&)t);
+  }
+
+  //Reference constructor
+  constexpr Option(T t) noexcept
+   requires (Reference<T>)
+  {
+   storage.emplace(t);
+  }
+
+  //Trivial copy constructor
+  constexpr Option(Option const&) noexcept requires (TrivialStorage) = default;
 
   //Copy constructor
-  constexpr Option(Option const& other) noexcept(
-   declval<Option&>().operator=(declval<Option const&>())
-  ) :
-   populated{false},
-   storage{}
+  constexpr Option(Option const& other) noexcept
+   requires (!TrivialStorage && CopyConstructible<T>)
   {
-   const_cast<Option&>(*this).operator=((Option const&)other);
+   mut().operator=((Option const&)other);
   }
 
+  //Trivial move constructor
+  constexpr Option(Option&&) noexcept requires (TrivialStorage) = default;
+
   //Move constructor
-  constexpr Option(Option&& other) noexcept(
-   declval<Option&>().operator=(declval<Option&&>())
-  ) :
-   populated{false},
-   storage{}
+  constexpr Option(Option&& other) noexcept
+   requires (!TrivialStorage && MoveConstructible<T>)
   {
-   const_cast<Option&>(*this).operator=((Option&&)other);
+   mut().operator=((Option&&)other);
   }
 
-  //Constexpr destructor
-  constexpr ~Option() noexcept(noexcept(reset())) {
+  //Trivial destructor
+  constexpr ~Option() noexcept
+   requires (TriviallyDestructible<Storage>)
+  = default;
+
+  //Destructs the value, if present
+  constexpr ~Option() noexcept {
    reset();
   }
 
+  //Trivial copy-assignment operator
+  constexpr Option& operator=(Option const&) noexcept
+   requires (TrivialStorage)
+  = default;
+
   //Option copy-assignment operator
-  constexpr Option& operator=(Option const& other) noexcept(
-   (TriviallyCopyable<T> && noexcept(storage = other.storage))
-   || (!TriviallyCopyable<T>
-       && noexcept(Storage{} = Storage{(T const&)other.storage.value})
-      )
-  ) {
-   if (other.populated) {
-    if constexpr (TriviallyCopyable<T>) {
-     storage = other.storage;
+  constexpr Option& operator=(Option const& other) noexcept
+   requires (!TrivialStorage && CopyConstructible<T>)
+  {
+   if (this != &other) {
+    if (other.storage.has()) {
+     operator=((T const&)other.storage.get());
     } else {
-     if (populated) {
-      storage.value = (T const&)other.storage.value;
-     } else {
-      storage = {(T const&)other.storage.value};
-     }
+     reset();
     }
-    populated = true;
-   } else {
-    reset();
    }
+   return *this;
   }
 
+  //Trivial move-assignment operator
+  constexpr Option& operator=(Option&&) noexcept
+   requires (TrivialStorage)
+  = default;
+
   //Option move-assignment operator
-  //Note: Constexpr moves are not permitted since they require modification
-  //of a remote object
-  Option& operator=(Option&& other) noexcept(
-   (TriviallyCopyable<T> && noexcept(storage = other.storage))
-   || (!TriviallyCopyable<T>
-       && noexcept(Storage{} = Storage{(T const&)other.storage.value})
-      )
-  ) {
-   reset();
-   populated = other.populated;
-   if constexpr (TriviallyCopyable<T>) {
-    storage = other.storage;
-   } else {
-    storage = {(T const&)other.storage.value};
+  constexpr Option& operator=(Option&& other) noexcept
+   requires (!TrivialStorage && MoveConstructible<T>)
+  {
+   if (this != &other) {
+    if (other.storage.has()) {
+     operator=((T&&)other.storage.get());
+    } else {
+     reset();
+    }
+    other.reset();
    }
-   other.reset();
    return *this;
   }
 
   //Value copy-assignment operator
-  constexpr Option& operator=(T const& other)
-   noexcept(
-    (CopyAssignable<T>
-     && noexcept(storage.value = (T const&)other)
-     && noexcept(Storage{} = Storage{(T const&)other})
-    )
-    || (!CopyAssignable<T> && noexcept(Storage{} = Storage{(T const&)other}))
-   )
-   requires (CopyConstructible<T>)
+  constexpr Option& operator=(T const& other) noexcept
+   requires (!Reference<T> && CopyConstructible<T>)
   {
    if constexpr (CopyAssignable<T>) {
-    if (populated) {
-     storage.value = (T const&)other;
-    } else {
-     storage = {(T const&)other};
+    if (storage.has()) {
+     storage.get() = (T const&)other;
+     return *this;
     }
-   } else {
-    reset();
-    storage = {(T const&)other};
    }
+   reset();
+   storage.emplace((T const&)other);
    return *this;
   }
 
   //Value move-assignment operator
-  constexpr Option& operator=(T&& other)
-   noexcept(
-    (MoveAssignable<T>
-     && noexcept(storage.value = (T&&)other)
-     && noexcept(Storage{} = Storage{(T&&)other})
-    )
-    || (!MoveAssignable<T> && noexcept(Storage{} = Storage{(T&&)other}))
-   )
-   requires (MoveConstructible<T>)
+  constexpr Option& operator=(T&& other) noexcept
+   requires (!Reference<T> && MoveConstructible<T>)
   {
    if constexpr (MoveAssignable<T>) {
-    if (populated) {
-     storage.value = (T&&)other;
-    } else {
-     storage = {(T&&)other};
+    if (storage.has()) {
+     storage.get() = (T&&)other;
+     return *this;
     }
-   } else {
-    reset();
-    storage = {(T&&)other};
    }
+   reset();
+   storage.emplace((T&&)other);
+   return *this;
+  }
+
+  //Reference rebinding assignment operator
+  constexpr Option& operator=(T other) noexcept
+   requires (Reference<T>)
+  {
+   storage.emplace(other);
    return *this;
   }
 
   //Destructs storage value, if populated, and resets option
-  constexpr void reset() noexcept(noexcept(storage.value.~T())) {
-   if constexpr (!TriviallyDestructible<T>) {
-    if (populated) {
-     storage.value.~T();
-    }
-   }
-   populated = false;
-   storage = {};
+  constexpr void reset() noexcept {
+   storage.clear();
+  }
+
+  //Value presence check
+  constexpr bool hasValue() const noexcept {
+   return storage.has();
   }
 
   //Value presence implicit conversion
   constexpr operator bool() const noexcept {
-   return populated;
+   return storage.has();
   }
 
   //"Value or immediate" operator
-  constexpr auto& operator|(T other) const noexcept {
-   return populated ? storage.value : other;
+  constexpr T operator|(T other) const noexcept {
+   if (storage.has()) {
+    return (ValueReference)storage.get();
+   }
+   return (T)other;
   }
 
-  //"Value or lazyily evaluated result" operator
-  constexpr auto operator|(FunctionOperator<T ()> auto generator) const
-   noexcept/*(generator())*/
+  //"Value or lazily evaluated result" operator
+  constexpr T operator|(FunctionWithPrototype<T ()> auto generator) const
+   noexcept
   {
-   return populated ? storage.value : generator();
+   if (storage.has()) {
+    return (ValueReference)storage.get();
+   }
+   return generator();
   }
 
   //Checked value decapsulation
-  auto& operator+() const noexcept {
-   if (populated) {
-    return storage.value();
+  constexpr ValueReference operator+() const noexcept {
+   if (!storage.has()) [[unlikely]] {
+    exit(OptionValueNotPresentError{});
    }
-   //TODO appropriate error
-   exit();
+   return storage.get();
   }
 
   //Unchecked value decapsulation
-  constexpr auto& operator!() const noexcept {
-   return storage.value;
+  constexpr ValueReference operator!() const noexcept {
+   return storage.get();
   }
  };
 
+ //Option deduction guide
+ template<typename T>
+ Option(T) -> Option<T>;
+
+ //Supporting meta-functions for `CX::OptionTuple`
+ namespace OptionMetaFunctions {
+  //Yields the smallest builtin unsigned integral type with at least `N` bits;
+  //used as the presence bitmask of `CX::OptionTuple`
+  template<SizeType N>
+  requires (N <= sizeof(unsigned long long) * 8)
+  using PresenceMask = SelectType<
+   (N <= sizeof(unsigned char) * 8),
+   unsigned char,
+   SelectType<
+    (N <= sizeof(unsigned short) * 8),
+    unsigned short,
+    SelectType<
+     (N <= sizeof(unsigned int) * 8),
+     unsigned int,
+     unsigned long long
+    >
+   >
+  >;
+
+  //Describes the in-memory layout of an `OptionTuple<Types...>`; all
+  //elements and the presence mask are stored in order of descending
+  //alignment, so that no padding is required between them
+  template<typename Mask, typename... Types>
+  struct OptionTupleLayout final {
+   //Total number of stored members, including the presence mask
+   static constexpr SizeType const Count = sizeof...(Types) + 1;
+
+   //Storage order of the members; `Order::indices[Position]` yields the
+   //declared index of the member stored at `Position`, where the declared
+   //index `sizeof...(Types)` refers to the presence mask
+   struct Order final {
+    SizeType indices[Count];
+   };
+
+   static constexpr Order const StorageOrder = []() constexpr noexcept {
+    SizeType const alignments[Count]{
+     TypeAlignment<Types>...,
+     TypeAlignment<Mask>
+    };
+    Order order{};
+    for (SizeType i = 0; i < Count; i++) {
+     order.indices[i] = i;
+    }
+    //Stable insertion sort by descending alignment
+    for (SizeType i = 1; i < Count; i++) {
+     auto const index = order.indices[i];
+     auto j = i;
+     for (; j > 0 && alignments[order.indices[j - 1]] < alignments[index]; j--) {
+      order.indices[j] = order.indices[j - 1];
+     }
+     order.indices[j] = index;
+    }
+    return order;
+   }();
+
+   //Yields the storage position of the member with the declared `Index`
+   static constexpr SizeType positionOf(SizeType const index) noexcept {
+    SizeType position = 0;
+    while (StorageOrder.indices[position] != index) {
+     position++;
+    }
+    return position;
+   }
+
+   //Storage position of the presence mask
+   static constexpr SizeType const MaskPosition = positionOf(sizeof...(Types));
+
+   //Yields the member type stored at `Position`
+   template<SizeType Position>
+   using MemberAt = SelectType<
+    Position == MaskPosition,
+    Mask,
+    OptionSlot<TypeAtIndex<StorageOrder.indices[Position], Types...>>
+   >;
+  };
+
+  //Recursive storage for the members of an `OptionTuple`, in storage order
+  //Note: Since members are sorted by descending alignment, the nested
+  //storage does not introduce any padding beyond that of a flat struct
+  template<typename Layout, SizeType Position = 0>
+  struct OptionTupleStorage final {
+   typename Layout::template MemberAt<Position> member{};
+   OptionTupleStorage<Layout, Position + 1> next{};
+
+   //Returns the member at `Target`, relative to `Position`
+   template<SizeType Target>
+   constexpr auto& at() const noexcept {
+    if constexpr (Target == Position) {
+     return const_cast<typename Layout::template MemberAt<Position>&>(member);
+    } else {
+     return next.template at<Target>();
+    }
+   }
+  };
+
+  template<typename Layout, SizeType Position>
+  requires (Position == Layout::Count - 1)
+  struct OptionTupleStorage<Layout, Position> final {
+   typename Layout::template MemberAt<Position> member{};
+
+   template<SizeType Target>
+   requires (Target == Position)
+   constexpr auto& at() const noexcept {
+    return const_cast<typename Layout::template MemberAt<Position>&>(member);
+   }
+  };
+ }
+
  //`OptionTuple` impl
+ //A tuple of optional values that stores the presence of all elements in a
+ //single bitmask, instead of one (padded) flag per element
  template<OptionParameter... Types>
  struct OptionTuple final {
-  //TODO
   static_assert(
-   sizeof...(Types) != sizeof...(Types),
-   "Unimplemented"
+   !(Reference<Types> || ...),
+   "OptionTuple does not support reference element types"
   );
+
+  static_assert(
+   !(IsOption<Types> || ...),
+   "Cascading options is an antipattern. Consider consolidating your optional "
+   "values."
+  );
+
+  //Element type at `Index`
+  template<SizeType Index>
+  requires (Index < sizeof...(Types))
+  using ElementType = TypeAtIndex<Index, Types...>;
+
+ private:
+  using Mask = OptionMetaFunctions::PresenceMask<sizeof...(Types)>;
+  using Layout = OptionMetaFunctions::OptionTupleLayout<Mask, Types...>;
+
+  OptionMetaFunctions::OptionTupleStorage<Layout> storage;
+
+  static constexpr bool const TriviallyCopyableElements
+   = (TriviallyCopyable<Types> && ...);
+
+  static constexpr bool const TriviallyDestructibleElements
+   = (TriviallyDestructible<Types> && ...);
+
+  //Presence bit for the element at `Index`
+  template<SizeType Index>
+  static constexpr Mask const Bit = (Mask)((Mask)1 << Index);
+
+  //Returns mutable reference to the presence mask
+  constexpr Mask& mask() const noexcept {
+   return storage.template at<Layout::MaskPosition>();
+  }
+
+  //Returns mutable reference to the slot of the element at `Index`
+  template<SizeType Index>
+  constexpr auto& slot() const noexcept {
+   return storage.template at<Layout::positionOf(Index)>();
+  }
+
+  //Invokes `op` for every element index, in declaration order
+  template<SizeType Index = 0>
+  static constexpr void forEachIndex(auto& op) noexcept {
+   if constexpr (Index < sizeof...(Types)) {
+    op.template operator()<Index>();
+    forEachIndex<Index + 1>(op);
+   }
+  }
+
+  //Copies or moves all present elements from `other`
+  //Note: Expects all elements of `*this` to be absent
+  template<typename Other>
+  constexpr void initFrom(Other&& other) noexcept {
+   constexpr auto const move = RValueReference<Other&&>;
+   auto const init = [&]<SizeType Index>() constexpr noexcept {
+    using T = ElementType<Index>;
+    if (other.template has<Index>()) {
+     if constexpr (move) {
+      std::construct_at(&slot<Index>().value, (T&&)other.template value<Index>());
+     } else {
+      std::construct_at(&slot<Index>().value, (T const&)other.template value<Index>());
+     }
+    }
+   };
+   forEachIndex(init);
+   mask() = other.mask();
+  }
+
+ public:
+  //Default constructor; all elements are absent
+  constexpr OptionTuple() noexcept = default;
+
+  //Trivial copy constructor
+  constexpr OptionTuple(OptionTuple const&) noexcept
+   requires (TriviallyCopyableElements)
+  = default;
+
+  //Copy constructor
+  constexpr OptionTuple(OptionTuple const& other) noexcept
+   requires (!TriviallyCopyableElements && (CopyConstructible<Types> && ...))
+  {
+   initFrom((OptionTuple const&)other);
+  }
+
+  //Trivial move constructor
+  constexpr OptionTuple(OptionTuple&&) noexcept
+   requires (TriviallyCopyableElements)
+  = default;
+
+  //Move constructor
+  constexpr OptionTuple(OptionTuple&& other) noexcept
+   requires (!TriviallyCopyableElements && (MoveConstructible<Types> && ...))
+  {
+   initFrom((OptionTuple&&)other);
+   other.reset();
+  }
+
+  //Trivial destructor
+  constexpr ~OptionTuple() noexcept
+   requires (TriviallyDestructibleElements)
+  = default;
+
+  //Destructs all present elements
+  constexpr ~OptionTuple() noexcept {
+   reset();
+  }
+
+  //Trivial copy-assignment operator
+  constexpr OptionTuple& operator=(OptionTuple const&) noexcept
+   requires (TriviallyCopyableElements)
+  = default;
+
+  //Copy-assignment operator
+  constexpr OptionTuple& operator=(OptionTuple const& other) noexcept
+   requires (!TriviallyCopyableElements && (CopyConstructible<Types> && ...))
+  {
+   if (this != &other) {
+    reset();
+    initFrom((OptionTuple const&)other);
+   }
+   return *this;
+  }
+
+  //Trivial move-assignment operator
+  constexpr OptionTuple& operator=(OptionTuple&&) noexcept
+   requires (TriviallyCopyableElements)
+  = default;
+
+  //Move-assignment operator
+  constexpr OptionTuple& operator=(OptionTuple&& other) noexcept
+   requires (!TriviallyCopyableElements && (MoveConstructible<Types> && ...))
+  {
+   if (this != &other) {
+    reset();
+    initFrom((OptionTuple&&)other);
+    other.reset();
+   }
+   return *this;
+  }
+
+  //Returns whether or not the element at `Index` is present
+  template<SizeType Index>
+  requires (Index < sizeof...(Types))
+  constexpr bool has() const noexcept {
+   return mask() & Bit<Index>;
+  }
+
+  //Returns the number of present elements
+  constexpr SizeType count() const noexcept {
+   return (SizeType)__builtin_popcountll(mask());
+  }
+
+  //Returns `true` if no elements are present
+  constexpr bool empty() const noexcept {
+   return !mask();
+  }
+
+  //Checked element decapsulation
+  template<SizeType Index>
+  requires (Index < sizeof...(Types))
+  constexpr auto& get() const noexcept {
+   if (!has<Index>()) {
+    exit(OptionValueNotPresentError{});
+   }
+   return slot<Index>().value;
+  }
+
+  //Unchecked element decapsulation
+  template<SizeType Index>
+  requires (Index < sizeof...(Types))
+  constexpr auto& value() const noexcept {
+   return slot<Index>().value;
+  }
+
+  //Copies `value` into the element at `Index`
+  template<SizeType Index>
+  requires (Index < sizeof...(Types) && CopyConstructible<ElementType<Index>>)
+  constexpr auto& set(ElementType<Index> const& value) noexcept {
+   using T = ElementType<Index>;
+   reset<Index>();
+   std::construct_at(&slot<Index>().value, (T const&)value);
+   mask() |= Bit<Index>;
+   return slot<Index>().value;
+  }
+
+  //Moves `value` into the element at `Index`
+  template<SizeType Index>
+  requires (Index < sizeof...(Types) && MoveConstructible<ElementType<Index>>)
+  constexpr auto& set(ElementType<Index>&& value) noexcept {
+   using T = ElementType<Index>;
+   reset<Index>();
+   std::construct_at(&slot<Index>().value, (T&&)value);
+   mask() |= Bit<Index>;
+   return slot<Index>().value;
+  }
+
+  //Destructs the element at `Index`, if present
+  template<SizeType Index>
+  requires (Index < sizeof...(Types))
+  constexpr void reset() noexcept {
+   using T = ElementType<Index>;
+   if constexpr (!TriviallyDestructible<T>) {
+    if (has<Index>()) {
+     slot<Index>().value.~T();
+    }
+   }
+   mask() &= (Mask)~Bit<Index>;
+  }
+
+  //Destructs all present elements
+  constexpr void reset() noexcept {
+   if constexpr (!TriviallyDestructibleElements) {
+    auto const destroy = [&]<SizeType Index>() constexpr noexcept {
+     reset<Index>();
+    };
+    forEachIndex(destroy);
+   }
+   mask() = 0;
+  }
+
+  //Invokes `op` with every present element, in declaration order. `op` may
+  //either accept the element, or accept the element and take its index as
+  //a template parameter; ie. `[]<SizeType Index>(auto& element) {...}`
+  constexpr void forEach(auto op) const noexcept {
+   if (empty()) {
+    return;
+   }
+   auto const visit = [&]<SizeType Index>() constexpr noexcept {
+    auto& element = slot<Index>().value;
+    if (has<Index>()) {
+     if constexpr (requires { op.template operator()<Index>(element); }) {
+      op.template operator()<Index>(element);
+     } else {
+      op(element);
+     }
+    }
+   };
+   forEachIndex(visit);
+  }
  };
 }
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <cx/allocator.h>
+#include <cx/common.h>
+#include <cx/idioms.h>
+#include <cx/bitset.h>
+#include <cx/spinlock.h>
+
+//Maximum number of threads with a magazine cache in each pool; threads
+//beyond the limit allocate directly from the shared free lists
+#ifndef CX_POOL_THREAD_CACHES
+ #define CX_POOL_THREAD_CACHES 64
+#endif
+
+namespace CX {
+ //Supporting meta-functions for `CX::Pool`
+ namespace PoolMetaFunctions {
+  //Number of thread cache slots
+  constexpr SizeType const ThreadCaches = CX_POOL_THREAD_CACHES;
+
+  //Number of objects moved between a thread cache and the shared free
+  //lists at a time
+  constexpr SizeType const MagazineSize = 32;
+
+  //Default number of objects per slab
+  constexpr SizeType const DefaultSlabObjects = 256;
+
+  //Free object; overlays the storage of free pool objects
+  struct Node final {
+   //Next free object
+   Node * next;
+   //Next magazine; only valid for the first object of a magazine
+   Node * nextMagazine;
+  };
+
+  //Storage for a single pool object
+  template<typename T>
+  union Slot {
+   Node node;
+   alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  //Slab header; occupies the first slot of every slab
+  struct Slab final {
+   Slab * next;
+   SizeType slots;
+  };
+
+  //Thread cache slot of the calling thread
+  using ThreadSlot = CX::ThreadSlot<Node, ThreadCaches>;
+ }
+
+ //Fixed-size object pool. Free objects are kept in intrusive free lists and
+ //new objects are carved from slabs obtained from `CX::Allocator`. When
+ //thread caches are enabled, each thread allocates from and frees to its own
+ //magazine of objects without synchronization; magazines are exchanged with
+ //the shared free lists, under a spinlock, only when a thread cache runs
+ //empty or overflows. Objects may be freed by any thread. Slabs are only
+ //returned to `CX::Allocator` when the pool is destroyed
+ template<typename T>
+ struct Pool final {
+ private:
+  using Node = PoolMetaFunctions::Node;
+  using Slot = PoolMetaFunctions::Slot<T>;
+  using Slab = PoolMetaFunctions::Slab;
+
+  static_assert(sizeof(Slab) <= sizeof(Slot));
+
+  //Magazine cache of a single thread
+  struct alignas(BitsetMetaFunctions::CacheLineSize) ThreadCache final {
+   Node * head = nullptr;
+   SizeType count = 0;
+  };
+
+  //Thread caches, indexed by thread slot
+  ThreadCache caches[PoolMetaFunctions::ThreadCaches];
+
+  //Shared state
+  SpinLock lock;
+  //Full magazines, linked through `Node::nextMagazine`
+  Node * magazines = nullptr;
+  //Individually freed objects
+  Node * freeList = nullptr;
+  //Unused slots of the most recent slab
+  Slot * carve = nullptr;
+  Slot * carveEnd = nullptr;
+  Slab * slabs = nullptr;
+  SizeType const slabObjects;
+  bool const threadCaches;
+
+  //Allocates a slab; the shared lock must be held. Returns whether the
+  //allocation succeeded
+  bool grow() noexcept {
+   auto const slots = slabObjects + 1;
+   auto const result = Allocator<Slot>::allocate(slots);
+   if (!result.hasValue()) {
+    return false;
+   }
+   auto const slab = &result.value();
+   auto const header = (Slab *)slab;
+   header->next = slabs;
+   header->slots = slots;
+   slabs = header;
+   carve = slab + 1;
+   carveEnd = slab + slots;
+   return true;
+  }
+
+  //Takes a single object from the shared free lists; the shared lock must
+  //be held. Returns `nullptr` if a slab cannot be allocated
+  Node * takeLocked() noexcept {
+   if (freeList) {
+    auto const node = freeList;
+    freeList = node->next;
+    return node;
+   }
+   if (magazines) {
+    //Split the first object off a magazine
+    auto const node = magazines;
+    magazines = node->nextMagazine;
+    if (node->next) {
+     freeList = node->next;
+    }
+    return node;
+   }
+   if (carve == carveEnd && !grow()) {
+    return nullptr;
+   }
+   return &(carve++)->node;
+  }
+
+  //Refills an empty thread cache with a magazine; the magazine is partial,
+  //or empty, if a slab cannot be allocated
+  [[gnu::noinline]]
+  void refill(ThreadCache& cache) noexcept {
+   lock.lock();
+   if (magazines) {
+    cache.head = magazines;
+    magazines = magazines->nextMagazine;
+    cache.count = PoolMetaFunctions::MagazineSize;
+    lock.unlock();
+    return;
+   }
+   //Assemble a magazine from individually freed objects and fresh slots
+   Node * head = nullptr;
+   SizeType count = 0;
+   while (count < PoolMetaFunctions::MagazineSize) {
+    Node * node;
+    if (freeList) {
+     node = freeList;
+     freeList = node->next;
+    } else {
+     if (carve == carveEnd && !grow()) {
+      break;
+     }
+     node = &(carve++)->node;
+    }
+    node->next = head;
+    head = node;
+    count++;
+   }
+   lock.unlock();
+   cache.head = head;
+   cache.count = count;
+  }
+
+  //Returns a magazine from an overflowing thread cache to the shared free
+  //lists
+  [[gnu::noinline]]
+  void flush(ThreadCache& cache) noexcept {
+   //Split off the first `MagazineSize` objects, outside of the lock
+   auto const magazine = cache.head;
+   auto last = magazine;
+   for (SizeType i = 1; i < PoolMetaFunctions::MagazineSize; i++) {
+    last = last->next;
+   }
+   cache.head = last->next;
+   cache.count -= PoolMetaFunctions::MagazineSize;
+   last->next = nullptr;
+   lock.lock();
+   magazine->nextMagazine = magazines;
+   magazines = magazine;
+   lock.unlock();
+  }
+
+  //Returns the thread cache of the calling thread, or `nullptr` if thread
+  //caches are disabled or unavailable
+  ThreadCache * threadCache() noexcept {
+   if (!threadCaches) {
+    return nullptr;
+   }
+   auto const slot = PoolMetaFunctions::ThreadSlot::get();
+   return slot < PoolMetaFunctions::ThreadCaches ? &caches[slot] : nullptr;
+  }
+
+ public:
+  //Constructs an empty pool; no memory is allocated until the first
+  //allocation. `slabObjects` is the number of objects per slab
+  explicit Pool(
+   SizeType const slabObjects = PoolMetaFunctions::DefaultSlabObjects,
+   bool const threadCaches = true
+  ) noexcept :
+   slabObjects(slabObjects ? slabObjects : 1),
+   threadCaches(threadCaches)
+  {}
+
+  //Allocators refer to their pool by address; pools cannot be copied or
+  //moved
+  Pool(Pool const&) = delete;
+  Pool(Pool&&) = delete;
+
+  //Destructor; returns all slabs to `CX::Allocator`. Objects allocated from
+  //the pool must not be used afterwards
+  ~Pool() noexcept {
+   while (slabs) {
+    auto const next = slabs->next;
+    Allocator<Slot>::deallocate(*(Slot *)slabs, slabs->slots);
+    slabs = next;
+   }
+  }
+
+  //Allocates storage for a single object
+  [[nodiscard]]
+  AllocResult<T> allocate() noexcept {
+   Node * node;
+   if (auto const cache = threadCache()) {
+    if (!cache->head) {
+     refill(*cache);
+    }
+    node = cache->head;
+    if (node) {
+     cache->head = node->next;
+     cache->count--;
+    }
+   } else {
+    lock.lock();
+    node = takeLocked();
+    lock.unlock();
+   }
+   if (!node) {
+    return AllocError{AllocErrorType::OUT_OF_MEMORY};
+   }
+   return *(T *)node;
+  }
+
+  //Returns the storage of a single object to the pool
+  void deallocate(T const& t) noexcept {
+   auto const node = (Node *)&t;
+   if (auto const cache = threadCache()) {
+    node->next = cache->head;
+    cache->head = node;
+    if (++cache->count >= 2 * PoolMetaFunctions::MagazineSize) {
+     flush(*cache);
+    }
+    return;
+   }
+   lock.lock();
+   node->next = freeList;
+   freeList = node;
+   lock.unlock();
+  }
+
+  //Returns the number of slabs allocated by the pool
+  SizeType slabCount() noexcept {
+   lock.lock();
+   SizeType count = 0;
+   for (auto slab = slabs; slab; slab = slab->next) {
+    count++;
+   }
+   lock.unlock();
+   return count;
+  }
+ };
+
+ //Stateful allocator handle for `CX::Pool`. Single-object allocations are
+ //served by the referenced pool; array allocations fall through to
+ //`CX::Allocator`
+ template<typename T>
+ struct PoolAllocator final {
+ private:
+  Pool<T> * pool;
+
+ public:
+  constexpr PoolAllocator(Pool<T>& pool) noexcept :
+   pool(&pool)
+  {}
+
+  //Returns the referenced pool
+  constexpr Pool<T>& resource() const noexcept {
+   return *pool;
+  }
+
+  [[nodiscard]]
+  AllocResult<T> allocate(SizeType const n = 1) noexcept {
+   if (n == 1) {
+    return pool->allocate();
+   }
+   return Allocator<T>::allocate(n);
+  }
+
+  void deallocate(T const& t, SizeType const n = 1) noexcept {
+   if (n == 1) {
+    pool->deallocate(t);
+   } else {
+    Allocator<T>::deallocate(t, n);
+   }
+  }
+
+  //Allocators are equal when they share a pool
+  constexpr bool operator==(PoolAllocator const& other) const noexcept {
+   return pool == other.pool;
+  }
+ };
+ static_assert(IsStatefulAllocator<PoolAllocator>);
+}
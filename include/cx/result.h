@@ -143,12 +143,22 @@ namespace CX {
    constexpr Storage(Storage const&) noexcept = default;
 
    //Default constexpr union destructor
+   constexpr ~Storage() noexcept
+    requires (TriviallyDestructible<R> && TriviallyDestructible<E>)
+   = default;
+
+   //Constexpr union destructor; members are destructed by `Result`
    constexpr ~Storage() noexcept {}
 
    //Default union copy-assignment operator
    constexpr Storage& operator=(Storage const&) = default;
   } storage;
 
+  //Whether results are copied bitwise; results of trivially copyable values
+  //and errors are themselves trivially copyable, and are passed in registers
+  static constexpr bool const Trivial = TriviallyCopyable<R>
+   && TriviallyCopyable<E>;
+
   //Resets state to `ResultState::MOVED`
   constexpr void reset() noexcept {
    switch (state) {
@@ -209,6 +219,9 @@ namespace CX {
    storage{(E&&)error}
   {}
 
+  //Trivial result copy constructor
+  constexpr Result(Result const&) noexcept requires Trivial = default;
+
   //Result copy constructor
   constexpr Result(Result const& other) noexcept :
    state{ResultState::ERR},
@@ -217,6 +230,9 @@ namespace CX {
    mut().operator=((Result const&)other);
   }
 
+  //Trivial result move constructor
+  constexpr Result(Result&&) noexcept requires Trivial = default;
+
   //Result move constructor
   constexpr Result(Result&& other) noexcept :
    state{ResultState::ERR},
@@ -225,6 +241,9 @@ namespace CX {
    mut().operator=((Result&&)other);
   }
 
+  //Trivial destructor
+  constexpr ~Result() noexcept requires Trivial = default;
+
   //Constexpr destructor
   constexpr ~Result() noexcept {
    mut().reset();
@@ -294,6 +313,10 @@ namespace CX {
    return *this;
   }
 
+  //Trivial result copy-assignment operator
+  constexpr Result& operator=(Result const&) noexcept requires Trivial
+  = default;
+
   //Result copy-assignment operator
   constexpr Result& operator=(Result const& other) noexcept {
    auto const initStorage = [&]<typename T>(T const& t) constexpr noexcept {
@@ -328,6 +351,9 @@ namespace CX {
    return *this;
   }
 
+  //Trivial result move-assignment operator
+  constexpr Result& operator=(Result&&) noexcept requires Trivial = default;
+
   //Result move-assignment operator
   constexpr Result& operator=(Result&& other) noexcept {
    auto const initStorage = [&]<typename T>(T&& t) constexpr noexcept {
@@ -447,6 +473,245 @@ namespace CX {
   }
  };
 
+ //`CX::Result` specialization for reference values; stores a pointer to the
+ //referenced value. Copying a reference result copies the reference, not
+ //the referenced value
+ //Note: Trivially copyable when `E` is, so reference results with trivial
+ //errors are returned in registers
+ template<typename R, ResultErrorParameter E>
+ struct Result<R&, E> final {
+ private:
+  using ResultState = ResultMetaFunctions::ResultState;
+
+  ResultState state;
+  union Storage {
+   //Intermediate state
+   Never _;
+   //Value state
+   R * value;
+   //Error state
+   E error;
+
+   //Intermediate state constructor
+   constexpr Storage() noexcept :
+    _{}
+   {}
+
+   //Value constructor
+   constexpr Storage(R& value) noexcept :
+    value{&value}
+   {}
+
+   //Error copy constructor
+   constexpr Storage(E const& error) noexcept
+    requires (CopyConstructible<E>)
+   :
+    error{(E const&)error}
+   {}
+
+   //Error move constructor
+   constexpr Storage(E&& error) noexcept
+    requires (MoveConstructible<E>)
+   :
+    error{(E&&)error}
+   {}
+
+   //Trivial union destructor
+   constexpr ~Storage() noexcept requires (TriviallyDestructible<E>) = default;
+
+   //Non-trivial union destructor; the active member is destroyed by
+   //`Result`
+   constexpr ~Storage() noexcept {}
+  } storage;
+
+  //Destructs the encapsulated error, if present
+  constexpr void destroy() noexcept {
+   if constexpr (Destructible<E> && !TriviallyDestructible<E>) {
+    if (state == ResultState::ERR) {
+     storage.error.~E();
+    }
+   }
+  }
+
+  //Initializes storage and state from `other`; the error is copied from
+  //lvalues and moved from rvalues
+  template<typename O>
+  constexpr void init(O&& other) noexcept {
+   switch (other.state) {
+    case ResultState::OK: {
+     storage.value = other.storage.value;
+     break;
+    }
+    case ResultState::ERR: {
+     if constexpr (LValueReference<O>) {
+      std::construct_at(&storage.error, (E const&)other.storage.error);
+     } else {
+      std::construct_at(&storage.error, (E&&)other.storage.error);
+     }
+     break;
+    }
+    case ResultState::MOVED: {
+     storage._ = {};
+     break;
+    }
+   }
+   state = other.state;
+  }
+
+ public:
+  //Value constructor
+  constexpr Result(R& value) noexcept :
+   state{ResultState::OK},
+   storage{value}
+  {}
+
+  //Error copy constructor
+  constexpr Result(E const& error) noexcept :
+   state{ResultState::ERR},
+   storage{(E const&)error}
+  {}
+
+  //Error move constructor
+  constexpr Result(E&& error) noexcept :
+   state{ResultState::ERR},
+   storage{(E&&)error}
+  {}
+
+  //Trivial result copy constructor
+  constexpr Result(Result const&) noexcept
+   requires (TriviallyCopyable<E>)
+  = default;
+
+  //Result copy constructor
+  constexpr Result(Result const& other) noexcept :
+   state{ResultState::MOVED},
+   storage{}
+  {
+   init((Result const&)other);
+  }
+
+  //Trivial result move constructor
+  constexpr Result(Result&&) noexcept requires (TriviallyCopyable<E>) = default;
+
+  //Result move constructor
+  constexpr Result(Result&& other) noexcept :
+   state{ResultState::MOVED},
+   storage{}
+  {
+   init((Result&&)other);
+  }
+
+  //Trivial destructor
+  constexpr ~Result() noexcept requires (TriviallyDestructible<E>) = default;
+
+  //Destructor
+  constexpr ~Result() noexcept {
+   destroy();
+  }
+
+  //Trivial result copy-assignment operator
+  constexpr Result& operator=(Result const&) noexcept
+   requires (TriviallyCopyable<E>)
+  = default;
+
+  //Result copy-assignment operator
+  constexpr Result& operator=(Result const& other) noexcept {
+   if (this != &other) {
+    destroy();
+    init((Result const&)other);
+   }
+   return *this;
+  }
+
+  //Trivial result move-assignment operator
+  constexpr Result& operator=(Result&&) noexcept
+   requires (TriviallyCopyable<E>)
+  = default;
+
+  //Result move-assignment operator
+  constexpr Result& operator=(Result&& other) noexcept {
+   if (this != &other) {
+    destroy();
+    init((Result&&)other);
+   }
+   return *this;
+  }
+
+  //Value presence check
+  constexpr bool hasValue() const noexcept {
+   return state == ResultState::OK;
+  }
+
+  //Error presence check
+  constexpr bool hasError() const noexcept {
+   return state == ResultState::ERR;
+  }
+
+  //Value presence implicit conversion
+  constexpr operator bool() const noexcept {
+   return hasValue();
+  }
+
+  //"Value or immediate" operator
+  constexpr R& operator||(R& other) const noexcept {
+   return hasValue() ? *storage.value : other;
+  }
+
+  //Checked value decapsulation
+  constexpr R& operator+() const noexcept {
+   if (hasValue()) {
+    return *storage.value;
+   }
+   if (state == ResultState::MOVED) {
+    exit(ResultMovedError{});
+   } else {
+    exit(ResultValueNotPresentError{});
+   }
+  }
+
+  //Checked value decapsulation
+  constexpr R& getValue() const noexcept {
+   return +*this;
+  }
+
+  //Checked error decapsulation
+  constexpr auto& operator-() const noexcept {
+   if (hasError()) {
+    return storage.error;
+   }
+   if (state == ResultState::MOVED) {
+    exit(ResultMovedError{});
+   } else {
+    exit(ResultErrorNotPresentError{});
+   }
+  }
+
+  //Checked error decapsulation
+  constexpr auto& getError() const noexcept {
+   return -*this;
+  }
+
+  //Unchecked value decapsulation
+  constexpr R& operator!() const noexcept {
+   return *storage.value;
+  }
+
+  //Unchecked value decapsulation
+  constexpr R& value() const noexcept {
+   return !*this;
+  }
+
+  //Unchecked error decapsulation
+  constexpr auto& operator~() const noexcept {
+   return storage.error;
+  }
+
+  //Unchecked error decapsulation
+  constexpr auto& error() const noexcept {
+   return ~*this;
+  }
+ };
+
  //Result deduction guides
  //Guide for results that always hold a value
  template<typename T>
@@ -0,0 +1,1290 @@
+#pragma once
+
+#include <cx/allocator.h>
+#include <cx/common.h>
+#include <cx/idioms.h>
+#include <cx/bitset.h>
+
+namespace CX {
+ //Supporting meta-functions for `CX::RoaringBitmap`
+ namespace RoaringMetaFunctions {
+  //Element type of roaring bitmaps
+  using Value = unsigned int;
+  static_assert(sizeof(Value) == 4, "Roaring bitmaps require 32-bit values");
+
+  //Low half of a value; the position of a value within its container
+  using Low = unsigned short;
+
+  //Container representations
+  enum struct ContainerType : unsigned char {
+   //Sorted array of values
+   ARRAY,
+   //`Bitset<65536>`
+   BITSET,
+   //Sorted array of inclusive runs of consecutive values
+   RUN
+  };
+
+  //Number of values in the key space of each container
+  constexpr SizeType const ContainerBits = 65536;
+
+  //Largest cardinality of array containers; beyond 4096 values an array
+  //container is larger than a bitset container
+  constexpr SizeType const ArrayMaxCardinality = 4096;
+
+  //Bitset container type
+  using BitsetContainer = Bitset<ContainerBits>;
+
+  //Inclusive run of consecutive values
+  struct Run final {
+   Low start;
+   Low last;
+  };
+
+  //Container of all values sharing the high half `key`
+  struct Container final {
+   Low key;
+   ContainerType type;
+   //Number of values in the container; never zero
+   unsigned int cardinality;
+   //Number of elements in `data`; values for array containers, runs for
+   //run containers and `1` for bitset containers
+   unsigned int size;
+   //Number of allocated elements in `data`
+   unsigned int capacity;
+   //`Low[]`, `BitsetContainer` or `Run[]`, depending on `type`
+   void * data;
+
+   Low * values() const noexcept {
+    return (Low *)data;
+   }
+
+   BitsetContainer * bitset() const noexcept {
+    return (BitsetContainer *)data;
+   }
+
+   Run * runs() const noexcept {
+    return (Run *)data;
+   }
+  };
+
+  //Returns the high half of `value`
+  constexpr Low highOf(Value const value) noexcept {
+   return (Low)(value >> 16);
+  }
+
+  //Returns the low half of `value`
+  constexpr Low lowOf(Value const value) noexcept {
+   return (Low)(value & 0xFFFF);
+  }
+
+  //Returns the index of the first element of `values` not less than
+  //`value`
+  inline SizeType lowerBound(
+   Low const * const values,
+   SizeType const size,
+   Low const value
+  ) noexcept {
+   SizeType low = 0;
+   SizeType high = size;
+   while (low < high) {
+    auto const middle = low + (high - low) / 2;
+    if (values[middle] < value) {
+     low = middle + 1;
+    } else {
+     high = middle;
+    }
+   }
+   return low;
+  }
+
+  //Returns the index of the last run starting at or before `value`, or
+  //`size` if there is none
+  inline SizeType runAt(
+   Run const * const runs,
+   SizeType const size,
+   Low const value
+  ) noexcept {
+   SizeType low = 0;
+   SizeType high = size;
+   while (low < high) {
+    auto const middle = low + (high - low) / 2;
+    if (runs[middle].start <= value) {
+     low = middle + 1;
+    } else {
+     high = middle;
+    }
+   }
+   return low == 0 ? size : low - 1;
+  }
+
+  //Returns whether `container` holds `value`
+  inline bool contains(Container const& container, Low const value) noexcept {
+   switch (container.type) {
+    case ContainerType::ARRAY: {
+     auto const index = lowerBound(container.values(), container.size, value);
+     return index < container.size && container.values()[index] == value;
+    }
+    case ContainerType::BITSET: {
+     return container.bitset()->get(value);
+    }
+    case ContainerType::RUN: {
+     auto const index = runAt(container.runs(), container.size, value);
+     return index < container.size && value <= container.runs()[index].last;
+    }
+   }
+   return false;
+  }
+
+  //Returns the number of runs of consecutive values in `container`
+  inline SizeType runCount(Container const& container) noexcept {
+   switch (container.type) {
+    case ContainerType::ARRAY: {
+     SizeType runs = 0;
+     for (SizeType i = 0; i < container.size; i++) {
+      if (i == 0 || container.values()[i] != container.values()[i - 1] + 1) {
+       runs++;
+      }
+     }
+     return runs;
+    }
+    case ContainerType::BITSET: {
+     return container.bitset()->runCount();
+    }
+    case ContainerType::RUN: {
+     return container.size;
+    }
+   }
+   return 0;
+  }
+
+  //Returns the number of values held by both containers
+  inline SizeType intersectCardinality(Container const& a, Container const& b)
+   noexcept
+  {
+   //Order operands by type to halve the number of cases
+   if (a.type > b.type) {
+    return intersectCardinality(b, a);
+   }
+   SizeType total = 0;
+   if (a.type == ContainerType::ARRAY && b.type == ContainerType::ARRAY) {
+    SizeType i = 0;
+    SizeType j = 0;
+    while (i < a.size && j < b.size) {
+     auto const x = a.values()[i];
+     auto const y = b.values()[j];
+     total += x == y;
+     i += x <= y;
+     j += y <= x;
+    }
+   } else if (a.type == ContainerType::BITSET && b.type == ContainerType::BITSET) {
+    total = a.bitset()->intersectCount(*b.bitset());
+   } else if (a.type == ContainerType::RUN && b.type == ContainerType::RUN) {
+    SizeType i = 0;
+    SizeType j = 0;
+    while (i < a.size && j < b.size) {
+     auto const x = a.runs()[i];
+     auto const y = b.runs()[j];
+     auto const start = x.start > y.start ? x.start : y.start;
+     auto const last = x.last < y.last ? x.last : y.last;
+     if (start <= last) {
+      total += (SizeType)(last - start) + 1;
+     }
+     i += x.last <= y.last;
+     j += y.last <= x.last;
+    }
+   } else if (b.type == ContainerType::RUN) {
+    //Array or bitset against runs
+    for (SizeType i = 0; i < b.size; i++) {
+     auto const run = b.runs()[i];
+     if (a.type == ContainerType::ARRAY) {
+      total += lowerBound(a.values(), a.size, run.last)
+       - lowerBound(a.values(), a.size, run.start)
+       + contains(a, run.last);
+     } else {
+      total += a.bitset()->rank((SizeType)run.last + 1)
+       - a.bitset()->rank(run.start);
+     }
+    }
+   } else {
+    //Array against bitset
+    for (SizeType i = 0; i < a.size; i++) {
+     total += b.bitset()->get(a.values()[i]);
+    }
+   }
+   return total;
+  }
+
+  //Invokes `op` with every value of `container`, in ascending order
+  template<typename Op>
+  void forEach(Container const& container, Op&& op) {
+   auto const high = (Value)container.key << 16;
+   switch (container.type) {
+    case ContainerType::ARRAY: {
+     for (SizeType i = 0; i < container.size; i++) {
+      op(high | container.values()[i]);
+     }
+     break;
+    }
+    case ContainerType::BITSET: {
+     for (auto const index : container.bitset()->setBits()) {
+      op(high | (Value)index);
+     }
+     break;
+    }
+    case ContainerType::RUN: {
+     for (SizeType i = 0; i < container.size; i++) {
+      auto const run = container.runs()[i];
+      for (Value value = run.start; value <= run.last; value++) {
+       op(high | value);
+      }
+     }
+     break;
+    }
+   }
+  }
+
+  //Serialized layout:
+  // - `SerialHeader`
+  // - one `SerialContainer` per container, in ascending key order
+  // - container payloads, each aligned to 8 bytes: `Low[size]` for array
+  //   containers, the 1024 words of a `Bitset<65536>` for bitset containers
+  //   and `Run[size]` for run containers
+  //All fields are stored in native byte order
+  struct SerialHeader final {
+   unsigned int magic;
+   unsigned int containers;
+  };
+
+  struct SerialContainer final {
+   Low key;
+   ContainerType type;
+   unsigned char reserved;
+   unsigned int cardinality;
+   unsigned int size;
+   //Byte offset of the payload from the start of the serialized bitmap
+   unsigned int offset;
+  };
+  static_assert(sizeof(SerialContainer) == 16);
+
+  //Serialized bitmap identifier, "CXRB"
+  constexpr unsigned int const SerialMagic = 0x42525843;
+
+  //Alignment of serialized payloads and of serialized bitmaps
+  constexpr SizeType const SerialAlignment = alignof(BitsetMetaFunctions::Word);
+
+  //Returns `offset` rounded up to `SerialAlignment`
+  constexpr SizeType serialAlign(SizeType const offset) noexcept {
+   return (offset + SerialAlignment - 1) & ~(SerialAlignment - 1);
+  }
+
+  //Returns the size of a serialized container payload
+  constexpr SizeType payloadBytes(ContainerType const type, SizeType const size)
+   noexcept
+  {
+   switch (type) {
+    case ContainerType::ARRAY: {
+     return size * sizeof(Low);
+    }
+    case ContainerType::BITSET: {
+     return sizeof(BitsetContainer);
+    }
+    case ContainerType::RUN: {
+     return size * sizeof(Run);
+    }
+   }
+   return 0;
+  }
+ }
+
+ //Read-only view of a serialized `CX::RoaringBitmap`. Containers are read
+ //in place, so the view can be placed over memory-mapped files without
+ //deserializing them. The viewed bytes must outlive the view
+ struct RoaringView final {
+  using Value = RoaringMetaFunctions::Value;
+
+ private:
+  unsigned char const * bytes;
+  SizeType containers;
+
+  //Reads the directory entry for container `index`
+  RoaringMetaFunctions::SerialContainer entry(SizeType const index)
+   const noexcept
+  {
+   RoaringMetaFunctions::SerialContainer result;
+   __builtin_memcpy(
+    &result,
+    bytes
+     + sizeof(RoaringMetaFunctions::SerialHeader)
+     + index * sizeof(RoaringMetaFunctions::SerialContainer),
+    sizeof(result)
+   );
+   return result;
+  }
+
+  //Returns the index of the container for `key`, or `containerCount()` if
+  //there is none
+  SizeType find(RoaringMetaFunctions::Low const key) const noexcept {
+   SizeType low = 0;
+   SizeType high = containers;
+   while (low < high) {
+    auto const middle = low + (high - low) / 2;
+    if (entry(middle).key < key) {
+     low = middle + 1;
+    } else {
+     high = middle;
+    }
+   }
+   return low < containers && entry(low).key == key ? low : containers;
+  }
+
+ public:
+  //Returns whether `size` bytes at `bytes` hold a well-formed serialized
+  //bitmap. Validates the header, the directory, payload bounds and payload
+  //contents: arrays must be strictly increasing and hold at most
+  //`ArrayMaxCardinality` values, runs must be ordered and disjoint, and
+  //the values of each container must add up to its cardinality
+  static bool validate(unsigned char const * const bytes, SizeType const size)
+   noexcept
+  {
+   using namespace RoaringMetaFunctions;
+   if (!bytes
+    || (SizeType)bytes % SerialAlignment != 0
+    || size < sizeof(SerialHeader)
+   ) {
+    return false;
+   }
+   SerialHeader header;
+   __builtin_memcpy(&header, bytes, sizeof(header));
+   auto const directoryEnd = sizeof(SerialHeader)
+    + (SizeType)header.containers * sizeof(SerialContainer);
+   if (header.magic != SerialMagic || directoryEnd > size) {
+    return false;
+   }
+   RoaringView const view{bytes};
+   for (SizeType i = 0; i < header.containers; i++) {
+    auto const container = view.entry(i);
+    if (i > 0 && view.entry(i - 1).key >= container.key) {
+     return false;
+    }
+    if (container.cardinality == 0 || container.cardinality > ContainerBits) {
+     return false;
+    }
+    switch (container.type) {
+     case ContainerType::ARRAY: {
+      if (container.size != container.cardinality
+       || container.cardinality > ArrayMaxCardinality
+      ) {
+       return false;
+      }
+      break;
+     }
+     case ContainerType::BITSET: {
+      if (container.size != 1) {
+       return false;
+      }
+      break;
+     }
+     case ContainerType::RUN: {
+      if (container.size == 0 || container.size > ContainerBits / 2) {
+       return false;
+      }
+      break;
+     }
+     default: {
+      return false;
+     }
+    }
+    if (container.offset < directoryEnd
+     || container.offset % SerialAlignment != 0
+     || container.offset + payloadBytes(container.type, container.size) > size
+    ) {
+     return false;
+    }
+    auto const payload = bytes + container.offset;
+    switch (container.type) {
+     case ContainerType::ARRAY: {
+      auto const values = (Low const *)payload;
+      for (SizeType j = 1; j < container.size; j++) {
+       if (values[j - 1] >= values[j]) {
+        return false;
+       }
+      }
+      break;
+     }
+     case ContainerType::BITSET: {
+      if (((BitsetContainer const *)payload)->count() != container.cardinality) {
+       return false;
+      }
+      break;
+     }
+     case ContainerType::RUN: {
+      auto const runs = (Run const *)payload;
+      SizeType total = 0;
+      for (SizeType j = 0; j < container.size; j++) {
+       if (runs[j].start > runs[j].last
+        || (j > 0 && runs[j - 1].last >= runs[j].start)
+       ) {
+        return false;
+       }
+       total += (SizeType)runs[j].last - runs[j].start + 1;
+      }
+      if (total != container.cardinality) {
+       return false;
+      }
+      break;
+     }
+    }
+   }
+   return true;
+  }
+
+  //Constructs a view of the serialized bitmap at `bytes`; `bytes` must
+  //satisfy `validate`
+  explicit RoaringView(unsigned char const * const bytes) noexcept :
+   bytes(bytes)
+  {
+   RoaringMetaFunctions::SerialHeader header;
+   __builtin_memcpy(&header, bytes, sizeof(header));
+   containers = header.containers;
+  }
+
+  //Returns the number of containers
+  SizeType containerCount() const noexcept {
+   return containers;
+  }
+
+  //Returns container `index`, referring to the viewed bytes
+  RoaringMetaFunctions::Container container(SizeType const index)
+   const noexcept
+  {
+   auto const serial = entry(index);
+   return {
+    serial.key,
+    serial.type,
+    serial.cardinality,
+    serial.size,
+    0,
+    (void *)(bytes + serial.offset)
+   };
+  }
+
+  //Returns the number of values in the bitmap
+  SizeType cardinality() const noexcept {
+   SizeType total = 0;
+   for (SizeType i = 0; i < containers; i++) {
+    total += entry(i).cardinality;
+   }
+   return total;
+  }
+
+  //Returns whether the bitmap holds `value`
+  bool contains(Value const value) const noexcept {
+   auto const index = find(RoaringMetaFunctions::highOf(value));
+   return index < containers && RoaringMetaFunctions::contains(
+    container(index),
+    RoaringMetaFunctions::lowOf(value)
+   );
+  }
+
+  //Invokes `op` with every value of the bitmap, in ascending order
+  template<typename Op>
+  void forEach(Op&& op) const {
+   for (SizeType i = 0; i < containers; i++) {
+    RoaringMetaFunctions::forEach(container(i), op);
+   }
+  }
+ };
+
+ //Compressed bitmap over the 32-bit value space. Values are partitioned
+ //into containers by their high 16 bits; each container stores the low 16
+ //bits of its values as a sorted array (at most 4096 values), a
+ //`Bitset<65536>`, or a sorted array of runs. Array and bitset containers
+ //are converted into each other as their cardinality crosses 4096;
+ //`optimize` additionally converts every container into the smallest of
+ //the three representations
+ //Note: Containers are allocated individually with `A`; stateful
+ //allocators are not supported
+ //TODO Support stateful allocators
+ template<template<typename...> typename A = Allocator>
+ requires IsStatelessAllocator<A>
+ struct RoaringBitmap final {
+  using Value = RoaringMetaFunctions::Value;
+  using ContainerType = RoaringMetaFunctions::ContainerType;
+
+ private:
+  using Low = RoaringMetaFunctions::Low;
+  using Run = RoaringMetaFunctions::Run;
+  using Container = RoaringMetaFunctions::Container;
+  using BitsetContainer = RoaringMetaFunctions::BitsetContainer;
+
+  //Containers in ascending key order
+  Container * containers = nullptr;
+  SizeType count = 0;
+  SizeType capacity = 0;
+
+  template<typename T>
+  static T * allocate(SizeType const n) noexcept {
+   return &unwrapAllocation(A<T>::allocate(n));
+  }
+
+  //Resizes an allocation of `previous` objects to `n` objects, in place
+  //when `A` supports it
+  template<typename T>
+  static T * reallocate(
+   T * const data,
+   SizeType const previous,
+   SizeType const n
+  ) noexcept {
+   Never stateless;
+   return &unwrapAllocation(CX::reallocate<A>(stateless, *data, previous, n));
+  }
+
+  template<typename T>
+  static void deallocate(T * const data, SizeType const n) noexcept {
+   A<T>::deallocate(*data, n);
+  }
+
+  //Releases the storage of `container`
+  static void release(Container& container) noexcept {
+   switch (container.type) {
+    case ContainerType::ARRAY: {
+     deallocate(container.values(), container.capacity);
+     break;
+    }
+    case ContainerType::BITSET: {
+     deallocate(container.bitset(), 1);
+     break;
+    }
+    case ContainerType::RUN: {
+     deallocate(container.runs(), container.capacity);
+     break;
+    }
+   }
+  }
+
+  //Returns an empty array container with room for `capacity` values
+  static Container newArray(Low const key, SizeType capacity) noexcept {
+   capacity = capacity ? capacity : 1;
+   return {
+    key,
+    ContainerType::ARRAY,
+    0,
+    0,
+    (unsigned int)capacity,
+    allocate<Low>(capacity)
+   };
+  }
+
+  //Returns an empty bitset container
+  static Container newBitset(Low const key) noexcept {
+   auto const bitset = allocate<BitsetContainer>(1);
+   std::construct_at(bitset);
+   return {key, ContainerType::BITSET, 0, 1, 1, bitset};
+  }
+
+  //Returns a deep copy of `container`
+  static Container copy(Container const& container) noexcept {
+   auto result = container;
+   result.capacity = container.size;
+   switch (container.type) {
+    case ContainerType::ARRAY: {
+     result.data = allocate<Low>(result.capacity);
+     __builtin_memcpy(
+      result.data,
+      container.data,
+      container.size * sizeof(Low)
+     );
+     break;
+    }
+    case ContainerType::BITSET: {
+     auto const bitset = allocate<BitsetContainer>(1);
+     std::construct_at(bitset, *container.bitset());
+     result.data = bitset;
+     break;
+    }
+    case ContainerType::RUN: {
+     result.data = allocate<Run>(result.capacity);
+     __builtin_memcpy(
+      result.data,
+      container.data,
+      container.size * sizeof(Run)
+     );
+     break;
+    }
+   }
+   return result;
+  }
+
+  //Converts `container` into a bitset container
+  static void toBitset(Container& container) noexcept {
+   if (container.type == ContainerType::BITSET) {
+    return;
+   }
+   auto result = newBitset(container.key);
+   auto& bitset = *result.bitset();
+   if (container.type == ContainerType::ARRAY) {
+    for (SizeType i = 0; i < container.size; i++) {
+     bitset.set(container.values()[i]);
+    }
+   } else {
+    for (SizeType i = 0; i < container.size; i++) {
+     auto const run = container.runs()[i];
+     bitset.setRange(run.start, (SizeType)run.last + 1);
+    }
+   }
+   result.cardinality = container.cardinality;
+   release(container);
+   container = result;
+  }
+
+  //Converts `container` into an array container; `container` must not
+  //hold more than `ArrayMaxCardinality` values
+  static void toArray(Container& container) noexcept {
+   if (container.type == ContainerType::ARRAY) {
+    return;
+   }
+   auto result = newArray(container.key, container.cardinality);
+   RoaringMetaFunctions::forEach(container, [&](Value const value) {
+    result.values()[result.size++] = RoaringMetaFunctions::lowOf(value);
+   });
+   result.cardinality = result.size;
+   release(container);
+   container = result;
+  }
+
+  //Converts `container` into a run container
+  static void toRun(Container& container) noexcept {
+   if (container.type == ContainerType::RUN) {
+    return;
+   }
+   auto const runs = RoaringMetaFunctions::runCount(container);
+   Container result {
+    container.key,
+    ContainerType::RUN,
+    container.cardinality,
+    0,
+    (unsigned int)runs,
+    allocate<Run>(runs)
+   };
+   auto const output = result.runs();
+   if (container.type == ContainerType::ARRAY) {
+    for (SizeType i = 0; i < container.size; i++) {
+     auto const value = container.values()[i];
+     if (result.size > 0 && output[result.size - 1].last + 1 == value) {
+      output[result.size - 1].last = value;
+     } else {
+      output[result.size++] = {value, value};
+     }
+    }
+   } else {
+    //Extract runs a word at a time, using the next set and clear bits
+    auto const& bitset = *container.bitset();
+    for (auto start = bitset.findFirst();
+     start < RoaringMetaFunctions::ContainerBits;
+    ) {
+     auto const end = bitset.findNextClear(start);
+     output[result.size++] = {(Low)start, (Low)(end - 1)};
+     start = bitset.findNext(end);
+    }
+   }
+   release(container);
+   container = result;
+  }
+
+  //Converts run containers into array or bitset containers, so that they
+  //can be modified
+  static void toMutable(Container& container) noexcept {
+   if (container.type != ContainerType::RUN) {
+    return;
+   }
+   if (container.cardinality <= RoaringMetaFunctions::ArrayMaxCardinality) {
+    toArray(container);
+   } else {
+    toBitset(container);
+   }
+  }
+
+  //Converts `container` into the smallest representation of its values
+  static void optimize(Container& container) noexcept {
+   using namespace RoaringMetaFunctions;
+   auto const runBytes = runCount(container) * sizeof(Run);
+   auto const bitsetBytes = sizeof(BitsetContainer);
+   auto const arrayBytes = container.cardinality <= ArrayMaxCardinality
+    ? container.cardinality * sizeof(Low)
+    : bitsetBytes + 1;
+   if (runBytes < arrayBytes && runBytes < bitsetBytes) {
+    toRun(container);
+   } else if (arrayBytes <= bitsetBytes) {
+    toArray(container);
+   } else {
+    toBitset(container);
+   }
+  }
+
+  //Adds `value` to `container`; returns whether it was absent
+  static bool add(Container& container, Low const value) noexcept {
+   if (container.type == ContainerType::RUN) {
+    if (RoaringMetaFunctions::contains(container, value)) {
+     return false;
+    }
+    toMutable(container);
+   }
+   if (container.type == ContainerType::ARRAY) {
+    auto const values = container.values();
+    auto const index = RoaringMetaFunctions::lowerBound(
+     values,
+     container.size,
+     value
+    );
+    if (index < container.size && values[index] == value) {
+     return false;
+    }
+    if (container.size == RoaringMetaFunctions::ArrayMaxCardinality) {
+     toBitset(container);
+     return add(container, value);
+    }
+    if (container.size == container.capacity) {
+     //Grow geometrically, up to the largest array container
+     using RoaringMetaFunctions::ArrayMaxCardinality;
+     auto const grown = container.capacity * 2 < ArrayMaxCardinality
+      ? container.capacity * 2
+      : ArrayMaxCardinality;
+     container.data = reallocate(values, container.capacity, grown);
+     container.capacity = (unsigned int)grown;
+    }
+    auto const target = container.values();
+    __builtin_memmove(
+     target + index + 1,
+     target + index,
+     (container.size - index) * sizeof(Low)
+    );
+    target[index] = value;
+    container.size++;
+    container.cardinality++;
+    return true;
+   }
+   if (container.bitset()->set(value)) {
+    return false;
+   }
+   container.cardinality++;
+   return true;
+  }
+
+  //Removes `value` from `container`; returns whether it was present
+  static bool remove(Container& container, Low const value) noexcept {
+   if (!RoaringMetaFunctions::contains(container, value)) {
+    return false;
+   }
+   toMutable(container);
+   if (container.type == ContainerType::ARRAY) {
+    auto const values = container.values();
+    auto const index = RoaringMetaFunctions::lowerBound(
+     values,
+     container.size,
+     value
+    );
+    __builtin_memmove(
+     values + index,
+     values + index + 1,
+     (container.size - index - 1) * sizeof(Low)
+    );
+    container.size--;
+    container.cardinality--;
+   } else {
+    container.bitset()->set(value, false);
+    if (--container.cardinality <= RoaringMetaFunctions::ArrayMaxCardinality) {
+     toArray(container);
+    }
+   }
+   return true;
+  }
+
+  //Returns a mutable copy of `container`; run containers are expanded
+  static Container expand(Container const& container) noexcept {
+   auto result = copy(container);
+   toMutable(result);
+   return result;
+  }
+
+  //Returns the union of two containers with the same key
+  static Container unite(Container const& a, Container const& b) noexcept {
+   using namespace RoaringMetaFunctions;
+   if (a.type == ContainerType::RUN || b.type == ContainerType::RUN) {
+    auto x = expand(a);
+    auto y = expand(b);
+    auto result = unite(x, y);
+    release(x);
+    release(y);
+    return result;
+   }
+   if (a.type == ContainerType::ARRAY && b.type == ContainerType::ARRAY) {
+    if (a.cardinality + b.cardinality <= ArrayMaxCardinality) {
+     //Merge sorted arrays
+     auto result = newArray(a.key, a.cardinality + b.cardinality);
+     auto const output = result.values();
+     SizeType i = 0;
+     SizeType j = 0;
+     while (i < a.size && j < b.size) {
+      auto const x = a.values()[i];
+      auto const y = b.values()[j];
+      output[result.size++] = x < y ? x : y;
+      i += x <= y;
+      j += y <= x;
+     }
+     while (i < a.size) {
+      output[result.size++] = a.values()[i++];
+     }
+     while (j < b.size) {
+      output[result.size++] = b.values()[j++];
+     }
+     result.cardinality = result.size;
+     return result;
+    }
+    auto result = newBitset(a.key);
+    for (SizeType i = 0; i < a.size; i++) {
+     result.bitset()->set(a.values()[i]);
+    }
+    for (SizeType i = 0; i < b.size; i++) {
+     result.bitset()->set(b.values()[i]);
+    }
+    result.cardinality = (unsigned int)result.bitset()->count();
+    if (result.cardinality <= ArrayMaxCardinality) {
+     toArray(result);
+    }
+    return result;
+   }
+   if (a.type == ContainerType::BITSET && b.type == ContainerType::BITSET) {
+    auto result = copy(a);
+    *result.bitset() |= *b.bitset();
+    result.cardinality = (unsigned int)result.bitset()->count();
+    return result;
+   }
+   //Bitset and array
+   auto const& bitset = a.type == ContainerType::BITSET ? a : b;
+   auto const& array = a.type == ContainerType::BITSET ? b : a;
+   auto result = copy(bitset);
+   for (SizeType i = 0; i < array.size; i++) {
+    result.cardinality += !result.bitset()->set(array.values()[i]);
+   }
+   return result;
+  }
+
+  //Returns the intersection of two containers with the same key; the
+  //result may be empty
+  static Container intersect(Container const& a, Container const& b) noexcept {
+   using namespace RoaringMetaFunctions;
+   if (a.type == ContainerType::RUN || b.type == ContainerType::RUN) {
+    auto x = expand(a);
+    auto y = expand(b);
+    auto result = intersect(x, y);
+    release(x);
+    release(y);
+    return result;
+   }
+   if (a.type == ContainerType::BITSET && b.type == ContainerType::BITSET) {
+    auto const cardinality = a.bitset()->intersectCount(*b.bitset());
+    if (cardinality > ArrayMaxCardinality) {
+     auto result = copy(a);
+     *result.bitset() &= *b.bitset();
+     result.cardinality = (unsigned int)cardinality;
+     return result;
+    }
+    //Extract the intersection a word at a time, without materializing it
+    auto result = newArray(a.key, cardinality);
+    auto const w1 = a.bitset()->data();
+    auto const w2 = b.bitset()->data();
+    for (SizeType i = 0; i < BitsetContainer::WordCount; i++) {
+     for (auto word = w1[i] & w2[i]; word; word &= word - 1) {
+      result.values()[result.size++] = (Low)(
+       i * BitsetMetaFunctions::WordBits + (SizeType)__builtin_ctzll(word)
+      );
+     }
+    }
+    result.cardinality = result.size;
+    return result;
+   }
+   if (a.type == ContainerType::ARRAY && b.type == ContainerType::ARRAY) {
+    auto result = newArray(a.key, a.size < b.size ? a.size : b.size);
+    SizeType i = 0;
+    SizeType j = 0;
+    while (i < a.size && j < b.size) {
+     auto const x = a.values()[i];
+     auto const y = b.values()[j];
+     if (x == y) {
+      result.values()[result.size++] = x;
+     }
+     i += x <= y;
+     j += y <= x;
+    }
+    result.cardinality = result.size;
+    return result;
+   }
+   //Array and bitset
+   auto const& bitset = a.type == ContainerType::BITSET ? a : b;
+   auto const& array = a.type == ContainerType::BITSET ? b : a;
+   auto result = newArray(a.key, array.size);
+   for (SizeType i = 0; i < array.size; i++) {
+    auto const value = array.values()[i];
+    if (bitset.bitset()->get(value)) {
+     result.values()[result.size++] = value;
+    }
+   }
+   result.cardinality = result.size;
+   return result;
+  }
+
+  //Returns the index of the first container with a key not less than
+  //`key`
+  SizeType lowerBound(Low const key) const noexcept {
+   SizeType low = 0;
+   SizeType high = count;
+   while (low < high) {
+    auto const middle = low + (high - low) / 2;
+    if (containers[middle].key < key) {
+     low = middle + 1;
+    } else {
+     high = middle;
+    }
+   }
+   return low;
+  }
+
+  //Replaces the container buffer with one holding `required` containers
+  void reserve(SizeType const required) noexcept {
+   if (required <= capacity) {
+    return;
+   }
+   auto const grown = capacity * 2 > required ? capacity * 2 : required;
+   containers = containers
+    ? reallocate(containers, capacity, grown)
+    : allocate<Container>(grown);
+   capacity = grown;
+  }
+
+  //Releases all containers
+  void clear() noexcept {
+   for (SizeType i = 0; i < count; i++) {
+    release(containers[i]);
+   }
+   if (containers) {
+    deallocate(containers, capacity);
+   }
+   containers = nullptr;
+   count = 0;
+   capacity = 0;
+  }
+
+  //Appends a container; containers must be appended in ascending key order
+  void append(Container const& container) noexcept {
+   reserve(count + 1);
+   containers[count++] = container;
+  }
+
+ public:
+  //Default constructor; constructs an empty bitmap
+  RoaringBitmap() noexcept = default;
+
+  //Copy-constructor
+  RoaringBitmap(RoaringBitmap const& other) noexcept {
+   reserve(other.count);
+   for (SizeType i = 0; i < other.count; i++) {
+    containers[i] = copy(other.containers[i]);
+   }
+   count = other.count;
+  }
+
+  //Move-constructor; leaves `other` empty
+  RoaringBitmap(RoaringBitmap&& other) noexcept :
+   containers(other.containers),
+   count(other.count),
+   capacity(other.capacity)
+  {
+   other.containers = nullptr;
+   other.count = 0;
+   other.capacity = 0;
+  }
+
+  //Deserializes the bitmap viewed by `view`
+  explicit RoaringBitmap(RoaringView const& view) noexcept {
+   reserve(view.containerCount());
+   for (SizeType i = 0; i < view.containerCount(); i++) {
+    containers[i] = copy(view.container(i));
+   }
+   count = view.containerCount();
+  }
+
+  //Destructor; releases all containers
+  ~RoaringBitmap() noexcept {
+   clear();
+  }
+
+  //Copy-assignment operator
+  RoaringBitmap& operator=(RoaringBitmap const& other) noexcept {
+   if (this != &other) {
+    RoaringBitmap copy{other};
+    *this = (RoaringBitmap&&)copy;
+   }
+   return *this;
+  }
+
+  //Move-assignment operator; leaves `other` empty
+  RoaringBitmap& operator=(RoaringBitmap&& other) noexcept {
+   if (this != &other) {
+    clear();
+    containers = other.containers;
+    count = other.count;
+    capacity = other.capacity;
+    other.containers = nullptr;
+    other.count = 0;
+    other.capacity = 0;
+   }
+   return *this;
+  }
+
+  //Adds `value`; returns whether it was absent
+  bool add(Value const value) noexcept {
+   auto const key = RoaringMetaFunctions::highOf(value);
+   auto const index = lowerBound(key);
+   if (index == count || containers[index].key != key) {
+    reserve(count + 1);
+    __builtin_memmove(
+     containers + index + 1,
+     containers + index,
+     (count - index) * sizeof(Container)
+    );
+    containers[index] = newArray(key, 4);
+    count++;
+   }
+   return add(containers[index], RoaringMetaFunctions::lowOf(value));
+  }
+
+  //Removes `value`; returns whether it was present
+  bool remove(Value const value) noexcept {
+   auto const key = RoaringMetaFunctions::highOf(value);
+   auto const index = lowerBound(key);
+   if (index == count || containers[index].key != key) {
+    return false;
+   }
+   auto& container = containers[index];
+   if (!remove(container, RoaringMetaFunctions::lowOf(value))) {
+    return false;
+   }
+   if (container.cardinality == 0) {
+    release(container);
+    __builtin_memmove(
+     containers + index,
+     containers + index + 1,
+     (count - index - 1) * sizeof(Container)
+    );
+    count--;
+   }
+   return true;
+  }
+
+  //Returns whether the bitmap holds `value`
+  bool contains(Value const value) const noexcept {
+   auto const key = RoaringMetaFunctions::highOf(value);
+   auto const index = lowerBound(key);
+   return index < count
+    && containers[index].key == key
+    && RoaringMetaFunctions::contains(
+     containers[index],
+     RoaringMetaFunctions::lowOf(value)
+    );
+  }
+
+  //Returns the number of values in the bitmap
+  SizeType cardinality() const noexcept {
+   SizeType total = 0;
+   for (SizeType i = 0; i < count; i++) {
+    total += containers[i].cardinality;
+   }
+   return total;
+  }
+
+  //Returns whether the bitmap holds no values
+  bool empty() const noexcept {
+   return count == 0;
+  }
+
+  //Returns the number of containers
+  SizeType containerCount() const noexcept {
+   return count;
+  }
+
+  //Returns the number of containers with the representation `type`
+  SizeType containerCount(ContainerType const type) const noexcept {
+   SizeType total = 0;
+   for (SizeType i = 0; i < count; i++) {
+    total += containers[i].type == type;
+   }
+   return total;
+  }
+
+  //Converts every container into the smallest of the array, bitset and run
+  //representations of its values
+  void optimize() noexcept {
+   for (SizeType i = 0; i < count; i++) {
+    optimize(containers[i]);
+   }
+  }
+
+  //Invokes `op` with every value of the bitmap, in ascending order
+  template<typename Op>
+  void forEach(Op&& op) const {
+   for (SizeType i = 0; i < count; i++) {
+    RoaringMetaFunctions::forEach(containers[i], op);
+   }
+  }
+
+  //Returns the number of values held by both `*this` and `other`, without
+  //materializing the intersection
+  SizeType intersectCardinality(RoaringBitmap const& other) const noexcept {
+   SizeType total = 0;
+   SizeType i = 0;
+   SizeType j = 0;
+   while (i < count && j < other.count) {
+    auto const& a = containers[i];
+    auto const& b = other.containers[j];
+    if (a.key == b.key) {
+     total += RoaringMetaFunctions::intersectCardinality(a, b);
+    }
+    i += a.key <= b.key;
+    j += b.key <= a.key;
+   }
+   return total;
+  }
+
+  //Equality; bitmaps are equal when they hold the same values, regardless
+  //of their container representations
+  bool operator==(RoaringBitmap const& other) const noexcept {
+   if (count != other.count) {
+    return false;
+   }
+   for (SizeType i = 0; i < count; i++) {
+    auto const& a = containers[i];
+    auto const& b = other.containers[i];
+    if (a.key != b.key
+     || a.cardinality != b.cardinality
+     || RoaringMetaFunctions::intersectCardinality(a, b) != a.cardinality
+    ) {
+     return false;
+    }
+   }
+   return true;
+  }
+
+  //Union
+  RoaringBitmap operator|(RoaringBitmap const& other) const noexcept {
+   return RoaringBitmap{*this} |= other;
+  }
+
+  //Intersection
+  RoaringBitmap operator&(RoaringBitmap const& other) const noexcept {
+   RoaringBitmap result;
+   SizeType i = 0;
+   SizeType j = 0;
+   while (i < count && j < other.count) {
+    auto const& a = containers[i];
+    auto const& b = other.containers[j];
+    if (a.key == b.key) {
+     auto container = intersect(a, b);
+     if (container.cardinality) {
+      result.append(container);
+     } else {
+      release(container);
+     }
+    }
+    i += a.key <= b.key;
+    j += b.key <= a.key;
+   }
+   return result;
+  }
+
+  //Union assignment operator
+  RoaringBitmap& operator|=(RoaringBitmap const& other) noexcept {
+   if (this == &other) {
+    return *this;
+   }
+   //Merge the container lists into a new buffer
+   RoaringBitmap result;
+   result.reserve(count + other.count);
+   SizeType i = 0;
+   SizeType j = 0;
+   while (i < count || j < other.count) {
+    if (j == other.count
+     || (i < count && containers[i].key < other.containers[j].key)
+    ) {
+     //Containers only in `*this` are moved
+     result.containers[result.count++] = containers[i++];
+    } else if (i == count || other.containers[j].key < containers[i].key) {
+     result.containers[result.count++] = copy(other.containers[j++]);
+    } else {
+     result.containers[result.count++] = unite(
+      containers[i],
+      other.containers[j++]
+     );
+     release(containers[i++]);
+    }
+   }
+   //All containers have been moved or released
+   count = 0;
+   return *this = (RoaringBitmap&&)result;
+  }
+
+  //Intersection assignment operator
+  RoaringBitmap& operator&=(RoaringBitmap const& other) noexcept {
+   if (this != &other) {
+    *this = *this & other;
+   }
+   return *this;
+  }
+
+  //Returns the size of the serialized bitmap, in bytes
+  SizeType serializedSize() const noexcept {
+   using namespace RoaringMetaFunctions;
+   auto size = sizeof(SerialHeader) + count * sizeof(SerialContainer);
+   for (SizeType i = 0; i < count; i++) {
+    size = serialAlign(size)
+     + payloadBytes(containers[i].type, containers[i].size);
+   }
+   return size;
+  }
+
+  //Serializes the bitmap to `serializedSize()` bytes at `output`, which
+  //must be aligned to `alignof(unsigned long long)`. The result can be
+  //viewed in place with `CX::RoaringView`. Returns the number of bytes
+  //written
+  SizeType serialize(unsigned char * const output) const noexcept {
+   using namespace RoaringMetaFunctions;
+   SerialHeader const header{SerialMagic, (unsigned int)count};
+   __builtin_memcpy(output, &header, sizeof(header));
+   auto offset = sizeof(SerialHeader) + count * sizeof(SerialContainer);
+   for (SizeType i = 0; i < count; i++) {
+    auto const& container = containers[i];
+    //Zero alignment padding
+    auto const aligned = serialAlign(offset);
+    __builtin_memset(output + offset, 0, aligned - offset);
+    offset = aligned;
+    SerialContainer const entry {
+     container.key,
+     container.type,
+     0,
+     container.cardinality,
+     container.size,
+     (unsigned int)offset
+    };
+    __builtin_memcpy(
+     output + sizeof(SerialHeader) + i * sizeof(SerialContainer),
+     &entry,
+     sizeof(entry)
+    );
+    auto const bytes = payloadBytes(container.type, container.size);
+    __builtin_memcpy(output + offset, container.data, bytes);
+    offset += bytes;
+   }
+   return offset;
+  }
+ };
+}
@@ -0,0 +1,591 @@
+#pragma once
+
+//Dependencies for mapping memory with libc
+//Note: Included before any CX headers since system headers may depend on
+//exceptions.
+#ifdef CX_LIBC_SUPPORT
+ #include <sys/mman.h>
+#endif
+
+#include <cx/common.h>
+#include <cx/idioms.h>
+#include <cx/error.h>
+#include <cx/exit.h>
+#include <cx/alloc-result.h>
+#include <cx/spinlock.h>
+#include <cx/thread.h>
+
+//Without libc, memory is mapped with raw system calls
+#if !defined(CX_LIBC_SUPPORT) \
+ && !(defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__)))
+ #error \
+  <cx/sizeclass.h> requires libc support, or Linux on x86-64 or AArch64.
+#endif
+
+//Forward-declare `std::allocator` for constant-evaluated allocations; it is
+//defined by <cx/allocator.h> in builds without STL support
+#ifndef CX_STL_SUPPORT
+ namespace std {
+  template<typename>
+  struct allocator;
+ }
+#endif
+
+//Size-class segregated allocator, suitable as the default CX allocator. It
+//only depends on the ability to map memory, so it is also available in
+//builds without STL or libc support (on Linux). Must be included before
+//<cx/allocator.h>:
+// #include <cx/sizeclass.h>
+// #define CX_ALLOC_USER_IMPL CX::SizeClassAllocator
+// #include <cx/allocator.h>
+namespace CX {
+ //Supporting meta-functions for `CX::SizeClassHeap`
+ namespace SizeClassMetaFunctions {
+  //Spacing of the smallest size classes, and minimum object alignment
+  constexpr SizeType const Granularity = 16;
+
+  //Number of size classes spaced by `Granularity`; up to 128 bytes
+  constexpr SizeType const LinearClasses = 8;
+
+  //Number of size classes between successive powers of two, above 128
+  //bytes
+  constexpr SizeType const ClassesPerDoubling = 4;
+
+  //Largest size class; larger requests are mapped individually
+  constexpr SizeType const MaxClassSize = 256 * 1024;
+
+  //Number of size classes
+  constexpr SizeType const ClassCount = LinearClasses + ClassesPerDoubling * 11;
+
+  constexpr SizeType const PageSize = 4096;
+
+  //Size and alignment of regions mapped for spans; matches the size of huge
+  //pages, so that regions can be backed by transparent huge pages
+  constexpr SizeType const RegionSize = 2 << 20;
+
+  //Minimum size of the span of memory carved into objects of a size class
+  constexpr SizeType const MinSpanSize = 64 << 10;
+
+  //Approximate number of bytes moved between thread caches and central
+  //free lists at a time
+  constexpr SizeType const BatchBytes = 16 << 10;
+
+  //Returns `value` rounded up to `alignment`, which must be a power of two
+  constexpr SizeType alignUp(SizeType const value, SizeType const alignment)
+   noexcept
+  {
+   return (value + alignment - 1) & ~(alignment - 1);
+  }
+
+  //Returns the index of the smallest size class holding `size` bytes;
+  //`size` must not exceed `MaxClassSize`
+  constexpr SizeType classIndex(SizeType const size) noexcept {
+   if (size <= LinearClasses * Granularity) {
+    return size ? (size - 1) / Granularity : 0;
+   }
+   //Four classes per power of two, selected by the two bits below the
+   //leading bit of `size - 1`
+   auto const log = sizeof(unsigned long long) * 8 - 1
+    - (SizeType)__builtin_clzll(size - 1);
+   return LinearClasses
+    + (log - 7) * ClassesPerDoubling
+    + (((size - 1) >> (log - 2)) & 3);
+  }
+
+  //Returns the object size of size class `index`
+  constexpr SizeType classSize(SizeType const index) noexcept {
+   if (index < LinearClasses) {
+    return (index + 1) * Granularity;
+   }
+   auto const k = index - LinearClasses;
+   auto const log = 7 + k / ClassesPerDoubling;
+   return ((SizeType)1 << log)
+    + (k % ClassesPerDoubling + 1) * ((SizeType)1 << (log - 2));
+  }
+  static_assert(classSize(ClassCount - 1) == MaxClassSize);
+  static_assert(classIndex(MaxClassSize) == ClassCount - 1);
+
+  //Returns the size class for `size` bytes aligned to `alignment`, or
+  //`ClassCount` if the request must be mapped individually. Objects are
+  //placed at multiples of their size within page-aligned spans, so a
+  //class satisfies an alignment when its size is a multiple of it
+  constexpr SizeType classFor(SizeType const size, SizeType const alignment)
+   noexcept
+  {
+   if (size > MaxClassSize || alignment > PageSize) {
+    return ClassCount;
+   }
+   auto index = classIndex(size);
+   while (index < ClassCount && classSize(index) % alignment) {
+    index++;
+   }
+   return index;
+  }
+
+  //Returns the number of objects moved between thread caches and central
+  //free lists at a time, for size class `index`
+  constexpr SizeType batchSize(SizeType const index) noexcept {
+   auto const count = BatchBytes / classSize(index);
+   return count < 2 ? 2 : count > 64 ? 64 : count;
+  }
+
+  //Returns the size of spans carved into objects of size class `index`
+  constexpr SizeType spanSize(SizeType const index) noexcept {
+   auto const size = 8 * classSize(index);
+   return alignUp(size < MinSpanSize ? MinSpanSize : size, PageSize);
+  }
+  static_assert(spanSize(ClassCount - 1) <= RegionSize);
+
+  //Memory mapping primitives
+  namespace System {
+   #ifndef CX_LIBC_SUPPORT
+    #if defined(__x86_64__)
+     constexpr long const MapCall = 9;
+     constexpr long const UnmapCall = 11;
+     constexpr long const AdviseCall = 28;
+    #elif defined(__aarch64__)
+     constexpr long const MapCall = 222;
+     constexpr long const UnmapCall = 215;
+     constexpr long const AdviseCall = 233;
+    #endif
+
+    //Invokes system call `number`; returns a negated `errno` on failure
+    inline long call(
+     long const number,
+     long const a = 0,
+     long const b = 0,
+     long const c = 0,
+     long const d = 0,
+     long const e = 0,
+     long const f = 0
+    ) noexcept {
+     #if defined(__x86_64__)
+      long result;
+      register long r10 __asm__("r10") = d;
+      register long r8 __asm__("r8") = e;
+      register long r9 __asm__("r9") = f;
+      __asm__ __volatile__(
+       "syscall"
+       : "=a" (result)
+       : "a" (number), "D" (a), "S" (b), "d" (c), "r" (r10), "r" (r8), "r" (r9)
+       : "rcx", "r11", "memory"
+      );
+      return result;
+     #elif defined(__aarch64__)
+      register long x8 __asm__("x8") = number;
+      register long x0 __asm__("x0") = a;
+      register long x1 __asm__("x1") = b;
+      register long x2 __asm__("x2") = c;
+      register long x3 __asm__("x3") = d;
+      register long x4 __asm__("x4") = e;
+      register long x5 __asm__("x5") = f;
+      __asm__ __volatile__(
+       "svc 0"
+       : "+r" (x0)
+       : "r" (x8), "r" (x1), "r" (x2), "r" (x3), "r" (x4), "r" (x5)
+       : "memory"
+      );
+      return x0;
+     #endif
+    }
+   #endif
+
+   //Maps `bytes` bytes of zeroed, private memory; returns `nullptr` on
+   //failure
+   inline unsigned char * map(SizeType const bytes) noexcept {
+    #ifdef CX_LIBC_SUPPORT
+     auto const result = mmap(
+      nullptr,
+      bytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0
+     );
+     return result == MAP_FAILED ? nullptr : (unsigned char *)result;
+    #else
+     //`PROT_READ | PROT_WRITE`, `MAP_PRIVATE | MAP_ANONYMOUS`
+     auto const result = call(MapCall, 0, (long)bytes, 0x3, 0x22, -1, 0);
+     return result < 0 && result > -4096 ? nullptr : (unsigned char *)result;
+    #endif
+   }
+
+   inline void unmap(unsigned char * const address, SizeType const bytes)
+    noexcept
+   {
+    if (!bytes) {
+     return;
+    }
+    #ifdef CX_LIBC_SUPPORT
+     munmap(address, bytes);
+    #else
+     call(UnmapCall, (long)address, (long)bytes);
+    #endif
+   }
+
+   //Requests transparent huge pages for a mapping; a hint
+   inline void adviseHugePages(unsigned char * const address, SizeType const bytes)
+    noexcept
+   {
+    #ifdef CX_LIBC_SUPPORT
+     #ifdef MADV_HUGEPAGE
+      madvise(address, bytes, MADV_HUGEPAGE);
+     #else
+      (void)address;
+      (void)bytes;
+     #endif
+    #else
+     //`MADV_HUGEPAGE`
+     call(AdviseCall, (long)address, (long)bytes, 14);
+    #endif
+   }
+
+   //Maps `bytes` bytes aligned to `alignment`, a power of two; returns
+   //`nullptr` on failure. The mapping spans exactly
+   //`alignUp(bytes, PageSize)` bytes
+   inline unsigned char * mapAligned(SizeType bytes, SizeType const alignment)
+    noexcept
+   {
+    bytes = alignUp(bytes, PageSize);
+    if (alignment <= PageSize) {
+     return map(bytes);
+    }
+    //Over-allocate, then trim the misaligned head and the excess tail
+    auto const mapped = map(bytes + alignment);
+    if (!mapped) {
+     return nullptr;
+    }
+    auto const aligned = (unsigned char *)alignUp((SizeType)mapped, alignment);
+    unmap(mapped, (SizeType)(aligned - mapped));
+    unmap(aligned + bytes, (SizeType)(mapped + alignment - aligned));
+    return aligned;
+   }
+  }
+
+  //Free object; overlays the storage of free objects
+  struct Node final {
+   Node * next;
+   //Next batch; only valid for the first object of a batch
+   Node * nextBatch;
+  };
+  static_assert(sizeof(Node) <= Granularity);
+
+  //Shared free lists of a size class
+  struct alignas(64) CentralList final {
+   SpinLock lock;
+   //Full batches, linked through `Node::nextBatch`
+   Node * batches = nullptr;
+   //Objects returned individually, from flushed thread caches
+   Node * singles = nullptr;
+   //Unused objects of the most recent span
+   unsigned char * carve = nullptr;
+   unsigned char * carveEnd = nullptr;
+  };
+
+  //Source of spans; bump-allocates from huge-page-aligned regions
+  struct PageHeap final {
+   SpinLock lock;
+   unsigned char * cursor = nullptr;
+   unsigned char * end = nullptr;
+   SizeType mapped = 0;
+  };
+
+  //Objects of a size class cached by a thread
+  struct ClassCache final {
+   Node * head;
+   SizeType count;
+  };
+
+  //Per-thread object caches; constant-initialized, so that access does
+  //not require guards
+  struct ThreadCache final {
+   ClassCache classes[ClassCount];
+   bool flushRegistered;
+  };
+
+  inline CentralList centralLists[ClassCount];
+  inline PageHeap pageHeap;
+  inline thread_local ThreadCache threadCache;
+ }
+
+ //Process-wide size-class segregated heap. Requests up to 256KiB are rounded
+ //up to one of 52 size classes; each thread serves them from its own cache
+ //of free objects, without synchronization. Thread caches exchange batches
+ //of objects with per-class central free lists, which carve new objects
+ //from spans of 2MiB regions mapped from the operating system. Larger
+ //requests are mapped individually. Memory of size-class objects is reused
+ //but never returned to the operating system
+ //Note: Deallocations must pass the size and alignment of the allocation
+ //Note: Cached objects of exiting threads are returned to the central free
+ //lists when thread-exit hooks are available (see `CX::onThreadExit`);
+ //otherwise threads should call `flushThreadCache()` before exiting
+ struct SizeClassHeap final {
+ private:
+  using Node = SizeClassMetaFunctions::Node;
+  using ClassCache = SizeClassMetaFunctions::ClassCache;
+
+  //Returns the thread cache to the central free lists on thread exit
+  static void flushOnThreadExit(void *) noexcept {
+   flushThreadCache();
+  }
+
+  //Returns a span of `bytes` bytes from the page heap, or `nullptr` if
+  //memory cannot be mapped
+  static unsigned char * allocateSpan(SizeType const bytes) noexcept {
+   using namespace SizeClassMetaFunctions;
+   auto& heap = pageHeap;
+   heap.lock.lock();
+   if ((SizeType)(heap.end - heap.cursor) < bytes) {
+    //Leftovers of the previous region are abandoned
+    auto const region = System::mapAligned(RegionSize, RegionSize);
+    if (!region) {
+     heap.lock.unlock();
+     return nullptr;
+    }
+    System::adviseHugePages(region, RegionSize);
+    heap.cursor = region;
+    heap.end = region + RegionSize;
+    heap.mapped += RegionSize;
+   }
+   auto const span = heap.cursor;
+   heap.cursor += bytes;
+   heap.lock.unlock();
+   return span;
+  }
+
+  //Refills an empty thread cache for size class `index`; the batch is
+  //partial, or empty, if memory cannot be mapped
+  [[gnu::noinline]]
+  static void refill(ClassCache& cache, SizeType const index) noexcept {
+   using namespace SizeClassMetaFunctions;
+   if (!threadCache.flushRegistered) {
+    threadCache.flushRegistered = true;
+    onThreadExit<&flushOnThreadExit>(&threadCache);
+   }
+   auto const batch = batchSize(index);
+   auto& central = centralLists[index];
+   central.lock.lock();
+   if (central.batches) {
+    cache.head = central.batches;
+    central.batches = central.batches->nextBatch;
+    central.lock.unlock();
+    cache.count = batch;
+    return;
+   }
+   //Assemble a batch from individually returned objects and fresh spans
+   auto const size = classSize(index);
+   Node * head = nullptr;
+   SizeType count = 0;
+   for (; count < batch; count++) {
+    Node * node;
+    if (central.singles) {
+     node = central.singles;
+     central.singles = node->next;
+    } else {
+     if (central.carve == central.carveEnd) {
+      auto const span = spanSize(index);
+      auto const carve = allocateSpan(span);
+      if (!carve) {
+       break;
+      }
+      central.carve = carve;
+      central.carveEnd = carve + span / size * size;
+     }
+     node = (Node *)central.carve;
+     central.carve += size;
+    }
+    node->next = head;
+    head = node;
+   }
+   central.lock.unlock();
+   cache.head = head;
+   cache.count = count;
+  }
+
+  //Returns a batch from an overflowing thread cache to the central free
+  //list of size class `index`
+  [[gnu::noinline]]
+  static void flush(ClassCache& cache, SizeType const index) noexcept {
+   using namespace SizeClassMetaFunctions;
+   auto const batch = batchSize(index);
+   auto const first = cache.head;
+   auto last = first;
+   for (SizeType i = 1; i < batch; i++) {
+    last = last->next;
+   }
+   cache.head = last->next;
+   cache.count -= batch;
+   last->next = nullptr;
+   auto& central = centralLists[index];
+   central.lock.lock();
+   first->nextBatch = central.batches;
+   central.batches = first;
+   central.lock.unlock();
+  }
+
+ public:
+  //Allocates `bytes` bytes aligned to `alignment`, a power of two. Returns
+  //`nullptr` if memory cannot be mapped
+  [[nodiscard]]
+  static void * allocate(SizeType const bytes, SizeType const alignment)
+   noexcept
+  {
+   using namespace SizeClassMetaFunctions;
+   auto const index = classFor(bytes, alignment);
+   if (index == ClassCount) {
+    return System::mapAligned(bytes, alignment);
+   }
+   auto& cache = threadCache.classes[index];
+   if (!cache.head) {
+    refill(cache, index);
+    if (!cache.head) {
+     return nullptr;
+    }
+   }
+   auto const node = cache.head;
+   cache.head = node->next;
+   cache.count--;
+   return node;
+  }
+
+  //Returns whether an allocation of `bytes` bytes aligned to `alignment`
+  //can be resized to `newBytes` bytes without moving it; that is, whether
+  //both sizes fall in the same size class, or span the same pages
+  static constexpr bool expand(
+   SizeType const bytes,
+   SizeType const newBytes,
+   SizeType const alignment
+  ) noexcept {
+   using namespace SizeClassMetaFunctions;
+   auto const index = classFor(bytes, alignment);
+   if (index != classFor(newBytes, alignment)) {
+    return false;
+   }
+   return index < ClassCount
+    || alignUp(bytes, PageSize) == alignUp(newBytes, PageSize);
+  }
+
+  //Frees an allocation of `bytes` bytes aligned to `alignment`
+  static void deallocate(
+   void * const address,
+   SizeType const bytes,
+   SizeType const alignment
+  ) noexcept {
+   using namespace SizeClassMetaFunctions;
+   auto const index = classFor(bytes, alignment);
+   if (index == ClassCount) {
+    System::unmap((unsigned char *)address, alignUp(bytes, PageSize));
+    return;
+   }
+   auto& cache = threadCache.classes[index];
+   auto const node = (Node *)address;
+   node->next = cache.head;
+   cache.head = node;
+   if (++cache.count >= 2 * batchSize(index)) {
+    flush(cache, index);
+   }
+  }
+
+  //Returns all objects cached by the calling thread to the central free
+  //lists
+  static void flushThreadCache() noexcept {
+   using namespace SizeClassMetaFunctions;
+   for (SizeType index = 0; index < ClassCount; index++) {
+    auto& cache = threadCache.classes[index];
+    if (!cache.head) {
+     continue;
+    }
+    auto last = cache.head;
+    while (last->next) {
+     last = last->next;
+    }
+    auto& central = centralLists[index];
+    central.lock.lock();
+    last->next = central.singles;
+    central.singles = cache.head;
+    central.lock.unlock();
+    cache.head = nullptr;
+    cache.count = 0;
+   }
+  }
+
+  //Returns the number of bytes mapped for spans
+  static SizeType mappedBytes() noexcept {
+   auto& heap = SizeClassMetaFunctions::pageHeap;
+   heap.lock.lock();
+   auto const mapped = heap.mapped;
+   heap.lock.unlock();
+   return mapped;
+  }
+ };
+
+ //Stateless allocator backed by `CX::SizeClassHeap`
+ template<typename T>
+ struct SizeClassAllocator final : Never {
+  constexpr SizeClassAllocator() noexcept = default;
+  constexpr ~SizeClassAllocator() noexcept = default;
+
+  [[nodiscard]]
+  static constexpr AllocResult<T> allocate(SizeType const n = 1) noexcept {
+   return allocate(n, alignof(T));
+  }
+
+  [[nodiscard]]
+  static constexpr AllocResult<T> allocate(
+   SizeType const n,
+   SizeType const alignment
+  ) noexcept {
+   if (!AllocatorMetaFunctions::isAlignment(alignment)) {
+    return AllocError{AllocErrorType::INVALID_ALIGNMENT};
+   }
+   SizeType bytes;
+   if (!AllocatorMetaFunctions::byteSize<T>(n, bytes)) {
+    return AllocError{AllocErrorType::SIZE_OVERFLOW};
+   }
+   if (isConstexpr()) {
+    return *std::allocator<T>{}.allocate(n);
+   }
+   auto const address = SizeClassHeap::allocate(
+    bytes,
+    alignment < alignof(T) ? alignof(T) : alignment
+   );
+   if (!address) {
+    return AllocError{AllocErrorType::OUT_OF_MEMORY};
+   }
+   return *(T *)address;
+  }
+
+  static constexpr void deallocate(T const& t, SizeType const n = 1) noexcept {
+   deallocate(t, n, alignof(T));
+  }
+
+  static constexpr void deallocate(
+   T const& t,
+   SizeType const n,
+   SizeType const alignment
+  ) noexcept {
+   if (isConstexpr()) {
+    std::allocator<T>{}.deallocate(&const_cast<T&>(t), n);
+    return;
+   }
+   SizeClassHeap::deallocate(
+    (void *)&t,
+    n * sizeof(T),
+    alignment < alignof(T) ? alignof(T) : alignment
+   );
+  }
+
+  //Resizes the allocation in place; see `SizeClassHeap::expand`
+  //Note: Only valid for allocations made with `allocate(n)`
+  static constexpr bool expand(T&, SizeType const oldN, SizeType const newN)
+   noexcept
+  {
+   if (isConstexpr()) {
+    return oldN == newN;
+   }
+   SizeType bytes;
+   return AllocatorMetaFunctions::byteSize<T>(newN, bytes)
+    && SizeClassHeap::expand(oldN * sizeof(T), bytes, alignof(T));
+  }
+ };
+}
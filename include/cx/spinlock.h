@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cx/common.h>
+
+namespace CX {
+ //Test-and-test-and-set spinlock, for short critical sections in
+ //allocator slow paths
+ struct SpinLock final {
+ private:
+  bool locked = false;
+
+ public:
+  constexpr SpinLock() noexcept = default;
+
+  SpinLock(SpinLock const&) = delete;
+  SpinLock(SpinLock&&) = delete;
+
+  void lock() noexcept {
+   while (__atomic_test_and_set(&locked, __ATOMIC_ACQUIRE)) {
+    while (__atomic_load_n(&locked, __ATOMIC_RELAXED)) {
+     #if defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+     #elif defined(__aarch64__)
+      __asm__ __volatile__("yield");
+     #endif
+    }
+   }
+  }
+
+  void unlock() noexcept {
+   __atomic_clear(&locked, __ATOMIC_RELEASE);
+  }
+ };
+}
@@ -3,6 +3,12 @@
 #include <cx/idioms.h>
 
 namespace CX {
+ //Compile-time sequence of indices
+ template<SizeType... Indices>
+ struct IndexSequence final {
+  static constexpr auto const Size = sizeof...(Indices);
+ };
+
  namespace MetaFunctions {
   //Produce max value from pack of non-type template parameters
   template<auto... Values>
@@ -308,6 +314,75 @@ namespace CX {
    static constexpr auto const Value = 0;
   };
 
+  //Concatenates two index sequences, offsetting the indices of the second
+  //sequence by the size of the first
+  template<typename, typename>
+  struct IndexSequenceJoin;
+
+  template<SizeType... Left, SizeType... Right>
+  struct IndexSequenceJoin<IndexSequence<Left...>, IndexSequence<Right...>> {
+   using Type = IndexSequence<Left..., (sizeof...(Left) + Right)...>;
+  };
+
+  //Yields `IndexSequence<0, ..., N - 1>`
+  //Note: Halves `N` at every step, so the instantiation depth is logarithmic
+  template<SizeType N>
+  struct MakeIndexSequence {
+   using Type = typename IndexSequenceJoin<
+    typename MakeIndexSequence<N / 2>::Type,
+    typename MakeIndexSequence<N - N / 2>::Type
+   >::Type;
+  };
+
+  template<>
+  struct MakeIndexSequence<0> {
+   using Type = IndexSequence<>;
+  };
+
+  template<>
+  struct MakeIndexSequence<1> {
+   using Type = IndexSequence<0>;
+  };
+
+  //Yields the indices of `Types`, stably sorted by descending alignment
+  template<typename... Types>
+  struct DescendingAlignmentOrder {
+   struct Indices final {
+    SizeType values[sizeof...(Types) > 0 ? sizeof...(Types) : 1];
+   };
+
+   static constexpr Indices const Value = []() constexpr noexcept {
+    constexpr SizeType const count = sizeof...(Types);
+    SizeType const alignments[count > 0 ? count : 1]{TypeAlignment<Types>::Value...};
+    Indices indices{};
+    for (SizeType i = 0; i < count; i++) {
+     indices.values[i] = i;
+    }
+    //Stable insertion sort
+    for (SizeType i = 1; i < count; i++) {
+     auto const index = indices.values[i];
+     auto j = i;
+     for (; j > 0 && alignments[indices.values[j - 1]] < alignments[index]; j--) {
+      indices.values[j] = indices.values[j - 1];
+     }
+     indices.values[j] = index;
+    }
+    return indices;
+   }();
+
+   template<typename>
+   struct Receiver;
+
+   template<SizeType... Positions>
+   struct Receiver<IndexSequence<Positions...>> {
+    using Type = IndexSequence<Value.values[Positions]...>;
+   };
+
+   using Type = typename Receiver<
+    typename MakeIndexSequence<sizeof...(Types)>::Type
+   >::Type;
+  };
+
   //Yields a reference to the `N`'th argument
   template<long N, typename... Args>
   requires (0 <= N && N < sizeof...(Args))
@@ -520,6 +595,16 @@ namespace CX {
   ::ValueAtIndex<Index, Values...>
   ::Value;
 
+ template<SizeType N>
+ using MakeIndexSequence = typename MetaFunctions
+  ::MakeIndexSequence<N>
+  ::Type;
+
+ template<typename... Types>
+ using DescendingAlignmentOrder = typename MetaFunctions
+  ::DescendingAlignmentOrder<Types...>
+  ::Type;
+
  template<auto N, typename... Args>
  requires (0 <= N && N < sizeof...(Args))
  auto& argumentAtIndex(Args&... args) {
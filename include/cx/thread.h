@@ -0,0 +1,74 @@
+#pragma once
+
+//Dependencies for thread-exit hooks without the STL
+//Note: Included before any CX headers since STL headers depend on exceptions.
+#if !defined(CX_STL_SUPPORT) && defined(CX_LIBC_SUPPORT)
+ #include <pthread.h>
+#endif
+
+#include <cx/common.h>
+
+namespace CX {
+ //Thread-exit hook; invoked with the argument it was registered with
+ using ThreadExitHook = void (*)(void * argument) noexcept;
+
+ //Supporting meta-functions for `CX::onThreadExit`
+ namespace ThreadMetaFunctions {
+  #if defined(CX_STL_SUPPORT)
+   //Invokes `Hook` on destruction of the thread-local registration
+   //Note: Destructors of `thread_local` objects are registered with
+   //`__cxa_thread_atexit`, provided by the C++ runtime
+   template<ThreadExitHook Hook>
+   struct ExitRegistration final {
+    void * argument = nullptr;
+
+    ~ExitRegistration() noexcept {
+     if (argument) {
+      Hook(argument);
+     }
+    }
+
+    //Returns the registration of the calling thread
+    static ExitRegistration& get() noexcept {
+     thread_local ExitRegistration registration;
+     return registration;
+    }
+   };
+  #elif defined(CX_LIBC_SUPPORT)
+   //Thread-specific key of `Hook`; its destructor invokes `Hook`
+   template<ThreadExitHook Hook>
+   struct ExitKey final {
+    static inline pthread_once_t once = PTHREAD_ONCE_INIT;
+    static inline pthread_key_t key;
+    static inline bool created = false;
+
+    static void destroy(void * const argument) noexcept {
+     Hook(argument);
+    }
+
+    static void create() noexcept {
+     created = pthread_key_create(&key, &destroy) == 0;
+    }
+   };
+  #endif
+ }
+
+ //Registers `Hook` to be invoked with `argument`, which must not be
+ //`nullptr`, when the calling thread exits. Registering `Hook` again from
+ //the same thread replaces its argument. Returns whether the hook was
+ //registered; thread-exit hooks require STL or libc (POSIX threads) support
+ template<ThreadExitHook Hook>
+ inline bool onThreadExit(void * const argument) noexcept {
+  #if defined(CX_STL_SUPPORT)
+   ThreadMetaFunctions::ExitRegistration<Hook>::get().argument = argument;
+   return true;
+  #elif defined(CX_LIBC_SUPPORT)
+   using Key = ThreadMetaFunctions::ExitKey<Hook>;
+   pthread_once(&Key::once, &Key::create);
+   return Key::created && pthread_setspecific(Key::key, argument) == 0;
+  #else
+   (void)argument;
+   return false;
+  #endif
+ }
+}
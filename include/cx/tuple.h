@@ -56,10 +56,14 @@
 #endif
 
 namespace CX {
- //Forward declare `CX::Tuple` for use with tuple meta-functions
+ //Forward declare `CX::Tuple` and `CX::PackedTuple` for use with tuple
+ //meta-functions
  template<typename...>
  struct Tuple;
 
+ template<typename...>
+ struct PackedTuple;
+
  //Supporting tuple meta-functions and concepts
  namespace TupleMetaFunctions {
   //Tuple identity and size meta-function
@@ -71,7 +75,7 @@ namespace CX {
    template<typename...> typename MaybeTuple,
    typename... Types
   >
-  requires (SameTemplateType<Tuple, MaybeTuple>)
+  requires (MatchAnyTemplateType<MaybeTuple, Tuple, PackedTuple>)
   struct IsTuple<T, MaybeTuple<Types...>> : TrueType {
    static constexpr auto const Size = sizeof...(Types);
   };
@@ -92,79 +96,377 @@ namespace CX {
 
  //Supporting tuple meta-functions and concepts
  namespace TupleMetaFunctions {
-  //Tuple element iterator
-  template<CX::IsTuple T, SizeType Index = CX::TupleSize<T>>
-  struct TupleElementIterator;
+  //Associates a tuple element type with its declared index
+  template<SizeType Index, typename T>
+  struct TupleIndexedType {
+   using Type = T;
+  };
 
-  template<CX::IsTuple T, SizeType Index>
-  struct TupleElementIterator {
-   template<CX::IsTuple, SizeType>
-   friend struct TupleElementIterator;
+  //Flat map from declared index to element type; lookup is a single
+  //base-class deduction rather than a recursive walk of the type pack
+  template<typename, typename...>
+  struct TupleTypeMap;
 
+  template<SizeType... Indices, typename... Types>
+  struct TupleTypeMap<IndexSequence<Indices...>, Types...> :
+   TupleIndexedType<Indices, Types>...
+  {
   private:
-   //TODO noexcept qualification
-   template<typename... Args>
-   static constexpr auto iterImpl(T const& tuple, auto& op, Args&... args) /*noexcept()*/ {
-    return TupleElementIterator<T, Index - 1>::iterImpl(tuple, op, args..., tuple.template get<Index - 1>());
-   }
+   template<SizeType Index, typename T>
+   static TupleIndexedType<Index, T> lookup(TupleIndexedType<Index, T> const&);
 
   public:
-   //Shim to `iterImpl`
-   //TODO noexcept qualification
-   static constexpr auto iter(T const& tuple, auto op) /*noexcept()*/ {
-    return iterImpl(tuple, op);
+   template<SizeType Index>
+   using At = typename decltype(
+    lookup<Index>(*(TupleTypeMap const *)nullptr)
+   )::Type;
+  };
+
+  //Element type at `Index` of `Types`
+  template<SizeType Index, typename... Types>
+  using TupleTypeAtIndex = typename TupleTypeMap<
+   MakeIndexSequence<sizeof...(Types)>,
+   Types...
+  >::template At<Index>;
+
+  //Tag types for selecting tuple storage constructors
+  struct TupleElementTag final {};
+  struct TupleForwardTag final {};
+
+  //Storage for a single tuple element; `Index` is the declared index of the
+  //element, which keeps leaves of identical types distinct
+  template<SizeType Index, typename T>
+  struct TupleLeaf {
+   [[no_unique_address]] T value;
+
+   constexpr TupleLeaf() noexcept(noexcept(T{}))
+    requires (Constructible<T>)
+   :
+    value{}
+   {}
+
+   template<typename Arg>
+   constexpr TupleLeaf(TupleElementTag, Arg&& arg)
+    noexcept(__is_nothrow_constructible(T, Arg&&))
+   :
+    value((Arg&&)arg)
+   {}
+
+   constexpr TupleLeaf(TupleLeaf const&) = default;
+   constexpr TupleLeaf(TupleLeaf&&) = default;
+
+   constexpr ~TupleLeaf() = default;
+
+   constexpr TupleLeaf& operator=(TupleLeaf const&) = default;
+   constexpr TupleLeaf& operator=(TupleLeaf&&) = default;
+
+   //Reference elements assign through to the referenced object, rather
+   //than rebinding
+   constexpr TupleLeaf& operator=(TupleLeaf const& other)
+    noexcept(noexcept(value = other.value))
+    requires (Reference<T> && requires (T& lhs, T& rhs) { lhs = rhs; })
+   {
+    value = other.value;
+    return *this;
+   }
+
+   constexpr TupleLeaf& operator=(TupleLeaf&& other)
+    noexcept(noexcept(value = (T&&)other.value))
+    requires (Reference<T> && requires (T& lhs, T&& rhs) { lhs = (T&&)rhs; })
+   {
+    value = (T&&)other.value;
+    return *this;
    }
   };
 
-  template<CX::IsTuple T>
-  struct TupleElementIterator<T, 0> {
-   template<CX::IsTuple, SizeType>
-   friend struct TupleElementIterator;
+  //Yields the leaf for the declared index `Index` from any tuple storage
+  template<SizeType Index, typename T>
+  constexpr TupleLeaf<Index, T>& leafAt(TupleLeaf<Index, T>& leaf) noexcept {
+   return leaf;
+  }
+
+  //Identity concept for `CX` tuples and types implementing the structured
+  //binding tuple protocol
+  template<typename T>
+  concept TupleLike = CX::IsTuple<T> || requires {
+   std::tuple_size<ConstDecayed<ReferenceDecayed<T>>>::value;
+  };
+
+  //Number of elements in the tuple-like type `T`
+  template<TupleLike T>
+  constexpr SizeType const TupleLikeSize = std::tuple_size<
+   ConstDecayed<ReferenceDecayed<T>>
+  >::value;
+
+  template<TupleLike T>
+  requires (CX::IsTuple<T>)
+  constexpr SizeType const TupleLikeSize<T> = CX::TupleSize<T>;
+
+  //Yields the element at `Index` of the tuple-like `t`, preserving the value
+  //category of `t`. Uses member `get`/`rget` where available and falls back
+  //to `get<Index>(t)`, found by ADL, for STL tuple-likes
+  template<SizeType Index, typename T>
+  constexpr auto&& tupleElement(T&& t) noexcept {
+   if constexpr (requires { t.template get<Index>(); }) {
+    if constexpr (RValueReference<T&&>) {
+     return t.template rget<Index>();
+    } else {
+     return t.template get<Index>();
+    }
+   } else {
+    return get<Index>((T&&)t);
+   }
+  }
+
+  //Invokes `op` with every element of `t` as a single argument list
+  template<typename T, typename Op, SizeType... Indices>
+  constexpr decltype(auto) apply(T&& t, Op&& op, IndexSequence<Indices...>)
+   noexcept(noexcept(((Op&&)op)(tupleElement<Indices>((T&&)t)...)))
+  {
+   return ((Op&&)op)(tupleElement<Indices>((T&&)t)...);
+  }
+
+  //Invokes `op` with a single element; `op` may take the element index as
+  //a template parameter
+  template<SizeType Index, typename Op, typename E>
+  requires (requires (Op& op, E&& e) {
+   op.template operator()<Index>((E&&)e);
+  })
+  constexpr void visit(Op& op, E&& e)
+   noexcept(noexcept(op.template operator()<Index>((E&&)e)))
+  {
+   op.template operator()<Index>((E&&)e);
+  }
+
+  template<SizeType, typename Op, typename E>
+  constexpr void visit(Op& op, E&& e) noexcept(noexcept(op((E&&)e))) {
+   op((E&&)e);
+  }
+
+  //Invokes `op` with every element of `t`, in declared order
+  template<typename T, typename Op, SizeType... Indices>
+  constexpr void forEach(T&& t, Op& op, IndexSequence<Indices...>)
+   noexcept((noexcept(visit<Indices>(op, tupleElement<Indices>((T&&)t))) && ...))
+  {
+   (visit<Indices>(op, tupleElement<Indices>((T&&)t)), ...);
+  }
+
+  //Yields a `CX::Tuple` of the results of `op` applied to every element of
+  //`t`; `op` is invoked in declared order
+  template<typename T, typename Op, SizeType... Indices>
+  constexpr auto transform(T&& t, Op& op, IndexSequence<Indices...>)
+   noexcept((noexcept(op(tupleElement<Indices>((T&&)t))) && ...)
+    && noexcept(Tuple<decltype(op(tupleElement<Indices>((T&&)t)))...>{
+     op(tupleElement<Indices>((T&&)t))...
+    })
+   )
+  {
+   return Tuple<decltype(op(tupleElement<Indices>((T&&)t)))...>{
+    op(tupleElement<Indices>((T&&)t))...
+   };
+  }
 
+  //Flat tuple storage; elements are inherited as leaves in `Order`, while
+  //all accessors use the declared index of each element
+  template<typename Indices, typename Order, typename... Types>
+  struct TupleStorage;
+
+  template<SizeType... Indices, SizeType... Positions, typename... Types>
+  struct TupleStorage<
+   IndexSequence<Indices...>,
+   IndexSequence<Positions...>,
+   Types...
+  > :
+   TupleLeaf<Positions, TupleTypeAtIndex<Positions, Types...>>...
+  {
   private:
-   //TODO noexcept qualification
+   static constexpr bool const DeclaredOrder = SameType<
+    IndexSequence<Indices...>,
+    IndexSequence<Positions...>
+   >;
+
+   using Sequence = IndexSequence<Indices...>;
+
+  public:
+   template<SizeType Index>
+   requires (Index < sizeof...(Types))
+   using ElementType = TupleTypeAtIndex<Index, Types...>;
+
+   //Value-initializes every element
+   constexpr TupleStorage()
+    requires (Constructible<Types> && ...)
+   = default;
+
+   //Constructs every element, in declared order, from `args`
    template<typename... Args>
-   static constexpr auto iterImpl(T const&, auto& op, Args&... args) {
-    return op.template operator()<Args&...>(args...);
+   requires (DeclaredOrder && sizeof...(Args) == sizeof...(Types))
+   constexpr TupleStorage(TupleElementTag, Args&&... args)
+    noexcept((__is_nothrow_constructible(Types, Args&&) && ...))
+   :
+    TupleLeaf<Indices, Types>(TupleElementTag{}, (Args&&)args)...
+   {}
+
+   //Constructs every element, in storage order, from a tuple of forwarding
+   //references
+   template<typename... Args>
+   requires (sizeof...(Args) == sizeof...(Types))
+   constexpr TupleStorage(TupleForwardTag, Tuple<Args...>&& args)
+    noexcept((__is_nothrow_constructible(Types, Args) && ...))
+   :
+    TupleLeaf<Positions, ElementType<Positions>>(
+     TupleElementTag{},
+     args.template rget<Positions>()
+    )...
+   {}
+
+   //Returns l-value reference to tuple element at `Index`
+   template<SizeType Index>
+   requires (Index < sizeof...(Types))
+   constexpr auto& get() const noexcept {
+    return (ElementType<Index>&)leafAt<Index>(
+     const_cast<TupleStorage&>(*this)
+    ).value;
    }
 
-  public:
-   //TODO noexcept qualification
-   static constexpr auto iter(T const& tuple, auto op) /*noexcept(...)*/ {
-    return iterImpl(tuple, op);
+   //Returns r-value reference to tuple element at `Index`
+   template<SizeType Index>
+   requires (Index < sizeof...(Types))
+   constexpr auto&& rget() const noexcept {
+    return (ElementType<Index>&&)leafAt<Index>(
+     const_cast<TupleStorage&>(*this)
+    ).value;
+   }
+
+   //Invokes `op` with every element as a single argument list, ie.
+   //`op(get<0>(), ..., get<N - 1>())`
+   template<typename Op>
+   constexpr decltype(auto) apply(Op&& op) const&
+    noexcept(noexcept(TupleMetaFunctions::apply(*this, (Op&&)op, Sequence{})))
+   {
+    return TupleMetaFunctions::apply(*this, (Op&&)op, Sequence{});
+   }
+
+   //Invokes `op` with every element as a single argument list, ie.
+   //`op(rget<0>(), ..., rget<N - 1>())`
+   template<typename Op>
+   constexpr decltype(auto) apply(Op&& op) &&
+    noexcept(noexcept(TupleMetaFunctions::apply(
+     (TupleStorage&&)*this,
+     (Op&&)op,
+     Sequence{}
+    )))
+   {
+    return TupleMetaFunctions::apply((TupleStorage&&)*this, (Op&&)op, Sequence{});
+   }
+
+   //Invokes `op` with every element, in declared order. `op` may either
+   //accept the element, or accept the element and take its index as a
+   //template parameter; ie. `[]<SizeType Index>(auto& element) {...}`
+   template<typename Op>
+   constexpr void forEach(Op op) const&
+    noexcept(noexcept(TupleMetaFunctions::forEach(*this, op, Sequence{})))
+   {
+    TupleMetaFunctions::forEach(*this, op, Sequence{});
+   }
+
+   //Invokes `op` with every element, as an r-value, in declared order
+   template<typename Op>
+   constexpr void forEach(Op op) &&
+    noexcept(noexcept(TupleMetaFunctions::forEach(
+     (TupleStorage&&)*this,
+     op,
+     Sequence{}
+    )))
+   {
+    TupleMetaFunctions::forEach((TupleStorage&&)*this, op, Sequence{});
+   }
+
+   //Yields a `Tuple` of the results of `op` applied to every element, in
+   //declared order
+   template<typename Op>
+   constexpr auto transform(Op op) const&
+    noexcept(noexcept(TupleMetaFunctions::transform(*this, op, Sequence{})))
+   {
+    return TupleMetaFunctions::transform(*this, op, Sequence{});
+   }
+
+   //Yields a `Tuple` of the results of `op` applied to every element, as an
+   //r-value, in declared order
+   template<typename Op>
+   constexpr auto transform(Op op) &&
+    noexcept(noexcept(TupleMetaFunctions::transform(
+     (TupleStorage&&)*this,
+     op,
+     Sequence{}
+    )))
+   {
+    return TupleMetaFunctions::transform((TupleStorage&&)*this, op, Sequence{});
    }
   };
 
-  //Tuple concatenation utilities
-  template<
-   typename T1,
-   typename T2,
-   typename U1 = Unqualified<T1>,
-   typename U2 = Unqualified<T2>
-  >
-  requires (CX::IsTuple<U1> && CX::IsTuple<U2>)
-  struct TuplePairOperations;
+  //Tuple concatenation utilities; maps every element of the concatenated
+  //tuple to its source tuple and index within that tuple, so that all
+  //elements are forwarded in a single expansion
+  template<typename... Tuples>
+  requires (CX::IsTuple<Tuples> && ...)
+  struct TupleConcatenation final {
+  private:
+   static constexpr SizeType const Count = (
+    CX::TupleSize<Tuples> + ... + 0
+   );
+
+   struct Mapping final {
+    SizeType outer[Count > 0 ? Count : 1];
+    SizeType inner[Count > 0 ? Count : 1];
+   };
+
+   static constexpr Mapping const Map = []() constexpr noexcept {
+    Mapping map{};
+    SizeType const sizes[sizeof...(Tuples) + 1]{CX::TupleSize<Tuples>..., 0};
+    SizeType position = 0;
+    for (SizeType outer = 0; outer < sizeof...(Tuples); outer++) {
+     for (SizeType inner = 0; inner < sizes[outer]; inner++, position++) {
+      map.outer[position] = outer;
+      map.inner[position] = inner;
+     }
+    }
+    return map;
+   }();
+
+   template<SizeType Index>
+   using ElementType = typename ConstDecayed<ReferenceDecayed<
+    TupleTypeAtIndex<Map.outer[Index], Tuples...>
+   >>::template ElementType<Map.inner[Index]>;
+
+   template<SizeType... Indices>
+   static constexpr auto concatenateImpl(
+    Tuple<Tuples&&...>&& tuples,
+    IndexSequence<Indices...>
+   ) noexcept(noexcept(Tuple<ElementType<Indices>...>{
+    tupleElement<Map.inner[Indices]>(
+     tuples.template rget<Map.outer[Indices]>()
+    )...
+   })) {
+    return Tuple<ElementType<Indices>...>{
+     tupleElement<Map.inner[Indices]>(
+      tuples.template rget<Map.outer[Indices]>()
+     )...
+    };
+   }
 
-  template<
-   typename T1,
-   typename T2,
-   template<typename...> typename TT1,
-   template<typename...> typename TT2,
-   typename... T1Args,
-   typename... T2Args
-  >
-  requires (IsTuple<TT1<T1Args...>>::Value && IsTuple<TT2<T2Args...>>::Value)
-  struct TuplePairOperations<T1, T2, TT1<T1Args...>, TT2<T2Args...>> {
-   //TODO noexcept qualification
-   static constexpr auto concatenate(T1 const& t1, T2 const& t2) /*noexcept(...)*/{
-    return TupleElementIterator<T1>::iter(t1, [&]<typename...>(T1Args&... t1args) {
-     return TupleElementIterator<T2>::iter(t2, [&]<typename...>(T2Args&... t2args) {
-      return Tuple<T1Args..., T2Args...> {
-       t1args...,
-       t2args...
-      };
-     });
-    });
+  public:
+   //Yields a `Tuple` of all elements of `tuples`; elements of r-value tuples
+   //are moved, elements of l-value tuples are copied
+   static constexpr auto concatenate(Tuples&&... tuples) noexcept(noexcept(
+    concatenateImpl(
+     Tuple<Tuples&&...>{(Tuples&&)tuples...},
+     MakeIndexSequence<Count>{}
+    )
+   )) {
+    return concatenateImpl(
+     Tuple<Tuples&&...>{(Tuples&&)tuples...},
+     MakeIndexSequence<Count>{}
+    );
    }
   };
  }
@@ -184,7 +486,9 @@ namespace std {
  private:
   template<typename... Types>
   struct TupleParameterReceiver {
-   using Type = CX::TypeAtIndex<I, Types...>;
+   using Type = CX
+    ::TupleMetaFunctions
+    ::TupleTypeAtIndex<I, Types...>;
   };
 
  public:
@@ -194,163 +498,187 @@ namespace std {
  };
 }
 
-//Define `CX::Tuple<...>` partial specializations
+//Define `CX::Tuple<...>` and `CX::PackedTuple<...>`
 namespace CX {
- //Empty tuple partial specialization
- template<>
- struct Tuple<> final {
-  template<typename...>
-  friend struct Tuple;
-
-  constexpr Tuple() noexcept = default;
-  constexpr Tuple(Tuple const&) noexcept = default;
-  constexpr Tuple(Tuple&&) noexcept = default;
-
-  constexpr ~Tuple() noexcept = default;
-
-  template<SizeType Index>
-  requires (Index != Index)
-  constexpr auto& get() noexcept {
-   return 0;
-  }
+ //Tuple with elements stored in declared order
+ template<typename... Types>
+ struct Tuple final : TupleMetaFunctions::TupleStorage<
+  MakeIndexSequence<sizeof...(Types)>,
+  MakeIndexSequence<sizeof...(Types)>,
+  Types...
+ > {
+ private:
+  using Storage = TupleMetaFunctions::TupleStorage<
+   MakeIndexSequence<sizeof...(Types)>,
+   MakeIndexSequence<sizeof...(Types)>,
+   Types...
+  >;
 
-  template<SizeType Index>
-  requires (Index != Index)
-  constexpr auto&& rget() noexcept {
-   return 0;
-  }
+ public:
+  constexpr Tuple() requires (Constructible<Types> && ...) = default;
+
+  //Tuple element constructor; elements are constructed in declared order
+  template<typename... Args>
+  requires (sizeof...(Args) == sizeof...(Types)
+   && sizeof...(Types) > 0
+   && (Constructible<Types, Args&&> && ...)
+   && !(sizeof...(Args) == 1 && (SameType<Unqualified<Args>, Tuple> && ...))
+  )
+  constexpr Tuple(Args&&... args)
+   noexcept((__is_nothrow_constructible(Types, Args&&) && ...))
+  :
+   Storage{TupleMetaFunctions::TupleElementTag{}, (Args&&)args...}
+  {}
 
-  //TODO generic tuple iterator
-
-  //Tuple concatenation operator
-  template<IsTuple OtherTuple>
-  constexpr auto operator+(OtherTuple const& other) const noexcept(noexcept(
-   TupleMetaFunctions
-    ::TuplePairOperations<Tuple, OtherTuple>
-    ::concatenate(*this, other)
-  )) {
-   return TupleMetaFunctions
-    ::TuplePairOperations<Tuple, OtherTuple>
-    ::concatenate(*this, other);
-  }
+  constexpr Tuple(Tuple const&) = default;
+  constexpr Tuple(Tuple&&) = default;
 
-  //Tuple copy-assignment operator
-  constexpr Tuple& operator=(Tuple const&) noexcept {
-   //nop
-   return *this;
-  }
+  constexpr ~Tuple() = default;
 
-  //Tuple move-assignment operator
-  constexpr Tuple& operator=(Tuple&&) noexcept {
-   //nop
-   return *this;
-  }
+  constexpr Tuple& operator=(Tuple const&) = default;
+  constexpr Tuple& operator=(Tuple&&) = default;
  };
 
- //Populated tuple partial specialization `(1 <= sizeof...(Types))`
- template<typename T, typename... Types>
- struct Tuple<T, Types...> final {
-  template<typename...>
-  friend struct Tuple;
-
+ //Tuple with elements stored in descending order of alignment, to minimize
+ //padding; element indices still follow the declared order
+ template<typename... Types>
+ struct PackedTuple final : TupleMetaFunctions::TupleStorage<
+  MakeIndexSequence<sizeof...(Types)>,
+  DescendingAlignmentOrder<Types...>,
+  Types...
+ > {
  private:
-  template<SizeType Index>
-  requires (Index <= sizeof...(Types))
-  using TupleTypeAtIndex = TypeAtIndex<Index, T, Types...>;
-
-  T t;
-  Tuple<Types...> next;
+  using Storage = TupleMetaFunctions::TupleStorage<
+   MakeIndexSequence<sizeof...(Types)>,
+   DescendingAlignmentOrder<Types...>,
+   Types...
+  >;
 
  public:
-  //TODO copy or move(preferentially)
-  //Tuple element constructor
-  constexpr Tuple(T t, Types... types) noexcept(
-   noexcept(T{t}) && noexcept(decltype(next){types...})
-  ) :
-   t{t},
-   next{types...}
-  {}
-
-  //Tuple copy-constructor
-  constexpr Tuple(Tuple const& other)
-   noexcept(noexcept(T{other.t}) && noexcept(decltype(next){other.next}))
-   requires (CopyConstructible<T> && CopyConstructible<decltype(next)>)
-  :
-   t{other.t},
-   next{other.next}
-  {}
-
-  //Tuple move-constructor
-  constexpr Tuple(Tuple&& other)
-   noexcept(noexcept(T{(T&&)other.t})
-    && noexcept(decltype(next){(decltype(next)&&)other.next})
+  constexpr PackedTuple() requires (Constructible<Types> && ...) = default;
+
+  //Tuple element constructor; elements are constructed in storage order
+  template<typename... Args>
+  requires (sizeof...(Args) == sizeof...(Types)
+   && sizeof...(Types) > 0
+   && (Constructible<Types, Args&&> && ...)
+   && !(sizeof...(Args) == 1
+    && (SameType<Unqualified<Args>, PackedTuple> && ...)
    )
-   requires (MoveConstructible<T> && MoveConstructible<decltype(next)>)
+  )
+  constexpr PackedTuple(Args&&... args)
+   noexcept((__is_nothrow_constructible(Types, Args&&) && ...))
   :
-   t{(T&&)other.t},
-   next{(decltype(next)&&)other.next}
+   Storage{
+    TupleMetaFunctions::TupleForwardTag{},
+    Tuple<Args&&...>{(Args&&)args...}
+   }
   {}
 
-  constexpr ~Tuple() noexcept(
-   noexcept(t.~T()) && noexcept(next.~Tuple<Types...>())
-  ) = default;
+  constexpr PackedTuple(PackedTuple const&) = default;
+  constexpr PackedTuple(PackedTuple&&) = default;
 
-  //Returns l-value reference to tuple element at `Index`
-  template<SizeType Index>
-  constexpr auto& get() const noexcept {
-   if constexpr (Index == 0) {
-    return (TupleTypeAtIndex<Index>&)t;
-   } else {
-    return next.template get<Index - 1>();
-   }
-  }
+  constexpr ~PackedTuple() = default;
 
-  //Returns r-value reference to tuple element at `Index`
-  template<SizeType Index>
-  constexpr auto&& rget() const noexcept {
-   if constexpr (Index == 0) {
-    return (TupleTypeAtIndex<Index>&&)t;
-   } else {
-    return next.template rget<Index - 1>();
-   }
-  }
+  constexpr PackedTuple& operator=(PackedTuple const&) = default;
+  constexpr PackedTuple& operator=(PackedTuple&&) = default;
+ };
 
-  //TODO generic lambda iterator
-
-  //Tuple concatenation operator
-  template<IsTuple OtherTuple>
-  constexpr auto operator+(OtherTuple const& other) const noexcept(noexcept(
-   TupleMetaFunctions
-    ::TuplePairOperations<Tuple, OtherTuple>
-    ::concatenate(*this, other)
-  )) {
-   return TupleMetaFunctions
-    ::TuplePairOperations<Tuple, OtherTuple>
-    ::concatenate(*this, other);
-  }
+ //Yields a `Tuple` of all elements of `tuples`, in order; elements of
+ //r-value tuples are moved, elements of l-value tuples are copied
+ template<typename... Tuples>
+ requires (IsTuple<Tuples> && ...)
+ constexpr auto concatenate(Tuples&&... tuples) noexcept(noexcept(
+  TupleMetaFunctions
+   ::TupleConcatenation<Tuples...>
+   ::concatenate((Tuples&&)tuples...)
+ )) {
+  return TupleMetaFunctions
+   ::TupleConcatenation<Tuples...>
+   ::concatenate((Tuples&&)tuples...);
+ }
 
-  //Tuple copy-assignment operator
-  constexpr Tuple& operator=(Tuple const& other)
-   noexcept(noexcept(t = other.t) && noexcept(next = other.next))
-   requires (CopyAssignable<T> && CopyAssignable<decltype(next)>)
-  {
-   t = other.t;
-   next = other.next;
-   return *this;
-  }
+ //Tuple concatenation operator
+ template<typename T1, typename T2>
+ requires (IsTuple<T1> && IsTuple<T2>)
+ constexpr auto operator+(T1&& t1, T2&& t2) noexcept(noexcept(
+  concatenate((T1&&)t1, (T2&&)t2)
+ )) {
+  return concatenate((T1&&)t1, (T2&&)t2);
+ }
 
-  //Tuple move-assignment operator
-  constexpr Tuple& operator=(Tuple&& other)
-   noexcept(noexcept(t = (T&&)other.t)
-    && noexcept(next = (decltype(next)&&)other.next)
-   )
-   requires (MoveAssignable<T> && MoveAssignable<decltype(next)>)
-  {
-   t = (T&&)other.t;
-   next = (decltype(next)&&)other.next;
-   return *this;
-  }
- };
+ //Tuple of references to the elements of other tuples
+ template<typename... Types>
+ using TupleView = Tuple<Types&...>;
+
+ //Yields a `TupleView` of the elements of `tuple`
+ template<IsTuple T>
+ constexpr auto view(T& tuple) noexcept {
+  return tuple.transform([](auto& element) constexpr noexcept -> auto& {
+   return element;
+  });
+ }
+
+ //Yields a `TupleView` of the elements of all `tuples`, in order, without
+ //copying or moving any element
+ template<IsTuple... Tuples>
+ constexpr auto concatenateView(Tuples&... tuples) noexcept {
+  return concatenate(view(tuples)...);
+ }
+
+ //Invokes `op` with every element of the tuple-like `t` as a single argument
+ //list; supports `CX` tuples and any type implementing the structured
+ //binding tuple protocol
+ template<typename Op, typename T>
+ requires (TupleMetaFunctions::TupleLike<T>)
+ constexpr decltype(auto) apply(Op&& op, T&& t) noexcept(noexcept(
+  TupleMetaFunctions::apply(
+   (T&&)t,
+   (Op&&)op,
+   MakeIndexSequence<TupleMetaFunctions::TupleLikeSize<T>>{}
+  )
+ )) {
+  return TupleMetaFunctions::apply(
+   (T&&)t,
+   (Op&&)op,
+   MakeIndexSequence<TupleMetaFunctions::TupleLikeSize<T>>{}
+  );
+ }
+
+ //Invokes `op` with every element of the tuple-like `t`, in declared order
+ template<typename T, typename Op>
+ requires (TupleMetaFunctions::TupleLike<T>)
+ constexpr void forEach(T&& t, Op op) noexcept(noexcept(
+  TupleMetaFunctions::forEach(
+   (T&&)t,
+   op,
+   MakeIndexSequence<TupleMetaFunctions::TupleLikeSize<T>>{}
+  )
+ )) {
+  TupleMetaFunctions::forEach(
+   (T&&)t,
+   op,
+   MakeIndexSequence<TupleMetaFunctions::TupleLikeSize<T>>{}
+  );
+ }
+
+ //Yields a `Tuple` of the results of `op` applied to every element of the
+ //tuple-like `t`, in declared order
+ template<typename T, typename Op>
+ requires (TupleMetaFunctions::TupleLike<T>)
+ constexpr auto transform(T&& t, Op op) noexcept(noexcept(
+  TupleMetaFunctions::transform(
+   (T&&)t,
+   op,
+   MakeIndexSequence<TupleMetaFunctions::TupleLikeSize<T>>{}
+  )
+ )) {
+  return TupleMetaFunctions::transform(
+   (T&&)t,
+   op,
+   MakeIndexSequence<TupleMetaFunctions::TupleLikeSize<T>>{}
+  );
+ }
 
  //Tuple deduction guides
  template<typename... Types>
@@ -369,6 +697,10 @@ namespace CX {
 
  Tuple() -> Tuple<>;
 
+ template<typename... Types>
+ requires (!(Array<Types> || ...))
+ PackedTuple(Types...) -> PackedTuple<Types...>;
+
  //TODO doc (same as std::tie)
  template<typename... Types>
  constexpr auto tie(Types&... types) noexcept {
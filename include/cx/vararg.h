@@ -4,6 +4,8 @@
 #include <cx/idioms.h>
 #include <cx/error.h>
 #include <cx/exit.h>
+#include <cx/templates.h>
+#include <cx/tuple.h>
 
 //Conditional stl dependencies if built with stl support
 #ifdef CX_STL_SUPPORT
@@ -19,6 +21,7 @@
  #define CX_VA_START(list, arg) va_start(list, arg)
  #define CX_VA_END(list) va_end(list)
  #define CX_VA_ARG(list, type) va_arg(list, type)
+ #define CX_VA_COPY(destination, source) va_copy(destination, source)
 #else
  //Compiler specific builtins
  #if defined(_MSC_VER)
@@ -26,26 +29,30 @@
   #define CX_VA_START(list, arg) __crt_va_start(list, arg)
   #define CX_VA_ARG(list, type) __crt_va_arg(list, type)
   #define CX_VA_END(list) __crt_va_end(list)
+  #define CX_VA_COPY(destination, source) ((destination) = (source))
  #elif defined(__GNUC__) || defined(__clang__) || defined(__INTEL_COMPILER)
   //Clang, GCC and ICC support
   #define CX_VA_START(list, arg) __builtin_va_start(list, arg)
   #define CX_VA_ARG(list, type) __builtin_va_arg(list, type)
   #define CX_VA_END(list) __builtin_va_end(list)
+  #define CX_VA_COPY(destination, source) __builtin_va_copy(destination, source)
  #endif
 #endif
 
 //Support for va_list intrensics without libc
 #ifdef CX_VARARG_INTRENSICS
  //Warn if libc macros are defined
- #if defined(va_start) || defined(va_end) || defined(va_arg)
+ #if defined(va_start) || defined(va_end) || defined(va_arg) \
+  || defined(va_copy)
   #error \
-   'CX_VARARG_INTRENSICS' is enabled but one of [va_start va_end va_arg] \
-   is already defined; are you sure you meant to enable this flag?
+   'CX_VARARG_INTRENSICS' is enabled but one of [va_start va_end va_arg \
+   va_copy] is already defined; are you sure you meant to enable this flag?
  #endif
  //Define libc va_list macros
  #define va_start(list, arg) CX_VA_START(list, arg)
  #define va_end(list) CX_VA_END(list)
  #define va_arg(list, type) CX_VA_ARG(list, type)
+ #define va_copy(destination, source) CX_VA_COPY(destination, source)
 #endif
 
 //Push diagnostic conetxt to silence gcc attribute parser bugs
@@ -133,10 +140,23 @@ namespace CX {
     list(list)
    {}
 
+   //Copies are independent of the original list; see `snapshot()`
+   VaListWrapper(VaListWrapper const& other) {
+    CX_VA_COPY(toPlatform(), ((VaListWrapper&)other).toPlatform());
+   }
+
    ~VaListWrapper() {
     CX_VA_END(toPlatform());
    }
 
+   VaListWrapper& operator=(VaListWrapper const& other) {
+    if (this != &other) {
+     CX_VA_END(toPlatform());
+     CX_VA_COPY(toPlatform(), ((VaListWrapper&)other).toPlatform());
+    }
+    return *this;
+   }
+
    [[gnu::always_inline]]
    PlatformListType& toPlatform() {
     return list;
@@ -153,6 +173,18 @@ namespace CX {
     using Promoted = VarargPromoted<T>;
     return (T)CX_VA_ARG(toPlatform(), Promoted);
    }
+
+   //Returns a copy of the list at its current position
+   [[gnu::always_inline]]
+   VaListWrapper snapshot() const {
+    return *this;
+   }
+
+   //Restores the list to the position of `snapshot`
+   [[gnu::always_inline]]
+   void rewind(VaListWrapper const& snapshot) {
+    *this = snapshot;
+   }
   };
 
   //clang, gcc, icx: AMD64
@@ -177,10 +209,24 @@ namespace CX {
     }())
    {}
 
+   //Copies are independent of the original list; `platformList` always
+   //refers to the list of its own wrapper. See `snapshot()`
+   VaListWrapper(VaListWrapper const& other) {
+    CX_VA_COPY(toPlatform(), ((VaListWrapper&)other).toPlatform());
+   }
+
    ~VaListWrapper() {
     CX_VA_END(toPlatform());
    }
 
+   VaListWrapper& operator=(VaListWrapper const& other) {
+    if (this != &other) {
+     CX_VA_END(toPlatform());
+     CX_VA_COPY(toPlatform(), ((VaListWrapper&)other).toPlatform());
+    }
+    return *this;
+   }
+
    [[gnu::always_inline]]
    PlatformListType& toPlatform() {
     return platformList;
@@ -197,6 +243,18 @@ namespace CX {
     using Promoted = VarargPromoted<T>;
     return (T)CX_VA_ARG(toPlatform(), Promoted);
    }
+
+   //Returns a copy of the list at its current position
+   [[gnu::always_inline]]
+   VaListWrapper snapshot() const {
+    return *this;
+   }
+
+   //Restores the list to the position of `snapshot`
+   [[gnu::always_inline]]
+   void rewind(VaListWrapper const& snapshot) {
+    *this = snapshot;
+   }
   };
 
   //clang, gcc, icx: x86
@@ -214,10 +272,23 @@ namespace CX {
     list(list)
    {}
 
+   //Copies are independent of the original list; see `snapshot()`
+   VaListWrapper(VaListWrapper const& other) {
+    CX_VA_COPY(toPlatform(), ((VaListWrapper&)other).toPlatform());
+   }
+
    ~VaListWrapper() {
     CX_VA_END(toPlatform());
    }
 
+   VaListWrapper& operator=(VaListWrapper const& other) {
+    if (this != &other) {
+     CX_VA_END(toPlatform());
+     CX_VA_COPY(toPlatform(), ((VaListWrapper&)other).toPlatform());
+    }
+    return *this;
+   }
+
    [[gnu::always_inline]]
    PlatformListType& toPlatform() {
     return list;
@@ -242,10 +313,367 @@ namespace CX {
     using Promoted = VarargPromoted<T>;
     return (T)CX_VA_ARG(toPlatform(), Promoted);
    }
+
+   //Returns a copy of the list at its current position
+   [[gnu::always_inline]]
+   VaListWrapper snapshot() const {
+    return *this;
+   }
+
+   //Restores the list to the position of `snapshot`
+   [[gnu::always_inline]]
+   void rewind(VaListWrapper const& snapshot) {
+    *this = snapshot;
+   }
   };
  }
 
  using VaList = Internal::VaListWrapper<0>;
+
+ //Printf-style format string, usable as a template argument
+ template<SizeType N>
+ struct FormatString final {
+  char data[N];
+
+  constexpr FormatString(char const (&format)[N]) noexcept {
+   for (SizeType i = 0; i < N; i++) {
+    data[i] = format[i];
+   }
+  }
+
+  //Returns the length of the format string, excluding the terminator
+  static constexpr SizeType size() noexcept {
+   return N - 1;
+  }
+ };
+
+ namespace Internal {
+  //Argument kinds of printf-style conversions; signed and unsigned integral
+  //kinds are ordered by `FormatLength`
+  enum class FormatArgument : unsigned char {
+   INT,
+   SIGNED_CHAR,
+   SHORT,
+   LONG,
+   LONG_LONG,
+   SIGNED_SIZE,
+   PTRDIFF,
+   UNSIGNED,
+   UNSIGNED_CHAR,
+   UNSIGNED_SHORT,
+   UNSIGNED_LONG,
+   UNSIGNED_LONG_LONG,
+   SIZE,
+   UNSIGNED_PTRDIFF,
+   CHAR,
+   STRING,
+   POINTER,
+   DOUBLE,
+   LONG_DOUBLE
+  };
+
+  //Length modifiers of printf-style conversions
+  enum class FormatLength : unsigned char {
+   NONE,
+   HH,
+   H,
+   L,
+   LL,
+   Z,
+   T,
+   BIG_L
+  };
+
+  using PtrDiffType = decltype((char *)nullptr - (char *)nullptr);
+
+  //C++ type of each argument kind
+  template<FormatArgument Argument>
+  using FormatArgumentType = TypeAtIndex<
+   (long)Argument,
+   int,
+   signed char,
+   short,
+   long,
+   long long,
+   SignPromoted<SizeType>,
+   PtrDiffType,
+   unsigned,
+   unsigned char,
+   unsigned short,
+   unsigned long,
+   unsigned long long,
+   SizeType,
+   SignDecayed<PtrDiffType>,
+   char,
+   char const *,
+   void const *,
+   double,
+   long double
+  >;
+
+  //Width or precision read from an `int` argument
+  constexpr int const FormatStar = -2;
+
+  //Absent width or precision
+  constexpr int const FormatNone = -1;
+
+  //Conversion specification of a format string
+  struct FormatConversion final {
+   //Offset and length of the literal text preceding the conversion
+   SizeType literal;
+   SizeType literalLength;
+   //Offset and length of the specification, including the leading `%`
+   SizeType specification;
+   SizeType specificationLength;
+   //Index of the first argument consumed by the conversion
+   SizeType index;
+   //Flags
+   bool left;
+   bool plus;
+   bool space;
+   bool alternate;
+   bool zero;
+   //Width and precision; `FormatNone` if absent, `FormatStar` if read from
+   //an argument
+   int width;
+   int precision;
+   //Conversion character; `%` for literal percent signs
+   char conversion;
+   FormatArgument argument;
+  };
+
+  //Argument kinds consumed by a format string, in order, and its
+  //conversions
+  template<SizeType N>
+  struct FormatSignature final {
+   FormatArgument arguments[N];
+   SizeType count;
+   FormatConversion conversions[N];
+   SizeType conversionCount;
+   //Offset of the literal text following the last conversion
+   SizeType trailing;
+   bool valid;
+  };
+
+  //Parses the conversions of `format`; `*` widths and precisions consume an
+  //`int`. `%n`, `%j` and wide character conversions are not supported and
+  //yield an invalid signature
+  template<SizeType N>
+  constexpr FormatSignature<N> parseFormat(FormatString<N> const& format)
+   noexcept
+  {
+   FormatSignature<N> signature{};
+   auto const at = [&](SizeType const i) constexpr noexcept {
+    return i < N ? format.data[i] : '\0';
+   };
+   auto const push = [&](FormatArgument const argument) constexpr noexcept {
+    signature.arguments[signature.count++] = argument;
+   };
+   auto const offset = [](FormatArgument const base, FormatLength const length)
+    constexpr noexcept
+   {
+    return (FormatArgument)((unsigned char)base + (unsigned char)length);
+   };
+   auto const number = [&](SizeType& i) constexpr noexcept {
+    int value = 0;
+    while (at(i) >= '0' && at(i) <= '9') {
+     value = value * 10 + (at(i++) - '0');
+    }
+    return value;
+   };
+
+   SizeType i = 0;
+   SizeType literal = 0;
+   while (at(i) != '\0') {
+    if (at(i++) != '%') {
+     continue;
+    }
+    auto& conversion = signature.conversions[signature.conversionCount++];
+    conversion.literal = literal;
+    conversion.literalLength = i - 1 - literal;
+    conversion.specification = i - 1;
+    conversion.index = signature.count;
+    conversion.width = FormatNone;
+    conversion.precision = FormatNone;
+    if (at(i) == '%') {
+     conversion.conversion = '%';
+     conversion.specificationLength = 2;
+     literal = ++i;
+     continue;
+    }
+
+    //Flags
+    for (bool flag = true; flag;) {
+     switch (at(i)) {
+      case '-': conversion.left = true; break;
+      case '+': conversion.plus = true; break;
+      case ' ': conversion.space = true; break;
+      case '#': conversion.alternate = true; break;
+      case '0': conversion.zero = true; break;
+      case '\'': break;
+      default: flag = false; continue;
+     }
+     i++;
+    }
+
+    //Width
+    if (at(i) == '*') {
+     push(FormatArgument::INT);
+     conversion.width = FormatStar;
+     i++;
+    } else if (at(i) >= '0' && at(i) <= '9') {
+     conversion.width = number(i);
+    }
+
+    //Precision
+    if (at(i) == '.') {
+     i++;
+     if (at(i) == '*') {
+      push(FormatArgument::INT);
+      conversion.precision = FormatStar;
+      i++;
+     } else {
+      conversion.precision = number(i);
+     }
+    }
+
+    //Length modifier
+    auto length = FormatLength::NONE;
+    switch (at(i)) {
+     case 'h': {
+      length = at(i + 1) == 'h' ? FormatLength::HH : FormatLength::H;
+      break;
+     }
+     case 'l': {
+      length = at(i + 1) == 'l' ? FormatLength::LL : FormatLength::L;
+      break;
+     }
+     case 'z': {
+      length = FormatLength::Z;
+      break;
+     }
+     case 't': {
+      length = FormatLength::T;
+      break;
+     }
+     case 'L': {
+      length = FormatLength::BIG_L;
+      break;
+     }
+     default: break;
+    }
+    if (length == FormatLength::HH || length == FormatLength::LL) {
+     i += 2;
+    } else if (length != FormatLength::NONE) {
+     i++;
+    }
+
+    //Conversion
+    conversion.conversion = at(i++);
+    switch (conversion.conversion) {
+     case 'd':
+     case 'i': {
+      if (length == FormatLength::BIG_L) {
+       return {};
+      }
+      push(offset(FormatArgument::INT, length));
+      break;
+     }
+     case 'u':
+     case 'o':
+     case 'x':
+     case 'X': {
+      if (length == FormatLength::BIG_L) {
+       return {};
+      }
+      push(offset(FormatArgument::UNSIGNED, length));
+      break;
+     }
+     case 'f':
+     case 'F':
+     case 'e':
+     case 'E':
+     case 'g':
+     case 'G':
+     case 'a':
+     case 'A': {
+      if (length == FormatLength::NONE || length == FormatLength::L) {
+       push(FormatArgument::DOUBLE);
+      } else if (length == FormatLength::BIG_L) {
+       push(FormatArgument::LONG_DOUBLE);
+      } else {
+       return {};
+      }
+      break;
+     }
+     case 'c':
+     case 's':
+     case 'p': {
+      if (length != FormatLength::NONE) {
+       return {};
+      }
+      switch (conversion.conversion) {
+       case 'c': push(FormatArgument::CHAR); break;
+       case 's': push(FormatArgument::STRING); break;
+       default: push(FormatArgument::POINTER); break;
+      }
+      break;
+     }
+     default: return {};
+    }
+    conversion.argument = signature.arguments[signature.count - 1];
+    conversion.specificationLength = i - conversion.specification;
+    literal = i;
+   }
+   signature.trailing = literal;
+   signature.valid = true;
+   return signature;
+  }
+
+  //Signature of the arguments consumed by `Format`
+  template<FormatString Format>
+  constexpr auto const FormatSignatureOf = parseFormat(Format);
+
+  template<auto Signature, typename = MakeIndexSequence<Signature.count>>
+  struct FormatArguments;
+
+  template<auto Signature, SizeType... Indices>
+  struct FormatArguments<Signature, IndexSequence<Indices...>> final {
+   using Type = Tuple<FormatArgumentType<Signature.arguments[Indices]>...>;
+
+   //Decodes every argument from `list` in a single pass
+   template<typename List>
+   [[gnu::always_inline]]
+   static Type decode(List& list) {
+    return Type{
+     list.template arg<FormatArgumentType<Signature.arguments[Indices]>>()...
+    };
+   }
+  };
+ }
+
+ //Format string validity concept
+ template<FormatString Format>
+ concept ValidFormat = Internal::FormatSignatureOf<Format>.valid;
+
+ //Tuple of the argument types consumed by `Format`, in order:
+ // FormatArguments<"%s: %zu"> -> Tuple<char const *, SizeType>
+ template<FormatString Format>
+ requires ValidFormat<Format>
+ using FormatArguments = typename Internal
+  ::FormatArguments<Internal::FormatSignatureOf<Format>>
+  ::Type;
+
+ //Decodes all arguments consumed by `Format` from `list` in one pass; use
+ //`list.snapshot()` beforehand to decode the same arguments again
+ template<FormatString Format>
+ requires ValidFormat<Format>
+ [[gnu::always_inline]]
+ inline FormatArguments<Format> decode(VaList& list) {
+  return Internal
+   ::FormatArguments<Internal::FormatSignatureOf<Format>>
+   ::decode(list);
+ }
 }
 
 //Pop diagnostic context
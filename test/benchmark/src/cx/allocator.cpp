@@ -0,0 +1,61 @@
+#include <cx/test/benchmark/common.h>
+
+#include <cx/allocator.h>
+#include <cx/bitset.h>
+
+namespace CX::Testing {
+ //Libc-backed allocator without in-place resizing; every resize copies
+ template<typename T>
+ struct CopyingAllocator final : Never {
+  static AllocResult<T> allocate(SizeType const n) noexcept {
+   return LibcAllocator<T>::allocate(n);
+  }
+
+  static void deallocate(T const& t, SizeType const n) noexcept {
+   LibcAllocator<T>::deallocate(t, n);
+  }
+ };
+
+ //Grows a bitset one word at a time up to `state.range(0)` bits
+ template<template<typename...> typename A>
+ void bitsetGrowth(benchmark::State& state) {
+  auto const bits = (SizeType)state.range(0);
+  for (auto _ : state) {
+   DynamicBitset<A> bitset;
+   for (SizeType size = 0; size < bits; size += 64) {
+    bitset.resize(size + 64, true);
+   }
+   doNotOptimize(bitset.data());
+  }
+  state.SetItemsProcessed((long long)state.iterations() * (bits / 64));
+ }
+
+ static void bitsetGrowthReallocating(benchmark::State& state) {
+  bitsetGrowth<LibcAllocator>(state);
+ }
+ BENCHMARK(bitsetGrowthReallocating)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
+
+ static void bitsetGrowthCopying(benchmark::State& state) {
+  bitsetGrowth<CopyingAllocator>(state);
+ }
+ BENCHMARK(bitsetGrowthCopying)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20);
+
+ //Allocates and frees over-aligned blocks through each libc path
+ static void libcAlignedAllocation(benchmark::State& state) {
+  auto const alignment = (SizeType)state.range(0);
+  auto const n = (SizeType)state.range(1);
+  for (auto _ : state) {
+   auto& block = +LibcAllocator<unsigned char>::allocate(n, alignment);
+   doNotOptimize(&block);
+   LibcAllocator<unsigned char>::deallocate(block, n, alignment);
+  }
+ }
+ BENCHMARK(libcAlignedAllocation)
+  ->ArgNames({"alignment", "bytes"})
+  //`malloc`
+  ->Args({16, 256})
+  //`aligned_alloc`
+  ->Args({64, 256})
+  //`posix_memalign`
+  ->Args({64, 200});
+}
@@ -0,0 +1,61 @@
+#include <cx/test/benchmark/common.h>
+
+#include <cx/arena.h>
+
+#include <vector>
+
+namespace CX::Testing {
+ //Request-scoped object, sized like a small request context node
+ struct alignas(16) RequestObject final {
+  unsigned char bytes[48];
+ };
+
+ //Allocates `state.range(0)` objects and releases them all at once, as a
+ //request-scoped workload would
+ static void arenaRequestScope(benchmark::State& state) {
+  auto const count = (SizeType)state.range(0);
+  Arena arena;
+  ArenaAllocator<RequestObject> allocator{arena};
+  for (auto _ : state) {
+   for (SizeType i = 0; i < count; i++) {
+    doNotOptimize(&+allocator.allocate(1));
+   }
+   arena.reset();
+  }
+  state.SetItemsProcessed((long long)state.iterations() * count);
+ }
+ BENCHMARK(arenaRequestScope)->Arg(16)->Arg(256)->Arg(4096);
+
+ static void libcRequestScope(benchmark::State& state) {
+  auto const count = (SizeType)state.range(0);
+  std::vector<RequestObject *> objects(count);
+  for (auto _ : state) {
+   for (SizeType i = 0; i < count; i++) {
+    objects[i] = &+LibcAllocator<RequestObject>::allocate(1);
+    doNotOptimize(objects[i]);
+   }
+   for (SizeType i = 0; i < count; i++) {
+    LibcAllocator<RequestObject>::deallocate(*objects[i], 1);
+   }
+  }
+  state.SetItemsProcessed((long long)state.iterations() * count);
+ }
+ BENCHMARK(libcRequestScope)->Arg(16)->Arg(256)->Arg(4096);
+
+ //Nested scopes, rewinding the inner allocations of every outer iteration
+ static void arenaNestedScopes(benchmark::State& state) {
+  Arena arena;
+  ArenaAllocator<RequestObject> allocator{arena};
+  for (auto _ : state) {
+   Arena::Scope const outer{arena};
+   for (int i = 0; i < 16; i++) {
+    Arena::Scope const inner{arena};
+    for (int j = 0; j < 16; j++) {
+     doNotOptimize(&+allocator.allocate(1));
+    }
+   }
+  }
+  state.SetItemsProcessed((long long)state.iterations() * 256);
+ }
+ BENCHMARK(arenaNestedScopes);
+}
@@ -0,0 +1,376 @@
+#include <cx/test/benchmark/common.h>
+
+#include <cx/bitset.h>
+
+#include <bitset>
+#include <mutex>
+#include <vector>
+
+namespace CX::Testing {
+ using BitsetMetaFunctions::KernelSet;
+ using BitsetMetaFunctions::KernelTable;
+ using BitsetMetaFunctions::Word;
+
+ //Bitset sizes, in bits
+ constexpr SizeType const SmallBits = 4096;
+ constexpr SizeType const MediumBits = 65536;
+ constexpr SizeType const LargeBits = 1 << 20;
+
+ //Word buffers populated with deterministic pseudo-random bits
+ struct KernelOperands final {
+  std::vector<Word> a, b;
+
+  KernelOperands(SizeType const bits) :
+   a(BitsetMetaFunctions::wordsForBits(bits)),
+   b(BitsetMetaFunctions::wordsForBits(bits))
+  {
+   Word seed = 0x9E3779B97F4A7C15ull;
+   for (SizeType i = 0; i < a.size(); i++) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    a[i] = seed;
+    b[i] = ~seed;
+   }
+  }
+ };
+
+ //Returns the kernel table for `set`, skipping the benchmark if the
+ //executing CPU does not support it
+ static KernelTable const * kernelTableOrSkip(
+  benchmark::State& state,
+  KernelSet const set
+ ) {
+  auto const table = BitsetMetaFunctions::kernelsFor(set);
+  if (!table) {
+   state.SkipWithError("Kernel set not supported by this CPU");
+  }
+  return table;
+ }
+
+ template<KernelSet Set>
+ void kernelAnd(benchmark::State& state) {
+  auto const table = kernelTableOrSkip(state, Set);
+  if (!table) {
+   return;
+  }
+  KernelOperands operands{(SizeType)state.range(0)};
+  for (auto _ : state) {
+   table->bitwiseAnd(operands.a.data(), operands.b.data(), operands.a.size());
+   benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(
+   (int64_t)(state.iterations() * operands.a.size() * sizeof(Word) * 2)
+  );
+ }
+
+ template<KernelSet Set>
+ void kernelPopcount(benchmark::State& state) {
+  auto const table = kernelTableOrSkip(state, Set);
+  if (!table) {
+   return;
+  }
+  KernelOperands operands{(SizeType)state.range(0)};
+  for (auto _ : state) {
+   doNotOptimize(table->popcount(operands.a.data(), operands.a.size()));
+  }
+  state.SetBytesProcessed(
+   (int64_t)(state.iterations() * operands.a.size() * sizeof(Word))
+  );
+ }
+
+ template<KernelSet Set>
+ void kernelIntersectCount(benchmark::State& state) {
+  auto const table = kernelTableOrSkip(state, Set);
+  if (!table) {
+   return;
+  }
+  KernelOperands operands{(SizeType)state.range(0)};
+  for (auto _ : state) {
+   doNotOptimize(table->intersectCount(
+    operands.a.data(),
+    operands.b.data(),
+    operands.a.size()
+   ));
+  }
+  state.SetBytesProcessed(
+   (int64_t)(state.iterations() * operands.a.size() * sizeof(Word) * 2)
+  );
+ }
+
+ template<KernelSet Set>
+ void kernelAny(benchmark::State& state) {
+  auto const table = kernelTableOrSkip(state, Set);
+  if (!table) {
+   return;
+  }
+  //Worst case; no bits are set
+  std::vector<Word> const words(
+   BitsetMetaFunctions::wordsForBits((SizeType)state.range(0))
+  );
+  for (auto _ : state) {
+   doNotOptimize(table->any(words.data(), words.size()));
+  }
+  state.SetBytesProcessed(
+   (int64_t)(state.iterations() * words.size() * sizeof(Word))
+  );
+ }
+
+ //`std::bitset` equivalents
+ template<SizeType N>
+ void stdBitsetAnd(benchmark::State& state) {
+  auto const a = new std::bitset<N>{};
+  auto const b = new std::bitset<N>{};
+  b->flip();
+  for (auto _ : state) {
+   *a &= *b;
+   benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed((int64_t)(state.iterations() * N / 8 * 2));
+  delete a;
+  delete b;
+ }
+
+ template<SizeType N>
+ void stdBitsetPopcount(benchmark::State& state) {
+  auto const a = new std::bitset<N>{};
+  for (SizeType i = 0; i < N; i += 3) {
+   a->set(i);
+  }
+  for (auto _ : state) {
+   doNotOptimize(a->count());
+  }
+  state.SetBytesProcessed((int64_t)(state.iterations() * N / 8));
+  delete a;
+ }
+
+ template<SizeType N>
+ void stdBitsetAny(benchmark::State& state) {
+  auto const a = new std::bitset<N>{};
+  for (auto _ : state) {
+   doNotOptimize(a->any());
+  }
+  state.SetBytesProcessed((int64_t)(state.iterations() * N / 8));
+  delete a;
+ }
+
+ //`CX::Bitset`, using the runtime-selected kernels
+ template<SizeType N>
+ void cxBitsetIntersectCount(benchmark::State& state) {
+  auto const a = new Bitset<N>{};
+  auto const b = new Bitset<N>{};
+  for (SizeType i = 0; i < N; i += 3) {
+   a->set(i);
+   b->set(i + 1 < N ? i + 1 : i);
+  }
+  for (auto _ : state) {
+   doNotOptimize(a->intersectCount(*b));
+  }
+  state.SetBytesProcessed((int64_t)(state.iterations() * N / 8 * 2));
+  delete a;
+  delete b;
+ }
+
+ template<SizeType N>
+ void stdBitsetIntersectCount(benchmark::State& state) {
+  auto const a = new std::bitset<N>{};
+  auto const b = new std::bitset<N>{};
+  for (SizeType i = 0; i < N; i += 3) {
+   a->set(i);
+   b->set(i + 1 < N ? i + 1 : i);
+  }
+  for (auto _ : state) {
+   doNotOptimize((*a & *b).count());
+  }
+  state.SetBytesProcessed((int64_t)(state.iterations() * N / 8 * 2));
+  delete a;
+  delete b;
+ }
+
+ //Bitset of `LargeBits` bits with a density of 1 / `state.range(0)`
+ static DynamicBitset<> sparseBitset(benchmark::State& state) {
+  DynamicBitset<> b{LargeBits};
+  Word seed = 0x9E3779B97F4A7C15ull;
+  for (SizeType i = 0; i < LargeBits; i++) {
+   seed ^= seed << 13;
+   seed ^= seed >> 7;
+   seed ^= seed << 17;
+   b.set(i, seed % (Word)state.range(0) == 0);
+  }
+  state.counters["popcount"] = (double)b.count();
+  return b;
+ }
+
+ //Visits set bits by testing every bit
+ static void scanAllBits(benchmark::State& state) {
+  auto const b = sparseBitset(state);
+  for (auto _ : state) {
+   SizeType sum = 0;
+   for (SizeType i = 0; i < b.size(); i++) {
+    if (b.get(i)) {
+     sum += i;
+    }
+   }
+   doNotOptimize(sum);
+  }
+ }
+
+ //Visits set bits using `findNext`
+ static void scanFindNext(benchmark::State& state) {
+  auto const b = sparseBitset(state);
+  for (auto _ : state) {
+   SizeType sum = 0;
+   for (auto i = b.findFirst(); i < b.size(); i = b.findNext(i + 1)) {
+    sum += i;
+   }
+   doNotOptimize(sum);
+  }
+ }
+
+ //Visits set bits using the set-bit iterator
+ static void scanSetBits(benchmark::State& state) {
+  auto const b = sparseBitset(state);
+  for (auto _ : state) {
+   SizeType sum = 0;
+   for (auto const i : b.setBits()) {
+    sum += i;
+   }
+   doNotOptimize(sum);
+  }
+ }
+
+ //`select` of evenly spaced ranks, without and with a rank index
+ static void selectDirect(benchmark::State& state) {
+  auto const b = sparseBitset(state);
+  auto const count = b.count();
+  auto const stride = count / 64 + 1;
+  for (auto _ : state) {
+   for (SizeType k = 0; k < count; k += stride) {
+    doNotOptimize(b.select(k));
+   }
+  }
+ }
+
+ static void selectIndexed(benchmark::State& state) {
+  auto const b = sparseBitset(state);
+  BitsetRankIndex<> const index{b};
+  auto const count = b.count();
+  auto const stride = count / 64 + 1;
+  for (auto _ : state) {
+   for (SizeType k = 0; k < count; k += stride) {
+    doNotOptimize(b.select(k, index));
+   }
+  }
+ }
+
+ #define CX_BITSET_SPARSITY_BENCHMARK(benchmark) \
+  BENCHMARK(benchmark)->Arg(2)->Arg(64)->Arg(4096);
+
+ CX_BITSET_SPARSITY_BENCHMARK(scanAllBits)
+ CX_BITSET_SPARSITY_BENCHMARK(scanFindNext)
+ CX_BITSET_SPARSITY_BENCHMARK(scanSetBits)
+ CX_BITSET_SPARSITY_BENCHMARK(selectDirect)
+ CX_BITSET_SPARSITY_BENCHMARK(selectIndexed)
+
+ #undef CX_BITSET_SPARSITY_BENCHMARK
+
+ //Number of slots in the contended slot pools
+ constexpr SizeType const PoolSlots = 4096;
+
+ //Claims and releases a slot per iteration from a slot pool shared by all
+ //benchmark threads. With `Spread`, each thread starts its search at a
+ //distinct word group; otherwise all threads contend on the first words
+ template<SizeType GroupWords, bool Spread>
+ void atomicSlotClaim(benchmark::State& state) {
+  static AtomicBitset<PoolSlots, GroupWords> pool;
+  auto const hint = Spread
+   ? (SizeType)state.thread_index() * (PoolSlots / (SizeType)state.threads())
+   : 0;
+  SizeType failures = 0;
+  for (auto _ : state) {
+   auto const slot = pool.findFirstClearAndSet(hint);
+   if (slot == PoolSlots) {
+    failures++;
+    continue;
+   }
+   pool.testAndClear(slot);
+  }
+  state.counters["failures"] = (double)failures;
+  state.SetItemsProcessed(state.iterations());
+ }
+
+ //`atomicSlotClaim` equivalent using a mutex-guarded `Bitset`
+ static void mutexSlotClaim(benchmark::State& state) {
+  static std::mutex mutex;
+  static Bitset<PoolSlots> pool;
+  for (auto _ : state) {
+   SizeType slot;
+   {
+    std::lock_guard<std::mutex> lock{mutex};
+    //Find the first clear bit
+    SizeType word = 0;
+    while (!~pool.data()[word]) {
+     word++;
+    }
+    slot = word * BitsetMetaFunctions::WordBits
+     + (SizeType)__builtin_ctzll(~pool.data()[word]);
+    pool.set(slot);
+   }
+   {
+    std::lock_guard<std::mutex> lock{mutex};
+    pool.set(slot, false);
+   }
+  }
+  state.SetItemsProcessed(state.iterations());
+ }
+
+ BENCHMARK(atomicSlotClaim<8, true>)
+  ->Name("atomicSlotClaim/cacheLineGroups/spread")
+  ->ThreadRange(1, 32)
+  ->UseRealTime();
+ BENCHMARK(atomicSlotClaim<8, false>)
+  ->Name("atomicSlotClaim/cacheLineGroups/shared")
+  ->ThreadRange(1, 32)
+  ->UseRealTime();
+ BENCHMARK(atomicSlotClaim<1, true>)
+  ->Name("atomicSlotClaim/wordPerLine/spread")
+  ->ThreadRange(1, 32)
+  ->UseRealTime();
+ BENCHMARK(mutexSlotClaim)->ThreadRange(1, 32)->UseRealTime();
+
+ #define CX_BITSET_KERNEL_BENCHMARK(kernel, set) \
+  BENCHMARK(kernel<KernelSet::set>)\
+   ->Name(#kernel "/" #set)\
+   ->Arg(SmallBits)\
+   ->Arg(MediumBits)\
+   ->Arg(LargeBits);
+
+ #define CX_BITSET_KERNEL_BENCHMARKS(kernel) \
+  CX_BITSET_KERNEL_BENCHMARK(kernel, SCALAR)\
+  CX_BITSET_KERNEL_BENCHMARK(kernel, SSE)\
+  CX_BITSET_KERNEL_BENCHMARK(kernel, AVX2)\
+  CX_BITSET_KERNEL_BENCHMARK(kernel, AVX512)\
+  CX_BITSET_KERNEL_BENCHMARK(kernel, NEON)
+
+ #define CX_BITSET_SIZED_BENCHMARKS(benchmark) \
+  BENCHMARK(benchmark<SmallBits>)->Name(#benchmark "/4096");\
+  BENCHMARK(benchmark<MediumBits>)->Name(#benchmark "/65536");\
+  BENCHMARK(benchmark<LargeBits>)->Name(#benchmark "/1048576");
+
+ CX_BITSET_KERNEL_BENCHMARKS(kernelAnd)
+ CX_BITSET_SIZED_BENCHMARKS(stdBitsetAnd)
+
+ CX_BITSET_KERNEL_BENCHMARKS(kernelPopcount)
+ CX_BITSET_SIZED_BENCHMARKS(stdBitsetPopcount)
+
+ CX_BITSET_KERNEL_BENCHMARKS(kernelAny)
+ CX_BITSET_SIZED_BENCHMARKS(stdBitsetAny)
+
+ CX_BITSET_KERNEL_BENCHMARKS(kernelIntersectCount)
+ CX_BITSET_SIZED_BENCHMARKS(cxBitsetIntersectCount)
+ CX_BITSET_SIZED_BENCHMARKS(stdBitsetIntersectCount)
+
+ #undef CX_BITSET_SIZED_BENCHMARKS
+ #undef CX_BITSET_KERNEL_BENCHMARKS
+ #undef CX_BITSET_KERNEL_BENCHMARK
+}
@@ -0,0 +1,51 @@
+#include <cx/test/benchmark/common.h>
+
+#include <cstdio>
+
+#include <cx/format.h>
+
+namespace CX::Testing {
+ //Runtime interpretation of a format string
+ static void formatSnprintf(benchmark::State& state) {
+  char buffer[256];
+  for (auto _ : state) {
+   doNotOptimize(snprintf(
+    buffer,
+    sizeof(buffer),
+    "%s: %d of %zu [%08x] at %p",
+    "request",
+    3,
+    (SizeType)8,
+    0xBEEFu,
+    (void *)buffer
+   ));
+  }
+ }
+ BENCHMARK(formatSnprintf);
+
+ //Formatting routine compiled for the format string
+ static void formatCompiled(benchmark::State& state) {
+  char buffer[256];
+  for (auto _ : state) {
+   doNotOptimize(format<"%s: %d of %zu [%08x] at %p">(
+    buffer,
+    sizeof(buffer),
+    "request",
+    3,
+    (SizeType)8,
+    0xBEEFu,
+    (void *)buffer
+   ));
+  }
+ }
+ BENCHMARK(formatCompiled);
+
+ //Floating point conversions are delegated to `snprintf`
+ static void formatCompiledFloating(benchmark::State& state) {
+  char buffer[256];
+  for (auto _ : state) {
+   doNotOptimize(format<"%s: %.2f">(buffer, sizeof(buffer), "ratio", 0.375));
+  }
+ }
+ BENCHMARK(formatCompiledFloating);
+}
@@ -0,0 +1,86 @@
+#include <cx/test/benchmark/common.h>
+
+#include <cx/log.h>
+
+#include <cstdarg>
+
+namespace CX::Testing {
+ //Records between drains of the ring buffer; fits the default ring size
+ constexpr int const DrainInterval = 256;
+
+ //Formats a c-variadic call into a buffer, as a synchronous logger would
+ [[gnu::noinline]]
+ static int formatLog(char * buffer, char const * format, ...) {
+  va_list list;
+  va_start(list, format);
+  auto const length = vsnprintf(buffer, 256, format, list);
+  va_end(list);
+  return length;
+ }
+
+ //Hot path of a synchronous log statement
+ static void logVsnprintf(benchmark::State& state) {
+  char buffer[256];
+  for (auto _ : state) {
+   doNotOptimize(formatLog(
+    buffer,
+    "%s: %d of %zu (%.2f) at %p",
+    "request",
+    3,
+    (SizeType)8,
+    0.375,
+    (void *)buffer
+   ));
+  }
+ }
+ BENCHMARK(logVsnprintf);
+
+ //Hot path of a deferred log statement; the ring buffer is drained, outside
+ //of the timed region, every `DrainInterval` records
+ static void logDeferred(benchmark::State& state) {
+  DeferredLog log;
+  char buffer[256];
+  int pending = 0;
+  for (auto _ : state) {
+   doNotOptimize(deferLog<"%s: %d of %zu (%.2f) at %p">(
+    &log,
+    "request",
+    3,
+    (SizeType)8,
+    0.375,
+    (void *)buffer
+   ));
+   if (++pending == DrainInterval) {
+    state.PauseTiming();
+    log.consume([](char const *, SizeType) noexcept {});
+    pending = 0;
+    state.ResumeTiming();
+   }
+  }
+  state.counters["dropped"] = (double)log.dropped();
+ }
+ BENCHMARK(logDeferred);
+
+ //Cost of formatting deferred records on the consumer
+ static void logDeferredConsume(benchmark::State& state) {
+  DeferredLog log;
+  char buffer[256];
+  for (auto _ : state) {
+   state.PauseTiming();
+   for (int i = 0; i < DrainInterval; i++) {
+    deferLog<"%s: %d of %zu (%.2f) at %p">(
+     &log,
+     "request",
+     3,
+     (SizeType)8,
+     0.375,
+     (void *)buffer
+    );
+   }
+   state.ResumeTiming();
+   doNotOptimize(log.consume([](char const *, SizeType) noexcept {}));
+  }
+  state.SetItemsProcessed((long long)state.iterations() * DrainInterval);
+ }
+ BENCHMARK(logDeferredConsume);
+}
@@ -0,0 +1,75 @@
+#include <cx/test/benchmark/common.h>
+
+#include <cx/memory.h>
+#include <cx/arena.h>
+
+namespace CX::Testing {
+ //Registers and drains four deferred increments through a type-erased `Defer`
+ static void deferErased(benchmark::State& state) {
+  int counter = 0;
+  for (auto _ : state) {
+   Defer<4> deferred;
+   deferred += [&counter] { counter++; };
+   deferred += [&counter] { counter += 2; };
+   deferred += [&counter] { counter += 3; };
+   deferred += [&counter] { counter += 4; };
+   deferred.drain();
+   doNotOptimize(counter);
+  }
+  state.counters["bytes"] = sizeof(Defer<4>);
+ }
+ BENCHMARK(deferErased);
+
+ //Registers and drains four deferred increments through a typed `DeferFrame`
+ static void deferFrame(benchmark::State& state) {
+  int counter = 0;
+  SizeType bytes = 0;
+  for (auto _ : state) {
+   auto frame = DeferFrame{[&counter] { counter++; }}
+    .then([&counter] { counter += 2; })
+    .then([&counter] { counter += 3; })
+    .then([&counter] { counter += 4; });
+   bytes = sizeof(frame);
+   frame.drain();
+   doNotOptimize(counter);
+  }
+  state.counters["bytes"] = (double)bytes;
+ }
+ BENCHMARK(deferFrame);
+
+ //Runs a transaction registering `state.range(0)` cleanups, rolling back
+ //the second half to a checkpoint and draining the remainder
+ template<template<typename...> typename A>
+ void deferTransaction(benchmark::State& state, AllocDefer<A>& deferred) {
+  auto const cleanups = (SizeType)state.range(0);
+  int counter = 0;
+  for (auto _ : state) {
+   for (SizeType i = 0; i < cleanups / 2; i++) {
+    deferred += [&counter] { counter++; };
+   }
+   auto const checkpoint = deferred.checkpoint();
+   for (SizeType i = cleanups / 2; i < cleanups; i++) {
+    deferred += [&counter] { counter--; };
+   }
+   deferred.rollback(checkpoint);
+   deferred.drain();
+   doNotOptimize(counter);
+  }
+  state.SetItemsProcessed((long long)state.iterations() * cleanups);
+ }
+
+ static void allocDeferTransaction(benchmark::State& state) {
+  AllocDefer deferred;
+  deferTransaction(state, deferred);
+ }
+ BENCHMARK(allocDeferTransaction)->Arg(4)->Arg(64);
+
+ static void allocDeferArenaTransaction(benchmark::State& state) {
+  Arena arena;
+  AllocDefer<ArenaAllocator> deferred{
+   ArenaAllocator<AllocDefer<ArenaAllocator>::Entry>{arena}
+  };
+  deferTransaction(state, deferred);
+ }
+ BENCHMARK(allocDeferArenaTransaction)->Arg(4)->Arg(64);
+}
@@ -0,0 +1,82 @@
+#include <cx/test/benchmark/common.h>
+
+#include <cx/pool.h>
+#include <cx/new-variant.h>
+
+#include <cstdlib>
+
+namespace CX::Testing {
+ //Variant-holding message node
+ struct MessageNode final {
+  MessageNode * next;
+  Variant<int, double, char const *> payload;
+ };
+
+ //Number of nodes each thread keeps live between frees
+ constexpr SizeType const LiveNodes = 64;
+
+ //Allocates and frees batches of message nodes through `Alloc`
+ template<typename Alloc, typename Free>
+ void messageChurn(benchmark::State& state, Alloc&& alloc, Free&& free) {
+  MessageNode * nodes[LiveNodes];
+  for (auto _ : state) {
+   for (SizeType i = 0; i < LiveNodes; i++) {
+    nodes[i] = alloc();
+    doNotOptimize(nodes[i]);
+   }
+   for (SizeType i = 0; i < LiveNodes; i++) {
+    free(nodes[i]);
+   }
+  }
+  state.SetItemsProcessed((long long)state.iterations() * LiveNodes);
+ }
+
+ //Shared by all benchmark threads
+ static Pool<MessageNode> sharedPool;
+ static Pool<MessageNode> sharedUncachedPool{
+  PoolMetaFunctions::DefaultSlabObjects,
+  false
+ };
+
+ static void poolAllocator(benchmark::State& state) {
+  PoolAllocator<MessageNode> allocator{sharedPool};
+  messageChurn(
+   state,
+   [&] { return &+allocator.allocate(); },
+   [&](MessageNode * node) { allocator.deallocate(*node); }
+  );
+ }
+ BENCHMARK(poolAllocator)->Threads(1)->Threads(8)->Threads(32)->UseRealTime();
+
+ static void poolAllocatorUncached(benchmark::State& state) {
+  PoolAllocator<MessageNode> allocator{sharedUncachedPool};
+  messageChurn(
+   state,
+   [&] { return &+allocator.allocate(); },
+   [&](MessageNode * node) { allocator.deallocate(*node); }
+  );
+ }
+ BENCHMARK(poolAllocatorUncached)
+  ->Threads(1)
+  ->Threads(8)
+  ->Threads(32)
+  ->UseRealTime();
+
+ static void libcAllocator(benchmark::State& state) {
+  messageChurn(
+   state,
+   [] { return &+LibcAllocator<MessageNode>::allocate(1); },
+   [](MessageNode * node) { LibcAllocator<MessageNode>::deallocate(*node, 1); }
+  );
+ }
+ BENCHMARK(libcAllocator)->Threads(1)->Threads(8)->Threads(32)->UseRealTime();
+
+ static void glibcMalloc(benchmark::State& state) {
+  messageChurn(
+   state,
+   [] { return (MessageNode *)malloc(sizeof(MessageNode)); },
+   [](MessageNode * node) { free(node); }
+  );
+ }
+ BENCHMARK(glibcMalloc)->Threads(1)->Threads(8)->Threads(32)->UseRealTime();
+}
@@ -0,0 +1,150 @@
+#include <cx/test/benchmark/common.h>
+
+#include <cx/roaring.h>
+
+#include <vector>
+
+namespace CX::Testing {
+ //Size of the value range populated by the benchmarks
+ constexpr unsigned int const ValueRange = 1 << 22;
+
+ //Densities, in values per 1000; sparse inputs produce array containers,
+ //dense inputs bitset containers
+ #define CX_ROARING_DENSITIES Arg(1)->Arg(50)->Arg(500)
+
+ //Returns deterministic pseudo-random values below `ValueRange`, at
+ //`perMille` values per 1000
+ static std::vector<unsigned int> randomValues(
+  SizeType const perMille,
+  unsigned int seed
+ ) {
+  std::vector<unsigned int> values;
+  for (unsigned int value = 0; value < ValueRange; value++) {
+   seed ^= seed << 13;
+   seed ^= seed >> 17;
+   seed ^= seed << 5;
+   if (seed % 1000 < perMille) {
+    values.push_back(value);
+   }
+  }
+  return values;
+ }
+
+ //Roaring and flat bitmaps holding the same pseudo-random values
+ struct BitmapOperands final {
+  RoaringBitmap<> roaringA, roaringB;
+  DynamicBitset<> flatA, flatB;
+
+  BitmapOperands(SizeType const perMille) :
+   flatA(ValueRange),
+   flatB(ValueRange)
+  {
+   for (auto const value : randomValues(perMille, 0x12345678)) {
+    roaringA.add(value);
+    flatA.set(value);
+   }
+   for (auto const value : randomValues(perMille, 0x9ABCDEF1)) {
+    roaringB.add(value);
+    flatB.set(value);
+   }
+  }
+ };
+
+ static void roaringUnion(benchmark::State& state) {
+  BitmapOperands const operands{(SizeType)state.range(0)};
+  for (auto _ : state) {
+   auto result = operands.roaringA | operands.roaringB;
+   doNotOptimize(&result);
+  }
+  state.counters["bytes"] = operands.roaringA.serializedSize();
+ }
+ BENCHMARK(roaringUnion)->CX_ROARING_DENSITIES;
+
+ static void flatUnion(benchmark::State& state) {
+  BitmapOperands const operands{(SizeType)state.range(0)};
+  for (auto _ : state) {
+   auto result = operands.flatA | operands.flatB;
+   doNotOptimize(&result);
+  }
+  state.counters["bytes"] = ValueRange / 8;
+ }
+ BENCHMARK(flatUnion)->CX_ROARING_DENSITIES;
+
+ static void roaringIntersection(benchmark::State& state) {
+  BitmapOperands const operands{(SizeType)state.range(0)};
+  for (auto _ : state) {
+   auto result = operands.roaringA & operands.roaringB;
+   doNotOptimize(&result);
+  }
+ }
+ BENCHMARK(roaringIntersection)->CX_ROARING_DENSITIES;
+
+ static void flatIntersection(benchmark::State& state) {
+  BitmapOperands const operands{(SizeType)state.range(0)};
+  for (auto _ : state) {
+   auto result = operands.flatA & operands.flatB;
+   doNotOptimize(&result);
+  }
+ }
+ BENCHMARK(flatIntersection)->CX_ROARING_DENSITIES;
+
+ static void roaringIntersectCardinality(benchmark::State& state) {
+  BitmapOperands const operands{(SizeType)state.range(0)};
+  for (auto _ : state) {
+   doNotOptimize(operands.roaringA.intersectCardinality(operands.roaringB));
+  }
+ }
+ BENCHMARK(roaringIntersectCardinality)->CX_ROARING_DENSITIES;
+
+ static void flatIntersectCardinality(benchmark::State& state) {
+  BitmapOperands const operands{(SizeType)state.range(0)};
+  for (auto _ : state) {
+   doNotOptimize(operands.flatA.intersectCount(operands.flatB));
+  }
+ }
+ BENCHMARK(flatIntersectCardinality)->CX_ROARING_DENSITIES;
+
+ static void roaringContains(benchmark::State& state) {
+  BitmapOperands const operands{(SizeType)state.range(0)};
+  unsigned int value = 0;
+  for (auto _ : state) {
+   value = (value + 7919) % ValueRange;
+   doNotOptimize(operands.roaringA.contains(value));
+  }
+ }
+ BENCHMARK(roaringContains)->CX_ROARING_DENSITIES;
+
+ //Queries a serialized bitmap in place, as if memory-mapped
+ static void roaringViewContains(benchmark::State& state) {
+  BitmapOperands const operands{(SizeType)state.range(0)};
+  std::vector<unsigned long long> buffer(
+   (operands.roaringA.serializedSize() + 7) / 8
+  );
+  auto const bytes = (unsigned char *)buffer.data();
+  operands.roaringA.serialize(bytes);
+  RoaringView const view{bytes};
+  unsigned int value = 0;
+  for (auto _ : state) {
+   value = (value + 7919) % ValueRange;
+   doNotOptimize(view.contains(value));
+  }
+ }
+ BENCHMARK(roaringViewContains)->CX_ROARING_DENSITIES;
+
+ static void roaringSerialize(benchmark::State& state) {
+  BitmapOperands const operands{(SizeType)state.range(0)};
+  std::vector<unsigned long long> buffer(
+   (operands.roaringA.serializedSize() + 7) / 8
+  );
+  for (auto _ : state) {
+   doNotOptimize(operands.roaringA.serialize((unsigned char *)buffer.data()));
+   benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(
+   (long long)state.iterations() * operands.roaringA.serializedSize()
+  );
+ }
+ BENCHMARK(roaringSerialize)->CX_ROARING_DENSITIES;
+
+ #undef CX_ROARING_DENSITIES
+}
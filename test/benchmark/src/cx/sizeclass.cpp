@@ -0,0 +1,120 @@
+#include <cx/test/benchmark/common.h>
+
+#include <cx/sizeclass.h>
+
+#include <cstdlib>
+#include <vector>
+
+namespace CX::Testing {
+ //Number of allocations each thread keeps live
+ constexpr SizeType const WorkingSet = 4096;
+
+ //Number of pre-generated requests, replayed in a cycle
+ constexpr SizeType const Requests = 1 << 16;
+
+ //Allocation size distributions
+ enum struct SizeDistribution : unsigned char {
+  //Mostly small nodes and strings
+  SMALL,
+  //Server-style mix: small objects with occasional buffers up to 256KiB
+  MIXED,
+  //Fixed 64-byte objects
+  FIXED
+ };
+
+ //Returns pre-generated request sizes drawn from `distribution`
+ static std::vector<SizeType> requestSizes(SizeDistribution const distribution) {
+  std::vector<SizeType> sizes(Requests);
+  unsigned int seed = 0x2545F491;
+  auto const next = [&] {
+   seed ^= seed << 13;
+   seed ^= seed >> 17;
+   seed ^= seed << 5;
+   return (SizeType)seed;
+  };
+  for (auto& size : sizes) {
+   auto const bucket = next() % 100;
+   switch (distribution) {
+    case SizeDistribution::SMALL: {
+     size = bucket < 70 ? 8 + next() % 56 : 64 + next() % 448;
+     break;
+    }
+    case SizeDistribution::MIXED: {
+     if (bucket < 60) {
+      size = 8 + next() % 56;
+     } else if (bucket < 85) {
+      size = 64 + next() % 448;
+     } else if (bucket < 95) {
+      size = 512 + next() % 3584;
+     } else if (bucket < 99) {
+      size = 4096 + next() % 28672;
+     } else {
+      size = 32768 + next() % 229376;
+     }
+     break;
+    }
+    case SizeDistribution::FIXED: {
+     size = 64;
+     break;
+    }
+   }
+  }
+  return sizes;
+ }
+
+ //Replaces a pseudo-random live allocation with a new one per iteration
+ template<typename Alloc, typename Free>
+ void churn(benchmark::State& state, Alloc&& alloc, Free&& free) {
+  auto const sizes = requestSizes((SizeDistribution)state.range(0));
+  struct Live final {
+   void * address;
+   SizeType size;
+  };
+  std::vector<Live> live(WorkingSet);
+  for (SizeType i = 0; i < WorkingSet; i++) {
+   live[i] = {alloc(sizes[i]), sizes[i]};
+  }
+  SizeType request = WorkingSet;
+  for (auto _ : state) {
+   auto& slot = live[(request * 2654435761u) % WorkingSet];
+   free(slot.address, slot.size);
+   auto const size = sizes[request++ % Requests];
+   slot = {alloc(size), size};
+   *(unsigned char *)slot.address = 1;
+  }
+  for (auto const& slot : live) {
+   free(slot.address, slot.size);
+  }
+  state.SetItemsProcessed((long long)state.iterations());
+ }
+
+ static void sizeClassHeap(benchmark::State& state) {
+  churn(
+   state,
+   [](SizeType size) { return SizeClassHeap::allocate(size, 16); },
+   [](void * address, SizeType size) {
+    SizeClassHeap::deallocate(address, size, 16);
+   }
+  );
+ }
+ BENCHMARK(sizeClassHeap)
+  ->ArgNames({"distribution"})
+  ->DenseRange(0, 2)
+  ->Threads(1)
+  ->Threads(8)
+  ->UseRealTime();
+
+ static void glibcMalloc(benchmark::State& state) {
+  churn(
+   state,
+   [](SizeType size) { return malloc(size); },
+   [](void * address, SizeType) { free(address); }
+  );
+ }
+ BENCHMARK(glibcMalloc)
+  ->ArgNames({"distribution"})
+  ->DenseRange(0, 2)
+  ->Threads(1)
+  ->Threads(8)
+  ->UseRealTime();
+}
@@ -0,0 +1,157 @@
+#include <cx/test/benchmark/common.h>
+
+#include <cx/tuple.h>
+
+#include <string>
+#include <tuple>
+
+//Note: Compile-time cost of the flat tuple layout is measured by building this
+//translation unit; `CX_TUPLE_BENCHMARK_MAX_ELEMENTS` bounds the largest tuple
+//instantiated, to compare build times across element counts
+#ifndef CX_TUPLE_BENCHMARK_MAX_ELEMENTS
+ #define CX_TUPLE_BENCHMARK_MAX_ELEMENTS 128
+#endif
+
+namespace CX::Testing {
+ //Cycles through element types with mixed alignments, to expose padding
+ template<SizeType I>
+ using MixedElement = TypeAtIndex<I % 4, char, double, short, int>;
+
+ //Generates `TT<MixedElement<0>, ..., MixedElement<N - 1>>`
+ template<template<typename...> typename TT, typename>
+ struct MixedTupleGenerator;
+
+ template<template<typename...> typename TT, SizeType... I>
+ struct MixedTupleGenerator<TT, IndexSequence<I...>> {
+  using Type = TT<MixedElement<I>...>;
+ };
+
+ template<template<typename...> typename TT, SizeType N>
+ using MixedTuple = typename MixedTupleGenerator<
+  TT,
+  MakeIndexSequence<N>
+ >::Type;
+
+ //Sums every element of `tuple` using index-based access
+ template<SizeType N, typename T>
+ double sumElements(T const& tuple) noexcept {
+  return [&]<SizeType... I>(IndexSequence<I...>) {
+   if constexpr (requires { tuple.template get<0>(); }) {
+    return (0.0 + ... + (double)tuple.template get<I>());
+   } else {
+    return (0.0 + ... + (double)std::get<I>(tuple));
+   }
+  }(MakeIndexSequence<N>{});
+ }
+
+ template<template<typename...> typename TT, SizeType N>
+ void tupleAccess(benchmark::State& state) {
+  using TupleType = MixedTuple<TT, N>;
+  TupleType tuple{};
+  state.counters["sizeof"] = sizeof(TupleType);
+  for (auto _ : state) {
+   doNotOptimize(&tuple);
+   doNotOptimize(sumElements<N>(tuple));
+  }
+ }
+
+ template<template<typename...> typename TT, SizeType N>
+ void tupleCopy(benchmark::State& state) {
+  using TupleType = MixedTuple<TT, N>;
+  TupleType tuple{};
+  state.counters["sizeof"] = sizeof(TupleType);
+  for (auto _ : state) {
+   doNotOptimize(&tuple);
+   TupleType copy{tuple};
+   doNotOptimize(&copy);
+   benchmark::ClobberMemory();
+  }
+ }
+
+ #define CX_TUPLE_BENCHMARK(n) \
+  BENCHMARK(tupleAccess<Tuple, n>)->Name("cx_tuple_access/" #n);\
+  BENCHMARK(tupleAccess<PackedTuple, n>)->Name("cx_packed_tuple_access/" #n);\
+  BENCHMARK(tupleAccess<std::tuple, n>)->Name("std_tuple_access/" #n);\
+  BENCHMARK(tupleCopy<Tuple, n>)->Name("cx_tuple_copy/" #n);\
+  BENCHMARK(tupleCopy<PackedTuple, n>)->Name("cx_packed_tuple_copy/" #n);\
+  BENCHMARK(tupleCopy<std::tuple, n>)->Name("std_tuple_copy/" #n);
+
+ CX_TUPLE_BENCHMARK(8)
+
+ #if CX_TUPLE_BENCHMARK_MAX_ELEMENTS >= 32
+  CX_TUPLE_BENCHMARK(32)
+ #endif
+
+ #if CX_TUPLE_BENCHMARK_MAX_ELEMENTS >= 128
+  CX_TUPLE_BENCHMARK(128)
+ #endif
+
+ #undef CX_TUPLE_BENCHMARK
+
+ //Heap-allocated element type, so that copies are measurably more
+ //expensive than moves
+ static std::string const LargeElement(256, 'x');
+
+ static void cx_tuple_concatenate_copy(benchmark::State& state) {
+  Tuple<std::string, int> t1{LargeElement, 1};
+  Tuple<std::string, std::string> t2{LargeElement, LargeElement};
+  for (auto _ : state) {
+   auto t = t1 + t2;
+   doNotOptimize(&t);
+  }
+ }
+ BENCHMARK(cx_tuple_concatenate_copy);
+
+ static void std_tuple_cat_copy(benchmark::State& state) {
+  std::tuple<std::string, int> t1{LargeElement, 1};
+  std::tuple<std::string, std::string> t2{LargeElement, LargeElement};
+  for (auto _ : state) {
+   auto t = std::tuple_cat(t1, t2);
+   doNotOptimize(&t);
+  }
+ }
+ BENCHMARK(std_tuple_cat_copy);
+
+ static void cx_tuple_concatenate_move(benchmark::State& state) {
+  for (auto _ : state) {
+   Tuple<std::string, int> t1{LargeElement, 1};
+   Tuple<std::string, std::string> t2{LargeElement, LargeElement};
+   auto t = (decltype(t1)&&)t1 + (decltype(t2)&&)t2;
+   doNotOptimize(&t);
+  }
+ }
+ BENCHMARK(cx_tuple_concatenate_move);
+
+ static void std_tuple_cat_move(benchmark::State& state) {
+  for (auto _ : state) {
+   std::tuple<std::string, int> t1{LargeElement, 1};
+   std::tuple<std::string, std::string> t2{LargeElement, LargeElement};
+   auto t = std::tuple_cat((decltype(t1)&&)t1, (decltype(t2)&&)t2);
+   doNotOptimize(&t);
+  }
+ }
+ BENCHMARK(std_tuple_cat_move);
+
+ static void cx_tuple_concatenate_view(benchmark::State& state) {
+  Tuple<std::string, int> t1{LargeElement, 1};
+  Tuple<std::string, std::string> t2{LargeElement, LargeElement};
+  for (auto _ : state) {
+   auto t = concatenateView(t1, t2);
+   doNotOptimize(&t);
+  }
+ }
+ BENCHMARK(cx_tuple_concatenate_view);
+
+ static void std_tuple_cat_tie(benchmark::State& state) {
+  std::tuple<std::string, int> t1{LargeElement, 1};
+  std::tuple<std::string, std::string> t2{LargeElement, LargeElement};
+  for (auto _ : state) {
+   auto t = std::tuple_cat(
+    std::apply([](auto&... e) { return std::tie(e...); }, t1),
+    std::apply([](auto&... e) { return std::tie(e...); }, t2)
+   );
+   doNotOptimize(&t);
+  }
+ }
+ BENCHMARK(std_tuple_cat_tie);
+}
@@ -1,6 +1,7 @@
 #include <cx/test/benchmark/common.h>
 
 #include <cx/vararg.h>
+#include <cx/lambda.h>
 
 #include <cstdarg>
 
@@ -80,4 +81,286 @@ namespace CX::Testing {
  BENCHMARK_TEMPLATE_F(VarargsBenchmarkFixture, large_cx_va_list, 500)(benchmark::State &state) {
   runCXVaList(state);
  }
+
+ //Name of the `VaListWrapper` specialization for the host ABI; recorded in
+ //the benchmark context so that results from different hosts can be told
+ //apart
+ //Note: Silences gcc attribute parser bugs, as in `cx/vararg.h`
+ #if defined(__GNUC__) && !defined(__clang__)
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wignored-attributes"
+  #pragma GCC diagnostic ignored "-Wattributes"
+ #endif
+ constexpr char const * vaListAbi() noexcept {
+  using PlatformListType = typename CX::VaList::PlatformListType;
+  if constexpr (SameType<PlatformListType, char *>) {
+   return "char *";
+  } else if constexpr (Pointer<PlatformListType>) {
+   return "va_list[1]";
+  } else {
+   return "va_list";
+  }
+ }
+ #if defined(__GNUC__) && !defined(__clang__)
+  #pragma GCC diagnostic pop
+ #endif
+
+ static bool const vaListAbiRecorded = [] {
+  benchmark::AddCustomContext("cx_va_list_abi", vaListAbi());
+  return true;
+ }();
+
+ //Struct arguments passed in registers and in memory, respectively, by the
+ //AMD64 and AArch64 ABIs
+ struct VarargPair final {
+  long long key;
+  double value;
+ };
+
+ struct VarargBlock final {
+  long long values[4];
+ };
+
+ //Pulls `N` arguments of type `T` with `va_arg`
+ template<typename T, auto N>
+ static void vaArgLoop(benchmark::State& state) {
+  VarargInvoker<N, T>::invoke([&]<typename... Args>(Args... args) {
+   for (auto _ : state) {
+    [](int i, ...) {
+     va_list list;
+     va_start(list, i);
+     for (int c = 0; c < N; c++) {
+      doNotOptimize(va_arg(list, T));
+     }
+     va_end(list);
+    }(0, args...);
+   }
+  });
+  state.SetItemsProcessed((long long)state.iterations() * N);
+ }
+
+ //Pulls `N` arguments of type `T` with `CX::VaList::arg<T>()`
+ template<typename T, auto N>
+ static void cxArgLoop(benchmark::State& state) {
+  VarargInvoker<N, T>::invoke([&]<typename... Args>(Args... args) {
+   for (auto _ : state) {
+    [](int i, ...) {
+     CX::VaList list;
+     va_start(list, i);
+     for (int c = 0; c < N; c++) {
+      doNotOptimize(list.template arg<T>());
+     }
+    }(0, args...);
+   }
+  });
+  state.SetItemsProcessed((long long)state.iterations() * N);
+ }
+
+ BENCHMARK_TEMPLATE(vaArgLoop, int, 16);
+ BENCHMARK_TEMPLATE(cxArgLoop, int, 16);
+ BENCHMARK_TEMPLATE(vaArgLoop, double, 16);
+ BENCHMARK_TEMPLATE(cxArgLoop, double, 16);
+ BENCHMARK_TEMPLATE(vaArgLoop, void const *, 16);
+ BENCHMARK_TEMPLATE(cxArgLoop, void const *, 16);
+ BENCHMARK_TEMPLATE(vaArgLoop, VarargPair, 16);
+ BENCHMARK_TEMPLATE(cxArgLoop, VarargPair, 16);
+ BENCHMARK_TEMPLATE(vaArgLoop, VarargBlock, 16);
+ BENCHMARK_TEMPLATE(cxArgLoop, VarargBlock, 16);
+
+ //Copies a `va_list` and pulls one argument from the copy
+ static void vaCopy(benchmark::State& state) {
+  [](benchmark::State * state, ...) {
+   va_list list;
+   va_start(list, state);
+   for (auto _ : *state) {
+    va_list copy;
+    va_copy(copy, list);
+    doNotOptimize(va_arg(copy, int));
+    va_end(copy);
+   }
+   va_end(list);
+  }(&state, 1, 2.0);
+ }
+ BENCHMARK(vaCopy);
+
+ //Snapshots a `CX::VaList` and pulls one argument from the snapshot
+ static void cxSnapshot(benchmark::State& state) {
+  [](benchmark::State * state, ...) {
+   CX::VaList list;
+   va_start(list, state);
+   for (auto _ : *state) {
+    auto snapshot = list.snapshot();
+    doNotOptimize(snapshot.arg<int>());
+   }
+  }(&state, 1, 2.0);
+ }
+ BENCHMARK(cxSnapshot);
+
+ //Pulls one argument from a `CX::VaList` and rewinds it to a snapshot
+ static void cxRewind(benchmark::State& state) {
+  [](benchmark::State * state, ...) {
+   CX::VaList list;
+   va_start(list, state);
+   auto const snapshot = list.snapshot();
+   for (auto _ : *state) {
+    doNotOptimize(list.arg<int>());
+    list.rewind(snapshot);
+   }
+  }(&state, 1, 2.0);
+ }
+ BENCHMARK(cxRewind);
+
+ //C-variadic callee for the invocation benchmarks
+ [[gnu::noinline]]
+ static int sumVarargs(int count, ...) {
+  va_list list;
+  va_start(list, count);
+  int sum = 0;
+  for (int i = 0; i < count; i++) {
+   sum += va_arg(list, int);
+  }
+  va_end(list);
+  return sum;
+ }
+
+ //Direct call of a c-variadic function
+ static void directVariadicCall(benchmark::State& state) {
+  int a = 1, b = 2, c = 3, d = 4;
+  for (auto _ : state) {
+   benchmark::DoNotOptimize(a);
+   doNotOptimize(sumVarargs(4, a, b, c, d));
+  }
+ }
+ BENCHMARK(directVariadicCall);
+
+ //Call of a c-variadic function through a function pointer
+ static void pointerVariadicCall(benchmark::State& state) {
+  int (* volatile function)(int, ...) = &sumVarargs;
+  int a = 1, b = 2, c = 3, d = 4;
+  for (auto _ : state) {
+   benchmark::DoNotOptimize(a);
+   doNotOptimize(function(4, a, b, c, d));
+  }
+ }
+ BENCHMARK(pointerVariadicCall);
+
+ //Call of a c-variadic function through a c-variadic `Lambda`
+ static void lambdaVariadicCall(benchmark::State& state) {
+  Lambda<int (int, ...)> function = &sumVarargs;
+  int a = 1, b = 2, c = 3, d = 4;
+  for (auto _ : state) {
+   benchmark::DoNotOptimize(a);
+   doNotOptimize(function(4, a, b, c, d));
+  }
+ }
+ BENCHMARK(lambdaVariadicCall);
+ //Mixed argument set of a typical log statement
+ #define CX_VARARG_MIXED_FORMAT "%s: %d of %zu (%.2f) at %p [%lld]"
+ #define CX_VARARG_MIXED_ARGUMENTS \
+  "request", 3, (SizeType)8, 0.375, (void *)&state, 42LL
+
+ //Pulls the mixed argument set from `list` with one `arg<T>()` call each
+ [[gnu::always_inline]]
+ inline void decodeMixed(CX::VaList& list) {
+  auto const name = list.arg<char const *>();
+  auto const index = list.arg<int>();
+  auto const count = list.arg<SizeType>();
+  auto const ratio = list.arg<double>();
+  auto const pointer = list.arg<void const *>();
+  auto const id = list.arg<long long>();
+  doNotOptimize(name, index, count, ratio, pointer, id);
+ }
+
+ //Decodes the mixed argument set with one `va_arg` call per argument
+ static void mixedVaArgLoop(benchmark::State& state) {
+  for (auto _ : state) {
+   [](int i, ...) {
+    va_list list;
+    va_start(list, i);
+    auto const name = va_arg(list, char const *);
+    auto const index = va_arg(list, int);
+    auto const count = va_arg(list, SizeType);
+    auto const ratio = va_arg(list, double);
+    auto const pointer = va_arg(list, void const *);
+    auto const id = va_arg(list, long long);
+    va_end(list);
+    doNotOptimize(name, index, count, ratio, pointer, id);
+   }(0, CX_VARARG_MIXED_ARGUMENTS);
+  }
+ }
+ BENCHMARK(mixedVaArgLoop);
+
+ //Decodes the mixed argument set with one `arg<T>()` call per argument
+ static void mixedArgLoop(benchmark::State& state) {
+  for (auto _ : state) {
+   [](int i, ...) {
+    CX::VaList list;
+    va_start(list, i);
+    decodeMixed(list);
+   }(0, CX_VARARG_MIXED_ARGUMENTS);
+  }
+ }
+ BENCHMARK(mixedArgLoop);
+
+ //Decodes the mixed argument set into a `Tuple` from its format string
+ static void mixedDecode(benchmark::State& state) {
+  for (auto _ : state) {
+   [](int i, ...) {
+    CX::VaList list;
+    va_start(list, i);
+    auto const arguments = decode<CX_VARARG_MIXED_FORMAT>(list);
+    apply([](auto... values) { doNotOptimize(values...); }, arguments);
+   }(0, CX_VARARG_MIXED_ARGUMENTS);
+  }
+ }
+ BENCHMARK(mixedDecode);
+
+ //Pulls the mixed argument set twice, restarting the list in between, as a
+ //size pass followed by a format pass does
+ static void mixedArgLoopRestarted(benchmark::State& state) {
+  for (auto _ : state) {
+   [](int i, ...) {
+    CX::VaList list;
+    va_start(list, i);
+    decodeMixed(list);
+    va_end(list);
+    va_start(list, i);
+    decodeMixed(list);
+   }(0, CX_VARARG_MIXED_ARGUMENTS);
+  }
+ }
+ BENCHMARK(mixedArgLoopRestarted);
+
+ //Pulls the mixed argument set twice, rewinding to a snapshot in between;
+ //the only option for functions receiving a `va_list`
+ static void mixedArgLoopRewound(benchmark::State& state) {
+  for (auto _ : state) {
+   [](int i, ...) {
+    CX::VaList list;
+    va_start(list, i);
+    auto const snapshot = list.snapshot();
+    decodeMixed(list);
+    list.rewind(snapshot);
+    decodeMixed(list);
+   }(0, CX_VARARG_MIXED_ARGUMENTS);
+  }
+ }
+ BENCHMARK(mixedArgLoopRewound);
+
+ //Decodes the mixed argument set once and consumes the `Tuple` twice
+ static void mixedDecodeReused(benchmark::State& state) {
+  for (auto _ : state) {
+   [](int i, ...) {
+    CX::VaList list;
+    va_start(list, i);
+    auto const arguments = decode<CX_VARARG_MIXED_FORMAT>(list);
+    apply([](auto... values) { doNotOptimize(values...); }, arguments);
+    apply([](auto... values) { doNotOptimize(values...); }, arguments);
+   }(0, CX_VARARG_MIXED_ARGUMENTS);
+  }
+ }
+ BENCHMARK(mixedDecodeReused);
+
+ #undef CX_VARARG_MIXED_ARGUMENTS
+ #undef CX_VARARG_MIXED_FORMAT
 }
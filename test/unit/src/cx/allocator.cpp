@@ -8,8 +8,8 @@ namespace CX {
  struct StatelessAllocator final {
   static constexpr bool const Stateless = true;
 
-  static constexpr T& allocate(SizeType) noexcept {
-   return *static_cast<T *>(nullptr);
+  static constexpr AllocResult<T> allocate(SizeType) noexcept {
+   return AllocError{AllocErrorType::UNSUPPORTED};
   }
 
   static constexpr void deallocate(T const&, SizeType) noexcept {}
@@ -20,8 +20,8 @@ namespace CX {
  struct StatefulAllocator final {
   static constexpr bool const Stateless = false;
 
-  constexpr T& allocate(SizeType) noexcept {
-   return *static_cast<T *>(nullptr);
+  constexpr AllocResult<T> allocate(SizeType) noexcept {
+   return AllocError{AllocErrorType::UNSUPPORTED};
   }
 
   constexpr void deallocate(T const&, SizeType) noexcept {}
@@ -89,7 +89,7 @@ namespace CX {
 
  TEST(ConstexprAllocator, constant_evaluated_memory_management_does_not_yield_an_error) {
   constexpr auto const r = []() constexpr noexcept {
-   auto& p = ConstexprAllocator<int>::allocate(20);
+   auto& p = +ConstexprAllocator<int>::allocate(20);
    ConstexprAllocator<int>::deallocate(p, 20);
    return 0;
   }();
@@ -115,7 +115,101 @@ namespace CX {
  }
  */
 
- //TODO Tests for the libc-backed allocator
+ #ifdef CX_STL_SUPPORT
+  TEST(StlAllocator, over_aligned_requests_are_aligned) {
+   auto const result = StlAllocator<int>::allocate(3, 256);
+   ASSERT_TRUE(result.hasValue());
+   EXPECT_EQ((SizeType)&result.value() % 256, 0u);
+   StlAllocator<int>::deallocate(result.value(), 3, 256);
+  }
+ #endif
+
+ #ifdef CX_LIBC_SUPPORT
+  TEST(LibcAllocator, allocator_supports_aligned_expanding_and_reallocating_requests) {
+   EXPECT_TRUE((IsAligningAllocator<LibcAllocator>));
+   EXPECT_TRUE((IsExpandingAllocator<LibcAllocator>));
+   EXPECT_TRUE((IsReallocatingAllocator<LibcAllocator>));
+   EXPECT_FALSE((IsExpandingAllocator<StatelessAllocator>));
+   EXPECT_FALSE((IsReallocatingAllocator<StatefulAllocator>));
+  }
+
+  TEST(LibcAllocator, over_aligned_requests_are_aligned) {
+   //Sizes that are and are not multiples of the alignment
+   for (SizeType const n : {16u, 5u}) {
+    auto const result = LibcAllocator<int>::allocate(n, 64);
+    ASSERT_TRUE(result.hasValue());
+    EXPECT_EQ((SizeType)&result.value() % 64, 0u);
+    LibcAllocator<int>::deallocate(result.value(), n, 64);
+   }
+  }
+
+  TEST(LibcAllocator, invalid_requests_yield_errors) {
+   auto const alignment = LibcAllocator<int>::allocate(1, 24);
+   ASSERT_TRUE(alignment.hasError());
+   EXPECT_EQ(alignment.error().type, AllocErrorType::INVALID_ALIGNMENT);
+   auto const size = LibcAllocator<int>::allocate((SizeType)-1 / 2);
+   ASSERT_TRUE(size.hasError());
+   EXPECT_EQ(size.error().type, AllocErrorType::SIZE_OVERFLOW);
+  }
+
+  TEST(LibcAllocator, reallocate_preserves_contents) {
+   auto p = &+LibcAllocator<int>::allocate(4);
+   for (int i = 0; i < 4; i++) {
+    p[i] = i;
+   }
+   EXPECT_TRUE(LibcAllocator<int>::expand(*p, 4, 2));
+   p = &+LibcAllocator<int>::reallocate(*p, 4, 1024);
+   for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(p[i], i);
+   }
+   LibcAllocator<int>::deallocate(*p, 1024);
+  }
+
+  //Stateful allocator without in-place resizing; counts live allocations
+  template<typename T>
+  struct MovingAllocator final {
+   int * live;
+
+   AllocResult<T> allocate(SizeType const n) noexcept {
+    (*live)++;
+    return LibcAllocator<T>::allocate(n);
+   }
+
+   void deallocate(T const& t, SizeType const n) noexcept {
+    (*live)--;
+    LibcAllocator<T>::deallocate(t, n);
+   }
+  };
+
+  TEST(reallocate, allocations_are_moved_without_reallocate_or_expand) {
+   int live = 0;
+   MovingAllocator<int> allocator{&live};
+   auto p = &+allocator.allocate(3);
+   for (int i = 0; i < 3; i++) {
+    p[i] = i + 1;
+   }
+   auto& q = +reallocate<MovingAllocator>(allocator, *p, 3, 64);
+   EXPECT_NE(&q, p);
+   EXPECT_EQ(live, 1);
+   for (int i = 0; i < 3; i++) {
+    EXPECT_EQ((&q)[i], i + 1);
+   }
+   allocator.deallocate(q, 64);
+  }
+
+  TEST(reallocate, allocations_are_shrunk_in_place) {
+   Never none;
+   auto& p = +LibcAllocator<int>::allocate(64);
+   EXPECT_EQ(&+reallocate<LibcAllocator>(none, p, 64, 8), &p);
+   LibcAllocator<int>::deallocate(p, 8);
+  }
+ #endif
+
+ TEST(NoneAllocator, allocation_yields_an_error) {
+  auto const result = NoneAllocator<int>::allocate(1);
+  ASSERT_TRUE(result.hasError());
+  EXPECT_EQ(result.error().type, AllocErrorType::UNAVAILABLE);
+ }
 
  //TODO Tests for the default allocator
 }
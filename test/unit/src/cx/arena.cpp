@@ -0,0 +1,215 @@
+#include <cx/test/common/common.h>
+#include <cx/arena.h>
+#include <cx/bitset.h>
+
+namespace CX::Testing {
+ //Upstream allocator counting live chunks
+ template<typename T>
+ struct CountingUpstream final {
+  static inline SizeType live = 0;
+
+  static AllocResult<T> allocate(SizeType const n) noexcept {
+   live++;
+   return Allocator<T>::allocate(n);
+  }
+
+  static void deallocate(T const& t, SizeType const n) noexcept {
+   live--;
+   Allocator<T>::deallocate(t, n);
+  }
+ };
+
+ using ArenaUpstream = CountingUpstream<ArenaMetaFunctions::Block>;
+
+ //Returns an arena allocating chunks from `CountingUpstream`
+ Arena countingArena(
+  SizeType const chunkSize = ArenaMetaFunctions::DefaultChunkSize
+ ) {
+  return Arena{chunkSize, ArenaMetaFunctions::Upstream::of<CountingUpstream>()};
+ }
+
+ TEST(ArenaAllocator, satisfies_stateful_allocator_concept) {
+  EXPECT_TRUE((IsStatefulAllocator<ArenaAllocator>));
+  EXPECT_FALSE((IsStatelessAllocator<ArenaAllocator>));
+  EXPECT_EQ(sizeof(ArenaAllocator<int>), sizeof(void *));
+ }
+
+ TEST(Arena, arena_allocates_lazily) {
+  {
+   auto const arena = countingArena();
+   EXPECT_EQ(arena.chunkCount(), 0);
+   EXPECT_EQ(arena.capacity(), 0);
+   EXPECT_EQ(ArenaUpstream::live, 0);
+  }
+  EXPECT_EQ(ArenaUpstream::live, 0);
+ }
+
+ TEST(Arena, allocations_are_contiguous_and_aligned) {
+  Arena arena;
+  auto const a = (unsigned char *)arena.allocate(3, 1);
+  auto const b = (unsigned char *)arena.allocate(5, 1);
+  EXPECT_EQ(b, a + 3);
+  auto const c = arena.allocate(8, 8);
+  EXPECT_EQ((SizeType)c % 8, 0);
+  EXPECT_EQ((unsigned char *)c, a + 8);
+  for (SizeType alignment = 1; alignment <= 4096; alignment *= 2) {
+   (void)arena.allocate(1, 1);
+   auto const p = arena.allocate(alignment, alignment);
+   EXPECT_EQ((SizeType)p % alignment, 0);
+  }
+ }
+
+ TEST(Arena, chunks_grow_and_oversized_requests_fit) {
+  auto arena = countingArena(64);
+  (void)arena.allocate(48, 8);
+  EXPECT_EQ(arena.chunkCount(), 1);
+  (void)arena.allocate(48, 8);
+  EXPECT_EQ(arena.chunkCount(), 2);
+  auto const large = (unsigned char *)arena.allocate(100000, 64);
+  EXPECT_EQ((SizeType)large % 64, 0);
+  large[0] = 1;
+  large[99999] = 1;
+  EXPECT_EQ(arena.chunkCount(), 3);
+  EXPECT_GE(arena.capacity(), 100000);
+  EXPECT_EQ(ArenaUpstream::live, 3);
+ }
+
+ TEST(Arena, reset_retains_most_recent_chunk) {
+  {
+   auto arena = countingArena(256);
+   for (int i = 0; i < 100; i++) {
+    (void)arena.allocate(64, 8);
+   }
+   EXPECT_GT(arena.chunkCount(), 1);
+   auto const capacity = arena.capacity();
+   arena.reset();
+   EXPECT_EQ(arena.chunkCount(), 1);
+   EXPECT_EQ(ArenaUpstream::live, 1);
+   EXPECT_LT(arena.capacity(), capacity);
+   //The retained chunk is reused without upstream allocations
+   auto const first = arena.allocate(8, 8);
+   arena.reset();
+   EXPECT_EQ(arena.allocate(8, 8), first);
+   EXPECT_EQ(ArenaUpstream::live, 1);
+  }
+  EXPECT_EQ(ArenaUpstream::live, 0);
+ }
+
+ TEST(Arena, rewind_releases_allocations_after_mark) {
+  auto arena = countingArena(128);
+  (void)arena.allocate(16, 8);
+  auto const mark = arena.mark();
+  auto const next = arena.allocate(16, 8);
+  for (int i = 0; i < 50; i++) {
+   (void)arena.allocate(64, 8);
+  }
+  EXPECT_GT(arena.chunkCount(), 1);
+  arena.rewind(mark);
+  EXPECT_EQ(arena.chunkCount(), 1);
+  EXPECT_EQ(ArenaUpstream::live, 1);
+  EXPECT_EQ(arena.allocate(16, 8), next);
+ }
+
+ TEST(Arena, scopes_nest) {
+  Arena arena;
+  (void)arena.allocate(8, 8);
+  auto const outer = arena.mark();
+  void * inner;
+  {
+   Arena::Scope const scope{arena};
+   (void)arena.allocate(32, 8);
+   {
+    Arena::Scope const nested{arena};
+    inner = arena.allocate(32, 8);
+   }
+   EXPECT_EQ(arena.allocate(32, 8), inner);
+  }
+  EXPECT_EQ(arena.mark().cursor, outer.cursor);
+  //Rewinding to a mark taken before any allocation resets the arena
+  Arena empty;
+  auto const start = empty.mark();
+  (void)empty.allocate(8, 8);
+  empty.rewind(start);
+  EXPECT_EQ(empty.chunkCount(), 1);
+  EXPECT_EQ(empty.mark().cursor, empty.mark().chunk->begin());
+ }
+
+ TEST(ArenaAllocator, typed_allocations_share_arena) {
+  Arena arena;
+  ArenaAllocator<int> ints{arena};
+  ArenaAllocator<double> doubles{ints};
+  EXPECT_TRUE(ints == doubles);
+  EXPECT_EQ(&doubles.resource(), &arena);
+  auto& i = +ints.allocate(3);
+  auto& d = +doubles.allocate(2);
+  EXPECT_EQ((SizeType)&d % alignof(double), 0);
+  (&i)[2] = 7;
+  (&d)[1] = 1.5;
+  ints.deallocate(i, 3);
+  EXPECT_EQ((&i)[2], 7);
+  Arena other;
+  EXPECT_FALSE(ints == ArenaAllocator<int>{other});
+ }
+
+ TEST(ArenaAllocator, plugs_into_allocator_aware_containers) {
+  Arena arena;
+  {
+   ArenaAllocator<BitsetMetaFunctions::Word> allocator{arena};
+   DynamicBitset<ArenaAllocator> bitset{1000, allocator};
+   bitset.set(999);
+   bitset.resize(5000, true);
+   EXPECT_EQ(bitset.count(), 4001);
+   EXPECT_GE(arena.capacity(), 5000 / 8);
+  }
+  arena.reset();
+  EXPECT_EQ(arena.chunkCount(), 1);
+ }
+
+ TEST(Arena, most_recent_allocation_expands_in_place) {
+  Arena arena;
+  auto const a = arena.allocate(16, 8);
+  EXPECT_TRUE(arena.expand(a, 16, 64));
+  auto const b = arena.allocate(8, 8);
+  EXPECT_EQ(b, (unsigned char *)a + 64);
+  //Only the most recent allocation can grow
+  EXPECT_FALSE(arena.expand(a, 64, 128));
+  EXPECT_TRUE(arena.expand(a, 64, 32));
+  //Shrinking the most recent allocation releases its tail
+  EXPECT_TRUE(arena.expand(b, 8, 0));
+  EXPECT_EQ(arena.allocate(8, 8), b);
+  //Growth is bounded by the current chunk
+  EXPECT_FALSE(arena.expand(b, 8, 1 << 20));
+
+  //Containers grow without copying
+  ArenaAllocator<BitsetMetaFunctions::Word> allocator{arena};
+  DynamicBitset<ArenaAllocator> bitset{1000, allocator};
+  auto const words = bitset.data();
+  bitset.resize(2000);
+  EXPECT_EQ(bitset.data(), words);
+ }
+
+ //Upstream allocator that always fails
+ template<typename T>
+ struct FailingUpstream final {
+  static AllocResult<T> allocate(SizeType) noexcept {
+   return AllocError{AllocErrorType::OUT_OF_MEMORY};
+  }
+
+  static void deallocate(T const&, SizeType) noexcept {}
+ };
+
+ TEST(ArenaAllocator, upstream_failures_yield_errors) {
+  Arena arena{
+   ArenaMetaFunctions::DefaultChunkSize,
+   ArenaMetaFunctions::Upstream::of<FailingUpstream>()
+  };
+  EXPECT_EQ(arena.allocate(8, 8), nullptr);
+  auto const result = ArenaAllocator<int>{arena}.allocate(4);
+  ASSERT_TRUE(result.hasError());
+  EXPECT_EQ(result.error().type, AllocErrorType::OUT_OF_MEMORY);
+  EXPECT_EQ(
+   ArenaAllocator<int>{arena}.allocate(1, 3).error().type,
+   AllocErrorType::INVALID_ALIGNMENT
+  );
+ }
+}
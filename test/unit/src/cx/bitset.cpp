@@ -1,22 +1,809 @@
 #include <cx/test/common/common.h>
 #include <cx/bitset.h>
 
-namespace CX {
- TEST(Bitset, test) {
-  /*
-  constexpr auto const nBits = 2;
-  Bitset<nBits> b;
-  b & (uint32_t)3;
-  printf("b: 0b");
-  for (SizeType i = 0; i < nBits; i++) {
-   printf("%d", b[i] ? 1 : 0);
-  }
-  printf("\n");
-  */
-
-  /*
-  Bitset b{0x3};
-  printf("%s\n", typeid(b).name());
-  */
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace CX::Testing {
+ TEST(Bitset, default_constructed_bitset_has_no_set_bits) {
+  Bitset<200> b;
+  EXPECT_TRUE(b.none());
+  EXPECT_EQ(b.count(), 0);
+  EXPECT_EQ(b.findFirst(), 200);
+  EXPECT_FALSE((bool)b);
+ }
+
+ TEST(Bitset, bitset_uses_word_storage) {
+  EXPECT_EQ(sizeof(Bitset<1>), 8);
+  EXPECT_EQ(sizeof(Bitset<64>), 8);
+  EXPECT_EQ(sizeof(Bitset<65>), 16);
+  EXPECT_EQ((Bitset<1000>::WordCount), 16);
+  EXPECT_TRUE((TriviallyCopyable<Bitset<100>>));
+ }
+
+ TEST(Bitset, get_set_and_flip_affect_single_bits) {
+  Bitset<130> b;
+  EXPECT_FALSE(b.set(0));
+  EXPECT_FALSE(b.set(64));
+  EXPECT_FALSE(b.set(129));
+  EXPECT_TRUE(b.set(129));
+  EXPECT_TRUE(b.get(0));
+  EXPECT_TRUE(b.get(64));
+  EXPECT_TRUE(b.get(129));
+  EXPECT_FALSE(b.get(1));
+  EXPECT_FALSE(b.get(128));
+  EXPECT_EQ(b.count(), 3);
+  EXPECT_TRUE(b.set(64, false));
+  EXPECT_FALSE(b.get(64));
+  EXPECT_FALSE(b.flip(5));
+  EXPECT_TRUE(b.get(5));
+  EXPECT_EQ(b.count(), 3);
+ }
+
+ TEST(Bitset, reset_assigns_all_bits) {
+  Bitset<70> b;
+  b.reset(true);
+  EXPECT_TRUE(b.all());
+  EXPECT_EQ(b.count(), 70);
+  //Unused tail bits are not set
+  EXPECT_EQ(b.data()[1], 0x3Full);
+  b.reset();
+  EXPECT_TRUE(b.none());
+ }
+
+ TEST(Bitset, integral_constructor_assigns_low_bits) {
+  Bitset<100> b{0b1011u};
+  EXPECT_EQ(b.count(), 3);
+  EXPECT_TRUE(b[0]);
+  EXPECT_TRUE(b[1]);
+  EXPECT_FALSE(b[2]);
+  EXPECT_TRUE(b[3]);
+  //Sign bits of narrow types are not extended
+  Bitset<64> n{(signed char)-1};
+  EXPECT_EQ(n.count(), 8);
+  //Excess bits are discarded
+  Bitset<4> t{0xFFu};
+  EXPECT_EQ(t.count(), 4);
+  Bitset d{(unsigned short)3};
+  EXPECT_EQ(d.size(), 16);
+ }
+
+ TEST(Bitset, bit_reference_reads_and_writes_bits) {
+  Bitset<128> b;
+  b[100] = true;
+  EXPECT_TRUE(b.get(100));
+  auto bit = b[100];
+  EXPECT_TRUE((bool)bit);
+  EXPECT_FALSE(~bit);
+  bit.flip();
+  EXPECT_FALSE(b.get(100));
+  b[3] = true;
+  b[4] = b[3];
+  EXPECT_TRUE(b.get(4));
+  Bitset<128> const& c = b;
+  EXPECT_TRUE(c[4]);
+ }
+
+ TEST(Bitset, bitwise_operators_operate_on_all_words) {
+  Bitset<192> a, b;
+  a.set(1);
+  a.set(70);
+  a.set(191);
+  b.set(70);
+  b.set(150);
+  auto const andResult = a & b;
+  EXPECT_EQ(andResult.count(), 1);
+  EXPECT_TRUE(andResult.get(70));
+  auto const orResult = a | b;
+  EXPECT_EQ(orResult.count(), 4);
+  auto const xorResult = a ^ b;
+  EXPECT_EQ(xorResult.count(), 3);
+  EXPECT_FALSE(xorResult.get(70));
+  auto const notResult = ~a;
+  EXPECT_EQ(notResult.count(), 189);
+  EXPECT_FALSE(notResult.get(191));
+ }
+
+ TEST(Bitset, not_operator_does_not_set_tail_bits) {
+  Bitset<3> b;
+  auto const inverted = ~b;
+  EXPECT_EQ(inverted.count(), 3);
+  EXPECT_EQ(inverted.data()[0], 0b111ull);
+  EXPECT_TRUE(inverted.all());
+ }
+
+ TEST(Bitset, shift_operators_carry_across_words) {
+  Bitset<200> b;
+  b.set(0);
+  b.set(63);
+  auto const left = b << 65;
+  EXPECT_EQ(left.count(), 2);
+  EXPECT_TRUE(left.get(65));
+  EXPECT_TRUE(left.get(128));
+  auto const right = left >> 64;
+  EXPECT_TRUE(right.get(1));
+  EXPECT_TRUE(right.get(64));
+  EXPECT_EQ(right.count(), 2);
+  EXPECT_EQ((b >> 1).count(), 1);
+  EXPECT_TRUE((b << 200).none());
+  //Bits shifted beyond `N` are discarded
+  Bitset<70> c;
+  c.set(69);
+  EXPECT_TRUE((c << 1).none());
+  c <<= 0;
+  EXPECT_TRUE(c.get(69));
+ }
+
+ TEST(Bitset, find_first_and_next_yield_set_bits_in_order) {
+  Bitset<300> b;
+  b.set(5);
+  b.set(64);
+  b.set(299);
+  EXPECT_EQ(b.findFirst(), 5);
+  EXPECT_EQ(b.findNext(5), 5);
+  EXPECT_EQ(b.findNext(6), 64);
+  EXPECT_EQ(b.findNext(65), 299);
+  EXPECT_EQ(b.findNext(300), 300);
+  int visited = 0;
+  for (auto i = b.findFirst(); i < 300; i = b.findNext(i + 1)) {
+   visited++;
+  }
+  EXPECT_EQ(visited, 3);
+ }
+
+ TEST(Bitset, differently_sized_bitsets_interoperate) {
+  Bitset<64> small{0xF0F0u};
+  Bitset<256> large;
+  large.set(4);
+  large.set(200);
+  auto const andResult = large & small;
+  EXPECT_EQ(andResult.count(), 1);
+  EXPECT_TRUE(andResult.get(4));
+  auto const orResult = large | small;
+  EXPECT_EQ(orResult.count(), 9);
+  Bitset<8> narrow = large;
+  EXPECT_EQ(narrow.count(), 1);
+  Bitset<256> widened = small;
+  EXPECT_TRUE(widened == small);
+  EXPECT_FALSE(large == small);
+  large.set(200, false);
+  large |= small;
+  EXPECT_EQ(large.count(), 8);
+ }
+
+ TEST(Bitset, bitset_operations_are_constexpr) {
+  constexpr auto const b = []() constexpr {
+   Bitset<130> b;
+   b.set(1);
+   b.set(129);
+   return (b << 1) | Bitset<130>{1u};
+  }();
+  static_assert(b.count() == 2);
+  static_assert(b.findFirst() == 0);
+  static_assert(b.findNext(1) == 2);
+  EXPECT_TRUE(b.get(0));
+ }
+
+ TEST(Bitset, is_bitset_identifies_bitsets) {
+  EXPECT_TRUE((IsBitset<Bitset<1>>));
+  EXPECT_TRUE((IsBitset<Bitset<100> const&>));
+  EXPECT_FALSE((IsBitset<int>));
+ }
+ TEST(Bitset, and_not_and_intersect_count_operate_on_all_words) {
+  Bitset<5000> a, b;
+  for (int i = 0; i < 5000; i += 3) {
+   a.set(i);
+  }
+  for (int i = 0; i < 5000; i += 5) {
+   b.set(i);
+  }
+  //Multiples of 15 in [0, 5000)
+  EXPECT_EQ(a.intersectCount(b), 334);
+  EXPECT_EQ((a & b).count(), 334);
+  a.andNot(b);
+  EXPECT_EQ(a.count(), 1667 - 334);
+  EXPECT_EQ(a.intersectCount(b), 0);
+  EXPECT_TRUE(a.any());
+ }
+
+ TEST(BitsetKernels, scalar_kernels_are_always_available) {
+  auto const scalar = BitsetMetaFunctions::kernelsFor(
+   BitsetMetaFunctions::KernelSet::SCALAR
+  );
+  ASSERT_NE(scalar, nullptr);
+  EXPECT_EQ(scalar->set, BitsetMetaFunctions::KernelSet::SCALAR);
+  EXPECT_NE(&BitsetMetaFunctions::kernels(), nullptr);
+ }
+
+ TEST(BitsetKernels, all_supported_kernels_match_scalar_kernels) {
+  using namespace BitsetMetaFunctions;
+  constexpr SizeType const maxWords = 67;
+  //Deterministic pseudo-random words
+  Word seed = 0x9E3779B97F4A7C15ull;
+  auto const next = [&]() {
+   seed ^= seed << 13;
+   seed ^= seed >> 7;
+   seed ^= seed << 17;
+   return seed;
+  };
+  Word a[maxWords], b[maxWords], expected[maxWords], actual[maxWords];
+  for (SizeType i = 0; i < maxWords; i++) {
+   a[i] = next();
+   b[i] = next() & next();
+  }
+  for (auto const set : {
+   KernelSet::SCALAR,
+   KernelSet::SSE,
+   KernelSet::AVX2,
+   KernelSet::AVX512,
+   KernelSet::NEON
+  }) {
+   auto const table = kernelsFor(set);
+   if (!table) {
+    continue;
+   }
+   //Exercise every tail length of every vector width
+   for (SizeType count = 0; count <= maxWords; count += (count < 20 ? 1 : 23)) {
+    using Op = void (*)(Word *, Word const *, SizeType) noexcept;
+    Op const reference[] {
+     Kernels::bitwiseAnd,
+     Kernels::bitwiseOr,
+     Kernels::bitwiseXor,
+     Kernels::bitwiseAndNot
+    };
+    Op const vectorized[] {
+     table->bitwiseAnd,
+     table->bitwiseOr,
+     table->bitwiseXor,
+     table->bitwiseAndNot
+    };
+    for (SizeType op = 0; op < 4; op++) {
+     Kernels::copy(expected, a, maxWords);
+     Kernels::copy(actual, a, maxWords);
+     reference[op](expected, b, count);
+     vectorized[op](actual, b, count);
+     EXPECT_TRUE(Kernels::equal(expected, actual, maxWords))
+      << "kernel set " << (int)set << ", op " << op << ", count " << count;
+    }
+    EXPECT_EQ(table->popcount(a, count), Kernels::popcount(a, count));
+    EXPECT_EQ(
+     table->intersectCount(a, b, count),
+     Kernels::intersectCount(a, b, count)
+    );
+    EXPECT_EQ(table->any(a, count), count > 0);
+    Kernels::fill(actual, 0, maxWords);
+    EXPECT_FALSE(table->any(actual, count));
+    if (count > 0) {
+     actual[count - 1] = 1ull << 63;
+     EXPECT_TRUE(table->any(actual, count));
+    }
+   }
+  }
+ }
+}
+
+namespace CX::Testing {
+ //Stateless allocator that counts live allocations
+ template<typename T>
+ struct CountingAllocator final {
+  static inline int allocations = 0;
+
+  static AllocResult<T> allocate(SizeType const n) noexcept {
+   allocations++;
+   return Allocator<T>::allocate(n);
+  }
+
+  static void deallocate(T const& t, SizeType const n) noexcept {
+   allocations--;
+   Allocator<T>::deallocate(t, n);
+  }
+ };
+
+ //Stateful allocator that counts allocated words through a shared counter
+ template<typename T>
+ struct TrackingAllocator final {
+  SizeType * live = nullptr;
+
+  AllocResult<T> allocate(SizeType const n) noexcept {
+   *live += n;
+   return Allocator<T>::allocate(n);
+  }
+
+  void deallocate(T const& t, SizeType const n) noexcept {
+   *live -= n;
+   Allocator<T>::deallocate(t, n);
+  }
+ };
+
+ TEST(DynamicBitset, small_bitsets_are_stored_inline) {
+  using Counted = DynamicBitset<CountingAllocator>;
+  EXPECT_EQ(sizeof(Counted), 24);
+  EXPECT_TRUE((IsStatelessAllocator<CountingAllocator>));
+  {
+   Counted b{128};
+   EXPECT_EQ(CountingAllocator<BitsetMetaFunctions::Word>::allocations, 0);
+   b.set(127);
+   Counted c{129};
+   EXPECT_EQ(CountingAllocator<BitsetMetaFunctions::Word>::allocations, 1);
+   c.set(128);
+   c.resize(64);
+   EXPECT_EQ(CountingAllocator<BitsetMetaFunctions::Word>::allocations, 0);
+   EXPECT_TRUE(c.none());
+   b.resize(1000);
+   EXPECT_EQ(CountingAllocator<BitsetMetaFunctions::Word>::allocations, 1);
+   EXPECT_TRUE(b.get(127));
+   EXPECT_EQ(b.count(), 1);
+  }
+  EXPECT_EQ(CountingAllocator<BitsetMetaFunctions::Word>::allocations, 0);
+ }
+
+ TEST(DynamicBitset, stateful_allocators_are_used_for_allocated_storage) {
+  SizeType live = 0;
+  TrackingAllocator<BitsetMetaFunctions::Word> allocator{&live};
+  EXPECT_TRUE((IsStatefulAllocator<TrackingAllocator>));
+  {
+   DynamicBitset<TrackingAllocator> b{1000, allocator};
+   EXPECT_EQ(live, 16);
+   auto c = b;
+   EXPECT_EQ(live, 32);
+   auto d = (decltype(c)&&)c;
+   EXPECT_EQ(live, 32);
+   EXPECT_EQ(c.size(), 0);
+   EXPECT_EQ(d.size(), 1000);
+  }
+  EXPECT_EQ(live, 0);
+ }
+
+ TEST(DynamicBitset, allocated_storage_is_resized_in_place_when_possible) {
+  //Without in-place resizing, words are moved to a new allocation
+  SizeType live = 0;
+  TrackingAllocator<BitsetMetaFunctions::Word> allocator{&live};
+  DynamicBitset<TrackingAllocator> b{1000, allocator};
+  b.set(999);
+  b.resize(2000, true);
+  EXPECT_EQ(live, 32);
+  EXPECT_TRUE(b.get(999));
+  EXPECT_FALSE(b.get(998));
+  EXPECT_EQ(b.count(), 1 + 1000);
+  #ifdef CX_LIBC_SUPPORT
+   //Shrinking libc allocations never moves them
+   DynamicBitset<LibcAllocator> c{4096};
+   c.set(100);
+   auto const words = c.data();
+   c.resize(1024);
+   EXPECT_EQ(c.data(), words);
+   c.resize(8192);
+   EXPECT_TRUE(c.get(100));
+   EXPECT_EQ(c.count(), 1);
+  #endif
+ }
+
+ TEST(DynamicBitset, resize_preserves_bits_and_assigns_added_bits) {
+  DynamicBitset<> b{70};
+  b.set(3);
+  b.set(69);
+  b.resize(300, true);
+  EXPECT_EQ(b.size(), 300);
+  EXPECT_TRUE(b.get(3));
+  EXPECT_FALSE(b.get(4));
+  EXPECT_TRUE(b.get(69));
+  EXPECT_EQ(b.count(), 2 + 230);
+  b.resize(5);
+  EXPECT_EQ(b.count(), 1);
+  EXPECT_EQ(b.data()[0], 0b1000ull);
+  //Bits removed by shrinking do not reappear when growing
+  b.resize(128);
+  EXPECT_EQ(b.count(), 1);
+  DynamicBitset<> e;
+  EXPECT_EQ(e.size(), 0);
+  EXPECT_TRUE(e.none());
+  EXPECT_TRUE(e.all());
+  EXPECT_EQ(e.findFirst(), 0);
+ }
+
+ TEST(DynamicBitset, operations_match_fixed_size_bitset) {
+  Bitset<1000> fixed;
+  DynamicBitset<> dynamic{1000};
+  for (SizeType i = 0; i < 1000; i += 7) {
+   fixed.set(i);
+   dynamic.set(i);
+  }
+  EXPECT_EQ(dynamic.count(), fixed.count());
+  EXPECT_TRUE(dynamic == fixed);
+  EXPECT_TRUE(fixed == dynamic);
+  EXPECT_TRUE((~dynamic) == (~fixed));
+  EXPECT_TRUE((dynamic << 65) == (fixed << 65));
+  EXPECT_TRUE((dynamic >> 130) == (fixed >> 130));
+  EXPECT_EQ(dynamic.findNext(8), fixed.findNext(8));
+  EXPECT_EQ(dynamic.findNext(995), 1000);
+  dynamic.reset(true);
+  EXPECT_TRUE(dynamic.all());
+  EXPECT_EQ(dynamic.data()[15], 0xFFFFFFFFFFull);
+  dynamic[5] = false;
+  EXPECT_FALSE(dynamic[5]);
+ }
+
+ TEST(DynamicBitset, dynamic_and_fixed_size_bitsets_interoperate) {
+  Bitset<64> small{0xF0F0u};
+  DynamicBitset<> large{256};
+  large.set(4);
+  large.set(200);
+  auto const andResult = large & small;
+  EXPECT_EQ(andResult.size(), 256);
+  EXPECT_EQ(andResult.count(), 1);
+  auto const orResult = large | small;
+  EXPECT_EQ(orResult.count(), 9);
+  auto const fixedAnd = small & large;
+  EXPECT_EQ(fixedAnd.count(), 1);
+  Bitset<256> fixedOr = small;
+  fixedOr |= large;
+  EXPECT_EQ(fixedOr.count(), 9);
+  EXPECT_EQ(large.intersectCount(small), 1);
+  //Assignment adopts the size of a fixed-size source
+  large = small;
+  EXPECT_EQ(large.size(), 64);
+  EXPECT_TRUE(large == small);
+  //Fixed-size bitsets keep their size
+  Bitset<8> narrow = orResult;
+  EXPECT_EQ(narrow.count(), 4);
+  DynamicBitset<> fromFixed = Bitset<300>{1u};
+  EXPECT_EQ(fromFixed.size(), 300);
+  EXPECT_EQ(fromFixed.count(), 1);
+  EXPECT_TRUE((IsDynamicBitset<DynamicBitset<> const&>));
+  EXPECT_FALSE((IsBitset<DynamicBitset<>>));
+  EXPECT_TRUE((IsAnyBitset<Bitset<3>>));
+ }
+
+ TEST(DynamicBitset, copy_and_move_transfer_bits) {
+  DynamicBitset<> a{500};
+  a.set(499);
+  DynamicBitset<> b{10};
+  b = a;
+  EXPECT_EQ(b.size(), 500);
+  EXPECT_TRUE(b.get(499));
+  EXPECT_NE(b.data(), a.data());
+  auto const heap = a.data();
+  DynamicBitset<> c{(DynamicBitset<>&&)a};
+  EXPECT_EQ(c.data(), heap);
+  EXPECT_EQ(a.size(), 0);
+  b = (DynamicBitset<>&&)c;
+  EXPECT_EQ(b.data(), heap);
+  EXPECT_EQ(c.size(), 0);
+  DynamicBitset<> d{100};
+  d.set(1);
+  c = d;
+  EXPECT_TRUE(c == d);
+ }
+
+ TEST(DynamicBitset, inline_bitset_operations_are_constexpr) {
+  constexpr auto const count = []() constexpr {
+   DynamicBitset<> b{100};
+   b.set(1);
+   b.set(99);
+   b <<= 1;
+   return (b | Bitset<4>{1u}).count();
+  }();
+  static_assert(count == 2);
+  EXPECT_EQ(count, 2);
+ }
+}
+
+namespace CX::Testing {
+ //Populates `bitset` with deterministic pseudo-random bits of density
+ //1 / `sparsity`
+ template<typename B>
+ void fillSparse(B& bitset, unsigned const sparsity) {
+  BitsetMetaFunctions::Word seed = 0x9E3779B97F4A7C15ull;
+  for (SizeType i = 0; i < bitset.size(); i++) {
+   seed ^= seed << 13;
+   seed ^= seed >> 7;
+   seed ^= seed << 17;
+   bitset.set(i, seed % sparsity == 0);
+  }
+ }
+
+ TEST(BitsetSetBits, set_bit_range_yields_set_bits_in_order) {
+  Bitset<300> b;
+  b.set(0);
+  b.set(63);
+  b.set(64);
+  b.set(299);
+  SizeType const expected[] {0, 63, 64, 299};
+  SizeType visited = 0;
+  for (auto const index : b.setBits()) {
+   ASSERT_LT(visited, 4);
+   EXPECT_EQ(index, expected[visited++]);
+  }
+  EXPECT_EQ(visited, 4);
+  Bitset<300> empty;
+  EXPECT_TRUE(empty.setBits().begin() == empty.setBits().end());
+ }
+
+ TEST(BitsetSetBits, set_bit_range_matches_find_next) {
+  DynamicBitset<> b{5000};
+  fillSparse(b, 13);
+  auto next = b.findFirst();
+  for (auto const index : b.setBits()) {
+   EXPECT_EQ(index, next);
+   next = b.findNext(index + 1);
+  }
+  EXPECT_EQ(next, 5000);
+ }
+
+ TEST(BitsetSetBits, set_bit_range_is_constexpr) {
+  constexpr auto const sum = []() constexpr {
+   Bitset<200> b;
+   b.set(3);
+   b.set(150);
+   SizeType total = 0;
+   for (auto const index : b.setBits()) {
+    total += index;
+   }
+   return total;
+  }();
+  static_assert(sum == 153);
+  EXPECT_EQ(sum, 153);
+ }
+
+ TEST(BitsetRankSelect, rank_and_select_are_inverse) {
+  Bitset<5000> b;
+  fillSparse(b, 5);
+  SizeType k = 0;
+  for (auto const index : b.setBits()) {
+   EXPECT_EQ(b.rank(index), k);
+   EXPECT_EQ((SizeType)b.select(k), index);
+   k++;
+  }
+  EXPECT_EQ(b.rank(5000), b.count());
+  EXPECT_EQ(b.select(k), 5000);
+  EXPECT_EQ(b.rank(0), 0);
+ }
+
+ TEST(BitsetRankSelect, rank_index_matches_direct_queries) {
+  //Sizes with partial and block-aligned final blocks
+  for (SizeType const size : {1000, 1024, 4096, 5000}) {
+   DynamicBitset<> b{size};
+   fillSparse(b, 3);
+   BitsetRankIndex<> const index{b};
+   EXPECT_EQ(
+    index.blockCount(),
+    (size + BitsetRankIndex<>::BlockBits - 1) / BitsetRankIndex<>::BlockBits
+   );
+   for (SizeType i = 0; i <= size; i += 7) {
+    EXPECT_EQ(b.rank(i, index), b.rank(i)) << "size " << size << ", bit " << i;
+   }
+   EXPECT_EQ(b.rank(size, index), b.count());
+   for (SizeType k = 0; k <= b.count(); k++) {
+    EXPECT_EQ(b.select(k, index), b.select(k)) << "size " << size << ", k " << k;
+   }
+  }
+ }
+
+ TEST(BitsetRankSelect, rank_index_supports_fixed_size_and_empty_bitsets) {
+  Bitset<700> fixed;
+  fixed.set(10);
+  fixed.set(600);
+  BitsetRankIndex<> index{fixed};
+  EXPECT_EQ(fixed.rank(601, index), 2);
+  EXPECT_EQ(fixed.select(1, index), 600);
+  EXPECT_EQ(fixed.select(2, index), 700);
+  //Rebuilding reflects modifications
+  fixed.set(0);
+  index.build(fixed);
+  EXPECT_EQ(fixed.select(0, index), 0);
+  DynamicBitset<> empty;
+  BitsetRankIndex<> emptyIndex{empty};
+  EXPECT_EQ(emptyIndex.blockCount(), 0);
+  EXPECT_EQ(empty.rank(0, emptyIndex), 0);
+  EXPECT_EQ(empty.select(0, emptyIndex), 0);
+  BitsetRankIndex<> moved{(BitsetRankIndex<>&&)index};
+  EXPECT_EQ(index.blockCount(), 0);
+  EXPECT_EQ(fixed.select(2, moved), 600);
+ }
+
+ TEST(BitsetRankSelect, select_in_word_finds_kth_set_bit) {
+  using BitsetMetaFunctions::Kernels::selectInWord;
+  EXPECT_EQ(selectInWord(0b1011'0000ull, 0), 4);
+  EXPECT_EQ(selectInWord(0b1011'0000ull, 2), 7);
+  EXPECT_EQ(selectInWord(~0ull, 63), 63);
+  static_assert(selectInWord(1ull << 40 | 1, 1) == 40);
+ }
+}
+
+namespace CX::Testing {
+ TEST(AtomicBitset, word_groups_are_cache_line_aligned) {
+  EXPECT_EQ(alignof(AtomicBitset<1>), 64);
+  EXPECT_EQ(sizeof(AtomicBitset<512>), 64);
+  EXPECT_EQ(sizeof(AtomicBitset<513>), 128);
+  //Single-word groups place every word on its own cache line
+  EXPECT_EQ((sizeof(AtomicBitset<128, 1>)), 128);
+  EXPECT_EQ((AtomicBitset<1000, 2>::GroupCount), 8);
+ }
+
+ TEST(AtomicBitset, single_bit_operations_return_previous_values) {
+  AtomicBitset<130, 1> b;
+  EXPECT_FALSE(b.testAndSet(0));
+  EXPECT_TRUE(b.testAndSet(0));
+  EXPECT_FALSE(b.set(129));
+  EXPECT_TRUE(b.get(129));
+  EXPECT_TRUE(b.testAndClear(129));
+  EXPECT_FALSE(b.testAndClear(129));
+  EXPECT_FALSE(b.flip(64));
+  EXPECT_TRUE(b[64]);
+  EXPECT_EQ(b.count(), 2);
+  EXPECT_EQ(b.findFirst(), 0);
+  EXPECT_EQ(b.findNext(1), 64);
+  EXPECT_EQ(b.findNext(65), 130);
+  b.reset(true);
+  EXPECT_TRUE(b.all());
+  b.reset();
+  EXPECT_TRUE(b.none());
+ }
+
+ TEST(AtomicBitset, snapshots_round_trip_through_bitset) {
+  Bitset<200> bits;
+  bits.set(3);
+  bits.set(199);
+  AtomicBitset<200> b{bits};
+  EXPECT_TRUE(b.load() == bits);
+  b.set(100);
+  EXPECT_EQ(b.load().count(), 3);
+  b.store(Bitset<200>{});
+  EXPECT_FALSE((bool)b);
+ }
+
+ TEST(AtomicBitset, find_first_clear_and_set_claims_bits_in_order) {
+  AtomicBitset<70> b;
+  b.set(0);
+  EXPECT_EQ(b.findFirstClearAndSet(), 1);
+  //Search starts at the word containing the hint and wraps around
+  EXPECT_EQ(b.findFirstClearAndSet(65), 64);
+  b.reset(true);
+  b.set(5, false);
+  EXPECT_EQ(b.findFirstClearAndSet(69), 5);
+  //Unused tail bits are never claimed
+  EXPECT_EQ(b.findFirstClearAndSet(), 70);
+  EXPECT_TRUE(b.all());
+ }
+
+ TEST(AtomicBitset, concurrent_claims_yield_unique_bits) {
+  constexpr SizeType const Threads = 8;
+  constexpr SizeType const Slots = 4096;
+  static AtomicBitset<Slots> slots;
+  //Slots that have been released once, to be reclaimed by any thread
+  static AtomicBitset<Slots> released;
+  //Slots held by each thread; every slot must be held exactly once
+  std::vector<std::vector<SizeType>> claimed(Threads);
+  std::vector<std::thread> threads;
+  for (SizeType t = 0; t < Threads; t++) {
+   threads.emplace_back([&claimed, t] {
+    while (true) {
+     auto const slot = slots.findFirstClearAndSet(t * (Slots / Threads));
+     if (slot == Slots) {
+      break;
+     }
+     //Release every third slot once, to exercise contended words
+     if (slot % 3 == 0 && !released.testAndSet(slot)) {
+      if (!slots.testAndClear(slot)) {
+       ADD_FAILURE() << "slot " << slot << " was released by another thread";
+      }
+      continue;
+     }
+     claimed[t].push_back(slot);
+    }
+   });
+  }
+  for (auto& thread : threads) {
+   thread.join();
+  }
+  Bitset<Slots> seen;
+  SizeType total = 0;
+  for (auto const& slots : claimed) {
+   for (auto const slot : slots) {
+    EXPECT_FALSE(seen.set(slot)) << "slot " << slot << " claimed twice";
+    total++;
+   }
+  }
+  EXPECT_EQ(total, Slots);
+  EXPECT_TRUE(slots.all());
+ }
+}
+
+namespace CX::Testing {
+ TEST(BitsetRanges, set_range_fills_partial_and_whole_words) {
+  Bitset<300> b;
+  b.setRange(3, 5);
+  EXPECT_EQ(b.count(), 2);
+  b.setRange(60, 200);
+  EXPECT_EQ(b.count(), 142);
+  EXPECT_TRUE(b.get(60));
+  EXPECT_TRUE(b.get(199));
+  EXPECT_FALSE(b.get(200));
+  b.setRange(64, 128, false);
+  EXPECT_EQ(b.count(), 78);
+  //Ranges are clamped to the bitset
+  b.setRange(290, 1000);
+  EXPECT_EQ(b.count(), 88);
+  b.setRange(10, 10);
+  EXPECT_EQ(b.count(), 88);
+ }
+
+ TEST(BitsetRanges, run_count_and_find_next_clear_follow_runs) {
+  Bitset<256> b;
+  EXPECT_EQ(b.runCount(), 0);
+  b.setRange(0, 3);
+  b.setRange(62, 70);
+  b.setRange(128, 256);
+  EXPECT_EQ(b.runCount(), 3);
+  EXPECT_EQ(b.findNextClear(0), 3);
+  EXPECT_EQ(b.findNextClear(62), 70);
+  EXPECT_EQ(b.findNextClear(128), 256);
+  b.reset(true);
+  EXPECT_EQ(b.runCount(), 1);
+  EXPECT_EQ(b.findNextClear(0), 256);
+ }
+
+ struct SlotOwner;
+ using TestSlot = ThreadSlot<SlotOwner, 4>;
+
+ TEST(ThreadSlot, slot_is_stable_within_a_thread) {
+  auto const slot = TestSlot::get();
+  EXPECT_LT(slot, 4u);
+  EXPECT_EQ(TestSlot::get(), slot);
+ }
+
+ TEST(ThreadSlot, concurrent_threads_get_distinct_slots_until_exhausted) {
+  constexpr SizeType const Threads = 6;
+  std::vector<SizeType> claimed(Threads);
+  std::vector<std::thread> threads;
+  std::atomic<SizeType> ready = 0;
+  std::atomic<bool> release = false;
+  for (SizeType i = 0; i < Threads; i++) {
+   threads.emplace_back([&, i] {
+    claimed[i] = TestSlot::get();
+    ready++;
+    while (!release) {
+     std::this_thread::yield();
+    }
+   });
+  }
+  while (ready != Threads) {
+   std::this_thread::yield();
+  }
+  release = true;
+  for (auto& thread : threads) {
+   thread.join();
+  }
+  //The main thread holds one slot from the previous test, or claims it now
+  auto const mainSlot = TestSlot::get();
+  std::set<SizeType> distinct;
+  SizeType exhausted = 0;
+  for (auto const slot : claimed) {
+   if (slot == 4) {
+    exhausted++;
+   } else {
+    EXPECT_NE(slot, mainSlot);
+    distinct.insert(slot);
+   }
+  }
+  EXPECT_EQ(distinct.size(), 3u);
+  EXPECT_EQ(exhausted, 3u);
+ }
+
+ TEST(ThreadSlot, slots_are_released_on_thread_exit) {
+  auto const mainSlot = TestSlot::get();
+  std::set<SizeType> seen;
+  for (int i = 0; i < 16; i++) {
+   std::thread{[&] {
+    auto const slot = TestSlot::get();
+    EXPECT_LT(slot, 4u);
+    EXPECT_NE(slot, mainSlot);
+    seen.insert(slot);
+   }}.join();
+  }
+  //Sequential threads reuse released slots
+  EXPECT_EQ(seen.size(), 1u);
  }
 }
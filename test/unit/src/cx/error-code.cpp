@@ -0,0 +1,76 @@
+#include <cx/test/common/common.h>
+
+#include <cx/error-code.h>
+#include <cx/result.h>
+
+namespace CX {
+ //Mock table-backed error category
+ struct ParseCategory final {
+  using CodeType = unsigned char;
+
+  static constexpr char const Name[] = "parse";
+
+  static constexpr char const * describe(CodeType const code) noexcept {
+   constexpr char const * const Descriptions[] {
+    "Unexpected end of input",
+    "Unexpected character"
+   };
+   if (code < sizeof(Descriptions) / sizeof(Descriptions[0])) {
+    return Descriptions[code];
+   }
+   return "Unknown parse error";
+  }
+ };
+
+ TEST(IsErrorCategory, properly_formed_category_satisfies_constraint) {
+  EXPECT_TRUE((IsErrorCategory<ParseCategory>));
+  EXPECT_FALSE((IsErrorCategory<Error>));
+ }
+
+ TEST(ErrorCode, error_code_is_only_as_large_as_its_code) {
+  using ParseError = ErrorCode<ParseCategory>;
+  EXPECT_TRUE((IsError<ParseError>));
+  EXPECT_TRUE((TriviallyCopyable<ParseError>));
+  EXPECT_EQ(sizeof(ParseError), sizeof(unsigned char));
+ }
+
+ TEST(ErrorCode, description_is_looked_up_in_category) {
+  constexpr ErrorCode<ParseCategory> error{1};
+  static_assert(error.code() == 1);
+  EXPECT_STREQ(error.describe(), "Unexpected character");
+  EXPECT_STREQ(ErrorCode<ParseCategory>{9}.describe(), "Unknown parse error");
+  EXPECT_STREQ(error.category(), "parse");
+ }
+
+ TEST(ErrorCode, results_of_error_codes_are_register_sized) {
+  using R = Result<int, ErrorCode<ParseCategory>>;
+  EXPECT_TRUE((TriviallyCopyable<R>));
+  EXPECT_LE(sizeof(R), sizeof(void *));
+
+  R const r{ErrorCode<ParseCategory>{0}};
+  auto const copy = r;
+  ASSERT_TRUE(copy.hasError());
+  EXPECT_EQ(copy.error().code(), 0);
+ }
+
+ #ifdef CX_ERROR_MSG
+  TEST(ErrorCode, conversion_to_error_references_description) {
+   ErrorCode<ParseCategory> const code{0};
+   Error const error{code};
+   EXPECT_EQ(error.describe(), code.describe());
+  }
+ #endif //CX_ERROR_MSG
+
+ #ifdef CX_LIBC_SUPPORT
+  TEST(ErrnoError, errno_values_are_described) {
+   EXPECT_STREQ(ErrnoError{EAGAIN}.describe(), "Resource temporarily unavailable");
+   EXPECT_STREQ(ErrnoError{ENOENT}.describe(), "No such file or directory");
+   EXPECT_STREQ(ErrnoError{-1}.describe(), "Unknown errno value");
+  }
+
+  TEST(ErrnoError, last_errno_captures_errno) {
+   errno = EINTR;
+   EXPECT_EQ(lastErrno(), ErrnoError{EINTR});
+  }
+ #endif //CX_LIBC_SUPPORT
+}
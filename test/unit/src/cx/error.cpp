@@ -2,6 +2,8 @@
 
 #include <cx/error.h>
 
+#include <thread>
+
 //TODO constexpr tests
 namespace CX {
  TEST(IsError, custom_error_type_with_describe_member_satisfies_constraint) {
@@ -55,7 +57,12 @@ namespace CX {
    Error toMove{expectedMessage};
    EXPECT_STREQ(toMove.describe(), expectedMessage);
    Error moved{(Error&&)toMove};
-   EXPECT_EQ(toMove.describe(), nullptr);
+   #ifdef CX_ERROR_MSG_STATIC
+    //Referenced messages are not released by moves
+    EXPECT_EQ(toMove.describe(), moved.describe());
+   #else
+    EXPECT_EQ(toMove.describe(), nullptr);
+   #endif //CX_ERROR_MSG_STATIC
    EXPECT_STREQ(moved.describe(), expectedMessage);
   }
 
@@ -76,7 +83,12 @@ namespace CX {
    EXPECT_STREQ(toMove.describe(), expectedMessage);
    Error moved{};
    moved = (Error&&)toMove;
-   EXPECT_EQ(toMove.describe(), nullptr);
+   #ifdef CX_ERROR_MSG_STATIC
+    //Referenced messages are not released by moves
+    EXPECT_EQ(toMove.describe(), moved.describe());
+   #else
+    EXPECT_EQ(toMove.describe(), nullptr);
+   #endif //CX_ERROR_MSG_STATIC
    EXPECT_STREQ(moved.describe(), expectedMessage);
   }
 
@@ -90,8 +102,75 @@ namespace CX {
    EXPECT_TRUE((IsError<ErrorLike>));
    ErrorLike toCopy;
    Error copied{(ErrorLike const&)toCopy};
-   EXPECT_STREQ(copied.describe(), expectedMessage);
+   #ifdef CX_ERROR_MSG_STATIC
+    //Descriptions that may not be static are not referenced
+    EXPECT_STREQ(copied.describe(), "(non-static error description)");
+   #else
+    EXPECT_STREQ(copied.describe(), expectedMessage);
+   #endif //CX_ERROR_MSG_STATIC
+  }
+
+  //Error-like object referring to a description with static storage
+  //duration
+  struct DeclaredError final {
+   char const * message;
+
+   static constexpr bool const StaticDescription = true;
+
+   constexpr char const * describe() const noexcept {
+    return message;
+   }
+  };
+
+  TEST(Error, declared_static_descriptions_are_referenced) {
+   static constexpr char expectedMessage[] = "declared static";
+   EXPECT_TRUE((ErrorMetaFunctions::StaticDescription<DeclaredError>));
+   Error error{DeclaredError{expectedMessage}};
+   EXPECT_EQ(error.describe(), expectedMessage);
+  }
+
+  //Descriptions formatted into the error-like object itself
+  struct FormattedError {
+   char buffer[16];
+
+   constexpr char const * describe() const noexcept {
+    return buffer;
+   }
+  };
+
+  TEST(Error, non_static_descriptions_are_not_referenced) {
+   Error error;
+   {
+    FormattedError formatted{"formatted"};
+    error = formatted;
+    formatted.buffer[0] = 'X';
+    EXPECT_NE(error.describe(), formatted.buffer);
+   }
+   #ifdef CX_ERROR_MSG_STATIC
+    EXPECT_STREQ(error.describe(), "(non-static error description)");
+   #else
+    EXPECT_STREQ(error.describe(), "formatted");
+   #endif //CX_ERROR_MSG_STATIC
+  }
+
+  TEST(Error, string_literal_descriptions_are_referenced) {
+   struct LiteralError {
+    static constexpr auto& describe() noexcept {
+     return "referenced, not copied";
+    }
+   };
+   Error error{LiteralError{}};
+   EXPECT_EQ(error.describe(), LiteralError::describe());
+   Error copied{(Error const&)error};
+   EXPECT_EQ(copied.describe(), LiteralError::describe());
   }
+
+  #if defined(CX_ERROR_MSG_STATIC) && !defined(CX_ERROR_TRACE)
+   TEST(Error, error_with_referenced_message_is_pointer_sized) {
+    EXPECT_TRUE((TriviallyCopyable<Error>));
+    EXPECT_EQ(sizeof(Error), sizeof(char const *));
+   }
+  #endif //defined(CX_ERROR_MSG_STATIC) && !defined(CX_ERROR_TRACE)
  #else
   //Tests when `CX_ERROR_MSG` is disabled
   TEST(Error, error_message_constructor_has_no_effect_on_message) {
@@ -187,8 +266,9 @@ namespace CX {
     Error toMove{"", (Error const&)cause};
     EXPECT_TRUE(toMove.cause());
     Error e{(Error&&)toMove};
-    EXPECT_FALSE(toMove.cause());
     EXPECT_TRUE(e.cause());
+    //Trace frames are shared, not owned
+    EXPECT_EQ(toMove.cause(), e.cause());
    }
 
    //Move error without populated cause
@@ -244,8 +324,9 @@ namespace CX {
     EXPECT_TRUE(toMove.cause());
     Error e;
     e = (Error&&)toMove;
-    EXPECT_FALSE(toMove.cause());
     EXPECT_TRUE(e.cause());
+    //Trace frames are shared, not owned
+    EXPECT_EQ(toMove.cause(), e.cause());
    }
 
    //Move error without populated cause
@@ -271,6 +352,71 @@ namespace CX {
    e = (ErrorLike const&)toCopy;
    EXPECT_FALSE(e.cause());
   }
+
+  TEST(Error, cause_frame_records_location_and_code) {
+   struct CodedError final {
+    constexpr char const * describe() const noexcept {
+     return "coded";
+    }
+
+    constexpr int code() const noexcept {
+     return 11;
+    }
+   };
+   auto const line = __LINE__ + 1;
+   Error e{"wrapped", CodedError{}};
+   auto const frame = e.causeFrame();
+   ASSERT_TRUE(frame);
+   EXPECT_EQ(frame->location.line, (unsigned)line);
+   EXPECT_STREQ(frame->location.file, __FILE__);
+   EXPECT_TRUE(frame->hasCode);
+   EXPECT_EQ(frame->code, 11);
+   EXPECT_EQ(&frame->error, e.cause());
+  }
+
+  TEST(Error, causes_form_a_chain) {
+   Error root;
+   Error middle{"middle", (Error const&)root};
+   Error top{"top", (Error const&)middle};
+   ASSERT_TRUE(top.cause());
+   ASSERT_TRUE(top.cause()->cause());
+   EXPECT_FALSE(top.cause()->cause()->cause());
+   EXPECT_FALSE(top.causeFrame()->hasCode);
+  }
+
+  TEST(Error, overwritten_trace_frames_are_not_resolved) {
+   Error cause;
+   Error e{"", (Error const&)cause};
+   EXPECT_TRUE(e.cause());
+   //Wrap enough errors to overwrite every frame in the ring
+   for (int i = 0; i < CX_ERROR_TRACE_FRAMES; i++) {
+    Error other{"", (Error const&)cause};
+    (void)other;
+   }
+   EXPECT_FALSE(e.cause());
+  }
+
+  TEST(Error, trace_frames_of_other_threads_are_not_resolved) {
+   //Both threads record their first frame, in the same ring slot
+   Error first;
+   std::thread{[&] {
+    first = Error{"first", Error{"first cause"}};
+    EXPECT_TRUE(first.cause());
+   }}.join();
+   std::thread{[&] {
+    Error second{"second", Error{"second cause"}};
+    ASSERT_TRUE(second.cause());
+    EXPECT_FALSE(first.causeFrame());
+    EXPECT_FALSE(first.cause());
+   }}.join();
+  }
+
+  #ifdef CX_ERROR_TRIVIAL
+   TEST(Error, error_with_cause_is_trivially_copyable) {
+    EXPECT_TRUE((TriviallyCopyable<Error>));
+    EXPECT_LE(sizeof(Error), 2 * sizeof(void *));
+   }
+  #endif //CX_ERROR_TRIVIAL
  #else
   //Tests when `CX_ERROR_TRACE` is disabled
   TEST(Error, error_message_and_cause_constructor_has_no_effect_on_cause) {
@@ -47,4 +47,74 @@ namespace CX {
    EXPECT_TRUE((getExitHandler() != origHandler));
   }());
  }
+
+ TEST(ErrorReport, report_contains_error_and_causes) {
+  Error cause{"inner"};
+  Error err{"outer", (Error const&)cause};
+  char buffer[256];
+  Internal::ErrorReport report{buffer, sizeof(buffer)};
+  Internal::formatError(report, "exit", err);
+  auto const length = report.finish();
+  EXPECT_FALSE(report.truncated);
+  buffer[length] = '\00';
+  #ifdef CX_ERROR_MSG
+   EXPECT_THAT(buffer, ::testing::StartsWith(
+    "`CX::exit(...)` invoked with error:\nouter\n"
+   ));
+  #else
+   EXPECT_STREQ(buffer, "`CX::exit(...)` invoked without an error\n");
+  #endif //CX_ERROR_MSG
+  #if defined(CX_ERROR_MSG) && defined(CX_ERROR_TRACE)
+   EXPECT_THAT(buffer, ::testing::HasSubstr("Caused by: inner\n"));
+  #endif //defined(CX_ERROR_MSG) && defined(CX_ERROR_TRACE)
+ }
+
+ TEST(ErrorReport, oversized_report_is_truncated_with_newline) {
+  char buffer[12];
+  Internal::ErrorReport report{buffer, sizeof(buffer)};
+  report.append("0123456789abcdef").append(-42ll);
+  EXPECT_TRUE(report.truncated);
+  EXPECT_EQ(report.finish(), sizeof(buffer));
+  EXPECT_EQ(buffer[sizeof(buffer) - 1], '\n');
+ }
+
+ TEST(ErrorReport, integers_are_formatted) {
+  char buffer[64];
+  Internal::ErrorReport report{buffer, sizeof(buffer)};
+  report
+   .append(-42ll)
+   .append(" ")
+   .append(255ull, 16)
+   .append(" ")
+   .append(7ull, 10, 3);
+  buffer[report.finish()] = '\00';
+  EXPECT_STREQ(buffer, "-42 ff 007");
+ }
+
+ TEST(ErrorReport, out_of_range_integer_formats_are_bounded) {
+  char buffer[128];
+  Internal::ErrorReport report{buffer, sizeof(buffer)};
+  report
+   .append(5ull, 1)
+   .append(5ull, 17)
+   .append(1ull, 2, 100);
+  buffer[report.finish()] = '\00';
+  EXPECT_EQ(__builtin_strlen(buffer), 64u);
+  EXPECT_EQ(buffer[63], '1');
+ }
+
+ #if CX_EXIT_HANDLER == 3
+  TEST(Exit, posix_exit_handler_writes_report) {
+   EXPECT_EXIT_BEHAVIOUR(
+    exit(),
+    #ifdef CX_EXIT_REPORT_TIMESTAMP
+     "\\[[0-9]+\\.[0-9]{9}\\] "
+    #endif //CX_EXIT_REPORT_TIMESTAMP
+    "`CX::exit\\(\\.\\.\\.\\)` invoked without an error\n"
+    #ifdef CX_EXIT_REPORT_BACKTRACE
+     "Backtrace:\n #0 0x"
+    #endif //CX_EXIT_REPORT_BACKTRACE
+   );
+  }
+ #endif //CX_EXIT_HANDLER == 3
 }
@@ -0,0 +1,130 @@
+#include <cx/test/common/common.h>
+
+#include <cstdio>
+#include <cstdarg>
+#include <string>
+
+#include <cx/format.h>
+
+namespace CX::Testing {
+ //Formats `args` with both `CX::format` and `snprintf`
+ template<FormatString Format, typename... Args>
+ void expectSnprintfOutput(Args... args) {
+  char expected[256];
+  char actual[256];
+  auto const expectedLength = snprintf(expected, sizeof(expected), Format.data, args...);
+  auto const actualLength = format<Format>(actual, sizeof(actual), args...);
+  EXPECT_EQ(actualLength, (SizeType)expectedLength) << Format.data;
+  EXPECT_STREQ(actual, expected) << Format.data;
+ }
+
+ TEST(FormatMatches, argument_types_are_checked_against_conversions) {
+  EXPECT_TRUE((FormatMatches<"%d %s", int, char const *>));
+  EXPECT_TRUE((FormatMatches<"%d %s", short, char *>));
+  EXPECT_TRUE((FormatMatches<"%u %x", int, unsigned>));
+  EXPECT_TRUE((FormatMatches<"%f %f", float, double>));
+  EXPECT_TRUE((FormatMatches<"%p %p %s", int *, NullptrType, NullptrType>));
+  EXPECT_TRUE((FormatMatches<"%zu %lld", SizeType, long long>));
+  EXPECT_TRUE((FormatMatches<"%*.*f", int, int, double>));
+  EXPECT_TRUE((FormatMatches<"literal %%">));
+ }
+
+ TEST(FormatMatches, mismatched_arguments_do_not_satisfy_constraint) {
+  EXPECT_FALSE((FormatMatches<"%d", char const *>));
+  EXPECT_FALSE((FormatMatches<"%d", long long>));
+  EXPECT_FALSE((FormatMatches<"%lld", int>));
+  EXPECT_FALSE((FormatMatches<"%s", int *>));
+  EXPECT_FALSE((FormatMatches<"%f", long double>));
+  EXPECT_FALSE((FormatMatches<"%Lf", double>));
+  EXPECT_FALSE((FormatMatches<"%p", int>));
+  EXPECT_FALSE((FormatMatches<"%d %d", int>));
+  EXPECT_FALSE((FormatMatches<"%d", int, int>));
+  EXPECT_FALSE((FormatMatches<"%n", int *>));
+ }
+
+ TEST(format, integral_conversions_match_snprintf) {
+  expectSnprintfOutput<"[%d] [%i] [%u]">(-42, 17, 4000000000u);
+  expectSnprintfOutput<"[%5d] [%-5d] [%05d] [%+d] [% d]">(42, 42, -42, 42, 42);
+  expectSnprintfOutput<"[%.3d] [%8.3d] [%.0d] [%-+6d]">(7, -7, 0, 9);
+  expectSnprintfOutput<"[%x] [%X] [%#x] [%#X] [%#x] [%08x]">(255u, 255u, 255u, 3054u, 0u, 48879u);
+  expectSnprintfOutput<"[%o] [%#o] [%#o] [%#.3o]">(8u, 8u, 0u, 8u);
+  expectSnprintfOutput<"[%hhd] [%hhu] [%hd] [%hu]">((signed char)-5, (unsigned char)250, (short)-300, (unsigned short)65000);
+  expectSnprintfOutput<"[%ld] [%lu] [%lld] [%llu]">(-1L << 40, ~0ul, (long long)(-0x7FFFFFFFFFFFFFFFLL - 1), ~0ull);
+  expectSnprintfOutput<"[%zu] [%zd] [%td]">((SizeType)12345, (long)-3, (long)-9);
+ }
+
+ TEST(format, star_widths_and_precisions_match_snprintf) {
+  expectSnprintfOutput<"[%*d] [%-*d] [%*d]">(6, 1, 6, 2, -6, 3);
+  expectSnprintfOutput<"[%.*d] [%.*s] [%*.*s]">(4, 5, 2, "abcdef", 6, 3, "abcdef");
+  expectSnprintfOutput<"[%.*d]">(-1, 5);
+ }
+
+ TEST(format, character_string_and_pointer_conversions_match_snprintf) {
+  int target = 0;
+  expectSnprintfOutput<"[%c] [%3c] [%-3c]">('a', 'b', 'c');
+  expectSnprintfOutput<"[%s] [%8s] [%-8s] [%.2s]">("text", "text", "text", "text");
+  expectSnprintfOutput<"[%p] [%20p] [%-20p]">((void *)&target, (void *)&target, (void *)&target);
+  expectSnprintfOutput<"[%p] [%s]">((void *)nullptr, (char const *)nullptr);
+  expectSnprintfOutput<"100%% of %d%%">(5);
+ }
+
+ TEST(format, floating_conversions_match_snprintf) {
+  expectSnprintfOutput<"[%f] [%.2f] [%10.3e] [%-8g] [%A]">(3.14159, 2.675, 12345.678, 0.0001, 1.0);
+  expectSnprintfOutput<"[%Lf] [%*.*f]">(1.5L, 10, 4, 2.25);
+ }
+
+ TEST(format, output_is_truncated_and_terminated_like_snprintf) {
+  char buffer[8];
+  EXPECT_EQ((format<"%s: %d">(buffer, sizeof(buffer), "truncated", 12345)), 16u);
+  EXPECT_STREQ(buffer, "truncat");
+  EXPECT_EQ((format<"%f">(buffer, sizeof(buffer), 1234.5)), 11u);
+  EXPECT_STREQ(buffer, "1234.50");
+  EXPECT_EQ((format<"%d">(nullptr, 0, 123456)), 6u);
+ }
+
+ TEST(format, arguments_are_read_from_va_list) {
+  auto op = [](char * buffer, SizeType size, ...) {
+   VaList list;
+   va_start(list, size);
+   return format<"%s=%5.1f (%c)">(buffer, size, list);
+  };
+  char buffer[32];
+  EXPECT_EQ(op(buffer, sizeof(buffer), "ratio", 0.25, 'r'), 15u);
+  EXPECT_STREQ(buffer, "ratio=  0.2 (r)");
+ }
+
+ TEST(formatVarargs, function_is_stored_in_c_variadic_lambda) {
+  Lambda<SizeType (char *, SizeType, ...)> formatter = &formatVarargs<"%s #%02d">;
+  char buffer[32];
+  EXPECT_EQ(formatter(buffer, sizeof(buffer), "item", 7), 8u);
+  EXPECT_STREQ(buffer, "item #07");
+ }
+
+ template<typename L, typename... Args>
+ concept InvocableFormatted = requires (L& l, Args... args) {
+  invokeFormatted<"%s: %u">(l, args...);
+ };
+
+ TEST(invokeFormatted, c_variadic_lambda_is_invoked_with_format_and_checked_arguments) {
+  Lambda<int (char *, SizeType, char const *, ...)> print = &snprintf;
+  char buffer[32];
+  auto const length = invokeFormatted<"%s: %u">(print, buffer, sizeof(buffer), "count", 3u);
+  EXPECT_EQ(length, 8);
+  EXPECT_STREQ(buffer, "count: 3");
+  EXPECT_TRUE((InvocableFormatted<decltype(print), char *, SizeType, char const *, unsigned>));
+  EXPECT_FALSE((InvocableFormatted<decltype(print), char *, SizeType, unsigned, char const *>));
+  EXPECT_FALSE((InvocableFormatted<decltype(print), char *, SizeType, char const *>));
+  //The format string is supplied by `invokeFormatted`, not the caller
+  EXPECT_FALSE((InvocableFormatted<decltype(print), char *, SizeType, char const *, char const *, unsigned>));
+  //The last fixed parameter must be a format string
+  Lambda<SizeType (char *, SizeType, ...)> unformatted = &formatVarargs<"%s: %u">;
+  EXPECT_FALSE((InvocableFormatted<decltype(unformatted), char *, char const *, unsigned>));
+ }
+
+ TEST(format, string_precision_bounds_reads_of_unterminated_strings) {
+  char const unterminated[3] = {'a', 'b', 'c'};
+  char buffer[8];
+  EXPECT_EQ((format<"[%.3s]">(buffer, sizeof(buffer), (char const *)unterminated)), 5u);
+  EXPECT_STREQ(buffer, "[abc]");
+ }
+}
@@ -0,0 +1,131 @@
+#include <cx/test/common/common.h>
+
+#include <string>
+#include <vector>
+#include <thread>
+
+//Small ring buffers to exercise wrapping and dropping
+#define CX_LOG_RING_SIZE 512
+#include <cx/log.h>
+
+namespace CX::Testing {
+ //Collects formatted records
+ struct CollectingSink final {
+  std::vector<std::string>& lines;
+
+  void operator()(char const * const line, SizeType const length) {
+   lines.emplace_back(line, length);
+  }
+ };
+
+ TEST(DeferredLog, records_are_formatted_on_consumption) {
+  DeferredLog log;
+  int target = 0;
+  EXPECT_TRUE((deferLog<"%s: %d of %zu (%.2f)">(&log, "request", 3, (SizeType)8, 0.375)));
+  EXPECT_TRUE((deferLog<"%hhu %hd %c %lld %p">(&log, (unsigned char)200, (short)-7, 'x', -5LL, (void *)&target)));
+  EXPECT_TRUE((deferLog<"no arguments %%">(&log)));
+
+  std::vector<std::string> lines;
+  EXPECT_EQ(log.consume(CollectingSink{lines}), 3u);
+  ASSERT_EQ(lines.size(), 3u);
+  char pointer[32];
+  snprintf(pointer, sizeof(pointer), "%p", (void *)&target);
+  EXPECT_EQ(lines[0], "request: 3 of 8 (0.38)");
+  EXPECT_EQ(lines[1], std::string{"200 -7 x -5 "} + pointer);
+  EXPECT_EQ(lines[2], "no arguments %");
+  EXPECT_EQ(log.consume(CollectingSink{lines}), 0u);
+ }
+
+ TEST(DeferredLog, strings_are_copied_into_records) {
+  DeferredLog log;
+  char name[] = "before";
+  deferLog<"[%s] [%s] [%s]">(&log, name, (char const *)nullptr, "static");
+  name[0] = 'X';
+
+  std::vector<std::string> lines;
+  log.consume(CollectingSink{lines});
+  ASSERT_EQ(lines.size(), 1u);
+  EXPECT_EQ(lines[0], "[before] [(null)] [static]");
+ }
+
+ TEST(DeferredLog, strings_are_copied_up_to_their_precision) {
+  DeferredLog log;
+  //Unterminated buffers; only the first four characters may be read
+  auto const name = new char[4]{'a', 'b', 'c', 'd'};
+  auto const other = new char[2]{'x', 'y'};
+  deferLog<"[%.4s] [%-6.*s] [%.2s]">(&log, name, 2, other, "longer");
+  deferLog<"[%.*s]">(&log, -1, "negative precision");
+  delete[] name;
+  delete[] other;
+
+  std::vector<std::string> lines;
+  log.consume(CollectingSink{lines});
+  ASSERT_EQ(lines.size(), 2u);
+  EXPECT_EQ(lines[0], "[abcd] [xy    ] [lo]");
+  EXPECT_EQ(lines[1], "[negative precision]");
+ }
+
+ TEST(DeferredLog, records_wrap_around_the_ring_buffer) {
+  DeferredLog log;
+  std::vector<std::string> lines;
+  for (int i = 0; i < 100; i++) {
+   EXPECT_TRUE((deferLog<"record %d: %s">(&log, i, "payload")));
+   if (i % 3 == 2) {
+    log.consume(CollectingSink{lines});
+   }
+  }
+  log.consume(CollectingSink{lines});
+  ASSERT_EQ(lines.size(), 100u);
+  for (int i = 0; i < 100; i++) {
+   EXPECT_EQ(lines[i], "record " + std::to_string(i) + ": payload");
+  }
+  EXPECT_EQ(log.dropped(), 0u);
+ }
+
+ TEST(DeferredLog, records_are_dropped_when_the_ring_buffer_is_full) {
+  DeferredLog log;
+  SizeType stored = 0;
+  for (int i = 0; i < 64; i++) {
+   stored += deferLog<"%d %f %s">(&log, i, 1.0, "a fairly long string argument");
+  }
+  EXPECT_GT(stored, 0u);
+  EXPECT_LT(stored, 64u);
+  EXPECT_EQ(log.dropped(), 64u - stored);
+
+  std::vector<std::string> lines;
+  EXPECT_EQ(log.consume(CollectingSink{lines}), stored);
+  EXPECT_TRUE((deferLog<"%d">(&log, 1)));
+ }
+
+ TEST(DeferredLog, threads_record_into_their_own_ring_buffers) {
+  constexpr int const Threads = 4;
+  constexpr int const Records = 200;
+  DeferredLog log;
+  std::vector<std::string> lines;
+  {
+   DeferredLogConsumer consumer{log, CollectingSink{lines}, std::chrono::microseconds{10}};
+   std::vector<std::thread> threads;
+   for (int t = 0; t < Threads; t++) {
+    threads.emplace_back([&log, t] {
+     for (int i = 0; i < Records; i++) {
+      while (!deferLog<"%d %d">(&log, t, i)) {
+       std::this_thread::yield();
+      }
+     }
+    });
+   }
+   for (auto& thread : threads) {
+    thread.join();
+   }
+  }
+
+  //Records of each thread are consumed in order
+  ASSERT_EQ(lines.size(), (SizeType)(Threads * Records));
+  int next[Threads]{};
+  for (auto const& line : lines) {
+   int t, i;
+   ASSERT_EQ(sscanf(line.c_str(), "%d %d", &t, &i), 2);
+   EXPECT_EQ(i, next[t]++);
+  }
+ }
+}
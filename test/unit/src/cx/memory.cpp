@@ -1,6 +1,7 @@
 #include <cx/test/common/common.h>
 
 #include <cx/memory.h>
+#include <cx/arena.h>
 
 namespace CX {
  //`Defer` tests
@@ -46,49 +47,239 @@ namespace CX {
   EXPECT_EQ(count, expectedCount);
  }
 
- //Note: `AllocDefer` tests require STL support to be enabled
- #ifdef CX_STL_SUPPORT
-  TEST(AllocDefer, drain_invokes_deferred_function) {
-   static int count;
-   static constexpr auto const callback = [] {
-    count++;
-   };
+ TEST(Defer, deferred_functions_invoked_in_reverse_order) {
+  int order[3]{};
+  int next = 0;
+
+  {
+   Defer<3> deferred;
+   for (int i = 0; i < 3; i++) {
+    deferred += [&order, &next, i] {
+     order[next++] = i;
+    };
+   }
+  }
+
+  EXPECT_EQ(order[0], 2);
+  EXPECT_EQ(order[1], 1);
+  EXPECT_EQ(order[2], 0);
+ }
+
+ //`DeferFrame` tests
+ TEST(DeferFrame, frame_is_only_as_large_as_captures) {
+  int i = 0;
+  auto frame = DeferFrame{[&i] { i++; }, [&i] { i--; }};
+  EXPECT_LE(sizeof(frame), 3 * sizeof(int *));
+  EXPECT_LT(sizeof(frame), sizeof(Defer<2>));
+  EXPECT_LE(sizeof(DeferFrame{[] {}}), sizeof(int *));
+ }
 
-   //Reset counter in case test is re-run
-   count = 0;
+ TEST(DeferFrame, deferred_functions_invoked_in_reverse_order_on_destruction) {
+  int order[3]{};
+  int next = 0;
+
+  {
+   auto frame = DeferFrame{[&] { order[next++] = 0; }}
+    .then([&] { order[next++] = 1; })
+    .then([&] { order[next++] = 2; });
+   EXPECT_EQ(next, 0);
+  }
+
+  EXPECT_EQ(next, 3);
+  EXPECT_EQ(order[0], 2);
+  EXPECT_EQ(order[1], 1);
+  EXPECT_EQ(order[2], 0);
+ }
+
+ TEST(DeferFrame, deferred_functions_invoked_once) {
+  int count = 0;
+
+  {
+   auto first = DeferFrame{[&] { count++; }};
+   using First = decltype(first);
+   //Moved-from frames no longer invoke their functions
+   auto second = ((First&&)first).then([&] { count++; });
+   using Second = decltype(second);
+   auto third = (Second&&)second;
+   third.drain();
+   EXPECT_EQ(count, 2);
+  }
+
+  EXPECT_EQ(count, 2);
+ }
+
+ TEST(DeferFrame, cancelled_frame_does_not_invoke_deferred_functions) {
+  int count = 0;
+
+  {
+   auto frame = DeferFrame{[&] { count++; }};
+   using Frame = decltype(frame);
+   frame.cancel();
+   //Frames extended from cancelled frames remain cancelled
+   auto extended = ((Frame&&)frame).then([&] { count++; });
+  }
+
+  EXPECT_EQ(count, 0);
+ }
+
+ //`AllocDefer` tests
+ TEST(AllocDefer, drain_invokes_deferred_function) {
+  static int count;
+  static constexpr auto const callback = [] {
+   count++;
+  };
+
+  //Reset counter in case test is re-run
+  count = 0;
+
+  {
+   //Construct deferral mechanism and add deferred function
+   AllocDefer deferred;
+   deferred += callback;
+
+   //Drain deferral mechanism
+   deferred.drain();
+  }
+
+  EXPECT_EQ(count, 1);
+ }
 
-   {
-    //Construct deferral mechanism and add deferred function
-    AllocDefer deferred;
+ TEST(AllocDefer, all_deferred_functions_invoked_when_deferral_mechanism_destructed) {
+  static constexpr auto const expectedCount = 12;
+  static int count;
+  static constexpr auto const callback = [] {
+   count++;
+  };
+
+  //Reset counter in case test is re-run
+  count = 0;
+
+  {
+   //Construct deferral mechanism and add deferred functions
+   AllocDefer deferred;
+   for (int i = 0; i < expectedCount; i++) {
     deferred += callback;
+   }
+  }
+
+  EXPECT_EQ(count, expectedCount);
+ }
+
+ TEST(AllocDefer, deferred_functions_invoked_in_reverse_order) {
+  int order[20]{};
+  int next = 0;
 
-    //Drain deferral mechanism
-    deferred.drain();
+  {
+   //Register enough functions to grow the buffer
+   AllocDefer deferred;
+   for (int i = 0; i < 20; i++) {
+    deferred += [&order, &next, i] {
+     order[next++] = i;
+    };
    }
+  }
 
-   EXPECT_EQ(count, 1);
+  ASSERT_EQ(next, 20);
+  for (int i = 0; i < 20; i++) {
+   EXPECT_EQ(order[i], 19 - i);
   }
+ }
 
-  TEST(AllocDefer, all_deferred_functions_invoked_when_deferral_mechanism_destructed) {
-   static constexpr auto const expectedCount = 12;
-   static int count;
-   static constexpr auto const callback = [] {
-    count++;
-   };
+ TEST(AllocDefer, buffer_is_kept_across_drains) {
+  int count = 0;
+  AllocDefer deferred;
+  for (int i = 0; i < 10; i++) {
+   deferred += [&count] { count++; };
+  }
+  auto const reserved = deferred.reserved();
+  EXPECT_GE(reserved, 10u);
+  deferred.drain();
+  EXPECT_EQ(deferred.size(), 0u);
+  EXPECT_EQ(deferred.reserved(), reserved);
 
-   //Reset counter in case test is re-run
-   count = 0;
+  //Re-registering does not grow the buffer
+  for (int i = 0; i < 10; i++) {
+   deferred += [&count] { count += 2; };
+  }
+  EXPECT_EQ(deferred.reserved(), reserved);
+  deferred.drain();
+  EXPECT_EQ(count, 30);
+ }
+
+ TEST(AllocDefer, rollback_invokes_functions_registered_since_checkpoint) {
+  int order[3]{};
+  int next = 0;
+  AllocDefer deferred;
+  deferred += [&] { order[next++] = 0; };
+  auto const checkpoint = deferred.checkpoint();
+  deferred += [&] { order[next++] = 1; };
+  deferred += [&] { order[next++] = 2; };
+
+  deferred.rollback(checkpoint);
+  ASSERT_EQ(next, 2);
+  EXPECT_EQ(order[0], 2);
+  EXPECT_EQ(order[1], 1);
+  EXPECT_EQ(deferred.size(), 1u);
+
+  deferred.drain();
+  EXPECT_EQ(next, 3);
+  EXPECT_EQ(order[2], 0);
+ }
 
-   {
-    //Construct deferral mechanism and add deferred functions
-    AllocDefer deferred;
-    for (int i = 0; i < expectedCount; i++) {
-     deferred += callback;
-    }
+ TEST(AllocDefer, deferred_functions_may_register_deferred_functions) {
+  int order[AllocDefer<>::InitialCapacity * 2]{};
+  int next = 0;
+  AllocDefer deferred;
+  //Fill the buffer so that the nested registrations grow it
+  for (SizeType i = 0; i + 1 < AllocDefer<>::InitialCapacity; i++) {
+   deferred += [&] { order[next++] = 0; };
+  }
+  deferred += [&] {
+   order[next++] = 1;
+   for (SizeType i = 0; i < AllocDefer<>::InitialCapacity; i++) {
+    deferred += [&] { order[next++] = 2; };
    }
+  };
+  ASSERT_EQ(deferred.size(), deferred.reserved());
 
-   EXPECT_EQ(count, expectedCount);
+  deferred.drain();
+  EXPECT_EQ(deferred.size(), 0u);
+  ASSERT_EQ(next, (int)AllocDefer<>::InitialCapacity * 2);
+  //Nested registrations run before the functions registered before them
+  EXPECT_EQ(order[0], 1);
+  for (SizeType i = 1; i <= AllocDefer<>::InitialCapacity; i++) {
+   EXPECT_EQ(order[i], 2);
   }
- #endif //CX_STL_SUPPORT
-}
+  for (SizeType i = AllocDefer<>::InitialCapacity + 1; i < AllocDefer<>::InitialCapacity * 2; i++) {
+   EXPECT_EQ(order[i], 0);
+  }
+ }
 
+ TEST(AllocDefer, discard_drops_functions_registered_since_checkpoint) {
+  int count = 0;
+  {
+   AllocDefer deferred;
+   deferred += [&count] { count++; };
+   auto const checkpoint = deferred.checkpoint();
+   deferred += [&count] { count += 10; };
+   deferred.discard(checkpoint);
+   EXPECT_EQ(deferred.size(), 1u);
+  }
+  EXPECT_EQ(count, 1);
+ }
+
+ TEST(AllocDefer, buffer_is_allocated_with_arena) {
+  Arena arena;
+  int count = 0;
+  {
+   AllocDefer<ArenaAllocator> deferred{
+    ArenaAllocator<AllocDefer<ArenaAllocator>::Entry>{arena}
+   };
+   for (int i = 0; i < 9; i++) {
+    deferred += [&count] { count++; };
+   }
+   EXPECT_GE(arena.capacity(), 9 * sizeof(AllocDefer<>::Entry));
+  }
+  EXPECT_EQ(count, 9);
+ }
+}
@@ -8,10 +8,274 @@ namespace CX {
  }
 
  TEST(Option, populated_option_with_noexcept_constructible_type_is_noexcept_constructible) {
-  FAIL();
+  EXPECT_TRUE((noexcept(Option<char>{'a'})));
  }
 
- //TODO remaining `Option` tests
+ TEST(Option, value_presence_is_reflected_by_bool_conversion) {
+  Option<int> o1;
+  EXPECT_FALSE(o1.hasValue());
+  Option<int> o2{1};
+  EXPECT_TRUE(o2.hasValue());
+  EXPECT_EQ(+o2, 1);
+  o2.reset();
+  EXPECT_FALSE(o2.hasValue());
+ }
+
+ TEST(Option, value_or_operators_yield_fallback_when_absent) {
+  Option<int> o;
+  EXPECT_EQ(o | 2, 2);
+  EXPECT_EQ(o | [] { return 3; }, 3);
+  o = 4;
+  EXPECT_EQ(o | 2, 4);
+  EXPECT_EQ(o | [] { return 3; }, 4);
+ }
+
+ TEST(Option, checked_decapsulation_of_absent_value_exits) {
+  static constexpr auto const decapsulateAbsent = [] {
+   Option<int> o;
+   (void)+o;
+  };
+  EXPECT_EXIT_BEHAVIOUR(decapsulateAbsent(), ".*");
+ }
+
+ TEST(Option, copy_and_move_preserve_presence_and_value) {
+  Option<int> o1{5};
+  auto o2 = o1;
+  EXPECT_TRUE(o2.hasValue());
+  EXPECT_EQ(+o2, 5);
+
+  Option<int> o3;
+  o3 = o1;
+  EXPECT_EQ(+o3, 5);
+  o3 = Option<int>{};
+  EXPECT_FALSE(o3.hasValue());
+ }
+
+ TEST(Option, non_trivial_values_are_destructed) {
+  static int live;
+  live = 0;
+
+  struct Counted {
+   Counted() noexcept {
+    live++;
+   }
+
+   Counted(Counted const&) noexcept {
+    live++;
+   }
+
+   Counted& operator=(Counted const&) noexcept = default;
+
+   ~Counted() noexcept {
+    live--;
+   }
+  };
+
+  {
+   Option<Counted> o1{Counted{}};
+   EXPECT_EQ(live, 1);
+   auto o2 = o1;
+   EXPECT_EQ(live, 2);
+   o1.reset();
+   EXPECT_EQ(live, 1);
+   Option<Counted> o3 = (Option<Counted>&&)o2;
+   EXPECT_FALSE(o2.hasValue());
+   EXPECT_EQ(live, 1);
+  }
+  EXPECT_EQ(live, 0);
+ }
+
+ TEST(Option, pointer_option_uses_null_niche) {
+  EXPECT_EQ(sizeof(Option<int *>), sizeof(int *));
+  EXPECT_TRUE((TriviallyCopyable<Option<int *>>));
+
+  int i = 0;
+  Option<int *> o;
+  EXPECT_FALSE(o.hasValue());
+  o = &i;
+  EXPECT_TRUE(o.hasValue());
+  EXPECT_EQ(+o, &i);
+  o = nullptr;
+  EXPECT_FALSE(o.hasValue());
+ }
+
+ TEST(Option, reference_option_is_supported_and_pointer_sized) {
+  EXPECT_EQ(sizeof(Option<int&>), sizeof(int *));
+
+  int i = 1, j = 2;
+  Option<int&> o;
+  EXPECT_FALSE(o.hasValue());
+  o = i;
+  EXPECT_TRUE(o.hasValue());
+  +o = 3;
+  EXPECT_EQ(i, 3);
+  EXPECT_EQ(&!o, &i);
+
+  //Assignment rebinds the reference
+  o = j;
+  EXPECT_EQ(&+o, &j);
+  EXPECT_EQ(i, 3);
+
+  EXPECT_EQ(&(Option<int&>{} | j), &j);
+ }
+
+ //Type with a user-declared sentinel value
+ struct Handle {
+  int fd;
+
+  constexpr bool operator==(Handle const&) const noexcept = default;
+ };
+}
+
+template<>
+struct CX::OptionNiche<CX::Handle> {
+ static constexpr CX::Handle const Value{-1};
+};
+
+namespace CX {
+ TEST(Option, user_declared_niche_is_used_as_absent_state) {
+  EXPECT_TRUE((HasOptionNiche<Handle>));
+  EXPECT_FALSE((HasOptionNiche<int>));
+  EXPECT_EQ(sizeof(Option<Handle>), sizeof(Handle));
 
- //TODO `OptionTuple` tests
+  Option<Handle> o;
+  EXPECT_FALSE(o.hasValue());
+  o = Handle{3};
+  EXPECT_TRUE(o.hasValue());
+  EXPECT_EQ((+o).fd, 3);
+  o.reset();
+  EXPECT_FALSE(o.hasValue());
+  EXPECT_EQ((!o).fd, -1);
+ }
+
+ //`OptionTuple` tests
+ TEST(OptionTuple, default_constructed_option_tuple_has_no_elements) {
+  OptionTuple<int, float, char> t;
+  EXPECT_TRUE(t.empty());
+  EXPECT_EQ(t.count(), 0);
+  EXPECT_FALSE((t.has<0>()));
+  EXPECT_FALSE((t.has<1>()));
+  EXPECT_FALSE((t.has<2>()));
+ }
+
+ TEST(OptionTuple, presence_flags_are_packed_into_a_single_word) {
+  //Elements are stored by descending alignment, followed by the 1-byte mask
+  EXPECT_EQ((sizeof(OptionTuple<char, double, char, int>)), 16);
+  EXPECT_EQ((sizeof(OptionTuple<char, short, char>)), 6);
+  EXPECT_EQ((sizeof(OptionTuple<char>)), 2);
+  EXPECT_EQ((alignof(OptionTuple<char, double>)), alignof(double));
+ }
+
+ TEST(OptionTuple, option_tuple_of_trivially_copyable_types_is_trivially_copyable) {
+  EXPECT_TRUE((TriviallyCopyable<OptionTuple<int, double, char *>>));
+  EXPECT_TRUE((TriviallyDestructible<OptionTuple<int, double, char *>>));
+ }
+
+ TEST(OptionTuple, set_get_and_reset_operate_on_a_single_element) {
+  OptionTuple<int, double, char> t;
+  t.set<1>(1.5);
+  EXPECT_FALSE((t.has<0>()));
+  EXPECT_TRUE((t.has<1>()));
+  EXPECT_FALSE((t.has<2>()));
+  EXPECT_EQ((t.get<1>()), 1.5);
+  EXPECT_EQ(t.count(), 1);
+
+  t.set<2>('x');
+  t.set<1>(2.5);
+  EXPECT_EQ((t.get<1>()), 2.5);
+  EXPECT_EQ((t.get<2>()), 'x');
+  EXPECT_EQ(t.count(), 2);
+
+  t.reset<1>();
+  EXPECT_FALSE((t.has<1>()));
+  EXPECT_TRUE((t.has<2>()));
+  EXPECT_EQ(t.count(), 1);
+
+  t.reset();
+  EXPECT_TRUE(t.empty());
+ }
+
+ TEST(OptionTuple, checked_get_of_absent_element_exits) {
+  static constexpr auto const getAbsent = [] {
+   OptionTuple<int, char> t;
+   (void)t.get<0>();
+  };
+  EXPECT_EXIT_BEHAVIOUR(getAbsent(), ".*");
+ }
+
+ TEST(OptionTuple, for_each_only_visits_present_elements_in_order) {
+  OptionTuple<int, double, char, long> t;
+  t.set<3>(4l);
+  t.set<0>(1);
+  t.set<2>('c');
+
+  SizeType visited[4]{};
+  SizeType count = 0;
+  t.forEach([&]<SizeType Index>(auto&) {
+   visited[count++] = Index;
+  });
+  EXPECT_EQ(count, 3);
+  EXPECT_EQ(visited[0], 0);
+  EXPECT_EQ(visited[1], 2);
+  EXPECT_EQ(visited[2], 3);
+
+  long sum = 0;
+  t.forEach([&](auto& element) {
+   sum += (long)element;
+  });
+  EXPECT_EQ(sum, 1 + 'c' + 4);
+ }
+
+ TEST(OptionTuple, non_trivial_elements_are_copied_moved_and_destructed) {
+  static int live;
+  live = 0;
+
+  struct Counted {
+   int value;
+
+   Counted(int value) noexcept :
+    value{value}
+   {
+    live++;
+   }
+
+   Counted(Counted const& other) noexcept :
+    value{other.value}
+   {
+    live++;
+   }
+
+   Counted(Counted&& other) noexcept :
+    value{other.value}
+   {
+    live++;
+   }
+
+   ~Counted() noexcept {
+    live--;
+   }
+  };
+
+  {
+   OptionTuple<Counted, int, Counted> t1;
+   t1.set<0>(Counted{1});
+   t1.set<1>(2);
+   EXPECT_EQ(live, 1);
+
+   auto t2 = t1;
+   EXPECT_EQ(live, 2);
+   EXPECT_EQ((t2.get<0>().value), 1);
+   EXPECT_EQ((t2.get<1>()), 2);
+   EXPECT_FALSE((t2.has<2>()));
+
+   auto t3 = (OptionTuple<Counted, int, Counted>&&)t2;
+   EXPECT_EQ(live, 2);
+   EXPECT_TRUE(t2.empty());
+   EXPECT_EQ((t3.get<0>().value), 1);
+
+   t1.reset<0>();
+   EXPECT_EQ(live, 1);
+  }
+  EXPECT_EQ(live, 0);
+ }
 }
@@ -0,0 +1,132 @@
+#include <cx/test/common/common.h>
+#include <cx/pool.h>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace CX::Testing {
+ struct PoolObject final {
+  SizeType owner;
+  SizeType value;
+  double padding[2];
+ };
+
+ TEST(PoolAllocator, satisfies_stateful_allocator_concept) {
+  EXPECT_TRUE((IsStatefulAllocator<PoolAllocator>));
+  EXPECT_FALSE((IsStatelessAllocator<PoolAllocator>));
+  EXPECT_EQ(sizeof(PoolAllocator<int>), sizeof(void *));
+ }
+
+ TEST(Pool, freed_objects_are_reused) {
+  for (auto const threadCaches : {false, true}) {
+   Pool<PoolObject> pool{16, threadCaches};
+   PoolAllocator<PoolObject> allocator{pool};
+   auto& a = +allocator.allocate();
+   auto& b = +allocator.allocate();
+   EXPECT_NE(&a, &b);
+   EXPECT_EQ((SizeType)&a % alignof(PoolObject), 0);
+   allocator.deallocate(b);
+   EXPECT_EQ(&+allocator.allocate(), &b);
+   allocator.deallocate(a);
+   allocator.deallocate(b);
+   EXPECT_EQ(pool.slabCount(), threadCaches ? 2 : 1);
+  }
+ }
+
+ TEST(Pool, slabs_grow_on_demand) {
+  Pool<PoolObject> pool{10, false};
+  std::set<PoolObject *> objects;
+  for (int i = 0; i < 35; i++) {
+   objects.insert(&+pool.allocate());
+  }
+  EXPECT_EQ(objects.size(), 35);
+  EXPECT_EQ(pool.slabCount(), 4);
+  for (auto const object : objects) {
+   pool.deallocate(*object);
+  }
+  for (int i = 0; i < 35; i++) {
+   EXPECT_TRUE(objects.count(&+pool.allocate()));
+  }
+  EXPECT_EQ(pool.slabCount(), 4);
+ }
+
+ TEST(Pool, thread_caches_exchange_magazines) {
+  Pool<PoolObject> pool{64};
+  std::vector<PoolObject *> objects;
+  //Overflow the thread cache several times, then drain it again
+  for (int i = 0; i < 1000; i++) {
+   objects.push_back(&+pool.allocate());
+  }
+  auto const slabs = pool.slabCount();
+  for (auto const object : objects) {
+   pool.deallocate(*object);
+  }
+  //Freed objects are served again, without growing the pool
+  std::set<PoolObject *> reused;
+  for (int i = 0; i < 1000; i++) {
+   reused.insert(&+pool.allocate());
+  }
+  EXPECT_EQ(reused.size(), 1000);
+  EXPECT_EQ(pool.slabCount(), slabs);
+ }
+
+ TEST(PoolAllocator, array_allocations_bypass_pool) {
+  Pool<PoolObject> pool;
+  PoolAllocator<PoolObject> allocator{pool};
+  auto& array = +allocator.allocate(4);
+  (&array)[3].value = 3;
+  allocator.deallocate(array, 4);
+  EXPECT_EQ(pool.slabCount(), 0);
+  EXPECT_TRUE(allocator == PoolAllocator<PoolObject>{pool});
+ }
+
+ TEST(Pool, objects_migrate_between_threads) {
+  for (auto const threadCaches : {false, true}) {
+   Pool<PoolObject> pool{32, threadCaches};
+   constexpr SizeType const threads = 8;
+   constexpr SizeType const rounds = 20000;
+   //Each thread allocates objects and hands them to its neighbour to free
+   std::vector<std::vector<PoolObject *>> handoff(threads);
+   std::vector<std::thread> workers;
+   bool failed = false;
+   for (SizeType t = 0; t < threads; t++) {
+    workers.emplace_back([&, t] {
+     std::vector<PoolObject *> live;
+     for (SizeType i = 0; i < rounds; i++) {
+      auto& object = +pool.allocate();
+      object.owner = t;
+      object.value = i;
+      live.push_back(&object);
+      if (live.size() == 64) {
+       for (auto const o : live) {
+        if (o->owner != t) {
+         __atomic_store_n(&failed, true, __ATOMIC_RELAXED);
+        }
+        pool.deallocate(*o);
+       }
+       live.clear();
+      }
+     }
+     handoff[t] = live;
+    });
+   }
+   for (auto& worker : workers) {
+    worker.join();
+   }
+   EXPECT_FALSE(failed);
+   //Free the remaining objects from other threads
+   workers.clear();
+   for (SizeType t = 0; t < threads; t++) {
+    workers.emplace_back([&, t] {
+     for (auto const o : handoff[(t + 1) % threads]) {
+      pool.deallocate(*o);
+     }
+    });
+   }
+   for (auto& worker : workers) {
+    worker.join();
+   }
+  }
+ }
+}
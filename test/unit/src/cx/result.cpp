@@ -252,6 +252,103 @@ namespace CX {
   FAIL();
  }
 
+ TEST(Result, reference_result_refers_to_value) {
+  struct E {
+   constexpr char const * describe() const noexcept {
+    return "E";
+   }
+  };
+  static_assert(TriviallyCopyable<Result<int&, E>>);
+  static_assert(sizeof(Result<int&, E>) == 2 * sizeof(int *));
+
+  int i = 1;
+  Result<int&, E> r{i};
+  EXPECT_TRUE(r.hasValue());
+  EXPECT_FALSE(r.hasError());
+  EXPECT_EQ(&r.getValue(), &i);
+  //Copies refer to the same value
+  auto const copy = r;
+  +copy = 2;
+  EXPECT_EQ(i, 2);
+  EXPECT_DEATH(
+   ([&] {
+    r.getError();
+   }()),
+   ".*"
+  );
+ }
+
+ TEST(Result, reference_result_holds_error) {
+  struct E {
+   int code;
+
+   constexpr char const * describe() const noexcept {
+    return "E";
+   }
+  };
+  int fallback = 3;
+  Result<int&, E> r{E{7}};
+  EXPECT_FALSE(r.hasValue());
+  EXPECT_TRUE(r.hasError());
+  EXPECT_EQ(r.getError().code, 7);
+  EXPECT_EQ(&(r || fallback), &fallback);
+  EXPECT_DEATH(
+   ([&] {
+    r.getValue();
+   }()),
+   ".*"
+  );
+ }
+
+ TEST(Result, reference_result_copies_do_not_move_error) {
+  //Error owning heap memory
+  struct E {
+   int * code;
+
+   E(int code) :
+    code{new int{code}}
+   {}
+
+   E(E const& other) :
+    code{other.code ? new int{*other.code} : nullptr}
+   {}
+
+   E(E&& other) :
+    code{other.code}
+   {
+    other.code = nullptr;
+   }
+
+   ~E() {
+    delete code;
+   }
+
+   char const * describe() const noexcept {
+    return "E";
+   }
+  };
+
+  Result<int&, E> a{E{7}};
+  Result<int&, E> b{a};
+  ASSERT_NE(a.getError().code, nullptr);
+  ASSERT_NE(b.getError().code, nullptr);
+  EXPECT_NE(a.getError().code, b.getError().code);
+  EXPECT_EQ(*a.getError().code, 7);
+  EXPECT_EQ(*b.getError().code, 7);
+
+  int i = 1;
+  Result<int&, E> c{i};
+  c = a;
+  ASSERT_NE(a.getError().code, nullptr);
+  ASSERT_NE(c.getError().code, nullptr);
+  EXPECT_EQ(*c.getError().code, 7);
+
+  //Moves still transfer the error
+  Result<int&, E> d{(Result<int&, E>&&)a};
+  ASSERT_NE(d.getError().code, nullptr);
+  EXPECT_EQ(*d.getError().code, 7);
+ }
+
  /*
  TEST(Result, a) {
   printf("sizeof(Never): %lu\n", sizeof(Never));
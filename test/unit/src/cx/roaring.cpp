@@ -0,0 +1,446 @@
+#include <cx/test/common/common.h>
+#include <cx/roaring.h>
+
+#include <set>
+#include <vector>
+
+namespace CX::Testing {
+ using Roaring = RoaringBitmap<>;
+ using RoaringContainerType = RoaringMetaFunctions::ContainerType;
+
+ //Returns the values of `bitmap`, in iteration order
+ template<typename B>
+ std::vector<unsigned int> valuesOf(B const& bitmap) {
+  std::vector<unsigned int> values;
+  bitmap.forEach([&](unsigned int const value) {
+   values.push_back(value);
+  });
+  return values;
+ }
+
+ //Fills `bitmap` with `count` pseudo-random values below `range` and returns
+ //the reference set of added values
+ std::set<unsigned int> fillRandom(
+  Roaring& bitmap,
+  SizeType const count,
+  unsigned int const range,
+  unsigned int seed
+ ) {
+  std::set<unsigned int> reference;
+  for (SizeType i = 0; i < count; i++) {
+   seed = seed * 1103515245 + 12345;
+   auto const value = (seed >> 1) % range;
+   EXPECT_EQ(bitmap.add(value), reference.insert(value).second);
+  }
+  return reference;
+ }
+
+ TEST(RoaringBitmap, default_constructed_bitmap_is_empty) {
+  Roaring const bitmap;
+  EXPECT_TRUE(bitmap.empty());
+  EXPECT_EQ(bitmap.cardinality(), 0);
+  EXPECT_EQ(bitmap.containerCount(), 0);
+  EXPECT_FALSE(bitmap.contains(0));
+  EXPECT_FALSE(bitmap.contains(0xFFFFFFFF));
+ }
+
+ TEST(RoaringBitmap, add_remove_and_contains_track_values) {
+  Roaring bitmap;
+  EXPECT_TRUE(bitmap.add(5));
+  EXPECT_FALSE(bitmap.add(5));
+  EXPECT_TRUE(bitmap.add(0x10000));
+  EXPECT_TRUE(bitmap.add(0xFFFFFFFF));
+  EXPECT_EQ(bitmap.cardinality(), 3);
+  EXPECT_EQ(bitmap.containerCount(), 3);
+  EXPECT_TRUE(bitmap.contains(5));
+  EXPECT_TRUE(bitmap.contains(0x10000));
+  EXPECT_TRUE(bitmap.contains(0xFFFFFFFF));
+  EXPECT_FALSE(bitmap.contains(6));
+  EXPECT_FALSE(bitmap.contains(0x10005));
+  EXPECT_EQ(valuesOf(bitmap), (std::vector<unsigned int>{5, 0x10000, 0xFFFFFFFF}));
+  EXPECT_TRUE(bitmap.remove(0x10000));
+  EXPECT_FALSE(bitmap.remove(0x10000));
+  EXPECT_FALSE(bitmap.remove(7));
+  EXPECT_EQ(bitmap.containerCount(), 2);
+  EXPECT_EQ(bitmap.cardinality(), 2);
+ }
+
+ TEST(RoaringBitmap, containers_switch_between_array_and_bitset) {
+  Roaring bitmap;
+  for (unsigned int i = 0; i < 4096; i++) {
+   bitmap.add(i * 2);
+  }
+  EXPECT_EQ(bitmap.containerCount(RoaringContainerType::ARRAY), 1);
+  bitmap.add(1);
+  EXPECT_EQ(bitmap.containerCount(RoaringContainerType::BITSET), 1);
+  EXPECT_EQ(bitmap.cardinality(), 4097);
+  EXPECT_TRUE(bitmap.contains(1));
+  EXPECT_TRUE(bitmap.contains(8190));
+  EXPECT_FALSE(bitmap.contains(8191));
+  bitmap.remove(2);
+  EXPECT_EQ(bitmap.containerCount(RoaringContainerType::ARRAY), 1);
+  EXPECT_EQ(bitmap.cardinality(), 4096);
+  EXPECT_TRUE(bitmap.contains(1));
+  EXPECT_FALSE(bitmap.contains(2));
+ }
+
+ TEST(RoaringBitmap, matches_reference_set_for_random_values) {
+  Roaring bitmap;
+  auto const reference = fillRandom(bitmap, 50000, 1 << 20, 7);
+  EXPECT_EQ(bitmap.cardinality(), reference.size());
+  EXPECT_EQ(
+   valuesOf(bitmap),
+   std::vector<unsigned int>(reference.begin(), reference.end())
+  );
+  for (unsigned int value = 0; value < (1 << 20); value += 97) {
+   EXPECT_EQ(bitmap.contains(value), reference.count(value) == 1);
+  }
+ }
+
+ TEST(RoaringBitmap, optimize_selects_smallest_representation) {
+  Roaring bitmap;
+  //Dense runs in container 0
+  for (unsigned int i = 0; i < 20000; i++) {
+   bitmap.add(i);
+  }
+  //Sparse values in container 1
+  for (unsigned int i = 0; i < 100; i++) {
+   bitmap.add(0x10000 + i * 300);
+  }
+  //Scattered dense values in container 2
+  for (unsigned int i = 0; i < 30000; i++) {
+   bitmap.add(0x20000 + i * 2);
+  }
+  Roaring const original{bitmap};
+  bitmap.optimize();
+  EXPECT_EQ(bitmap.containerCount(RoaringContainerType::RUN), 1);
+  EXPECT_EQ(bitmap.containerCount(RoaringContainerType::ARRAY), 1);
+  EXPECT_EQ(bitmap.containerCount(RoaringContainerType::BITSET), 1);
+  EXPECT_EQ(bitmap, original);
+  EXPECT_EQ(valuesOf(bitmap), valuesOf(original));
+ }
+
+ TEST(RoaringBitmap, run_containers_convert_on_modification) {
+  Roaring bitmap;
+  for (unsigned int i = 100; i < 10100; i++) {
+   bitmap.add(i);
+  }
+  bitmap.optimize();
+  EXPECT_EQ(bitmap.containerCount(RoaringContainerType::RUN), 1);
+  EXPECT_TRUE(bitmap.contains(100));
+  EXPECT_TRUE(bitmap.contains(10099));
+  EXPECT_FALSE(bitmap.contains(99));
+  EXPECT_FALSE(bitmap.contains(10100));
+  //No-op modifications keep the run representation
+  EXPECT_FALSE(bitmap.add(500));
+  EXPECT_FALSE(bitmap.remove(50));
+  EXPECT_EQ(bitmap.containerCount(RoaringContainerType::RUN), 1);
+  EXPECT_TRUE(bitmap.remove(500));
+  EXPECT_EQ(bitmap.containerCount(RoaringContainerType::BITSET), 1);
+  EXPECT_EQ(bitmap.cardinality(), 9999);
+  EXPECT_FALSE(bitmap.contains(500));
+ }
+
+ TEST(RoaringBitmap, union_and_intersection_match_reference_sets) {
+  Roaring a;
+  Roaring b;
+  fillRandom(a, 30000, 1 << 19, 3);
+  fillRandom(b, 30000, 1 << 19, 11);
+  //Add dense regions, so that every pair of representations is exercised
+  for (unsigned int i = 0; i < 40000; i++) {
+   a.add(0x80000 + i);
+   b.add(0x80000 + i * 3 / 2);
+  }
+  for (auto const optimized : {false, true}) {
+   if (optimized) {
+    a.optimize();
+   }
+   std::set<unsigned int> expectedUnion;
+   std::set<unsigned int> expectedIntersection;
+   auto const va = valuesOf(a);
+   auto const vb = valuesOf(b);
+   expectedUnion.insert(va.begin(), va.end());
+   expectedUnion.insert(vb.begin(), vb.end());
+   std::set<unsigned int> const sb(vb.begin(), vb.end());
+   for (auto const value : va) {
+    if (sb.count(value)) {
+     expectedIntersection.insert(value);
+    }
+   }
+   auto const united = a | b;
+   auto const intersected = a & b;
+   EXPECT_EQ(
+    valuesOf(united),
+    std::vector<unsigned int>(expectedUnion.begin(), expectedUnion.end())
+   );
+   EXPECT_EQ(
+    valuesOf(intersected),
+    std::vector<unsigned int>(
+     expectedIntersection.begin(),
+     expectedIntersection.end()
+    )
+   );
+   EXPECT_EQ(united.cardinality(), expectedUnion.size());
+   EXPECT_EQ(intersected.cardinality(), expectedIntersection.size());
+   EXPECT_EQ(a.intersectCardinality(b), expectedIntersection.size());
+   EXPECT_EQ(b.intersectCardinality(a), expectedIntersection.size());
+  }
+ }
+
+ TEST(RoaringBitmap, intersection_of_runs_and_bitsets) {
+  Roaring runs;
+  Roaring dense;
+  for (unsigned int i = 0; i < 30000; i++) {
+   runs.add(i);
+   runs.add(40000 + i);
+   dense.add(i * 2 + 1);
+  }
+  runs.optimize();
+  EXPECT_EQ(runs.containerCount(RoaringContainerType::RUN), 2);
+  EXPECT_EQ(dense.containerCount(RoaringContainerType::BITSET), 1);
+  auto const result = runs & dense;
+  //Odd values below 30000, and odd values in [40000, 60000)
+  EXPECT_EQ(result.cardinality(), 15000 + 10000);
+  EXPECT_EQ(runs.intersectCardinality(dense), 25000);
+  EXPECT_TRUE(result.contains(29999));
+  EXPECT_FALSE(result.contains(30001));
+  EXPECT_TRUE(result.contains(40001));
+  Roaring otherRuns;
+  for (unsigned int i = 20000; i < 50000; i++) {
+   otherRuns.add(i);
+  }
+  otherRuns.optimize();
+  EXPECT_EQ(runs.intersectCardinality(otherRuns), 20000);
+  EXPECT_EQ((runs & otherRuns).cardinality(), 20000);
+  EXPECT_EQ((runs | otherRuns).cardinality(), 65536 + 4464);
+ }
+
+ TEST(RoaringBitmap, compound_assignment_operators) {
+  Roaring a;
+  Roaring b;
+  for (unsigned int i = 0; i < 1000; i++) {
+   a.add(i);
+   b.add(i + 500);
+   b.add(0x30000 + i);
+  }
+  Roaring c{a};
+  c |= b;
+  EXPECT_EQ(c.cardinality(), 2500);
+  EXPECT_EQ(c.containerCount(), 2);
+  c &= a;
+  EXPECT_EQ(c, a);
+  c &= Roaring{};
+  EXPECT_TRUE(c.empty());
+  c |= c;
+  EXPECT_TRUE(c.empty());
+ }
+
+ TEST(RoaringBitmap, copy_and_move_semantics) {
+  Roaring a;
+  fillRandom(a, 10000, 1 << 18, 5);
+  Roaring b{a};
+  EXPECT_EQ(a, b);
+  b.add(0xABCDEF);
+  EXPECT_FALSE(a == b);
+  Roaring c{(Roaring&&)b};
+  EXPECT_TRUE(b.empty());
+  EXPECT_TRUE(c.contains(0xABCDEF));
+  b = c;
+  EXPECT_EQ(b, c);
+  a = (Roaring&&)c;
+  EXPECT_TRUE(c.empty());
+  EXPECT_EQ(a, b);
+ }
+
+ TEST(RoaringBitmap, serialized_bitmap_is_viewable_in_place) {
+  Roaring bitmap;
+  fillRandom(bitmap, 20000, 1 << 20, 13);
+  for (unsigned int i = 0; i < 60000; i++) {
+   bitmap.add(0x200000 + i);
+  }
+  for (unsigned int i = 0; i < 30000; i++) {
+   bitmap.add(0x300000 + i * 2);
+  }
+  bitmap.optimize();
+  EXPECT_GT(bitmap.containerCount(RoaringContainerType::ARRAY), 0);
+  EXPECT_EQ(bitmap.containerCount(RoaringContainerType::BITSET), 1);
+  EXPECT_EQ(bitmap.containerCount(RoaringContainerType::RUN), 1);
+  auto const size = bitmap.serializedSize();
+  std::vector<unsigned long long> buffer((size + 7) / 8);
+  auto const bytes = (unsigned char *)buffer.data();
+  EXPECT_EQ(bitmap.serialize(bytes), size);
+  ASSERT_TRUE(RoaringView::validate(bytes, size));
+  RoaringView const view{bytes};
+  EXPECT_EQ(view.containerCount(), bitmap.containerCount());
+  EXPECT_EQ(view.cardinality(), bitmap.cardinality());
+  EXPECT_EQ(valuesOf(view), valuesOf(bitmap));
+  for (unsigned int value = 0; value < 0x400000; value += 37) {
+   EXPECT_EQ(view.contains(value), bitmap.contains(value));
+  }
+  Roaring const deserialized{view};
+  EXPECT_EQ(deserialized, bitmap);
+ }
+
+ TEST(RoaringBitmap, validate_rejects_malformed_input) {
+  Roaring bitmap;
+  bitmap.add(1);
+  bitmap.add(0x50000);
+  auto const size = bitmap.serializedSize();
+  std::vector<unsigned long long> buffer((size + 7) / 8);
+  auto const bytes = (unsigned char *)buffer.data();
+  bitmap.serialize(bytes);
+  EXPECT_TRUE(RoaringView::validate(bytes, size));
+  //Truncated
+  EXPECT_FALSE(RoaringView::validate(bytes, size - 1));
+  EXPECT_FALSE(RoaringView::validate(bytes, 4));
+  EXPECT_FALSE(RoaringView::validate(nullptr, size));
+  //Misaligned
+  EXPECT_FALSE(RoaringView::validate(bytes + 1, size - 1));
+  //Bad magic
+  bytes[0] ^= 1;
+  EXPECT_FALSE(RoaringView::validate(bytes, size));
+  bytes[0] ^= 1;
+  //Bad container type
+  auto const type = bytes + sizeof(RoaringMetaFunctions::SerialHeader) + 2;
+  *type = 7;
+  EXPECT_FALSE(RoaringView::validate(bytes, size));
+  *type = 0;
+  //Empty bitmap
+  Roaring const empty;
+  unsigned long long header[1];
+  EXPECT_EQ(empty.serialize((unsigned char *)header), 8);
+  EXPECT_TRUE(RoaringView::validate((unsigned char *)header, 8));
+  EXPECT_EQ(RoaringView{(unsigned char *)header}.cardinality(), 0);
+ }
+
+ //Serialized single-container bitmap, with access to the directory entry
+ //and payload of its container
+ struct SerializedContainer final {
+  std::vector<unsigned long long> buffer;
+  SizeType size;
+
+  explicit SerializedContainer(Roaring const& bitmap) :
+   buffer((bitmap.serializedSize() + 7) / 8),
+   size(bitmap.serializedSize())
+  {
+   bitmap.serialize(bytes());
+  }
+
+  unsigned char * bytes() {
+   return (unsigned char *)buffer.data();
+  }
+
+  RoaringMetaFunctions::SerialContainer * entry() {
+   return (RoaringMetaFunctions::SerialContainer *)(
+    bytes() + sizeof(RoaringMetaFunctions::SerialHeader)
+   );
+  }
+
+  template<typename T>
+  T * payload() {
+   return (T *)(bytes() + entry()->offset);
+  }
+
+  bool valid() {
+   return RoaringView::validate(bytes(), size);
+  }
+ };
+
+ TEST(RoaringBitmap, validate_rejects_malformed_array_containers) {
+  Roaring bitmap;
+  for (unsigned int i = 0; i < 8; i++) {
+   bitmap.add(i * 3);
+  }
+  SerializedContainer serialized{bitmap};
+  ASSERT_EQ(serialized.entry()->type, RoaringContainerType::ARRAY);
+  EXPECT_TRUE(serialized.valid());
+  auto const values = serialized.payload<RoaringMetaFunctions::Low>();
+  //Unsorted
+  values[3] = 1;
+  EXPECT_FALSE(serialized.valid());
+  //Duplicate
+  values[3] = values[2];
+  EXPECT_FALSE(serialized.valid());
+  values[3] = 9;
+  EXPECT_TRUE(serialized.valid());
+
+  //More values than an array container may hold
+  Roaring large;
+  for (unsigned int i = 0; i < 5000; i++) {
+   large.add(i * 2);
+  }
+  large.optimize();
+  SerializedContainer oversized{large};
+  ASSERT_EQ(oversized.entry()->type, RoaringContainerType::BITSET);
+  std::vector<unsigned long long> buffer(
+   (sizeof(RoaringMetaFunctions::SerialHeader)
+    + sizeof(RoaringMetaFunctions::SerialContainer)
+    + 5000 * sizeof(RoaringMetaFunctions::Low)
+    + 7) / 8
+  );
+  auto const bytes = (unsigned char *)buffer.data();
+  __builtin_memcpy(
+   bytes,
+   oversized.bytes(),
+   sizeof(RoaringMetaFunctions::SerialHeader)
+    + sizeof(RoaringMetaFunctions::SerialContainer)
+  );
+  auto const entry = (RoaringMetaFunctions::SerialContainer *)(
+   bytes + sizeof(RoaringMetaFunctions::SerialHeader)
+  );
+  entry->type = RoaringContainerType::ARRAY;
+  entry->size = 5000;
+  auto const array = (RoaringMetaFunctions::Low *)(bytes + entry->offset);
+  for (unsigned int i = 0; i < 5000; i++) {
+   array[i] = (RoaringMetaFunctions::Low)(i * 2);
+  }
+  EXPECT_FALSE(RoaringView::validate(bytes, buffer.size() * 8));
+ }
+
+ TEST(RoaringBitmap, validate_rejects_malformed_run_containers) {
+  Roaring bitmap;
+  for (unsigned int i = 0; i < 100; i++) {
+   bitmap.add(i);
+   bitmap.add(1000 + i);
+   bitmap.add(2000 + i);
+  }
+  bitmap.optimize();
+  SerializedContainer serialized{bitmap};
+  ASSERT_EQ(serialized.entry()->type, RoaringContainerType::RUN);
+  ASSERT_EQ(serialized.entry()->size, 3u);
+  EXPECT_TRUE(serialized.valid());
+  auto const runs = serialized.payload<RoaringMetaFunctions::Run>();
+  //Inverted run
+  runs[1] = {1099, 1000};
+  EXPECT_FALSE(serialized.valid());
+  //Overlapping runs
+  runs[1] = {50, 149};
+  EXPECT_FALSE(serialized.valid());
+  //Unsorted runs
+  runs[1] = {3000, 3099};
+  EXPECT_FALSE(serialized.valid());
+  //Runs not adding up to the cardinality
+  runs[1] = {1000, 1100};
+  EXPECT_FALSE(serialized.valid());
+  runs[1] = {1000, 1099};
+  EXPECT_TRUE(serialized.valid());
+ }
+
+ TEST(RoaringBitmap, validate_rejects_malformed_bitset_containers) {
+  Roaring bitmap;
+  for (unsigned int i = 0; i < 10000; i++) {
+   bitmap.add(i * 5);
+  }
+  bitmap.optimize();
+  SerializedContainer serialized{bitmap};
+  ASSERT_EQ(serialized.entry()->type, RoaringContainerType::BITSET);
+  EXPECT_TRUE(serialized.valid());
+  //Popcount not matching the cardinality
+  auto const words = serialized.payload<unsigned long long>();
+  words[0] ^= 2;
+  EXPECT_FALSE(serialized.valid());
+  words[0] ^= 2;
+  serialized.entry()->cardinality++;
+  EXPECT_FALSE(serialized.valid());
+ }
+}
@@ -0,0 +1,172 @@
+#include <cx/test/common/common.h>
+
+#include <cx/sizeclass.h>
+#define CX_ALLOC_USER_IMPL CX::SizeClassAllocator
+#include <cx/allocator.h>
+#include <cx/arena.h>
+#include <cx/bitset.h>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace CX::Testing {
+ using namespace SizeClassMetaFunctions;
+
+ TEST(SizeClassMetaFunctions, classes_cover_sizes_without_gaps) {
+  EXPECT_EQ(ClassCount, 52);
+  EXPECT_EQ(classSize(0), 16);
+  EXPECT_EQ(classSize(LinearClasses - 1), 128);
+  EXPECT_EQ(classSize(LinearClasses), 160);
+  for (SizeType index = 1; index < ClassCount; index++) {
+   EXPECT_GT(classSize(index), classSize(index - 1));
+   EXPECT_EQ(classSize(index) % Granularity, 0);
+  }
+  for (SizeType size = 1; size <= MaxClassSize; size += size < 4096 ? 1 : 61) {
+   auto const index = classIndex(size);
+   ASSERT_LT(index, ClassCount);
+   EXPECT_GE(classSize(index), size);
+   if (index > 0) {
+    EXPECT_LT(classSize(index - 1), size);
+   }
+  }
+  EXPECT_EQ(classFor(MaxClassSize + 1, 8), ClassCount);
+  EXPECT_EQ(classFor(16, 8192), ClassCount);
+  //Alignment selects a class whose size is a multiple of the alignment
+  EXPECT_EQ(classSize(classFor(130, 64)), 192);
+  EXPECT_EQ(classSize(classFor(300, 256)), 512);
+ }
+
+ TEST(SizeClassAllocator, is_the_default_allocator) {
+  EXPECT_TRUE((IsStatelessAllocator<SizeClassAllocator>));
+  EXPECT_TRUE((SameType<Allocator<int>, SizeClassAllocator<int>>));
+ }
+
+ TEST(SizeClassHeap, allocations_are_aligned_and_distinct) {
+  struct Allocation final {
+   void * address;
+   SizeType size;
+   SizeType alignment;
+  };
+  std::vector<Allocation> allocations;
+  std::set<void *> addresses;
+  for (SizeType alignment = 1; alignment <= 16384; alignment *= 4) {
+   for (SizeType size : {1, 15, 16, 100, 129, 1000, 5000, 70000, 300000}) {
+    auto const p = SizeClassHeap::allocate(size, alignment);
+    EXPECT_EQ((SizeType)p % alignment, 0);
+    EXPECT_TRUE(addresses.insert(p).second);
+    ((unsigned char *)p)[0] = 1;
+    ((unsigned char *)p)[size - 1] = 1;
+    allocations.push_back({p, size, alignment});
+   }
+  }
+  for (auto const& allocation : allocations) {
+   SizeClassHeap::deallocate(
+    allocation.address,
+    allocation.size,
+    allocation.alignment
+   );
+  }
+ }
+
+ TEST(SizeClassHeap, freed_objects_are_reused) {
+  auto const p = SizeClassHeap::allocate(40, 8);
+  SizeClassHeap::deallocate(p, 40, 8);
+  EXPECT_EQ(SizeClassHeap::allocate(48, 16), p);
+  SizeClassHeap::deallocate(p, 48, 16);
+  //Churn does not map further memory
+  std::vector<void *> objects;
+  for (int i = 0; i < 10000; i++) {
+   objects.push_back(SizeClassHeap::allocate(64, 8));
+  }
+  for (auto const object : objects) {
+   SizeClassHeap::deallocate(object, 64, 8);
+  }
+  auto const mapped = SizeClassHeap::mappedBytes();
+  for (int round = 0; round < 10; round++) {
+   objects.clear();
+   for (int i = 0; i < 10000; i++) {
+    objects.push_back(SizeClassHeap::allocate(64, 8));
+   }
+   for (auto const object : objects) {
+    SizeClassHeap::deallocate(object, 64, 8);
+   }
+  }
+  EXPECT_EQ(SizeClassHeap::mappedBytes(), mapped);
+ }
+
+ TEST(SizeClassHeap, objects_migrate_between_threads) {
+  constexpr int const threads = 8;
+  std::vector<std::vector<SizeType *>> produced(threads);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; t++) {
+   workers.emplace_back([&, t] {
+    for (SizeType i = 0; i < 20000; i++) {
+     auto& value = +Allocator<SizeType>::allocate(1 + i % 7);
+     value = (SizeType)t;
+     produced[t].push_back(&value);
+    }
+   });
+  }
+  for (auto& worker : workers) {
+   worker.join();
+  }
+  workers.clear();
+  //Free every allocation from another thread
+  for (int t = 0; t < threads; t++) {
+   workers.emplace_back([&, t] {
+    auto const& values = produced[(t + 1) % threads];
+    for (SizeType i = 0; i < values.size(); i++) {
+     EXPECT_EQ(*values[i], (SizeType)((t + 1) % threads));
+     Allocator<SizeType>::deallocate(*values[i], 1 + i % 7);
+    }
+    SizeClassHeap::flushThreadCache();
+   });
+  }
+  for (auto& worker : workers) {
+   worker.join();
+  }
+ }
+
+ TEST(SizeClassAllocator, backs_cx_containers) {
+  DynamicBitset<> bitset{100000};
+  bitset.set(99999);
+  bitset.resize(500000, true);
+  EXPECT_EQ(bitset.count(), 400001);
+  Arena arena{1 << 20};
+  EXPECT_NE(arena.allocate(100, 8), nullptr);
+  EXPECT_EQ(arena.chunkCount(), 1);
+ }
+
+ TEST(SizeClassAllocator, allocations_expand_within_their_size_class) {
+  EXPECT_TRUE((IsAligningAllocator<SizeClassAllocator>));
+  EXPECT_TRUE((IsExpandingAllocator<SizeClassAllocator>));
+  EXPECT_TRUE(SizeClassHeap::expand(130, 160, 16));
+  EXPECT_FALSE(SizeClassHeap::expand(130, 200, 16));
+  EXPECT_TRUE(SizeClassHeap::expand(300000, 301000, 16));
+  EXPECT_FALSE(SizeClassHeap::expand(300000, 310000, 16));
+  Never none;
+  auto& p = +SizeClassAllocator<char>::allocate(130);
+  p = 'x';
+  EXPECT_EQ(&+reallocate<SizeClassAllocator>(none, p, 130, 160), &p);
+  auto& q = +reallocate<SizeClassAllocator>(none, p, 160, 4000);
+  EXPECT_NE(&q, &p);
+  EXPECT_EQ(q, 'x');
+  SizeClassAllocator<char>::deallocate(q, 4000);
+  auto const aligned = SizeClassAllocator<int>::allocate(3, 256);
+  ASSERT_TRUE(aligned.hasValue());
+  EXPECT_EQ((SizeType)&aligned.value() % 256, 0u);
+  SizeClassAllocator<int>::deallocate(aligned.value(), 3, 256);
+ }
+
+ TEST(SizeClassAllocator, supports_constant_evaluation) {
+  constexpr auto const value = [] {
+   auto& p = +SizeClassAllocator<int>::allocate(2);
+   (&p)[1] = 5;
+   auto const result = (&p)[1];
+   SizeClassAllocator<int>::deallocate(p, 2);
+   return result;
+  }();
+  EXPECT_EQ(value, 5);
+ }
+}
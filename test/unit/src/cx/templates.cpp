@@ -351,6 +351,24 @@ namespace CX::Testing {
   });
   EXPECT_EQ(invoked ^ expected, 0);
  }
+ TEST(MakeIndexSequence, yields_ascending_indices) {
+  EXPECT_TRUE((SameType<MakeIndexSequence<0>, IndexSequence<>>));
+  EXPECT_TRUE((SameType<MakeIndexSequence<1>, IndexSequence<0>>));
+  EXPECT_TRUE((SameType<MakeIndexSequence<5>, IndexSequence<0, 1, 2, 3, 4>>));
+  EXPECT_EQ(MakeIndexSequence<1000>::Size, 1000);
+ }
+
+ TEST(DescendingAlignmentOrder, yields_stable_descending_alignment_order) {
+  EXPECT_TRUE((SameType<DescendingAlignmentOrder<>, IndexSequence<>>));
+  EXPECT_TRUE((SameType<
+   DescendingAlignmentOrder<char, double, short, int, char, double>,
+   IndexSequence<1, 5, 3, 2, 0, 4>
+  >));
+  EXPECT_TRUE((SameType<
+   DescendingAlignmentOrder<char, double&>,
+   IndexSequence<1, 0>
+  >));
+ }
 }
 
 #ifdef CX_COMPILER_GCC
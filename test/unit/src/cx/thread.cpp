@@ -0,0 +1,30 @@
+#include <cx/test/common/common.h>
+#include <cx/thread.h>
+
+#include <thread>
+
+namespace CX::Testing {
+ //Argument of the most recent invocation of `recordExit`
+ void * recordedExitArgument = nullptr;
+
+ void recordExit(void * const argument) noexcept {
+  recordedExitArgument = argument;
+ }
+
+ TEST(onThreadExit, hook_is_invoked_with_latest_argument_on_thread_exit) {
+  int first = 0;
+  int second = 0;
+  recordedExitArgument = nullptr;
+  std::thread{[&] {
+   EXPECT_TRUE(onThreadExit<&recordExit>(&first));
+   EXPECT_TRUE(onThreadExit<&recordExit>(&second));
+   EXPECT_EQ(recordedExitArgument, nullptr);
+  }}.join();
+  EXPECT_EQ(recordedExitArgument, &second);
+
+  //Threads that do not register are unaffected
+  recordedExitArgument = nullptr;
+  std::thread{[] {}}.join();
+  EXPECT_EQ(recordedExitArgument, nullptr);
+ }
+}
@@ -2,6 +2,8 @@
 
 #include <cx/tuple.h>
 
+#include <tuple>
+
 namespace CX::Testing {
  //Supporting concepts
  template<typename Tuple, SizeType Index>
@@ -27,15 +29,19 @@ namespace CX::Testing {
  }
 
  TEST(Tuple, empty_tuple_rget_is_invalid) {
-  FAIL();
+  EXPECT_FALSE((TupleRgetIsValid<Tuple<>, 0>));
  }
 
  TEST(Tuple, empty_tuple_concat_empty_tuple_yields_empty_tuple) {
-  FAIL();
+  auto t = Tuple{} + Tuple{};
+  EXPECT_TRUE((SameType<decltype(t), Tuple<>>));
  }
 
  TEST(Tuple, empty_tuple_concat_populated_tuple_yields_populated_tuple) {
-  FAIL();
+  auto t = Tuple{} + Tuple{1, 'a'};
+  EXPECT_TRUE((SameType<decltype(t), Tuple<int, char>>));
+  EXPECT_EQ(t.get<0>(), 1);
+  EXPECT_EQ(t.get<1>(), 'a');
  }
 
  TEST(Tuple, populated_tuple_with_noexcept_types_is_noexcept_constructible) {
@@ -64,11 +70,296 @@ namespace CX::Testing {
  }
 
  TEST(Tuple, populated_tuple_with_non_noexcept_types_is_not_noexcept_constructible) {
-  FAIL();
+  struct A {
+   A() noexcept(false) {}
+   A(A const&) noexcept(false) {}
+  };
+  A a;
+  EXPECT_FALSE((noexcept(Tuple<int, A>{0, a})));
  }
 
  TEST(Tuple, populated_tuple_with_non_noexcept_types_is_not_noexcept_destructible) {
-  FAIL();
+  struct A {
+   ~A() noexcept(false) {}
+  };
+  EXPECT_FALSE((noexcept(Tuple<char, A>{'a', A{}}.~Tuple())));
+ }
+
+ TEST(Tuple, get_yields_elements_in_declared_order) {
+  Tuple<int, double, char const *> t{1, 2.5, "three"};
+  EXPECT_EQ(t.get<0>(), 1);
+  EXPECT_EQ(t.get<1>(), 2.5);
+  EXPECT_STREQ(t.get<2>(), "three");
+  t.get<0>() = 4;
+  EXPECT_EQ(t.get<0>(), 4);
+ }
+
+ TEST(Tuple, rget_yields_r_value_references) {
+  Tuple<int, float> t{0, 0.0f};
+  EXPECT_TRUE((SameType<decltype(t.rget<0>()), int&&>));
+  EXPECT_TRUE((SameType<decltype(t.rget<1>()), float&&>));
+ }
+
+ TEST(Tuple, elements_are_stored_in_declared_order) {
+  EXPECT_EQ((sizeof(Tuple<char, double, char>)), 24);
+  EXPECT_EQ((sizeof(Tuple<double, char, char>)), 16);
+ }
+
+ TEST(Tuple, empty_elements_occupy_no_storage) {
+  struct E1 {};
+  struct E2 {};
+  EXPECT_EQ((sizeof(Tuple<int, E1>)), sizeof(int));
+  EXPECT_EQ((sizeof(Tuple<E1, int, E2>)), sizeof(int));
+ }
+
+ TEST(Tuple, tuple_of_trivially_copyable_types_is_trivially_copyable) {
+  EXPECT_TRUE((TriviallyCopyable<Tuple<int, double, char>>));
+  EXPECT_TRUE((TriviallyCopyable<PackedTuple<int, double, char>>));
+ }
+
+ TEST(Tuple, tuple_of_identical_types_yields_distinct_elements) {
+  Tuple<int, int, int> t{1, 2, 3};
+  EXPECT_EQ(t.get<0>() + t.get<1>() * 10 + t.get<2>() * 100, 321);
+ }
+
+ TEST(Tuple, reference_elements_assign_through) {
+  int a = 1, b = 2;
+  Tuple<int&> ta{a};
+  Tuple<int&> tb{b};
+  ta = tb;
+  EXPECT_EQ(&ta.get<0>(), &a);
+  EXPECT_EQ(a, 2);
+ }
+
+ TEST(Tuple, default_constructor_value_initializes_elements) {
+  Tuple<int, double, void *> t;
+  EXPECT_EQ(t.get<0>(), 0);
+  EXPECT_EQ(t.get<1>(), 0.0);
+  EXPECT_EQ(t.get<2>(), nullptr);
+ }
+
+ TEST(Tuple, large_tuple_get_is_valid) {
+  using T = decltype([]<SizeType... I>(IndexSequence<I...>) {
+   return Tuple<decltype(I)...>{};
+  }(MakeIndexSequence<128>{}));
+  T t;
+  t.get<127>() = 127;
+  EXPECT_EQ(t.get<127>(), 127);
+  EXPECT_EQ(sizeof(T), 128 * sizeof(SizeType));
+ }
+
+ TEST(PackedTuple, elements_are_reordered_by_descending_alignment) {
+  EXPECT_EQ((sizeof(PackedTuple<char, double, char>)), 16);
+  EXPECT_EQ((sizeof(Tuple<char, int, short, char, double>)), 24);
+  EXPECT_EQ((sizeof(PackedTuple<char, int, short, char, double>)), 16);
+ }
+
+ TEST(PackedTuple, get_yields_elements_in_declared_order) {
+  PackedTuple t{'a', 1.5, (short)2, 3};
+  EXPECT_TRUE((SameType<decltype(t), PackedTuple<char, double, short, int>>));
+  EXPECT_EQ(t.get<0>(), 'a');
+  EXPECT_EQ(t.get<1>(), 1.5);
+  EXPECT_EQ(t.get<2>(), 2);
+  EXPECT_EQ(t.get<3>(), 3);
+ }
+
+ TEST(PackedTuple, supports_structured_binding_declarations) {
+  PackedTuple<char, double> t{'x', 2.0};
+  auto& [c, d] = t;
+  EXPECT_EQ(c, 'x');
+  EXPECT_EQ(d, 2.0);
+ }
+
+ TEST(PackedTuple, elements_are_forwarded) {
+  struct MoveOnly {
+   int value;
+   MoveOnly(int value) : value(value) {}
+   MoveOnly(MoveOnly const&) = delete;
+   MoveOnly(MoveOnly&&) = default;
+  };
+  PackedTuple<char, MoveOnly> t{'a', MoveOnly{7}};
+  EXPECT_EQ(t.get<1>().value, 7);
+ }
+
+ TEST(Tuple, apply_invokes_op_with_all_elements) {
+  Tuple<int, double, char> t{1, 2.5, 'c'};
+  auto const result = t.apply([](int i, double d, char c) {
+   return i + d + (c == 'c');
+  });
+  EXPECT_EQ(result, 4.5);
+  EXPECT_EQ(Tuple<>{}.apply([] { return 7; }), 7);
+ }
+
+ TEST(Tuple, apply_is_constexpr) {
+  constexpr auto const result = Tuple<int, int, int>{1, 2, 3}.apply(
+   [](int a, int b, int c) constexpr { return a * 100 + b * 10 + c; }
+  );
+  EXPECT_EQ(result, 123);
+ }
+
+ TEST(Tuple, apply_forwards_elements_of_r_value_tuples) {
+  struct MoveOnly {
+   int value;
+   MoveOnly(int value) : value(value) {}
+   MoveOnly(MoveOnly const&) = delete;
+   MoveOnly(MoveOnly&&) = default;
+  };
+  Tuple<MoveOnly, int> t{MoveOnly{5}, 1};
+  auto moved = ((Tuple<MoveOnly, int>&&)t).apply([](MoveOnly&& m, int&&) {
+   return MoveOnly{(MoveOnly&&)m};
+  });
+  EXPECT_EQ(moved.value, 5);
+  t.apply([](MoveOnly& m, int& i) {
+   m.value = 9;
+   i = 2;
+  });
+  EXPECT_EQ(t.get<0>().value, 9);
+  EXPECT_EQ(t.get<1>(), 2);
+ }
+
+ TEST(Tuple, for_each_visits_elements_in_declared_order) {
+  PackedTuple<char, double, short> t{'a', 2.0, (short)3};
+  int order = 0;
+  t.forEach([&]<SizeType Index>(auto& element) {
+   order = order * 10 + (int)Index + 1;
+   if constexpr (Index == 1) {
+    element = 4.0;
+   }
+  });
+  EXPECT_EQ(order, 123);
+  EXPECT_EQ(t.get<1>(), 4.0);
+  double sum = 0;
+  t.forEach([&](auto const& element) { sum += element; });
+  EXPECT_EQ(sum, 'a' + 4.0 + 3);
+ }
+
+ TEST(Tuple, transform_yields_tuple_of_results) {
+  Tuple<int, double> t{2, 1.5};
+  auto doubled = t.transform([](auto v) { return v * 2; });
+  EXPECT_TRUE((SameType<decltype(doubled), Tuple<int, double>>));
+  EXPECT_EQ(doubled.get<0>(), 4);
+  EXPECT_EQ(doubled.get<1>(), 3.0);
+  auto sizes = t.transform([](auto v) { return sizeof(v); });
+  EXPECT_TRUE((SameType<decltype(sizes), Tuple<SizeType, SizeType>>));
+ }
+
+ TEST(Tuple, free_functions_support_cx_and_stl_tuples) {
+  Tuple<int, int> cx{1, 2};
+  std::tuple<int, int> stl{3, 4};
+  std::pair<int, char> pair{5, 'x'};
+  auto const sum = [](int a, int b) { return a + b; };
+  EXPECT_EQ(CX::apply(sum, cx), 3);
+  EXPECT_EQ(CX::apply(sum, stl), 7);
+  int total = 0;
+  CX::forEach(stl, [&](int& v) { total += v; v = 0; });
+  EXPECT_EQ(total, 7);
+  EXPECT_EQ(std::get<0>(stl), 0);
+  auto t = CX::transform(pair, [](auto v) { return (int)v + 1; });
+  EXPECT_TRUE((SameType<decltype(t), Tuple<int, int>>));
+  EXPECT_EQ(t.get<1>(), 'x' + 1);
+ }
+
+ TEST(Tuple, supports_structured_binding_declarations) {
+  Tuple<int, double> t{1, 2.0};
+  auto& [i, d] = t;
+  i = 3;
+  EXPECT_EQ(t.get<0>(), 3);
+  EXPECT_EQ(d, 2.0);
+  auto [a, b] = CX::transform(std::tuple<int, int>{1, 2}, [](int v) {
+   return v * 3;
+  });
+  EXPECT_EQ(a + b, 9);
+ }
+
+ //Counts copies and moves of instances
+ struct CopyMoveCounter {
+  static inline int copies = 0;
+  static inline int moves = 0;
+
+  int value;
+
+  CopyMoveCounter(int value) noexcept : value(value) {}
+
+  CopyMoveCounter(CopyMoveCounter const& other) noexcept : value(other.value) {
+   copies++;
+  }
+
+  CopyMoveCounter(CopyMoveCounter&& other) noexcept : value(other.value) {
+   other.value = -1;
+   moves++;
+  }
+
+  static void reset() noexcept {
+   copies = 0;
+   moves = 0;
+  }
+ };
+
+ TEST(Tuple, concatenation_copies_elements_of_l_value_tuples) {
+  Tuple<CopyMoveCounter, int> t1{CopyMoveCounter{1}, 2};
+  Tuple<CopyMoveCounter> t2{CopyMoveCounter{3}};
+  CopyMoveCounter::reset();
+  auto t = t1 + t2;
+  EXPECT_TRUE((SameType<decltype(t), Tuple<CopyMoveCounter, int, CopyMoveCounter>>));
+  EXPECT_EQ(CopyMoveCounter::copies, 2);
+  EXPECT_EQ(CopyMoveCounter::moves, 0);
+  EXPECT_EQ(t.get<0>().value, 1);
+  EXPECT_EQ(t.get<1>(), 2);
+  EXPECT_EQ(t.get<2>().value, 3);
+  EXPECT_EQ(t1.get<0>().value, 1);
+ }
+
+ TEST(Tuple, concatenation_moves_elements_of_r_value_tuples) {
+  Tuple<CopyMoveCounter, int> t1{CopyMoveCounter{1}, 2};
+  Tuple<CopyMoveCounter> t2{CopyMoveCounter{3}};
+  CopyMoveCounter::reset();
+  auto t = (Tuple<CopyMoveCounter, int>&&)t1 + t2;
+  EXPECT_EQ(CopyMoveCounter::copies, 1);
+  EXPECT_EQ(CopyMoveCounter::moves, 1);
+  EXPECT_EQ(t1.get<0>().value, -1);
+  CopyMoveCounter::reset();
+  auto u = concatenate((decltype(t)&&)t, (Tuple<CopyMoveCounter>&&)t2, Tuple<char>{'c'});
+  EXPECT_EQ(CopyMoveCounter::copies, 0);
+  EXPECT_EQ(CopyMoveCounter::moves, 3);
+  EXPECT_EQ(u.get<0>().value, 1);
+  EXPECT_EQ(u.get<3>().value, 3);
+  EXPECT_EQ(u.get<4>(), 'c');
+ }
+
+ TEST(Tuple, concatenation_of_move_only_types_is_valid) {
+  struct MoveOnly {
+   MoveOnly() = default;
+   MoveOnly(MoveOnly const&) = delete;
+   MoveOnly(MoveOnly&&) = default;
+  };
+  auto t = Tuple<MoveOnly>{} + PackedTuple<MoveOnly, int>{MoveOnly{}, 1};
+  EXPECT_TRUE((SameType<decltype(t), Tuple<MoveOnly, MoveOnly, int>>));
+ }
+
+ TEST(TupleView, concatenate_view_yields_references_without_copies) {
+  Tuple<CopyMoveCounter, int> t1{CopyMoveCounter{1}, 2};
+  PackedTuple<double, CopyMoveCounter> t2{3.0, CopyMoveCounter{4}};
+  CopyMoveCounter::reset();
+  auto v = concatenateView(t1, t2);
+  EXPECT_TRUE((SameType<
+   decltype(v),
+   TupleView<CopyMoveCounter, int, double, CopyMoveCounter>
+  >));
+  EXPECT_EQ(CopyMoveCounter::copies, 0);
+  EXPECT_EQ(CopyMoveCounter::moves, 0);
+  EXPECT_EQ(&v.get<0>(), &t1.get<0>());
+  EXPECT_EQ(&v.get<2>(), &t2.get<0>());
+  v.get<3>().value = 5;
+  EXPECT_EQ(t2.get<1>().value, 5);
+ }
+
+ TEST(TupleView, view_concatenation_yields_view) {
+  Tuple<int> t1{1};
+  Tuple<char> t2{'a'};
+  auto v = view(t1) + view(t2);
+  EXPECT_TRUE((SameType<decltype(v), TupleView<int, char>>));
+  v.get<0>() = 2;
+  EXPECT_EQ(t1.get<0>(), 2);
  }
 
  //TODO remaining tuple tests
@@ -6,6 +6,7 @@
 #undef va_start
 #undef va_arg
 #undef va_end
+#undef va_copy
 #undef CX_LIBC_SUPPORT
 #define CX_VARARG_INTRENSICS
 #include <cx/vararg.h>
@@ -148,4 +149,123 @@ namespace CX::Testing {
  TEST(Vararg, cx_valist_is_copy_assignable) {
   EXPECT_TRUE((CopyAssignable<VaList>));
  }
+ TEST(Vararg, snapshot_is_independent_of_the_original_list) {
+  auto op = [](int n, ...) {
+   VaList list;
+   va_start(list, n);
+   EXPECT_EQ(list.arg<int>(), 1);
+   auto snapshot = list.snapshot();
+   EXPECT_EQ(list.arg<int>(), 2);
+   EXPECT_EQ(list.arg<int>(), 3);
+   EXPECT_EQ(snapshot.arg<int>(), 2);
+   EXPECT_EQ(snapshot.arg<int>(), 3);
+  };
+  op(3, 1, 2, 3);
+ }
+
+ TEST(Vararg, rewind_restores_the_position_of_a_snapshot) {
+  auto op = [](int n, ...) {
+   VaList list;
+   va_start(list, n);
+   auto const snapshot = list.snapshot();
+   for (int pass = 0; pass < 3; pass++) {
+    for (int i = 0; i < n; i++) {
+     EXPECT_EQ(list.arg<long>(), i * 10L);
+    }
+    list.rewind(snapshot);
+   }
+  };
+  op(4, 0L, 10L, 20L, 30L);
+ }
+
+ TEST(Vararg, copies_do_not_alias_the_original_list) {
+  auto op = [](int n, ...) {
+   VaList list;
+   va_start(list, n);
+   VaList copy{list};
+   VaList assigned;
+   assigned = list;
+   EXPECT_EQ(list.arg<double>(), 1.5);
+   EXPECT_EQ(copy.arg<double>(), 1.5);
+   EXPECT_EQ(copy.arg<double>(), 2.5);
+   EXPECT_EQ(assigned.arg<double>(), 1.5);
+   EXPECT_EQ(list.arg<double>(), 2.5);
+  };
+  op(2, 1.5, 2.5);
+ }
+
+ TEST(FormatArguments, conversions_map_to_argument_types) {
+  EXPECT_TRUE((SameType<FormatArguments<"no conversions %%">, Tuple<>>));
+  EXPECT_TRUE((SameType<
+   FormatArguments<"%d %i %hhd %hd %ld %lld %zd %td">,
+   Tuple<int, int, signed char, short, long, long long, SignPromoted<SizeType>, decltype((char *)0 - (char *)0)>
+  >));
+  EXPECT_TRUE((SameType<
+   FormatArguments<"%u %x %hhu %ho %lX %llu %zu">,
+   Tuple<unsigned, unsigned, unsigned char, unsigned short, unsigned long, unsigned long long, SizeType>
+  >));
+  EXPECT_TRUE((SameType<
+   FormatArguments<"%c %s %p %f %lf %.3e %Lg">,
+   Tuple<char, char const *, void const *, double, double, double, long double>
+  >));
+ }
+
+ TEST(FormatArguments, flags_width_and_precision_are_skipped) {
+  EXPECT_TRUE((SameType<
+   FormatArguments<"[%-+ #08.3f] [%'12lu]">,
+   Tuple<double, unsigned long>
+  >));
+ }
+
+ TEST(FormatArguments, star_width_and_precision_consume_int_arguments) {
+  EXPECT_TRUE((SameType<
+   FormatArguments<"%*d %.*s %*.*Lf">,
+   Tuple<int, int, int, char const *, int, int, long double>
+  >));
+ }
+
+ TEST(ValidFormat, unsupported_conversions_are_invalid) {
+  EXPECT_TRUE((ValidFormat<"%s: %zu (%p)">));
+  EXPECT_FALSE((ValidFormat<"%n">));
+  EXPECT_FALSE((ValidFormat<"%jd">));
+  EXPECT_FALSE((ValidFormat<"%ls">));
+  EXPECT_FALSE((ValidFormat<"%Ld">));
+  EXPECT_FALSE((ValidFormat<"%hf">));
+  EXPECT_FALSE((ValidFormat<"%q">));
+  EXPECT_FALSE((ValidFormat<"trailing %">));
+ }
+
+ TEST(decode, arguments_are_decoded_in_one_pass) {
+  int target = 0;
+  auto op = [&](int n, ...) {
+   VaList list;
+   va_start(list, n);
+   auto const [name, count, character, ratio, pointer, width, precise] =
+    decode<"%s %zu %c %.2f %p %*Lf">(list);
+   EXPECT_STREQ(name, "name");
+   EXPECT_EQ(count, (SizeType)42);
+   EXPECT_EQ(character, 'x');
+   EXPECT_EQ(ratio, 0.5);
+   EXPECT_EQ(pointer, &target);
+   EXPECT_EQ(width, 8);
+   EXPECT_EQ(precise, 1.25L);
+  };
+  op(0, "name", (SizeType)42, 'x', 0.5, (void *)&target, 8, 1.25L);
+ }
+
+ TEST(decode, snapshots_allow_decoding_arguments_twice) {
+  auto op = [](int n, ...) {
+   VaList list;
+   va_start(list, n);
+   auto const snapshot = list.snapshot();
+   auto const first = decode<"%hd %llx">(list);
+   list.rewind(snapshot);
+   auto const second = decode<"%hd %llx">(list);
+   EXPECT_EQ(first.get<0>(), (short)-3);
+   EXPECT_EQ(first.get<1>(), 0xFFFFFFFFFFULL);
+   EXPECT_EQ(second.get<0>(), first.get<0>());
+   EXPECT_EQ(second.get<1>(), first.get<1>());
+  };
+  op(0, (short)-3, 0xFFFFFFFFFFULL);
+ }
 }